@@ -0,0 +1,39 @@
+# Find the liburing library.
+#
+# This module defines the following variables:
+#
+# * URING_FOUND
+# * URING_INCLUDE_DIRS
+# * URING_LIBRARIES
+#
+# This module defines the following imported targets:
+#
+# * URING::uring
+#
+# This module defines the following interfaces:
+#
+# * URING
+
+find_path(URING_INCLUDE_DIR NAMES liburing.h)
+set(URING_INCLUDE_DIRS ${URING_INCLUDE_DIR})
+
+find_library(URING_LIBRARY NAMES uring)
+set(URING_LIBRARIES ${URING_LIBRARY})
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(
+    URING
+    REQUIRED_VARS URING_INCLUDE_DIR URING_LIBRARY)
+mark_as_advanced(URING_INCLUDE_DIR URING_LIBRARY)
+
+if(URING_FOUND AND NOT TARGET URING::uring)
+    add_library(URING::uring UNKNOWN IMPORTED)
+    set_target_properties(URING::uring PROPERTIES
+        IMPORTED_LOCATION "${URING_LIBRARY}"
+        INTERFACE_COMPILE_DEFINITIONS URING_FOUND
+        INTERFACE_INCLUDE_DIRECTORIES "${URING_INCLUDE_DIR}")
+endif()
+if(URING_FOUND AND NOT TARGET URING)
+    add_library(URING INTERFACE)
+    target_link_libraries(URING INTERFACE URING::uring)
+endif()
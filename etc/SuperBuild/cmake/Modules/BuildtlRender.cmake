@@ -6,6 +6,7 @@ set(tlRender_ARGS
     -DTLRENDER_API=${TLRENDER_API}
     -DTLRENDER_GLFW=${TLRENDER_GLFW}
     -DTLRENDER_NET=${TLRENDER_NET}
+    -DTLRENDER_URING=${TLRENDER_URING}
     -DTLRENDER_OCIO=${TLRENDER_OCIO}
     -DTLRENDER_AUDIO=${TLRENDER_AUDIO}
     -DTLRENDER_JPEG=${TLRENDER_JPEG}
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/AudioTimeStretch.h>
+#include <tlCore/Math.h>
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+using namespace tl;
+
+namespace
+{
+    //! Create audio with a mix of tones and noise.
+    std::vector<std::shared_ptr<audio::Audio> > getAudio(
+        const audio::Info& info,
+        size_t seconds,
+        size_t chunkSize)
+    {
+        std::vector<std::shared_ptr<audio::Audio> > out;
+        std::mt19937 random(0);
+        std::uniform_real_distribution<float> noise(-.05F, .05F);
+        for (size_t i = 0; i < seconds * info.sampleRate; i += chunkSize)
+        {
+            auto audio = audio::Audio::create(
+                audio::Info(info.channelCount, audio::DataType::F32, info.sampleRate),
+                chunkSize);
+            float* p = reinterpret_cast<float*>(audio->getData());
+            for (size_t j = 0; j < chunkSize; ++j)
+            {
+                const float t = (i + j) / static_cast<float>(info.sampleRate);
+                for (size_t c = 0; c < info.channelCount; ++c)
+                {
+                    p[j * info.channelCount + c] =
+                        .3F * std::sin(2.F * math::pi * (220.F + c * 110.F) * t) +
+                        noise(random);
+                }
+            }
+            out.push_back(audio::convert(audio, info.dataType));
+        }
+        return out;
+    }
+
+    void benchmark(const audio::Info& info, float speed)
+    {
+        const size_t seconds = 10;
+        const auto chunks = getAudio(info, seconds, 1024);
+        auto timeStretch = audio::AudioTimeStretch::create(info);
+        timeStretch->setSpeed(speed);
+        size_t sampleCount = 0;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (const auto& chunk : chunks)
+        {
+            sampleCount += timeStretch->process(chunk)->getSampleCount();
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+        const std::chrono::duration<double> diff = t1 - t0;
+
+        // The real-time factor is the duration of the output audio divided
+        // by the time it took to process.
+        const double duration = sampleCount / static_cast<double>(info.sampleRate);
+        std::cout << std::setw(10) << std::right << info.channelCount <<
+            std::setw(10) << info.dataType <<
+            std::setw(10) << std::fixed << std::setprecision(2) << speed <<
+            std::setw(14) << std::setprecision(3) << duration <<
+            std::setw(14) << diff.count() <<
+            std::setw(14) << std::setprecision(1) << duration / diff.count() << std::endl;
+    }
+}
+
+int main()
+{
+    std::cout << std::setw(10) << std::right << "Channels" <<
+        std::setw(10) << "Type" <<
+        std::setw(10) << "Speed" <<
+        std::setw(14) << "Output (s)" <<
+        std::setw(14) << "Time (s)" <<
+        std::setw(14) << "Real-time" << std::endl;
+    for (size_t channelCount : { 2, 8 })
+    {
+        for (auto dataType : { audio::DataType::S16, audio::DataType::F32 })
+        {
+            const audio::Info info(channelCount, dataType, 48000);
+            for (float speed : { .25F, .5F, .75F, 1.5F, 2.F, 4.F })
+            {
+                benchmark(info, speed);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlIO/DPX.h>
+
+#include <tlCore/File.h>
+#include <tlCore/FileBatch.h>
+#include <tlCore/FileIO.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace tl;
+
+namespace
+{
+    const image::Size imageSize(4096, 2160);
+    const size_t frameCount = 48;
+
+    void write(const file::Path& path)
+    {
+        const image::Info imageInfo(imageSize, image::PixelType::RGB_U10);
+        auto image = image::Image::create(imageInfo);
+        image->zero();
+        io::Info info;
+        info.video.push_back(imageInfo);
+        info.videoTime = otime::TimeRange(
+            otime::RationalTime(0.0, 24.0),
+            otime::RationalTime(frameCount, 24.0));
+        auto write = dpx::Write::create(path, info, io::Options(), std::weak_ptr<log::System>());
+        for (size_t i = 0; i < frameCount; ++i)
+        {
+            write->writeVideo(otime::RationalTime(i, 24.0), image);
+        }
+    }
+
+    double getRate(size_t byteCount, const std::chrono::steady_clock::time_point& t0)
+    {
+        const auto t1 = std::chrono::steady_clock::now();
+        const std::chrono::duration<double> diff = t1 - t0;
+        return byteCount / diff.count() / memory::gigabyte;
+    }
+
+    // Read the files one at a time with file::FileIO, like the current
+    // per-frame path.
+    double fileIO(const file::Path& path)
+    {
+        size_t byteCount = 0;
+        std::vector<uint8_t> buf;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < frameCount; ++i)
+        {
+            auto io = file::FileIO::create(path.get(i), file::Mode::Read);
+            buf.resize(io->getSize());
+            io->read(buf.data(), buf.size());
+            byteCount += buf.size();
+        }
+        return getRate(byteCount, t0);
+    }
+
+    // Read all of the files with a single batch.
+    double batchRead(const file::Path& path, bool direct, bool& uring)
+    {
+        file::BatchReadOptions options;
+        options.direct = direct;
+        auto batch = file::BatchRead::create(options);
+        uring = batch->hasURing();
+        std::vector<std::shared_ptr<image::Image> > images;
+        std::vector<file::BatchReadRequest> requests;
+        for (size_t i = 0; i < frameCount; ++i)
+        {
+            const std::string fileName = path.get(i);
+            const size_t size = file::FileIO::create(fileName, file::Mode::Read)->getSize();
+            images.push_back(image::Image::create(size, 1, image::PixelType::L_U8));
+            file::BatchReadRequest request;
+            request.fileName = fileName;
+            request.size = size;
+            request.data = images.back()->getData();
+            requests.push_back(request);
+        }
+        const auto t0 = std::chrono::steady_clock::now();
+        for (auto& future : batch->read(requests))
+        {
+            future.get();
+        }
+        return getRate(batch->getStats().byteCount, t0);
+    }
+
+    // Read the frames with the DPX reader.
+    double dpxRead(
+        const file::Path& path,
+        const std::shared_ptr<io::DecodePool>& decodePool,
+        const io::Options& options)
+    {
+        auto read = dpx::Read::create(path, options, nullptr, decodePool, std::weak_ptr<log::System>());
+        read->getInfo().get();
+        std::vector<otime::RationalTime> times;
+        for (size_t i = 0; i < frameCount; ++i)
+        {
+            times.push_back(otime::RationalTime(i, 24.0));
+        }
+        size_t byteCount = 0;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (auto& future : read->readVideo(times))
+        {
+            const auto videoData = future.get();
+            if (videoData.image)
+            {
+                byteCount += videoData.image->getDataByteCount();
+            }
+        }
+        return getRate(byteCount, t0);
+    }
+}
+
+int main()
+{
+    auto decodePool = io::DecodePool::create();
+    const std::string tempDir = file::createTempDir();
+    file::Path path(tempDir + '/', "render.", "0", 0, ".dpx");
+    path.setSequence(math::IntRange(0, frameCount - 1));
+    write(path);
+    std::cout << "Image size: " << imageSize << " 10-bit, " << frameCount << " frames" << std::endl;
+    std::cout << "Temporary directory: " << tempDir << std::endl;
+    std::cout << "Note: the files may be in the page cache; drop the caches" << std::endl;
+    std::cout << "between runs to measure the device." << std::endl;
+
+    std::cout << std::setw(32) << std::left << "Method" <<
+        std::setw(16) << std::right << "GB/s" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::setw(32) << std::left << "FileIO" <<
+        std::setw(16) << std::right << fileIO(path) << std::endl;
+    bool uring = false;
+    const double buffered = batchRead(path, false, uring);
+    std::cout << std::setw(32) << std::left << (uring ? "BatchRead (io_uring)" : "BatchRead (threads)") <<
+        std::setw(16) << std::right << buffered << std::endl;
+    const double direct = batchRead(path, true, uring);
+    std::cout << std::setw(32) << std::left << (uring ? "BatchRead O_DIRECT (io_uring)" : "BatchRead O_DIRECT (threads)") <<
+        std::setw(16) << std::right << direct << std::endl;
+
+    io::Options options;
+    std::cout << std::setw(32) << std::left << "dpx::Read" <<
+        std::setw(16) << std::right << dpxRead(path, decodePool, options) << std::endl;
+    options["SequenceIO/BatchRead"] = "1";
+    std::cout << std::setw(32) << std::left << "dpx::Read batch" <<
+        std::setw(16) << std::right << dpxRead(path, decodePool, options) << std::endl;
+    options["SequenceIO/DirectIO"] = "1";
+    std::cout << std::setw(32) << std::left << "dpx::Read batch O_DIRECT" <<
+        std::setw(16) << std::right << dpxRead(path, decodePool, options) << std::endl;
+
+    for (size_t i = 0; i < frameCount; ++i)
+    {
+        file::rm(path.get(i));
+    }
+    file::rmdir(tempDir);
+    return 0;
+}
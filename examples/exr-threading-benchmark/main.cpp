@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlIO/OpenEXR.h>
+
+#include <tlCore/File.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace tl;
+
+namespace
+{
+    const image::Size imageSize(3840, 2160);
+    const size_t frameCount = 24;
+
+    std::shared_ptr<image::Image> createImage()
+    {
+        // A gradient with some noise, so the image is not trivial to
+        // compress.
+        auto out = image::Image::create(imageSize.w, imageSize.h, image::PixelType::RGBA_F16);
+        image::F16_T* p = reinterpret_cast<image::F16_T*>(out->getData());
+        for (int y = 0; y < imageSize.h; ++y)
+        {
+            for (int x = 0; x < imageSize.w; ++x, p += 4)
+            {
+                const float noise = (std::rand() % 256) / 2550.F;
+                p[0] = x / static_cast<float>(imageSize.w) + noise;
+                p[1] = y / static_cast<float>(imageSize.h) + noise;
+                p[2] = 0.5F + noise;
+                p[3] = 1.F;
+            }
+        }
+        return out;
+    }
+
+    void write(
+        const file::Path& path,
+        exr::Compression compression,
+        const std::shared_ptr<image::Image>& image)
+    {
+        io::Info info;
+        info.video.push_back(image->getInfo());
+        info.videoTime = otime::TimeRange(
+            otime::RationalTime(0.0, 24.0),
+            otime::RationalTime(frameCount, 24.0));
+        io::Options options;
+        options["OpenEXR/Compression"] = exr::getLabel(compression);
+        auto write = exr::Write::create(path, info, options, std::weak_ptr<log::System>());
+        for (size_t i = 0; i < frameCount; ++i)
+        {
+            write->writeVideo(otime::RationalTime(i, 24.0), image);
+        }
+    }
+
+    // Read the frames one at a time, like scrubbing. Each frame is at the
+    // playhead.
+    double latency(
+        const file::Path& path,
+        const std::shared_ptr<io::DecodePool>& decodePool,
+        const std::string& chunkThreadCount)
+    {
+        io::Options options;
+        options["SequenceIO/ChunkThreadCount"] = chunkThreadCount;
+        auto read = exr::Read::create(path, options, nullptr, decodePool, std::weak_ptr<log::System>());
+        read->getInfo().get();
+        const auto t0 = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < frameCount; ++i)
+        {
+            read->readVideo(otime::RationalTime(i, 24.0)).get();
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+        const std::chrono::duration<double> diff = t1 - t0;
+        return diff.count() / frameCount * 1000.0;
+    }
+
+    // Read all of the frames at once, like filling the cache.
+    double throughput(
+        const file::Path& path,
+        const std::shared_ptr<io::DecodePool>& decodePool,
+        const std::string& chunkThreadCount)
+    {
+        io::Options options;
+        options["SequenceIO/ChunkThreadCount"] = chunkThreadCount;
+        auto read = exr::Read::create(path, options, nullptr, decodePool, std::weak_ptr<log::System>());
+        read->getInfo().get();
+        std::vector<otime::RationalTime> times;
+        for (size_t i = 0; i < frameCount; ++i)
+        {
+            times.push_back(otime::RationalTime(i, 24.0));
+        }
+        const auto t0 = std::chrono::steady_clock::now();
+        for (auto& future : read->readVideo(times))
+        {
+            future.get();
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+        const std::chrono::duration<double> diff = t1 - t0;
+        return frameCount / diff.count();
+    }
+}
+
+int main()
+{
+    auto decodePool = io::DecodePool::create();
+    // Creating the plugin sets up the OpenEXR thread pool.
+    auto plugin = exr::Plugin::create(nullptr, decodePool, std::weak_ptr<log::System>());
+    const auto image = createImage();
+    const std::string tempDir = file::createTempDir();
+    std::cout << "Image size: " << imageSize << ", " << frameCount << " frames" << std::endl;
+    std::cout << "Decode pool: " << decodePool->getThreadCount() << " threads" << std::endl;
+    std::cout << std::setw(12) << std::left << "Compression" <<
+        std::setw(20) << std::right << "Latency (ms)" <<
+        std::setw(20) << std::right << "Chunk threads (ms)" <<
+        std::setw(20) << std::right << "Throughput (fps)" <<
+        std::setw(20) << std::right << "Chunk threads (fps)" << std::endl;
+    for (auto compression : exr::getCompressionEnums())
+    {
+        file::Path path(tempDir + '/', exr::getLabel(compression) + ".", "0", 0, ".exr");
+        path.setSequence(math::IntRange(0, frameCount - 1));
+        write(path, compression, image);
+        std::cout << std::setw(12) << std::left << compression <<
+            std::fixed << std::setprecision(1) <<
+            std::setw(20) << std::right << latency(path, decodePool, "1") <<
+            std::setw(20) << std::right << latency(path, decodePool, "0") <<
+            std::setw(20) << std::right << throughput(path, decodePool, "1") <<
+            std::setw(20) << std::right << throughput(path, decodePool, "0") << std::endl;
+        for (size_t i = 0; i < frameCount; ++i)
+        {
+            file::rm(path.get(i));
+        }
+    }
+    file::rmdir(tempDir);
+    return 0;
+}
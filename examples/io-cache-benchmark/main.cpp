@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlIO/Cache.h>
+
+#include <tlCore/LRUCache.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace tl;
+
+namespace
+{
+    const size_t frameCount = 10000;
+    const size_t passCount = 10;
+
+    void print(const std::string& name, const std::chrono::duration<double>& diff)
+    {
+        const double requests = frameCount * passCount;
+        std::cout << std::setw(24) << std::left << name <<
+            std::setw(16) << std::right << std::fixed << std::setprecision(0) <<
+            requests / diff.count() << " requests/s" << std::endl;
+    }
+}
+
+int main()
+{
+    // Simulate the requests for a 10,000 frame image sequence where every
+    // frame is already in the cache.
+    const file::Path path("/path/to/a/render/directory/shot_010_comp_v001.0001.exr");
+    io::Options initOptions;
+    initOptions["SequenceIO/ThreadCount"] = "16";
+    initOptions["SequenceIO/DefaultSpeed"] = "24";
+    io::Options frameOptions = initOptions;
+    frameOptions["Layer"] = "0";
+    const auto image = image::Image::create(1, 1, image::PixelType::L_U8);
+
+    // String keys, as previously used by the I/O cache.
+    {
+        memory::LRUCache<std::string, io::VideoData> cache;
+        cache.setMax(frameCount);
+        for (size_t i = 0; i < frameCount; ++i)
+        {
+            const otime::RationalTime time(i, 24.0);
+            cache.add(
+                io::getVideoCacheKey(path, time, initOptions, frameOptions),
+                io::VideoData(time, 0, image));
+        }
+        const auto t0 = std::chrono::steady_clock::now();
+        io::VideoData videoData;
+        for (size_t pass = 0; pass < passCount; ++pass)
+        {
+            for (size_t i = 0; i < frameCount; ++i)
+            {
+                const otime::RationalTime time(i, 24.0);
+                cache.get(
+                    io::getVideoCacheKey(path, time, initOptions, frameOptions),
+                    videoData);
+            }
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+        print("String keys", t1 - t0);
+    }
+
+    // Binary keys.
+    {
+        auto cache = io::Cache::create();
+        const uint64_t pathID = io::getPathID(path);
+        const uint64_t initOptionsHash = io::getOptionsHash(initOptions);
+        for (size_t i = 0; i < frameCount; ++i)
+        {
+            const otime::RationalTime time(i, 24.0);
+            cache->addVideo(
+                io::getVideoCacheKey(pathID, time, initOptionsHash, frameOptions),
+                io::VideoData(time, 0, image));
+        }
+        const auto t0 = std::chrono::steady_clock::now();
+        io::VideoData videoData;
+        for (size_t pass = 0; pass < passCount; ++pass)
+        {
+            for (size_t i = 0; i < frameCount; ++i)
+            {
+                const otime::RationalTime time(i, 24.0);
+                cache->getVideo(
+                    io::getVideoCacheKey(pathID, time, initOptionsHash, frameOptions),
+                    videoData);
+            }
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+        print("Binary keys", t1 - t0);
+    }
+
+    return 0;
+}
@@ -0,0 +1,216 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/LRUCache.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+
+using namespace tl;
+
+namespace
+{
+    //! The previous LRU cache implementation, using ordered maps and
+    //! recency counters, for comparison.
+    template<typename T, typename U>
+    class MapLRUCache
+    {
+    public:
+        void setMax(size_t value)
+        {
+            _max = value;
+            _maxUpdate();
+        }
+
+        bool get(const T& key, U& value) const
+        {
+            auto i = _map.find(key);
+            if (i != _map.end())
+            {
+                value = i->second.first;
+                auto j = _counts.find(key);
+                if (j != _counts.end())
+                {
+                    ++_counter;
+                    j->second = _counter;
+                }
+                return true;
+            }
+            return false;
+        }
+
+        void add(const T& key, const U& value, size_t size = 1)
+        {
+            _map[key] = std::make_pair(value, size);
+            ++_counter;
+            _counts[key] = _counter;
+            _maxUpdate();
+        }
+
+    private:
+        size_t _getSize() const
+        {
+            size_t out = 0;
+            for (const auto& i : _map)
+            {
+                out += i.second.second;
+            }
+            return out;
+        }
+
+        void _maxUpdate()
+        {
+            if (_getSize() > _max)
+            {
+                std::map<int64_t, T> sorted;
+                for (const auto& i : _counts)
+                {
+                    sorted[i.second] = i.first;
+                }
+                while (_getSize() > _max)
+                {
+                    auto begin = sorted.begin();
+                    _map.erase(begin->second);
+                    _counts.erase(begin->second);
+                    sorted.erase(begin);
+                }
+            }
+        }
+
+        size_t _max = 10000;
+        std::map<T, std::pair<U, size_t> > _map;
+        mutable std::map<T, int64_t> _counts;
+        mutable int64_t _counter = 0;
+    };
+
+    //! Create keys that look like the I/O cache keys.
+    std::vector<std::string> getKeys(size_t count)
+    {
+        std::vector<std::string> out;
+        out.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            out.push_back(
+                "/path/to/a/render/directory/shot_010_comp_v001.####.exr;" +
+                std::to_string(i) +
+                ";" + std::to_string(i) + "/24;Layer:0;SequenceIO/ThreadCount:16");
+        }
+        return out;
+    }
+
+    template<typename T>
+    void benchmark(const std::string& name, T& cache, const std::vector<std::string>& keys)
+    {
+        const size_t count = keys.size();
+        cache.setMax(count);
+
+        // Fill the cache.
+        auto t0 = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < count; ++i)
+        {
+            cache.add(keys[i], static_cast<int>(i));
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        const std::chrono::duration<double> add = t1 - t0;
+
+        // Random lookups.
+        std::mt19937 random(0);
+        std::uniform_int_distribution<size_t> distribution(0, count - 1);
+        int value = 0;
+        t0 = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < count; ++i)
+        {
+            cache.get(keys[distribution(random)], value);
+        }
+        t1 = std::chrono::steady_clock::now();
+        const std::chrono::duration<double> get = t1 - t0;
+
+        // Add with eviction.
+        const size_t evictCount = std::min(count, size_t(10000));
+        t0 = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < evictCount; ++i)
+        {
+            cache.add(keys[i] + "+", static_cast<int>(i));
+        }
+        t1 = std::chrono::steady_clock::now();
+        const std::chrono::duration<double> evict = t1 - t0;
+
+        std::cout << std::setw(24) << std::left << name <<
+            std::setw(10) << std::right << count <<
+            std::setw(16) << std::fixed << std::setprecision(1) << add.count() / count * 1000000000.0 <<
+            std::setw(16) << get.count() / count * 1000000000.0 <<
+            std::setw(16) << evict.count() / evictCount * 1000000000.0 << std::endl;
+    }
+
+    void benchmarkConcurrent(const std::vector<std::string>& keys, size_t threadCount)
+    {
+        const size_t count = keys.size();
+        memory::ConcurrentLRUCache<std::string, int> cache;
+        cache.setMax(count);
+        const auto t0 = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < threadCount; ++i)
+        {
+            threads.push_back(std::thread(
+                [&cache, &keys, i, threadCount]
+                {
+                    int value = 0;
+                    for (size_t j = i; j < keys.size(); j += threadCount)
+                    {
+                        if (!cache.get(keys[j], value))
+                        {
+                            cache.add(keys[j], static_cast<int>(j));
+                        }
+                    }
+                }));
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+        const std::chrono::duration<double> diff = t1 - t0;
+        std::cout << std::setw(24) << std::left <<
+            ("concurrent x" + std::to_string(threadCount)) <<
+            std::setw(10) << std::right << count <<
+            std::setw(16) << std::fixed << std::setprecision(1) << diff.count() / count * 1000000000.0 <<
+            std::endl;
+    }
+}
+
+int main()
+{
+    std::cout << std::setw(24) << std::left << "Cache" <<
+        std::setw(10) << std::right << "Entries" <<
+        std::setw(16) << "Add (ns)" <<
+        std::setw(16) << "Get (ns)" <<
+        std::setw(16) << "Evict (ns)" << std::endl;
+    for (size_t count : { 10000, 100000, 1000000 })
+    {
+        const auto keys = getKeys(count);
+        {
+            memory::LRUCache<std::string, int> cache;
+            benchmark("LRUCache", cache, keys);
+        }
+        {
+            memory::ConcurrentLRUCache<std::string, int> cache;
+            benchmark("ConcurrentLRUCache", cache, keys);
+        }
+        // The previous implementation is quadratic when adding entries, so
+        // the larger sizes are skipped.
+        if (count <= 10000)
+        {
+            MapLRUCache<std::string, int> cache;
+            benchmark("MapLRUCache", cache, keys);
+        }
+        const size_t threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+        benchmarkConcurrent(keys, threadCount);
+    }
+    return 0;
+}
@@ -4,6 +4,7 @@
 
 #include <tlBakeApp/App.h>
 
+#include <tlTimelineCPU/Render.h>
 #include <tlTimelineGL/Render.h>
 
 #include <tlIO/System.h>
@@ -13,11 +14,15 @@
 #include <tlGL/Util.h>
 
 #include <tlCore/File.h>
+#include <tlCore/ImagePool.h>
 #include <tlCore/Math.h>
 #include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
 #include <tlCore/Time.h>
 
+#include <algorithm>
+#include <cstring>
+
 namespace tl
 {
     namespace bake
@@ -96,6 +101,24 @@ namespace tl
                         { "-sequenceThreadCount" },
                         "Number of threads for image sequence I/O.",
                         string::Format("{0}").arg(_options.sequenceThreadCount)),
+                    app::CmdLineValueOption<size_t>::create(
+                        _options.queueDepth,
+                        { "-queueDepth", "-qd" },
+                        "Number of frames in flight between decoding, rendering, and writing.",
+                        string::Format("{0}").arg(_options.queueDepth)),
+                    app::CmdLineValueOption<size_t>::create(
+                        _options.writeThreadCount,
+                        { "-writeThreadCount" },
+                        "Number of threads for writing image sequences. Movies are always written with a single thread.",
+                        string::Format("{0}").arg(_options.writeThreadCount)),
+                    app::CmdLineFlagOption::create(
+                        _options.cpuRender,
+                        { "-cpuRender" },
+                        "Render on the CPU, without a display or OpenGL."),
+                    app::CmdLineFlagOption::create(
+                        _options.audio,
+                        { "-audio" },
+                        "Write the timeline audio with the video, if the output is a movie."),
 #if defined(TLRENDER_EXR)
                     app::CmdLineValueOption<exr::Compression>::create(
                         _options.exrCompression,
@@ -167,7 +190,9 @@ namespace tl
         {}
 
         App::~App()
-        {}
+        {
+            _stopWriteThreads();
+        }
 
         std::shared_ptr<App> App::create(
             const std::vector<std::string>& argv,
@@ -185,11 +210,14 @@ namespace tl
                 _startTime = std::chrono::steady_clock::now();
 
                 // Create the window.
-                _window = gl::GLFWWindow::create(
-                    "test-patterns",
-                    math::Size2i(1, 1),
-                    _context,
-                    static_cast<int>(gl::GLFWWindowOptions::MakeCurrent));
+                if (!_options.cpuRender)
+                {
+                    _window = gl::GLFWWindow::create(
+                        "test-patterns",
+                        math::Size2i(1, 1),
+                        _context,
+                        static_cast<int>(gl::GLFWWindowOptions::MakeCurrent));
+                }
 
                 // Read the timeline.
                 timeline::Options options;
@@ -224,10 +252,18 @@ namespace tl
                 _print(string::Format("Render size: {0}").arg(_renderSize));
 
                 // Create the renderer.
-                _render = timeline_gl::Render::create(_context);
-                gl::OffscreenBufferOptions offscreenBufferOptions;
-                offscreenBufferOptions.colorType = gl::offscreenColorDefault;
-                _buffer = gl::OffscreenBuffer::create(_renderSize, offscreenBufferOptions);
+                if (_options.cpuRender)
+                {
+                    _cpuRender = timeline_cpu::Render::create(_context);
+                    _render = _cpuRender;
+                }
+                else
+                {
+                    _render = timeline_gl::Render::create(_context);
+                    gl::OffscreenBufferOptions offscreenBufferOptions;
+                    offscreenBufferOptions.colorType = gl::offscreenColorDefault;
+                    _buffer = gl::OffscreenBuffer::create(_renderSize, offscreenBufferOptions);
+                }
 
                 // Create the writer.
                 _writerPlugin = _context->getSystem<io::System>()->getPlugin(file::Path(_output));
@@ -249,26 +285,115 @@ namespace tl
                 _print(string::Format("Output info: {0} {1}").
                     arg(_outputInfo.size).
                     arg(_outputInfo.pixelType));
-                _outputImage = image::Image::create(_outputInfo);
                 ioInfo.video.push_back(_outputInfo);
                 ioInfo.videoTime = _timeRange;
-                _writer = _writerPlugin->write(file::Path(_output), ioInfo);
+                const auto movieExtensions = _writerPlugin->getExtensions(static_cast<int>(io::FileType::Movie));
+                if (_options.audio &&
+                    movieExtensions.find(string::toLower(file::Path(_output).getExtension())) != movieExtensions.end())
+                {
+                    ioInfo.audio = _timeline->getIOInfo().audio;
+                }
+                _audioInfo = ioInfo.audio;
+                if (_audioInfo.isValid())
+                {
+                    _print(string::Format("Output audio: {0} channels, {1}, {2} Hz").
+                        arg(_audioInfo.channelCount).
+                        arg(_audioInfo.dataType).
+                        arg(_audioInfo.sampleRate));
+                }
+                // Movies are written asynchronously, so encoding overlaps
+                // with rendering.
+                io::Options writeOptions;
+#if defined(TLRENDER_FFMPEG)
+                writeOptions["FFmpeg/WriteAsync"] = "1";
+                writeOptions["FFmpeg/WriteQueueSize"] = string::Format("{0}").arg(_options.queueDepth);
+#endif // TLRENDER_FFMPEG
+                _writer = _writerPlugin->write(file::Path(_output), ioInfo, writeOptions);
                 if (!_writer)
                 {
                     throw std::runtime_error(string::Format("{0}: Cannot open").arg(_output));
                 }
 
+                // Start the write threads. Image sequences can be written
+                // in parallel since each frame is a separate file, movies
+                // are written in order by a single thread.
+                _options.queueDepth = std::max(_options.queueDepth, size_t(1));
+                const size_t writeThreadCount = std::dynamic_pointer_cast<io::ISequenceWrite>(_writer) ?
+                    std::max(_options.writeThreadCount, size_t(1)) :
+                    1;
+                _print(string::Format("Queue depth: {0}").arg(_options.queueDepth));
+                _print(string::Format("Write threads: {0}").arg(writeThreadCount));
+                for (size_t i = 0; i < writeThreadCount; ++i)
+                {
+                    _writeThreads.push_back(std::thread(
+                        [this]
+                        {
+                            _writeThread();
+                        }));
+                }
+
+                // Create the pixel buffers used for asynchronous readback.
+                std::unique_ptr<gl::OffscreenBufferBinding> binding;
+                if (_buffer)
+                {
+                    binding.reset(new gl::OffscreenBufferBinding(_buffer));
+                }
+#if defined(TLRENDER_API_GL_4_1)
+                _pbos.resize(_buffer ? _options.queueDepth : 0, 0);
+                glGenBuffers(static_cast<GLsizei>(_pbos.size()), _pbos.data());
+                for (auto pbo : _pbos)
+                {
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+                    glBufferData(
+                        GL_PIXEL_PACK_BUFFER,
+                        image::getDataByteCount(_outputInfo),
+                        NULL,
+                        GL_STREAM_READ);
+                }
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+#endif // TLRENDER_API_GL_4_1
+
                 // Start the main loop.
-                gl::OffscreenBufferBinding binding(_buffer);
+                _requestTime = _inputTime;
                 while (_running)
                 {
                     _tick();
                 }
 
+                // Finish the frames that are still in flight.
+                while (!_readbacks.empty())
+                {
+                    _readbackFinish();
+                }
+                if (!_pbos.empty())
+                {
+                    glDeleteBuffers(static_cast<GLsizei>(_pbos.size()), _pbos.data());
+                    _pbos.clear();
+                }
+                {
+                    std::unique_lock<std::mutex> lock(_writeMutex.mutex);
+                    _writeMutex.stop = true;
+                }
+                _writeMutex.cv.notify_all();
+                for (auto& thread : _writeThreads)
+                {
+                    thread.join();
+                }
+                _writeThreads.clear();
+                {
+                    std::unique_lock<std::mutex> lock(_writeMutex.mutex);
+                    if (!_writeMutex.error.empty())
+                    {
+                        throw std::runtime_error(_writeMutex.error);
+                    }
+                }
+                _writer->finish();
+
                 const auto now = std::chrono::steady_clock::now();
                 const std::chrono::duration<float> diff = now - _startTime;
                 _print(string::Format("Seconds elapsed: {0}").arg(diff.count()));
                 _print(string::Format("Average FPS: {0}").arg(_timeRange.duration().value() / diff.count()));
+                _printTimings();
             }
 
             return _exit;
@@ -360,17 +485,72 @@ namespace tl
 
             _printProgress();
 
+            // Request the upcoming video frames so they are decoded while
+            // the current frame is rendered.
+            while (_videoRequests.size() < _options.queueDepth &&
+                _requestTime <= _timeRange.end_time_inclusive())
+            {
+                _videoRequests.push_back(_timeline->getVideo(_requestTime));
+                _requestTime += otime::RationalTime(1, _requestTime.rate());
+            }
+
             // Render the video.
+            const auto t0 = std::chrono::steady_clock::now();
+            const auto videoData = _videoRequests.front().future.get();
+            _videoRequests.pop_front();
+            const auto t1 = std::chrono::steady_clock::now();
+            _timings.decode += t1 - t0;
             _render->begin(_renderSize);
             _render->setOCIOOptions(_options.ocioOptions);
             _render->setLUTOptions(_options.lutOptions);
-            const auto videoData = _timeline->getVideo(_inputTime).future.get();
             _render->drawVideo(
                 { videoData },
                 { math::Box2i(0, 0, _renderSize.w, _renderSize.h) });
             _render->end();
+            const auto t2 = std::chrono::steady_clock::now();
+            _timings.render += t2 - t1;
 
-            // Write the frame.
+            // Read back the frame. The oldest readback is finished once all
+            // of the pixel buffers are in use.
+            _readbackStart();
+            if (_readbacks.size() >= _options.queueDepth)
+            {
+                _readbackFinish();
+            }
+
+            // Advance the time.
+            _inputTime += otime::RationalTime(1, _inputTime.rate());
+            if (_inputTime > _timeRange.end_time_inclusive())
+            {
+                _running = false;
+            }
+            _outputTime += otime::RationalTime(1, _outputTime.rate());
+        }
+
+        void App::_readbackStart()
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+            if (_cpuRender)
+            {
+                Readback readback;
+                readback.time = _outputTime;
+                readback.image = _getImage();
+                _cpuRender->copyImage(readback.image);
+                if (_outputInfo.layout.endian != memory::getEndian())
+                {
+                    const size_t wordSize = image::PixelType::RGB_U10 == _outputInfo.pixelType ?
+                        4 :
+                        static_cast<size_t>(std::max(image::getBitDepth(_outputInfo.pixelType) / 8, 1));
+                    memory::endian(
+                        readback.image->getData(),
+                        readback.image->getDataByteCount() / wordSize,
+                        wordSize);
+                }
+                _readbacks.push_back(readback);
+                const auto t1 = std::chrono::steady_clock::now();
+                _timings.readback += t1 - t0;
+                return;
+            }
             glPixelStorei(GL_PACK_ALIGNMENT, _outputInfo.layout.alignment);
 #if defined(TLRENDER_API_GL_4_1)
             glPixelStorei(GL_PACK_SWAP_BYTES, _outputInfo.layout.endian != memory::getEndian());
@@ -381,23 +561,283 @@ namespace tl
             {
                 throw std::runtime_error(string::Format("{0}: Cannot open").arg(_output));
             }
-            glReadPixels(
-                0,
-                0,
-                _outputInfo.size.w,
-                _outputInfo.size.h,
-                format,
-                type,
-                _outputImage->getData());
-            _writer->writeVideo(_outputTime, _outputImage);
+            Readback readback;
+            readback.time = _outputTime;
+            if (!_pbos.empty())
+            {
+#if defined(TLRENDER_API_GL_4_1)
+                // Read into a pixel buffer without waiting for the GPU.
+                readback.index = _pboIndex;
+                _pboIndex = (_pboIndex + 1) % _pbos.size();
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, _pbos[readback.index]);
+                glReadPixels(
+                    0,
+                    0,
+                    _outputInfo.size.w,
+                    _outputInfo.size.h,
+                    format,
+                    type,
+                    NULL);
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+#endif // TLRENDER_API_GL_4_1
+            }
+            else
+            {
+                readback.image = _getImage();
+                glReadPixels(
+                    0,
+                    0,
+                    _outputInfo.size.w,
+                    _outputInfo.size.h,
+                    format,
+                    type,
+                    readback.image->getData());
+            }
+            _readbacks.push_back(readback);
+            const auto t1 = std::chrono::steady_clock::now();
+            _timings.readback += t1 - t0;
+        }
+
+        void App::_readbackFinish()
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+            Readback readback = _readbacks.front();
+            _readbacks.pop_front();
+            if (!readback.image)
+            {
+#if defined(TLRENDER_API_GL_4_1)
+                readback.image = _getImage();
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, _pbos[readback.index]);
+                if (void* p = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY))
+                {
+                    memcpy(
+                        readback.image->getData(),
+                        p,
+                        readback.image->getDataByteCount());
+                    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+                }
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+#endif // TLRENDER_API_GL_4_1
+            }
+            const auto t1 = std::chrono::steady_clock::now();
+            _timings.readback += t1 - t0;
 
-            // Advance the time.
-            _inputTime += otime::RationalTime(1, _inputTime.rate());
-            if (_inputTime > _timeRange.end_time_inclusive())
+            // Add the frame to the write queue, waiting if it is full.
             {
-                _running = false;
+                std::unique_lock<std::mutex> lock(_writeMutex.mutex);
+                _writeMutex.cv.wait(
+                    lock,
+                    [this]
+                    {
+                        return
+                            _writeMutex.queue.size() < _options.queueDepth ||
+                            !_writeMutex.error.empty();
+                    });
+                if (!_writeMutex.error.empty())
+                {
+                    throw std::runtime_error(_writeMutex.error);
+                }
+                _writeMutex.queue.push_back(std::make_pair(readback.time, readback.image));
+            }
+            _writeMutex.cv.notify_all();
+            const auto t2 = std::chrono::steady_clock::now();
+            _timings.queue += t2 - t1;
+        }
+
+        std::shared_ptr<image::Image> App::_getImage()
+        {
+            std::shared_ptr<image::Image> out;
+            {
+                // Asynchronous writers hold on to the images until they are
+                // encoded, so only reuse images that are no longer shared.
+                std::unique_lock<std::mutex> lock(_writeMutex.mutex);
+                for (auto i = _writeMutex.images.begin(); i != _writeMutex.images.end(); ++i)
+                {
+                    if (1 == i->use_count())
+                    {
+                        out = *i;
+                        _writeMutex.images.erase(i);
+                        break;
+                    }
+                }
+            }
+            if (!out)
+            {
+                out = image::Image::create(_outputInfo);
+            }
+            return out;
+        }
+
+        void App::_writeThread()
+        {
+            while (true)
+            {
+                std::pair<otime::RationalTime, std::shared_ptr<image::Image> > frame;
+                {
+                    std::unique_lock<std::mutex> lock(_writeMutex.mutex);
+                    _writeMutex.cv.wait(
+                        lock,
+                        [this]
+                        {
+                            return !_writeMutex.queue.empty() || _writeMutex.stop;
+                        });
+                    if (_writeMutex.queue.empty())
+                    {
+                        break;
+                    }
+                    frame = _writeMutex.queue.front();
+                    _writeMutex.queue.pop_front();
+                }
+                _writeMutex.cv.notify_all();
+
+                const auto t0 = std::chrono::steady_clock::now();
+                std::string error;
+                try
+                {
+                    _writeAudio(frame.first);
+                    _writer->writeVideo(frame.first, frame.second);
+                }
+                catch (const std::exception& e)
+                {
+                    error = e.what();
+                }
+                const auto t1 = std::chrono::steady_clock::now();
+                {
+                    std::unique_lock<std::mutex> lock(_writeMutex.mutex);
+                    _writeMutex.time += t1 - t0;
+                    _writeMutex.images.push_back(frame.second);
+                    if (!error.empty() && _writeMutex.error.empty())
+                    {
+                        _writeMutex.error = error;
+                    }
+                }
+                _writeMutex.cv.notify_all();
+            }
+        }
+
+        void App::_writeAudio(const otime::RationalTime& time)
+        {
+            if (!_audioInfo.isValid())
+            {
+                return;
+            }
+
+            // Write the audio up to the end of the frame. The frame time is
+            // the output time which starts at zero, the timeline audio is
+            // requested one second at a time relative to the start of the
+            // timeline.
+            const otime::RationalTime timelineStart = _timeline->getTimeRange().start_time();
+            const int64_t sampleRate = _audioInfo.sampleRate;
+            const int64_t startSample = (_timeRange.start_time() - timelineStart).rescaled_to(sampleRate).value();
+            const int64_t endSample =
+                (time + otime::RationalTime(1.0, time.rate())).rescaled_to(sampleRate).value();
+            while (_audioSampleCount < endSample)
+            {
+                const int64_t t = startSample + _audioSampleCount;
+                const int64_t second = t / sampleRate;
+                if (second != _audioSecond)
+                {
+                    // Mix the audio layers. Layers that do not match the
+                    // output audio are resampled first.
+                    auto audioData = _timeline->getAudio(
+                        timelineStart.rescaled_to(1.0).value() + second).future.get();
+                    if (_audioLayerResample.size() < audioData.layers.size())
+                    {
+                        _audioLayerResample.resize(audioData.layers.size());
+                    }
+                    std::vector<std::shared_ptr<audio::Audio> > audioLayers;
+                    for (size_t i = 0; i < audioData.layers.size(); ++i)
+                    {
+                        const auto& audio = audioData.layers[i].audio;
+                        if (!audio)
+                        {
+                            continue;
+                        }
+                        if (audio->getInfo() == _audioInfo)
+                        {
+                            if (audio->getSampleCount() >= static_cast<size_t>(sampleRate))
+                            {
+                                audioLayers.push_back(audio);
+                            }
+                            continue;
+                        }
+                        auto& layerResample = _audioLayerResample[i];
+                        if (!layerResample.resample ||
+                            layerResample.resample->getInputInfo() != audio->getInfo())
+                        {
+                            layerResample.resample = audio::AudioResample::create(
+                                audio->getInfo(),
+                                _audioInfo);
+                            layerResample.buffer.clear();
+                        }
+                        if (auto resampled = layerResample.resample->process(audio))
+                        {
+                            layerResample.buffer.push_back(resampled);
+                        }
+
+                        // The resampler may hold back samples, so the
+                        // first second is padded at the start.
+                        const size_t sampleCount = std::min(
+                            audio::getSampleCount(layerResample.buffer),
+                            static_cast<size_t>(sampleRate));
+                        auto layerAudio = audio::Audio::create(_audioInfo, sampleRate);
+                        layerAudio->zero();
+                        const size_t byteCount = sampleCount * _audioInfo.getByteCount();
+                        audio::move(
+                            layerResample.buffer,
+                            layerAudio->getData() + layerAudio->getByteCount() - byteCount,
+                            byteCount);
+                        audioLayers.push_back(layerAudio);
+                    }
+                    std::vector<const uint8_t*> audioLayerP;
+                    for (const auto& audio : audioLayers)
+                    {
+                        audioLayerP.push_back(audio->getData());
+                    }
+                    _audioSecondData = audio::Audio::create(_audioInfo, sampleRate);
+                    _audioSecondData->zero();
+                    audio::mix(
+                        audioLayerP.data(),
+                        audioLayerP.size(),
+                        _audioSecondData->getData(),
+                        1.F,
+                        sampleRate,
+                        _audioInfo.channelCount,
+                        _audioInfo.dataType);
+                    _audioSecond = second;
+                }
+                const int64_t offset = t - second * sampleRate;
+                const int64_t size = std::min(sampleRate - offset, endSample - _audioSampleCount);
+                auto audio = audio::Audio::create(_audioInfo, size);
+                memcpy(
+                    audio->getData(),
+                    _audioSecondData->getData() + offset * _audioInfo.getByteCount(),
+                    audio->getByteCount());
+                _writer->writeAudio(
+                    otime::TimeRange(
+                        otime::RationalTime(_audioSampleCount, sampleRate),
+                        otime::RationalTime(size, sampleRate)),
+                    audio);
+                _audioSampleCount += size;
             }
-            _outputTime += otime::RationalTime(1, _outputTime.rate());
+        }
+
+        void App::_stopWriteThreads()
+        {
+            {
+                std::unique_lock<std::mutex> lock(_writeMutex.mutex);
+                _writeMutex.stop = true;
+                _writeMutex.queue.clear();
+            }
+            _writeMutex.cv.notify_all();
+            for (auto& thread : _writeThreads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+            _writeThreads.clear();
         }
 
         void App::_printProgress()
@@ -409,5 +849,26 @@ namespace tl
                 _print(string::Format("Complete: {0}%").arg(static_cast<int>(c / static_cast<float>(d) * 100)));
             }
         }
+
+        void App::_printTimings()
+        {
+            std::chrono::duration<double> writeTime;
+            {
+                std::unique_lock<std::mutex> lock(_writeMutex.mutex);
+                writeTime = _writeMutex.time;
+            }
+            _print(string::Format("Decode wait: {0} seconds").arg(_timings.decode.count()));
+            _print(string::Format("Render: {0} seconds").arg(_timings.render.count()));
+            _print(string::Format("Readback: {0} seconds").arg(_timings.readback.count()));
+            _print(string::Format("Write queue wait: {0} seconds").arg(_timings.queue.count()));
+            _print(string::Format("Write: {0} seconds").arg(writeTime.count()));
+            if (auto imagePool = image::getImagePool())
+            {
+                const auto stats = imagePool->getStats();
+                _print(string::Format("Image pool: {0} hits, {1} misses").
+                    arg(stats.hits).
+                    arg(stats.misses));
+            }
+        }
     }
 }
@@ -20,6 +20,13 @@
 #include <tlIO/USD.h>
 #endif // TLRENDER_USD
 
+#include <tlCore/AudioResample.h>
+
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+
 namespace tl
 {
     namespace gl
@@ -27,6 +34,11 @@ namespace tl
         class GLFWWindow;
     }
 
+    namespace timeline_cpu
+    {
+        class Render;
+    }
+
     //! tlbake application
     namespace bake
     {
@@ -40,6 +52,10 @@ namespace tl
             timeline::LUTOptions lutOptions;
             float sequenceDefaultSpeed = io::sequenceDefaultSpeed;
             int sequenceThreadCount = io::sequenceThreadCount;
+            size_t queueDepth = 4;
+            size_t writeThreadCount = 1;
+            bool cpuRender = false;
+            bool audio = false;
 
 #if defined(TLRENDER_EXR)
             exr::Compression exrCompression = exr::Compression::ZIP;
@@ -88,7 +104,14 @@ namespace tl
             io::Options _getIOOptions() const;
 
             void _tick();
+            void _readbackStart();
+            void _readbackFinish();
+            std::shared_ptr<image::Image> _getImage();
+            void _writeThread();
+            void _writeAudio(const otime::RationalTime&);
+            void _stopWriteThreads();
             void _printProgress();
+            void _printTimings();
 
             std::string _input;
             std::string _output;
@@ -100,15 +123,59 @@ namespace tl
             otime::TimeRange _timeRange = time::invalidTimeRange;
             otime::RationalTime _inputTime = time::invalidTime;
             otime::RationalTime _outputTime = time::invalidTime;
+            otime::RationalTime _requestTime = time::invalidTime;
+            std::list<timeline::VideoRequest> _videoRequests;
+
+            audio::Info _audioInfo;
+            int64_t _audioSampleCount = 0;
+            int64_t _audioSecond = -1;
+            std::shared_ptr<audio::Audio> _audioSecondData;
+            struct AudioLayerResample
+            {
+                std::shared_ptr<audio::AudioResample> resample;
+                std::list<std::shared_ptr<audio::Audio> > buffer;
+            };
+            std::vector<AudioLayerResample> _audioLayerResample;
 
             std::shared_ptr<gl::GLFWWindow> _window;
             std::shared_ptr<io::IPlugin> _usdPlugin;
             std::shared_ptr<timeline::IRender> _render;
+            std::shared_ptr<timeline_cpu::Render> _cpuRender;
             std::shared_ptr<gl::OffscreenBuffer> _buffer;
 
+            struct Readback
+            {
+                otime::RationalTime time = time::invalidTime;
+                size_t index = 0;
+                std::shared_ptr<image::Image> image;
+            };
+            std::vector<unsigned int> _pbos;
+            size_t _pboIndex = 0;
+            std::list<Readback> _readbacks;
+
             std::shared_ptr<io::IPlugin> _writerPlugin;
             std::shared_ptr<io::IWrite> _writer;
-            std::shared_ptr<image::Image> _outputImage;
+            struct WriteMutex
+            {
+                std::list<std::pair<otime::RationalTime, std::shared_ptr<image::Image> > > queue;
+                std::list<std::shared_ptr<image::Image> > images;
+                bool stop = false;
+                std::string error;
+                std::chrono::duration<double> time = std::chrono::duration<double>::zero();
+                std::mutex mutex;
+                std::condition_variable cv;
+            };
+            WriteMutex _writeMutex;
+            std::vector<std::thread> _writeThreads;
+
+            struct Timings
+            {
+                std::chrono::duration<double> decode = std::chrono::duration<double>::zero();
+                std::chrono::duration<double> render = std::chrono::duration<double>::zero();
+                std::chrono::duration<double> readback = std::chrono::duration<double>::zero();
+                std::chrono::duration<double> queue = std::chrono::duration<double>::zero();
+            };
+            Timings _timings;
 
             bool _running = true;
             std::chrono::steady_clock::time_point _startTime;
@@ -3,11 +3,14 @@
 // All rights reserved.
 
 #include <tlCore/Audio.h>
+#include <tlCore/AudioPrivate.h>
 
 #include <tlCore/Error.h>
 #include <tlCore/String.h>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 
 namespace tl
 {
@@ -131,6 +134,33 @@ namespace tl
             return out;
         }
 
+        TLRENDER_ENUM_IMPL(
+            SIMD,
+            "None",
+            "SSE2",
+            "AVX2");
+        TLRENDER_ENUM_SERIALIZE_IMPL(SIMD);
+
+        namespace
+        {
+            std::atomic<SIMD> simd(getCPUSIMD());
+        }
+
+        SIMD getSIMDSupported()
+        {
+            return getCPUSIMD();
+        }
+
+        SIMD getSIMD()
+        {
+            return simd;
+        }
+
+        void setSIMD(SIMD value)
+        {
+            simd = std::min(value, getCPUSIMD());
+        }
+
         namespace
         {
             template<typename T, typename TI>
@@ -139,24 +169,21 @@ namespace tl
                 size_t inCount,
                 uint8_t* out,
                 float volume,
-                size_t sampleCount,
-                size_t channelCount)
+                size_t start,
+                size_t size)
             {
                 const T** inP = reinterpret_cast<const T**>(in);
                 T* outP = reinterpret_cast<T*>(out);
-                for (size_t i = 0; i < sampleCount; ++i, outP += channelCount)
+                const TI min = static_cast<TI>(std::numeric_limits<T>::min());
+                const TI max = static_cast<TI>(std::numeric_limits<T>::max());
+                for (size_t i = start; i < size; ++i)
                 {
-                    for (size_t j = 0; j < channelCount; ++j)
+                    TI v = 0;
+                    for (size_t k = 0; k < inCount; ++k)
                     {
-                        const TI min = static_cast<TI>(std::numeric_limits<T>::min());
-                        const TI max = static_cast<TI>(std::numeric_limits<T>::max());
-                        TI v = 0;
-                        for (size_t k = 0; k < inCount; ++k)
-                        {
-                            v += math::clamp(static_cast<TI>(inP[k][i * channelCount + j] * volume), min, max);
-                        }
-                        outP[j] = math::clamp(v, min, max);
+                        v += math::clamp(static_cast<TI>(inP[k][i] * volume), min, max);
                     }
+                    outP[i] = math::clamp(v, min, max);
                 }
             }
 
@@ -166,22 +193,19 @@ namespace tl
                 size_t inCount,
                 uint8_t* out,
                 float volume,
-                size_t sampleCount,
-                size_t channelCount)
+                size_t start,
+                size_t size)
             {
                 const T** inP = reinterpret_cast<const T**>(in);
                 T* outP = reinterpret_cast<T*>(out);
-                for (size_t i = 0; i < sampleCount; ++i, outP += channelCount)
+                for (size_t i = start; i < size; ++i)
                 {
-                    for (size_t j = 0; j < channelCount; ++j)
+                    T v = static_cast<T>(0);
+                    for (size_t k = 0; k < inCount; ++k)
                     {
-                        T v = static_cast<T>(0);
-                        for (size_t k = 0; k < inCount; ++k)
-                        {
-                            v += inP[k][i * channelCount + j] * volume;
-                        }
-                        outP[j] = v;
+                        v += inP[k][i] * volume;
                     }
+                    outP[i] = v;
                 }
             }
         }
@@ -195,22 +219,34 @@ namespace tl
             size_t channelCount,
             DataType type)
         {
+            const size_t size = sampleCount * channelCount;
+            size_t start = 0;
+            switch (simd.load())
+            {
+            case SIMD::SSE2:
+                start = mixSSE2(in, inCount, out, volume, size, type);
+                break;
+            case SIMD::AVX2:
+                start = mixAVX2(in, inCount, out, volume, size, type);
+                break;
+            default: break;
+            }
             switch (type)
             {
             case DataType::S8:
-                mixI<int8_t, int16_t>(in, inCount, out, volume, sampleCount, channelCount);
+                mixI<int8_t, int16_t>(in, inCount, out, volume, start, size);
                 break;
             case DataType::S16:
-                mixI<int16_t, int32_t>(in, inCount, out, volume, sampleCount, channelCount);
+                mixI<int16_t, int32_t>(in, inCount, out, volume, start, size);
                 break;
             case DataType::S32:
-                mixI<int32_t, int64_t>(in, inCount, out, volume, sampleCount, channelCount);
+                mixI<int32_t, int64_t>(in, inCount, out, volume, start, size);
                 break;
             case DataType::F32:
-                mixF<float>(in, inCount, out, volume, sampleCount, channelCount);
+                mixF<float>(in, inCount, out, volume, start, size);
                 break;
             case DataType::F64:
-                mixF<double>(in, inCount, out, volume, sampleCount, channelCount);
+                mixF<double>(in, inCount, out, volume, start, size);
                 break;
             default: break;
             }
@@ -222,13 +258,14 @@ namespace tl
             void reverseI(
                 const uint8_t* in,
                 uint8_t* out,
+                size_t         start,
                 size_t         sampleCount,
                 size_t         channelCount)
             {
                 const T* inP = reinterpret_cast<const T*>(in) +
-                    (sampleCount - 1) * channelCount;
-                T* outP = reinterpret_cast<T*>(out);
-                for (size_t i = 0; i < sampleCount; ++i, inP -= channelCount, outP += channelCount)
+                    (sampleCount - 1 - start) * channelCount;
+                T* outP = reinterpret_cast<T*>(out) + start * channelCount;
+                for (size_t i = start; i < sampleCount; ++i, inP -= channelCount, outP += channelCount)
                 {
                     for (size_t j = 0; j < channelCount; ++j)
                     {
@@ -241,13 +278,14 @@ namespace tl
             void reverseF(
                 const uint8_t* in,
                 uint8_t* out,
+                size_t         start,
                 size_t         sampleCount,
                 size_t         channelCount)
             {
                 const T* inP = reinterpret_cast<const T*>(in) +
-                    (sampleCount - 1) * channelCount;
-                T* outP = reinterpret_cast<T*>(out);
-                for (size_t i = 0; i < sampleCount; ++i, inP -= channelCount, outP += channelCount)
+                    (sampleCount - 1 - start) * channelCount;
+                T* outP = reinterpret_cast<T*>(out) + start * channelCount;
+                for (size_t i = start; i < sampleCount; ++i, inP -= channelCount, outP += channelCount)
                 {
                     for (size_t j = 0; j < channelCount; ++j)
                     {
@@ -264,22 +302,34 @@ namespace tl
             size_t         channelCount,
             DataType       dataType)
         {
+            const size_t frameByteCount = channelCount * getByteCount(dataType);
+            size_t start = 0;
+            switch (simd.load())
+            {
+            case SIMD::SSE2:
+                start = reverseSSE2(in, out, sampleCount, frameByteCount);
+                break;
+            case SIMD::AVX2:
+                start = reverseAVX2(in, out, sampleCount, frameByteCount);
+                break;
+            default: break;
+            }
             switch (dataType)
             {
             case DataType::S8:
-                reverseI<int8_t>(in, out, sampleCount, channelCount);
+                reverseI<int8_t>(in, out, start, sampleCount, channelCount);
                 break;
             case DataType::S16:
-                reverseI<int16_t>(in, out, sampleCount, channelCount);
+                reverseI<int16_t>(in, out, start, sampleCount, channelCount);
                 break;
             case DataType::S32:
-                reverseI<int32_t>(in, out, sampleCount, channelCount);
+                reverseI<int32_t>(in, out, start, sampleCount, channelCount);
                 break;
             case DataType::F32:
-                reverseF<float>(in, out, sampleCount, channelCount);
+                reverseF<float>(in, out, start, sampleCount, channelCount);
                 break;
             case DataType::F64:
-                reverseF<double>(in, out, sampleCount, channelCount);
+                reverseF<double>(in, out, start, sampleCount, channelCount);
                 break;
             default: break;
             }
@@ -287,9 +337,9 @@ namespace tl
 
 #define _CONVERT(a, b) \
     { \
-        const a##_T * inP = reinterpret_cast<const a##_T *>(in->getData()); \
-        b##_T * outP = reinterpret_cast<b##_T *>(out->getData()); \
-        for (size_t i = 0; i < sampleCount * channelCount; ++i, ++inP, ++outP) \
+        const a##_T * inP = reinterpret_cast<const a##_T *>(in->getData()) + start; \
+        b##_T * outP = reinterpret_cast<b##_T *>(out->getData()) + start; \
+        for (size_t i = start; i < size; ++i, ++inP, ++outP) \
         { \
             a##To##b(*inP, *outP); \
         } \
@@ -310,6 +360,18 @@ namespace tl
             }
             else
             {
+                const size_t size = sampleCount * channelCount;
+                size_t start = 0;
+                switch (simd.load())
+                {
+                case SIMD::SSE2:
+                    start = convertSSE2(in->getData(), inType, out->getData(), type, size);
+                    break;
+                case SIMD::AVX2:
+                    start = convertAVX2(in->getData(), inType, out->getData(), type, size);
+                    break;
+                default: break;
+                }
                 switch (inType)
                 {
                 case DataType::S8:
@@ -380,11 +442,32 @@ namespace tl
                 {
                     planes.push_back(reinterpret_cast<const T*>(value->getData()) + i * sampleCount);
                 }
+                T* outP = reinterpret_cast<T*>(out->getData());
+                size_t start = 0;
+                if (2 == channelCount)
+                {
+                    const uint8_t* in0 = reinterpret_cast<const uint8_t*>(planes[0]);
+                    const uint8_t* in1 = reinterpret_cast<const uint8_t*>(planes[1]);
+                    switch (simd.load())
+                    {
+                    case SIMD::SSE2:
+                        start = interleaveStereoSSE2(in0, in1, out->getData(), sampleCount, sizeof(T));
+                        break;
+                    case SIMD::AVX2:
+                        start = interleaveStereoAVX2(in0, in1, out->getData(), sampleCount, sizeof(T));
+                        break;
+                    default: break;
+                    }
+                    for (auto& plane : planes)
+                    {
+                        plane += start;
+                    }
+                }
                 planarInterleave(
                     planes.data(),
-                    reinterpret_cast<T*>(out->getData()),
+                    outP + start * channelCount,
                     channelCount,
-                    sampleCount);
+                    sampleCount - start);
             }
         }
 
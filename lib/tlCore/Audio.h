@@ -175,6 +175,36 @@ namespace tl
             std::vector<uint8_t> _data;
         };
 
+        //! \name SIMD
+        ///@{
+
+        //! SIMD instruction sets used by the audio utility functions.
+        enum class SIMD
+        {
+            None,
+            SSE2,
+            AVX2,
+
+            Count,
+            First = None
+        };
+        TLRENDER_ENUM(SIMD);
+        TLRENDER_ENUM_SERIALIZE(SIMD);
+
+        //! Get the best SIMD instruction set supported by the CPU.
+        SIMD getSIMDSupported();
+
+        //! Get the SIMD instruction set used by the audio utility functions.
+        SIMD getSIMD();
+
+        //! Set the SIMD instruction set used by the audio utility functions.
+        //! The value is limited to what the CPU supports. This is intended
+        //! for testing and benchmarking, by default the best supported
+        //! instruction set is used.
+        void setSIMD(SIMD);
+
+        ///@}
+
         //! \name Utility
         ///@{
 
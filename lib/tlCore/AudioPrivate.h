@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Audio.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define TLRENDER_AUDIO_SIMD
+#endif // __x86_64__ || _M_X64
+
+namespace tl
+{
+    namespace audio
+    {
+        //! \name SIMD Kernels
+        //!
+        //! The kernels operate on flat arrays of interleaved samples. They
+        //! return the number of elements (or frames for reverse) that were
+        //! processed, and the remainder is processed by the scalar code.
+        //! The results are bit-identical to the scalar code.
+        ///@{
+
+        //! Get the best SIMD instruction set supported by the CPU.
+        SIMD getCPUSIMD();
+
+        size_t mixSSE2(
+            const uint8_t** in,
+            size_t          inCount,
+            uint8_t*        out,
+            float           volume,
+            size_t          size,
+            DataType);
+        size_t mixAVX2(
+            const uint8_t** in,
+            size_t          inCount,
+            uint8_t*        out,
+            float           volume,
+            size_t          size,
+            DataType);
+
+        size_t convertSSE2(
+            const uint8_t* in,
+            DataType       inType,
+            uint8_t*       out,
+            DataType       outType,
+            size_t         size);
+        size_t convertAVX2(
+            const uint8_t* in,
+            DataType       inType,
+            uint8_t*       out,
+            DataType       outType,
+            size_t         size);
+
+        size_t reverseSSE2(
+            const uint8_t* in,
+            uint8_t*       out,
+            size_t         sampleCount,
+            size_t         frameByteCount);
+        size_t reverseAVX2(
+            const uint8_t* in,
+            uint8_t*       out,
+            size_t         sampleCount,
+            size_t         frameByteCount);
+
+        size_t interleaveStereoSSE2(
+            const uint8_t* in0,
+            const uint8_t* in1,
+            uint8_t*       out,
+            size_t         sampleCount,
+            size_t         byteCount);
+        size_t interleaveStereoAVX2(
+            const uint8_t* in0,
+            const uint8_t* in1,
+            uint8_t*       out,
+            size_t         sampleCount,
+            size_t         byteCount);
+
+        ///@}
+    }
+}
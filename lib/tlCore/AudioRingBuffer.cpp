@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/AudioRingBuffer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace tl
+{
+    namespace audio
+    {
+        struct AudioRingBuffer::Private
+        {
+            Info info;
+            size_t byteCount = 0;
+            size_t sampleCount = 0;
+            std::vector<uint8_t> data;
+
+            // The positions increase monotonically, the producer only
+            // modifies the write position and the consumer only modifies
+            // the read position.
+            std::atomic<size_t> writePos;
+            std::atomic<size_t> readPos;
+        };
+
+        void AudioRingBuffer::_init(const Info& info, size_t sampleCount)
+        {
+            TLRENDER_P();
+            p.info = info;
+            p.byteCount = info.getByteCount();
+            p.sampleCount = sampleCount;
+            p.data.resize(sampleCount * p.byteCount);
+            p.writePos = 0;
+            p.readPos = 0;
+        }
+
+        AudioRingBuffer::AudioRingBuffer() :
+            _p(new Private)
+        {}
+
+        AudioRingBuffer::~AudioRingBuffer()
+        {}
+
+        std::shared_ptr<AudioRingBuffer> AudioRingBuffer::create(
+            const Info& info,
+            size_t sampleCount)
+        {
+            auto out = std::shared_ptr<AudioRingBuffer>(new AudioRingBuffer);
+            out->_init(info, sampleCount);
+            return out;
+        }
+
+        const Info& AudioRingBuffer::getInfo() const
+        {
+            return _p->info;
+        }
+
+        size_t AudioRingBuffer::getSampleCount() const
+        {
+            return _p->sampleCount;
+        }
+
+        size_t AudioRingBuffer::getReadAvailable() const
+        {
+            TLRENDER_P();
+            return
+                p.writePos.load(std::memory_order_acquire) -
+                p.readPos.load(std::memory_order_acquire);
+        }
+
+        size_t AudioRingBuffer::getWriteAvailable() const
+        {
+            return _p->sampleCount - getReadAvailable();
+        }
+
+        size_t AudioRingBuffer::write(const uint8_t* data, size_t sampleCount)
+        {
+            TLRENDER_P();
+            const size_t writePos = p.writePos.load(std::memory_order_relaxed);
+            const size_t readPos = p.readPos.load(std::memory_order_acquire);
+            const size_t out = std::min(sampleCount, p.sampleCount - (writePos - readPos));
+            if (out > 0)
+            {
+                const size_t index = writePos % p.sampleCount;
+                const size_t size = std::min(out, p.sampleCount - index);
+                std::memcpy(
+                    p.data.data() + index * p.byteCount,
+                    data,
+                    size * p.byteCount);
+                if (size < out)
+                {
+                    std::memcpy(
+                        p.data.data(),
+                        data + size * p.byteCount,
+                        (out - size) * p.byteCount);
+                }
+                p.writePos.store(writePos + out, std::memory_order_release);
+            }
+            return out;
+        }
+
+        size_t AudioRingBuffer::read(uint8_t* data, size_t sampleCount)
+        {
+            TLRENDER_P();
+            const size_t readPos = p.readPos.load(std::memory_order_relaxed);
+            const size_t writePos = p.writePos.load(std::memory_order_acquire);
+            const size_t out = std::min(sampleCount, writePos - readPos);
+            if (out > 0)
+            {
+                const size_t index = readPos % p.sampleCount;
+                const size_t size = std::min(out, p.sampleCount - index);
+                std::memcpy(
+                    data,
+                    p.data.data() + index * p.byteCount,
+                    size * p.byteCount);
+                if (size < out)
+                {
+                    std::memcpy(
+                        data + size * p.byteCount,
+                        p.data.data(),
+                        (out - size) * p.byteCount);
+                }
+                p.readPos.store(readPos + out, std::memory_order_release);
+            }
+            return out;
+        }
+
+        size_t AudioRingBuffer::skip(size_t sampleCount)
+        {
+            TLRENDER_P();
+            const size_t readPos = p.readPos.load(std::memory_order_relaxed);
+            const size_t writePos = p.writePos.load(std::memory_order_acquire);
+            const size_t out = std::min(sampleCount, writePos - readPos);
+            p.readPos.store(readPos + out, std::memory_order_release);
+            return out;
+        }
+    }
+}
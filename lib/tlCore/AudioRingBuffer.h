@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Audio.h>
+
+namespace tl
+{
+    namespace audio
+    {
+        //! Lock-free audio ring buffer.
+        //!
+        //! The ring buffer is safe to use from one producer thread and one
+        //! consumer thread at the same time. The storage is allocated when
+        //! the ring buffer is created, so reading and writing never
+        //! allocate memory or take locks, which makes the consumer side
+        //! suitable for use in real-time audio callbacks.
+        class AudioRingBuffer
+        {
+            TLRENDER_NON_COPYABLE(AudioRingBuffer);
+
+        protected:
+            void _init(const Info&, size_t sampleCount);
+
+            AudioRingBuffer();
+
+        public:
+            ~AudioRingBuffer();
+
+            //! Create a new ring buffer.
+            static std::shared_ptr<AudioRingBuffer> create(
+                const Info&,
+                size_t sampleCount);
+
+            //! Get the audio information.
+            const Info& getInfo() const;
+
+            //! Get the maximum number of samples the ring buffer can hold.
+            size_t getSampleCount() const;
+
+            //! Get the number of samples available for reading.
+            size_t getReadAvailable() const;
+
+            //! Get the number of samples available for writing.
+            size_t getWriteAvailable() const;
+
+            //! Write samples, returning the number of samples written. This
+            //! should only be called from the producer thread.
+            size_t write(const uint8_t*, size_t sampleCount);
+
+            //! Read samples, returning the number of samples read. This
+            //! should only be called from the consumer thread.
+            size_t read(uint8_t*, size_t sampleCount);
+
+            //! Discard samples, returning the number of samples discarded.
+            //! This should only be called from the consumer thread.
+            size_t skip(size_t sampleCount);
+
+        private:
+            TLRENDER_PRIVATE();
+        };
+    }
+}
@@ -0,0 +1,950 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/AudioPrivate.h>
+
+#include <algorithm>
+
+#if defined(TLRENDER_AUDIO_SIMD)
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define TLRENDER_AVX2
+#else // _MSC_VER
+#define TLRENDER_AVX2 __attribute__((target("avx2")))
+#endif // _MSC_VER
+#endif // TLRENDER_AUDIO_SIMD
+
+namespace tl
+{
+    namespace audio
+    {
+        SIMD getCPUSIMD()
+        {
+            SIMD out = SIMD::None;
+#if defined(TLRENDER_AUDIO_SIMD)
+            // SSE2 is always available on x86-64.
+            out = SIMD::SSE2;
+#if defined(_MSC_VER)
+            int info[4] = { 0, 0, 0, 0 };
+            __cpuid(info, 0);
+            if (info[0] >= 7)
+            {
+                __cpuid(info, 1);
+                const bool osxsave = info[2] & (1 << 27);
+                const bool avx = info[2] & (1 << 28);
+                if (osxsave && avx && (_xgetbv(0) & 6) == 6)
+                {
+                    __cpuidex(info, 7, 0);
+                    if (info[1] & (1 << 5))
+                    {
+                        out = SIMD::AVX2;
+                    }
+                }
+            }
+#else // _MSC_VER
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2"))
+            {
+                out = SIMD::AVX2;
+            }
+#endif // _MSC_VER
+#endif // TLRENDER_AUDIO_SIMD
+            return out;
+        }
+
+#if defined(TLRENDER_AUDIO_SIMD)
+        namespace
+        {
+            // The scalar code truncates to an integer and then clamps.
+            // Clamping the floating point value first gives the same result
+            // without overflowing the conversion.
+            inline __m128i clampTruncate(__m128 value, __m128 min, __m128 max)
+            {
+                return _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(value, min), max));
+            }
+
+            inline __m128i s16ToS32Lo(__m128i value)
+            {
+                return _mm_srai_epi32(_mm_unpacklo_epi16(value, value), 16);
+            }
+
+            inline __m128i s16ToS32Hi(__m128i value)
+            {
+                return _mm_srai_epi32(_mm_unpackhi_epi16(value, value), 16);
+            }
+
+            // Truncate to a 32-bit integer, saturating values greater than
+            // or equal to 2^31 to the maximum. Smaller values than -2^31
+            // already convert to the minimum.
+            inline __m128i truncateS32(__m128 value)
+            {
+                const __m128 big = _mm_cmpge_ps(value, _mm_set1_ps(2147483648.F));
+                const __m128i out = _mm_cvttps_epi32(value);
+                const __m128i bigI = _mm_castps_si128(big);
+                return _mm_or_si128(
+                    _mm_andnot_si128(bigI, out),
+                    _mm_and_si128(bigI, _mm_set1_epi32(S32Range.getMax())));
+            }
+
+            size_t mixS8SSE2(
+                const int8_t** in,
+                size_t inCount,
+                int8_t* out,
+                float volume,
+                size_t size)
+            {
+                // The scalar code sums in 16-bit integers.
+                if (inCount > 256)
+                    return 0;
+                const __m128 v = _mm_set1_ps(volume);
+                const __m128 min = _mm_set1_ps(S8Range.getMin());
+                const __m128 max = _mm_set1_ps(S8Range.getMax());
+                size_t i = 0;
+                for (; i + 16 <= size; i += 16)
+                {
+                    __m128i acc0 = _mm_setzero_si128();
+                    __m128i acc1 = _mm_setzero_si128();
+                    __m128i acc2 = _mm_setzero_si128();
+                    __m128i acc3 = _mm_setzero_si128();
+                    for (size_t k = 0; k < inCount; ++k)
+                    {
+                        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in[k] + i));
+                        const __m128i lo = _mm_srai_epi16(_mm_unpacklo_epi8(a, a), 8);
+                        const __m128i hi = _mm_srai_epi16(_mm_unpackhi_epi8(a, a), 8);
+                        acc0 = _mm_add_epi32(acc0, clampTruncate(_mm_mul_ps(_mm_cvtepi32_ps(s16ToS32Lo(lo)), v), min, max));
+                        acc1 = _mm_add_epi32(acc1, clampTruncate(_mm_mul_ps(_mm_cvtepi32_ps(s16ToS32Hi(lo)), v), min, max));
+                        acc2 = _mm_add_epi32(acc2, clampTruncate(_mm_mul_ps(_mm_cvtepi32_ps(s16ToS32Lo(hi)), v), min, max));
+                        acc3 = _mm_add_epi32(acc3, clampTruncate(_mm_mul_ps(_mm_cvtepi32_ps(s16ToS32Hi(hi)), v), min, max));
+                    }
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i*>(out + i),
+                        _mm_packs_epi16(_mm_packs_epi32(acc0, acc1), _mm_packs_epi32(acc2, acc3)));
+                }
+                return i;
+            }
+
+            size_t mixS16SSE2(
+                const int16_t** in,
+                size_t inCount,
+                int16_t* out,
+                float volume,
+                size_t size)
+            {
+                const __m128 v = _mm_set1_ps(volume);
+                const __m128 min = _mm_set1_ps(S16Range.getMin());
+                const __m128 max = _mm_set1_ps(S16Range.getMax());
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8)
+                {
+                    __m128i acc0 = _mm_setzero_si128();
+                    __m128i acc1 = _mm_setzero_si128();
+                    for (size_t k = 0; k < inCount; ++k)
+                    {
+                        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in[k] + i));
+                        acc0 = _mm_add_epi32(acc0, clampTruncate(_mm_mul_ps(_mm_cvtepi32_ps(s16ToS32Lo(a)), v), min, max));
+                        acc1 = _mm_add_epi32(acc1, clampTruncate(_mm_mul_ps(_mm_cvtepi32_ps(s16ToS32Hi(a)), v), min, max));
+                    }
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i*>(out + i),
+                        _mm_packs_epi32(acc0, acc1));
+                }
+                return i;
+            }
+
+            size_t mixS32SSE2(
+                const int32_t** in,
+                size_t inCount,
+                int32_t* out,
+                float volume,
+                size_t size)
+            {
+                // The scalar code sums in 64-bit integers, the sums are
+                // exact in double precision.
+                const __m128 v = _mm_set1_ps(volume);
+                const __m128d min = _mm_set1_pd(S32Range.getMin());
+                const __m128d max = _mm_set1_pd(S32Range.getMax());
+                size_t i = 0;
+                for (; i + 4 <= size; i += 4)
+                {
+                    __m128d acc0 = _mm_setzero_pd();
+                    __m128d acc1 = _mm_setzero_pd();
+                    for (size_t k = 0; k < inCount; ++k)
+                    {
+                        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in[k] + i));
+                        const __m128i t = truncateS32(_mm_mul_ps(_mm_cvtepi32_ps(a), v));
+                        acc0 = _mm_add_pd(acc0, _mm_cvtepi32_pd(t));
+                        acc1 = _mm_add_pd(acc1, _mm_cvtepi32_pd(_mm_shuffle_epi32(t, 0xEE)));
+                    }
+                    acc0 = _mm_min_pd(_mm_max_pd(acc0, min), max);
+                    acc1 = _mm_min_pd(_mm_max_pd(acc1, min), max);
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i*>(out + i),
+                        _mm_unpacklo_epi64(_mm_cvttpd_epi32(acc0), _mm_cvttpd_epi32(acc1)));
+                }
+                return i;
+            }
+
+            size_t mixF32SSE2(
+                const float** in,
+                size_t inCount,
+                float* out,
+                float volume,
+                size_t size)
+            {
+                const __m128 v = _mm_set1_ps(volume);
+                size_t i = 0;
+                for (; i + 4 <= size; i += 4)
+                {
+                    __m128 acc = _mm_setzero_ps();
+                    for (size_t k = 0; k < inCount; ++k)
+                    {
+                        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(in[k] + i), v));
+                    }
+                    _mm_storeu_ps(out + i, acc);
+                }
+                return i;
+            }
+
+            size_t mixF64SSE2(
+                const double** in,
+                size_t inCount,
+                double* out,
+                float volume,
+                size_t size)
+            {
+                const __m128d v = _mm_set1_pd(volume);
+                size_t i = 0;
+                for (; i + 2 <= size; i += 2)
+                {
+                    __m128d acc = _mm_setzero_pd();
+                    for (size_t k = 0; k < inCount; ++k)
+                    {
+                        acc = _mm_add_pd(acc, _mm_mul_pd(_mm_loadu_pd(in[k] + i), v));
+                    }
+                    _mm_storeu_pd(out + i, acc);
+                }
+                return i;
+            }
+        }
+
+        size_t mixSSE2(
+            const uint8_t** in,
+            size_t inCount,
+            uint8_t* out,
+            float volume,
+            size_t size,
+            DataType dataType)
+        {
+            size_t result = 0;
+            switch (dataType)
+            {
+            case DataType::S8:
+                result = mixS8SSE2(
+                    reinterpret_cast<const int8_t**>(in), inCount,
+                    reinterpret_cast<int8_t*>(out), volume, size);
+                break;
+            case DataType::S16:
+                result = mixS16SSE2(
+                    reinterpret_cast<const int16_t**>(in), inCount,
+                    reinterpret_cast<int16_t*>(out), volume, size);
+                break;
+            case DataType::S32:
+                result = mixS32SSE2(
+                    reinterpret_cast<const int32_t**>(in), inCount,
+                    reinterpret_cast<int32_t*>(out), volume, size);
+                break;
+            case DataType::F32:
+                result = mixF32SSE2(
+                    reinterpret_cast<const float**>(in), inCount,
+                    reinterpret_cast<float*>(out), volume, size);
+                break;
+            case DataType::F64:
+                result = mixF64SSE2(
+                    reinterpret_cast<const double**>(in), inCount,
+                    reinterpret_cast<double*>(out), volume, size);
+                break;
+            default: break;
+            }
+            return result;
+        }
+
+        namespace
+        {
+            TLRENDER_AVX2 inline __m256i clampTruncateAVX2(__m256 value, __m256 min, __m256 max)
+            {
+                return _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(value, min), max));
+            }
+
+            TLRENDER_AVX2 inline __m256i truncateS32AVX2(__m256 value)
+            {
+                const __m256 big = _mm256_cmp_ps(value, _mm256_set1_ps(2147483648.F), _CMP_GE_OQ);
+                return _mm256_blendv_epi8(
+                    _mm256_cvttps_epi32(value),
+                    _mm256_set1_epi32(S32Range.getMax()),
+                    _mm256_castps_si256(big));
+            }
+
+            TLRENDER_AVX2 inline __m128i packS32ToS16AVX2(__m256i value)
+            {
+                return _mm_packs_epi32(
+                    _mm256_castsi256_si128(value),
+                    _mm256_extracti128_si256(value, 1));
+            }
+
+            TLRENDER_AVX2 size_t mixS8AVX2(
+                const int8_t** in,
+                size_t inCount,
+                int8_t* out,
+                float volume,
+                size_t size)
+            {
+                if (inCount > 256)
+                    return 0;
+                const __m256 v = _mm256_set1_ps(volume);
+                const __m256 min = _mm256_set1_ps(S8Range.getMin());
+                const __m256 max = _mm256_set1_ps(S8Range.getMax());
+                size_t i = 0;
+                for (; i + 16 <= size; i += 16)
+                {
+                    __m256i acc0 = _mm256_setzero_si256();
+                    __m256i acc1 = _mm256_setzero_si256();
+                    for (size_t k = 0; k < inCount; ++k)
+                    {
+                        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in[k] + i));
+                        const __m256i lo = _mm256_cvtepi8_epi32(a);
+                        const __m256i hi = _mm256_cvtepi8_epi32(_mm_srli_si128(a, 8));
+                        acc0 = _mm256_add_epi32(acc0, clampTruncateAVX2(_mm256_mul_ps(_mm256_cvtepi32_ps(lo), v), min, max));
+                        acc1 = _mm256_add_epi32(acc1, clampTruncateAVX2(_mm256_mul_ps(_mm256_cvtepi32_ps(hi), v), min, max));
+                    }
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i*>(out + i),
+                        _mm_packs_epi16(packS32ToS16AVX2(acc0), packS32ToS16AVX2(acc1)));
+                }
+                return i;
+            }
+
+            TLRENDER_AVX2 size_t mixS16AVX2(
+                const int16_t** in,
+                size_t inCount,
+                int16_t* out,
+                float volume,
+                size_t size)
+            {
+                const __m256 v = _mm256_set1_ps(volume);
+                const __m256 min = _mm256_set1_ps(S16Range.getMin());
+                const __m256 max = _mm256_set1_ps(S16Range.getMax());
+                size_t i = 0;
+                for (; i + 16 <= size; i += 16)
+                {
+                    __m256i acc0 = _mm256_setzero_si256();
+                    __m256i acc1 = _mm256_setzero_si256();
+                    for (size_t k = 0; k < inCount; ++k)
+                    {
+                        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in[k] + i));
+                        const __m256i lo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(a));
+                        const __m256i hi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(a, 1));
+                        acc0 = _mm256_add_epi32(acc0, clampTruncateAVX2(_mm256_mul_ps(_mm256_cvtepi32_ps(lo), v), min, max));
+                        acc1 = _mm256_add_epi32(acc1, clampTruncateAVX2(_mm256_mul_ps(_mm256_cvtepi32_ps(hi), v), min, max));
+                    }
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packS32ToS16AVX2(acc0));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), packS32ToS16AVX2(acc1));
+                }
+                return i;
+            }
+
+            TLRENDER_AVX2 size_t mixS32AVX2(
+                const int32_t** in,
+                size_t inCount,
+                int32_t* out,
+                float volume,
+                size_t size)
+            {
+                const __m256 v = _mm256_set1_ps(volume);
+                const __m256d min = _mm256_set1_pd(S32Range.getMin());
+                const __m256d max = _mm256_set1_pd(S32Range.getMax());
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8)
+                {
+                    __m256d acc0 = _mm256_setzero_pd();
+                    __m256d acc1 = _mm256_setzero_pd();
+                    for (size_t k = 0; k < inCount; ++k)
+                    {
+                        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in[k] + i));
+                        const __m256i t = truncateS32AVX2(_mm256_mul_ps(_mm256_cvtepi32_ps(a), v));
+                        acc0 = _mm256_add_pd(acc0, _mm256_cvtepi32_pd(_mm256_castsi256_si128(t)));
+                        acc1 = _mm256_add_pd(acc1, _mm256_cvtepi32_pd(_mm256_extracti128_si256(t, 1)));
+                    }
+                    acc0 = _mm256_min_pd(_mm256_max_pd(acc0, min), max);
+                    acc1 = _mm256_min_pd(_mm256_max_pd(acc1, min), max);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_cvttpd_epi32(acc0));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), _mm256_cvttpd_epi32(acc1));
+                }
+                return i;
+            }
+
+            TLRENDER_AVX2 size_t mixF32AVX2(
+                const float** in,
+                size_t inCount,
+                float* out,
+                float volume,
+                size_t size)
+            {
+                const __m256 v = _mm256_set1_ps(volume);
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8)
+                {
+                    __m256 acc = _mm256_setzero_ps();
+                    for (size_t k = 0; k < inCount; ++k)
+                    {
+                        acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(in[k] + i), v));
+                    }
+                    _mm256_storeu_ps(out + i, acc);
+                }
+                return i;
+            }
+
+            TLRENDER_AVX2 size_t mixF64AVX2(
+                const double** in,
+                size_t inCount,
+                double* out,
+                float volume,
+                size_t size)
+            {
+                const __m256d v = _mm256_set1_pd(volume);
+                size_t i = 0;
+                for (; i + 4 <= size; i += 4)
+                {
+                    __m256d acc = _mm256_setzero_pd();
+                    for (size_t k = 0; k < inCount; ++k)
+                    {
+                        acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_loadu_pd(in[k] + i), v));
+                    }
+                    _mm256_storeu_pd(out + i, acc);
+                }
+                return i;
+            }
+        }
+
+        size_t mixAVX2(
+            const uint8_t** in,
+            size_t inCount,
+            uint8_t* out,
+            float volume,
+            size_t size,
+            DataType dataType)
+        {
+            size_t result = 0;
+            switch (dataType)
+            {
+            case DataType::S8:
+                result = mixS8AVX2(
+                    reinterpret_cast<const int8_t**>(in), inCount,
+                    reinterpret_cast<int8_t*>(out), volume, size);
+                break;
+            case DataType::S16:
+                result = mixS16AVX2(
+                    reinterpret_cast<const int16_t**>(in), inCount,
+                    reinterpret_cast<int16_t*>(out), volume, size);
+                break;
+            case DataType::S32:
+                result = mixS32AVX2(
+                    reinterpret_cast<const int32_t**>(in), inCount,
+                    reinterpret_cast<int32_t*>(out), volume, size);
+                break;
+            case DataType::F32:
+                result = mixF32AVX2(
+                    reinterpret_cast<const float**>(in), inCount,
+                    reinterpret_cast<float*>(out), volume, size);
+                break;
+            case DataType::F64:
+                result = mixF64AVX2(
+                    reinterpret_cast<const double**>(in), inCount,
+                    reinterpret_cast<double*>(out), volume, size);
+                break;
+            default: break;
+            }
+            return result;
+        }
+
+        size_t convertSSE2(
+            const uint8_t* in,
+            DataType inType,
+            uint8_t* out,
+            DataType outType,
+            size_t size)
+        {
+            size_t i = 0;
+            const float s16Max = static_cast<float>(S16Range.getMax());
+            const float s32Max = static_cast<float>(S32Range.getMax());
+            if (DataType::S16 == inType && DataType::S32 == outType)
+            {
+                const int16_t* inP = reinterpret_cast<const int16_t*>(in);
+                int32_t* outP = reinterpret_cast<int32_t*>(out);
+                for (; i + 8 <= size; i += 8)
+                {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(outP + i), _mm_slli_epi32(s16ToS32Lo(a), 16));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(outP + i + 4), _mm_slli_epi32(s16ToS32Hi(a), 16));
+                }
+            }
+            else if (DataType::S16 == inType && DataType::F32 == outType)
+            {
+                const int16_t* inP = reinterpret_cast<const int16_t*>(in);
+                float* outP = reinterpret_cast<float*>(out);
+                const __m128 d = _mm_set1_ps(s16Max);
+                for (; i + 8 <= size; i += 8)
+                {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                    _mm_storeu_ps(outP + i, _mm_div_ps(_mm_cvtepi32_ps(s16ToS32Lo(a)), d));
+                    _mm_storeu_ps(outP + i + 4, _mm_div_ps(_mm_cvtepi32_ps(s16ToS32Hi(a)), d));
+                }
+            }
+            else if (DataType::S16 == inType && DataType::F64 == outType)
+            {
+                const int16_t* inP = reinterpret_cast<const int16_t*>(in);
+                double* outP = reinterpret_cast<double*>(out);
+                const __m128d d = _mm_set1_pd(S16Range.getMax());
+                for (; i + 8 <= size; i += 8)
+                {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                    const __m128i lo = s16ToS32Lo(a);
+                    const __m128i hi = s16ToS32Hi(a);
+                    _mm_storeu_pd(outP + i, _mm_div_pd(_mm_cvtepi32_pd(lo), d));
+                    _mm_storeu_pd(outP + i + 2, _mm_div_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(lo, 0xEE)), d));
+                    _mm_storeu_pd(outP + i + 4, _mm_div_pd(_mm_cvtepi32_pd(hi), d));
+                    _mm_storeu_pd(outP + i + 6, _mm_div_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(hi, 0xEE)), d));
+                }
+            }
+            else if (DataType::S32 == inType && DataType::S16 == outType)
+            {
+                // Integer division rounds towards zero, so bias the
+                // negative values before shifting.
+                const int32_t* inP = reinterpret_cast<const int32_t*>(in);
+                int16_t* outP = reinterpret_cast<int16_t*>(out);
+                for (; i + 8 <= size; i += 8)
+                {
+                    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i + 4));
+                    a = _mm_srai_epi32(_mm_add_epi32(a, _mm_srli_epi32(_mm_srai_epi32(a, 31), 16)), 16);
+                    b = _mm_srai_epi32(_mm_add_epi32(b, _mm_srli_epi32(_mm_srai_epi32(b, 31), 16)), 16);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(outP + i), _mm_packs_epi32(a, b));
+                }
+            }
+            else if (DataType::S32 == inType && DataType::F32 == outType)
+            {
+                const int32_t* inP = reinterpret_cast<const int32_t*>(in);
+                float* outP = reinterpret_cast<float*>(out);
+                const __m128 d = _mm_set1_ps(s32Max);
+                for (; i + 4 <= size; i += 4)
+                {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                    _mm_storeu_ps(outP + i, _mm_div_ps(_mm_cvtepi32_ps(a), d));
+                }
+            }
+            else if (DataType::S32 == inType && DataType::F64 == outType)
+            {
+                const int32_t* inP = reinterpret_cast<const int32_t*>(in);
+                double* outP = reinterpret_cast<double*>(out);
+                const __m128d d = _mm_set1_pd(S32Range.getMax());
+                for (; i + 4 <= size; i += 4)
+                {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                    _mm_storeu_pd(outP + i, _mm_div_pd(_mm_cvtepi32_pd(a), d));
+                    _mm_storeu_pd(outP + i + 2, _mm_div_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(a, 0xEE)), d));
+                }
+            }
+            else if (DataType::F32 == inType && DataType::S16 == outType)
+            {
+                const float* inP = reinterpret_cast<const float*>(in);
+                int16_t* outP = reinterpret_cast<int16_t*>(out);
+                const __m128 m = _mm_set1_ps(S16Range.getMax());
+                const __m128 min = _mm_set1_ps(S16Range.getMin());
+                const __m128 max = _mm_set1_ps(S16Range.getMax());
+                for (; i + 8 <= size; i += 8)
+                {
+                    const __m128i a = clampTruncate(_mm_mul_ps(_mm_loadu_ps(inP + i), m), min, max);
+                    const __m128i b = clampTruncate(_mm_mul_ps(_mm_loadu_ps(inP + i + 4), m), min, max);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(outP + i), _mm_packs_epi32(a, b));
+                }
+            }
+            else if (DataType::F32 == inType && DataType::F64 == outType)
+            {
+                const float* inP = reinterpret_cast<const float*>(in);
+                double* outP = reinterpret_cast<double*>(out);
+                for (; i + 4 <= size; i += 4)
+                {
+                    const __m128 a = _mm_loadu_ps(inP + i);
+                    _mm_storeu_pd(outP + i, _mm_cvtps_pd(a));
+                    _mm_storeu_pd(outP + i + 2, _mm_cvtps_pd(_mm_movehl_ps(a, a)));
+                }
+            }
+            else if (DataType::F64 == inType && DataType::S16 == outType)
+            {
+                const double* inP = reinterpret_cast<const double*>(in);
+                int16_t* outP = reinterpret_cast<int16_t*>(out);
+                const __m128d m = _mm_set1_pd(S16Range.getMax());
+                const __m128d min = _mm_set1_pd(S16Range.getMin());
+                const __m128d max = _mm_set1_pd(S16Range.getMax());
+                for (; i + 8 <= size; i += 8)
+                {
+                    __m128i s[4];
+                    for (size_t j = 0; j < 4; ++j)
+                    {
+                        const __m128d a = _mm_mul_pd(_mm_loadu_pd(inP + i + j * 2), m);
+                        s[j] = _mm_cvttpd_epi32(_mm_min_pd(_mm_max_pd(a, min), max));
+                    }
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i*>(outP + i),
+                        _mm_packs_epi32(_mm_unpacklo_epi64(s[0], s[1]), _mm_unpacklo_epi64(s[2], s[3])));
+                }
+            }
+            else if (DataType::F64 == inType && DataType::F32 == outType)
+            {
+                const double* inP = reinterpret_cast<const double*>(in);
+                float* outP = reinterpret_cast<float*>(out);
+                for (; i + 4 <= size; i += 4)
+                {
+                    const __m128 a = _mm_cvtpd_ps(_mm_loadu_pd(inP + i));
+                    const __m128 b = _mm_cvtpd_ps(_mm_loadu_pd(inP + i + 2));
+                    _mm_storeu_ps(outP + i, _mm_movelh_ps(a, b));
+                }
+            }
+            return i;
+        }
+
+        TLRENDER_AVX2 size_t convertAVX2(
+            const uint8_t* in,
+            DataType inType,
+            uint8_t* out,
+            DataType outType,
+            size_t size)
+        {
+            size_t i = 0;
+            const float s16Max = static_cast<float>(S16Range.getMax());
+            const float s32Max = static_cast<float>(S32Range.getMax());
+            if (DataType::S16 == inType && DataType::S32 == outType)
+            {
+                const int16_t* inP = reinterpret_cast<const int16_t*>(in);
+                int32_t* outP = reinterpret_cast<int32_t*>(out);
+                for (; i + 8 <= size; i += 8)
+                {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                    _mm256_storeu_si256(
+                        reinterpret_cast<__m256i*>(outP + i),
+                        _mm256_slli_epi32(_mm256_cvtepi16_epi32(a), 16));
+                }
+            }
+            else if (DataType::S16 == inType && DataType::F32 == outType)
+            {
+                const int16_t* inP = reinterpret_cast<const int16_t*>(in);
+                float* outP = reinterpret_cast<float*>(out);
+                const __m256 d = _mm256_set1_ps(s16Max);
+                for (; i + 8 <= size; i += 8)
+                {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                    _mm256_storeu_ps(outP + i, _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(a)), d));
+                }
+            }
+            else if (DataType::S16 == inType && DataType::F64 == outType)
+            {
+                const int16_t* inP = reinterpret_cast<const int16_t*>(in);
+                double* outP = reinterpret_cast<double*>(out);
+                const __m256d d = _mm256_set1_pd(S16Range.getMax());
+                for (; i + 8 <= size; i += 8)
+                {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                    const __m256i b = _mm256_cvtepi16_epi32(a);
+                    _mm256_storeu_pd(outP + i, _mm256_div_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(b)), d));
+                    _mm256_storeu_pd(outP + i + 4, _mm256_div_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(b, 1)), d));
+                }
+            }
+            else if (DataType::S32 == inType && DataType::S16 == outType)
+            {
+                const int32_t* inP = reinterpret_cast<const int32_t*>(in);
+                int16_t* outP = reinterpret_cast<int16_t*>(out);
+                for (; i + 8 <= size; i += 8)
+                {
+                    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inP + i));
+                    a = _mm256_srai_epi32(_mm256_add_epi32(a, _mm256_srli_epi32(_mm256_srai_epi32(a, 31), 16)), 16);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(outP + i), packS32ToS16AVX2(a));
+                }
+            }
+            else if (DataType::S32 == inType && DataType::F32 == outType)
+            {
+                const int32_t* inP = reinterpret_cast<const int32_t*>(in);
+                float* outP = reinterpret_cast<float*>(out);
+                const __m256 d = _mm256_set1_ps(s32Max);
+                for (; i + 8 <= size; i += 8)
+                {
+                    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inP + i));
+                    _mm256_storeu_ps(outP + i, _mm256_div_ps(_mm256_cvtepi32_ps(a), d));
+                }
+            }
+            else if (DataType::S32 == inType && DataType::F64 == outType)
+            {
+                const int32_t* inP = reinterpret_cast<const int32_t*>(in);
+                double* outP = reinterpret_cast<double*>(out);
+                const __m256d d = _mm256_set1_pd(S32Range.getMax());
+                for (; i + 4 <= size; i += 4)
+                {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                    _mm256_storeu_pd(outP + i, _mm256_div_pd(_mm256_cvtepi32_pd(a), d));
+                }
+            }
+            else if (DataType::F32 == inType && DataType::S16 == outType)
+            {
+                const float* inP = reinterpret_cast<const float*>(in);
+                int16_t* outP = reinterpret_cast<int16_t*>(out);
+                const __m256 m = _mm256_set1_ps(S16Range.getMax());
+                const __m256 min = _mm256_set1_ps(S16Range.getMin());
+                const __m256 max = _mm256_set1_ps(S16Range.getMax());
+                for (; i + 8 <= size; i += 8)
+                {
+                    const __m256i a = clampTruncateAVX2(_mm256_mul_ps(_mm256_loadu_ps(inP + i), m), min, max);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(outP + i), packS32ToS16AVX2(a));
+                }
+            }
+            else if (DataType::F32 == inType && DataType::F64 == outType)
+            {
+                const float* inP = reinterpret_cast<const float*>(in);
+                double* outP = reinterpret_cast<double*>(out);
+                for (; i + 4 <= size; i += 4)
+                {
+                    _mm256_storeu_pd(outP + i, _mm256_cvtps_pd(_mm_loadu_ps(inP + i)));
+                }
+            }
+            else if (DataType::F64 == inType && DataType::S16 == outType)
+            {
+                const double* inP = reinterpret_cast<const double*>(in);
+                int16_t* outP = reinterpret_cast<int16_t*>(out);
+                const __m256d m = _mm256_set1_pd(S16Range.getMax());
+                const __m256d min = _mm256_set1_pd(S16Range.getMin());
+                const __m256d max = _mm256_set1_pd(S16Range.getMax());
+                for (; i + 8 <= size; i += 8)
+                {
+                    const __m256d a = _mm256_mul_pd(_mm256_loadu_pd(inP + i), m);
+                    const __m256d b = _mm256_mul_pd(_mm256_loadu_pd(inP + i + 4), m);
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i*>(outP + i),
+                        _mm_packs_epi32(
+                            _mm256_cvttpd_epi32(_mm256_min_pd(_mm256_max_pd(a, min), max)),
+                            _mm256_cvttpd_epi32(_mm256_min_pd(_mm256_max_pd(b, min), max))));
+                }
+            }
+            else if (DataType::F64 == inType && DataType::F32 == outType)
+            {
+                const double* inP = reinterpret_cast<const double*>(in);
+                float* outP = reinterpret_cast<float*>(out);
+                for (; i + 4 <= size; i += 4)
+                {
+                    _mm_storeu_ps(outP + i, _mm256_cvtpd_ps(_mm256_loadu_pd(inP + i)));
+                }
+            }
+            return i;
+        }
+
+        size_t reverseSSE2(
+            const uint8_t* in,
+            uint8_t* out,
+            size_t sampleCount,
+            size_t frameByteCount)
+        {
+            // Reverse the order of the frames, where each frame is treated
+            // as a single 16, 32, or 64-bit value.
+            size_t i = 0;
+            switch (frameByteCount)
+            {
+            case 2:
+                for (; i + 8 <= sampleCount; i += 8)
+                {
+                    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + (sampleCount - i - 8) * 2));
+                    a = _mm_shufflelo_epi16(a, 0x1B);
+                    a = _mm_shufflehi_epi16(a, 0x1B);
+                    a = _mm_shuffle_epi32(a, 0x4E);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2), a);
+                }
+                break;
+            case 4:
+                for (; i + 4 <= sampleCount; i += 4)
+                {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + (sampleCount - i - 4) * 4));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4), _mm_shuffle_epi32(a, 0x1B));
+                }
+                break;
+            case 8:
+                for (; i + 2 <= sampleCount; i += 2)
+                {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + (sampleCount - i - 2) * 8));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 8), _mm_shuffle_epi32(a, 0x4E));
+                }
+                break;
+            default: break;
+            }
+            return i;
+        }
+
+        TLRENDER_AVX2 size_t reverseAVX2(
+            const uint8_t* in,
+            uint8_t* out,
+            size_t sampleCount,
+            size_t frameByteCount)
+        {
+            size_t i = 0;
+            switch (frameByteCount)
+            {
+            case 2:
+            {
+                const __m256i mask = _mm256_setr_epi8(
+                    14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+                    14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+                for (; i + 16 <= sampleCount; i += 16)
+                {
+                    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + (sampleCount - i - 16) * 2));
+                    a = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(a, mask), 0x4E);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 2), a);
+                }
+                break;
+            }
+            case 4:
+            {
+                const __m256i index = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+                for (; i + 8 <= sampleCount; i += 8)
+                {
+                    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + (sampleCount - i - 8) * 4));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 4), _mm256_permutevar8x32_epi32(a, index));
+                }
+                break;
+            }
+            case 8:
+                for (; i + 4 <= sampleCount; i += 4)
+                {
+                    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + (sampleCount - i - 4) * 8));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 8), _mm256_permute4x64_epi64(a, 0x1B));
+                }
+                break;
+            default: break;
+            }
+            return i;
+        }
+
+        size_t interleaveStereoSSE2(
+            const uint8_t* in0,
+            const uint8_t* in1,
+            uint8_t* out,
+            size_t sampleCount,
+            size_t byteCount)
+        {
+            size_t i = 0;
+            const size_t step = 16 / std::max(byteCount, size_t(1));
+            for (; (2 == byteCount || 4 == byteCount || 8 == byteCount) && i + step <= sampleCount; i += step)
+            {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in0 + i * byteCount));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in1 + i * byteCount));
+                __m128i lo;
+                __m128i hi;
+                switch (byteCount)
+                {
+                case 2:
+                    lo = _mm_unpacklo_epi16(a, b);
+                    hi = _mm_unpackhi_epi16(a, b);
+                    break;
+                case 4:
+                    lo = _mm_unpacklo_epi32(a, b);
+                    hi = _mm_unpackhi_epi32(a, b);
+                    break;
+                default:
+                    lo = _mm_unpacklo_epi64(a, b);
+                    hi = _mm_unpackhi_epi64(a, b);
+                    break;
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2 * byteCount), lo);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2 * byteCount + 16), hi);
+            }
+            return i;
+        }
+
+        TLRENDER_AVX2 size_t interleaveStereoAVX2(
+            const uint8_t* in0,
+            const uint8_t* in1,
+            uint8_t* out,
+            size_t sampleCount,
+            size_t byteCount)
+        {
+            size_t i = 0;
+            const size_t step = 32 / std::max(byteCount, size_t(1));
+            for (; (2 == byteCount || 4 == byteCount || 8 == byteCount) && i + step <= sampleCount; i += step)
+            {
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in0 + i * byteCount));
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in1 + i * byteCount));
+                __m256i lo;
+                __m256i hi;
+                switch (byteCount)
+                {
+                case 2:
+                    lo = _mm256_unpacklo_epi16(a, b);
+                    hi = _mm256_unpackhi_epi16(a, b);
+                    break;
+                case 4:
+                    lo = _mm256_unpacklo_epi32(a, b);
+                    hi = _mm256_unpackhi_epi32(a, b);
+                    break;
+                default:
+                    lo = _mm256_unpacklo_epi64(a, b);
+                    hi = _mm256_unpackhi_epi64(a, b);
+                    break;
+                }
+                // The unpack instructions work within 128-bit lanes.
+                _mm256_storeu_si256(
+                    reinterpret_cast<__m256i*>(out + i * 2 * byteCount),
+                    _mm256_permute2x128_si256(lo, hi, 0x20));
+                _mm256_storeu_si256(
+                    reinterpret_cast<__m256i*>(out + i * 2 * byteCount + 32),
+                    _mm256_permute2x128_si256(lo, hi, 0x31));
+            }
+            return i;
+        }
+#else // TLRENDER_AUDIO_SIMD
+        size_t mixSSE2(const uint8_t**, size_t, uint8_t*, float, size_t, DataType)
+        {
+            return 0;
+        }
+
+        size_t mixAVX2(const uint8_t**, size_t, uint8_t*, float, size_t, DataType)
+        {
+            return 0;
+        }
+
+        size_t convertSSE2(const uint8_t*, DataType, uint8_t*, DataType, size_t)
+        {
+            return 0;
+        }
+
+        size_t convertAVX2(const uint8_t*, DataType, uint8_t*, DataType, size_t)
+        {
+            return 0;
+        }
+
+        size_t reverseSSE2(const uint8_t*, uint8_t*, size_t, size_t)
+        {
+            return 0;
+        }
+
+        size_t reverseAVX2(const uint8_t*, uint8_t*, size_t, size_t)
+        {
+            return 0;
+        }
+
+        size_t interleaveStereoSSE2(const uint8_t*, const uint8_t*, uint8_t*, size_t, size_t)
+        {
+            return 0;
+        }
+
+        size_t interleaveStereoAVX2(const uint8_t*, const uint8_t*, uint8_t*, size_t, size_t)
+        {
+            return 0;
+        }
+#endif // TLRENDER_AUDIO_SIMD
+    }
+}
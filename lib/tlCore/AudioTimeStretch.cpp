@@ -0,0 +1,258 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/AudioTimeStretch.h>
+
+#include <tlCore/Math.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace tl
+{
+    namespace audio
+    {
+        namespace
+        {
+            // The length of the overlapped segments in seconds.
+            const double segmentSeconds = .03;
+
+            // The segment position search tolerance in seconds.
+            const double toleranceSeconds = .008;
+
+            // Dot product with independent partial sums, so the compiler
+            // can vectorize the loop without reordering the additions.
+            float dot(const float* a, const float* b, size_t size)
+            {
+                float sum[8] = { 0.F, 0.F, 0.F, 0.F, 0.F, 0.F, 0.F, 0.F };
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8)
+                {
+                    for (size_t j = 0; j < 8; ++j)
+                    {
+                        sum[j] += a[i + j] * b[i + j];
+                    }
+                }
+                for (; i < size; ++i)
+                {
+                    sum[0] += a[i] * b[i];
+                }
+                return
+                    (sum[0] + sum[1]) + (sum[2] + sum[3]) +
+                    (sum[4] + sum[5]) + (sum[6] + sum[7]);
+            }
+        }
+
+        struct AudioTimeStretch::Private
+        {
+            audio::Info info;
+            float speed = 1.F;
+            size_t segment = 0;
+            size_t hop = 0;
+            size_t tolerance = 0;
+            std::vector<float> window;
+
+            std::vector<float> input;
+            std::vector<float> mono;
+            double position = 0.0;
+            int64_t previous = -1;
+            std::vector<float> tail;
+            std::vector<float> output;
+        };
+
+        void AudioTimeStretch::_init(const audio::Info& info)
+        {
+            TLRENDER_P();
+            p.info = info;
+            p.hop = std::max(static_cast<size_t>(info.sampleRate * segmentSeconds / 2.0), size_t(1));
+            p.segment = p.hop * 2;
+            p.tolerance = static_cast<size_t>(info.sampleRate * toleranceSeconds);
+
+            // A periodic Hann window sums to one when overlapped by half.
+            const size_t channelCount = info.channelCount;
+            p.window.resize(p.segment * channelCount);
+            for (size_t i = 0; i < p.segment; ++i)
+            {
+                const float w = .5F - .5F * std::cos(2.0 * math::pi * i / p.segment);
+                for (size_t c = 0; c < channelCount; ++c)
+                {
+                    p.window[i * channelCount + c] = w;
+                }
+            }
+            p.tail.resize(p.hop * channelCount, 0.F);
+        }
+
+        AudioTimeStretch::AudioTimeStretch() :
+            _p(new Private)
+        {}
+
+        AudioTimeStretch::~AudioTimeStretch()
+        {}
+
+        std::shared_ptr<AudioTimeStretch> AudioTimeStretch::create(const audio::Info& info)
+        {
+            auto out = std::shared_ptr<AudioTimeStretch>(new AudioTimeStretch);
+            out->_init(info);
+            return out;
+        }
+
+        const audio::Info& AudioTimeStretch::getInfo() const
+        {
+            return _p->info;
+        }
+
+        float AudioTimeStretch::getSpeed() const
+        {
+            return _p->speed;
+        }
+
+        void AudioTimeStretch::setSpeed(float value)
+        {
+            _p->speed = math::clamp(value, timeStretchSpeedMin, timeStretchSpeedMax);
+        }
+
+        std::shared_ptr<Audio> AudioTimeStretch::process(const std::shared_ptr<Audio>& value)
+        {
+            TLRENDER_P();
+            const size_t channelCount = p.info.channelCount;
+            if (!value ||
+                0 == channelCount ||
+                value->getChannelCount() != channelCount ||
+                value->getDataType() != p.info.dataType)
+            {
+                return Audio::create(p.info, 0);
+            }
+
+            // Add the input to the buffer.
+            std::shared_ptr<Audio> in = value;
+            if (in->getDataType() != DataType::F32)
+            {
+                in = convert(in, DataType::F32);
+            }
+            const size_t inSampleCount = in->getSampleCount();
+            const float* inP = reinterpret_cast<const float*>(in->getData());
+            const size_t inputSize = p.input.size();
+            p.input.resize(inputSize + inSampleCount * channelCount);
+            std::memcpy(
+                p.input.data() + inputSize,
+                inP,
+                inSampleCount * channelCount * sizeof(float));
+            const size_t monoSize = p.mono.size();
+            p.mono.resize(monoSize + inSampleCount);
+            const float channelScale = 1.F / channelCount;
+            for (size_t i = 0; i < inSampleCount; ++i)
+            {
+                float sum = 0.F;
+                for (size_t c = 0; c < channelCount; ++c)
+                {
+                    sum += inP[i * channelCount + c];
+                }
+                p.mono[monoSize + i] = sum * channelScale;
+            }
+
+            // Overlap-add the segments.
+            p.output.clear();
+            const int64_t sampleCount = p.mono.size();
+            const int64_t segment = p.segment;
+            const int64_t hop = p.hop;
+            const int64_t tolerance = p.tolerance;
+            const size_t hopSize = p.hop * channelCount;
+            while (true)
+            {
+                const int64_t nominal = std::llround(p.position);
+                const int64_t min = std::max(nominal - tolerance, int64_t(0));
+                const int64_t max = nominal + tolerance;
+                if (max + segment > sampleCount)
+                    break;
+
+                // Find the segment that best continues the waveform of the
+                // previous segment.
+                int64_t best = nominal;
+                if (p.previous >= 0)
+                {
+                    const float* reference = p.mono.data() + p.previous + hop;
+                    float energy = dot(p.mono.data() + min, p.mono.data() + min, hop);
+                    float bestCorrelation = -std::numeric_limits<float>::max();
+                    for (int64_t i = min; i <= max; ++i)
+                    {
+                        const float* candidate = p.mono.data() + i;
+                        const float correlation =
+                            dot(reference, candidate, hop) /
+                            std::sqrt(std::max(energy, 1.0e-9F));
+                        if (correlation > bestCorrelation)
+                        {
+                            bestCorrelation = correlation;
+                            best = i;
+                        }
+                        energy += candidate[hop] * candidate[hop] - candidate[0] * candidate[0];
+                    }
+                }
+
+                // Add the first half of the segment to the tail and output
+                // it, then keep the second half as the new tail.
+                const float* segmentP = p.input.data() + best * channelCount;
+                const float* windowP = p.window.data();
+                const size_t outputSize = p.output.size();
+                p.output.resize(outputSize + hopSize);
+                float* outputP = p.output.data() + outputSize;
+                float* tailP = p.tail.data();
+                for (size_t i = 0; i < hopSize; ++i)
+                {
+                    outputP[i] = tailP[i] + windowP[i] * segmentP[i];
+                }
+                for (size_t i = 0; i < hopSize; ++i)
+                {
+                    tailP[i] = windowP[hopSize + i] * segmentP[hopSize + i];
+                }
+
+                p.previous = best;
+                p.position += hop * p.speed;
+            }
+
+            // Discard the input that is no longer needed.
+            int64_t discard = std::llround(p.position) - tolerance;
+            if (p.previous >= 0)
+            {
+                discard = std::min(discard, p.previous);
+            }
+            discard = math::clamp(discard, int64_t(0), sampleCount);
+            if (discard > 0)
+            {
+                p.input.erase(p.input.begin(), p.input.begin() + discard * channelCount);
+                p.mono.erase(p.mono.begin(), p.mono.begin() + discard);
+                p.position -= discard;
+                if (p.previous >= 0)
+                {
+                    p.previous -= discard;
+                }
+            }
+
+            // Create the output.
+            const size_t outSampleCount = p.output.size() / channelCount;
+            auto out = Audio::create(Info(channelCount, DataType::F32, p.info.sampleRate), outSampleCount);
+            if (outSampleCount > 0)
+            {
+                std::memcpy(out->getData(), p.output.data(), p.output.size() * sizeof(float));
+            }
+            if (p.info.dataType != DataType::F32)
+            {
+                out = convert(out, p.info.dataType);
+            }
+            return out;
+        }
+
+        void AudioTimeStretch::flush()
+        {
+            TLRENDER_P();
+            p.input.clear();
+            p.mono.clear();
+            p.position = 0.0;
+            p.previous = -1;
+            std::fill(p.tail.begin(), p.tail.end(), 0.F);
+            p.output.clear();
+        }
+    }
+}
@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Audio.h>
+
+namespace tl
+{
+    namespace audio
+    {
+        //! Minimum time stretch speed.
+        const float timeStretchSpeedMin = .25F;
+
+        //! Maximum time stretch speed.
+        const float timeStretchSpeedMax = 4.F;
+
+        //! Change the speed of audio while preserving the pitch.
+        //!
+        //! This uses WSOLA (waveform similarity overlap-add): windowed
+        //! segments of the input are overlapped at a fixed output hop, and
+        //! each segment position is adjusted within a small tolerance to
+        //! best match the waveform of the previous segment.
+        class AudioTimeStretch
+        {
+            TLRENDER_NON_COPYABLE(AudioTimeStretch);
+
+        protected:
+            void _init(const audio::Info&);
+
+            AudioTimeStretch();
+
+        public:
+            ~AudioTimeStretch();
+
+            //! Create a new time stretch.
+            static std::shared_ptr<AudioTimeStretch> create(const audio::Info&);
+
+            //! Get the audio information.
+            const audio::Info& getInfo() const;
+
+            //! Get the speed.
+            float getSpeed() const;
+
+            //! Set the speed. Values greater than one speed up the audio,
+            //! values less than one slow it down. The value is clamped to
+            //! the time stretch speed range.
+            void setSpeed(float);
+
+            //! Stretch audio data. The output sample count is approximately
+            //! the input sample count divided by the speed, and depends on
+            //! the amount of input that has been buffered.
+            std::shared_ptr<Audio> process(const std::shared_ptr<Audio>&);
+
+            //! Flush any remaining data.
+            void flush();
+
+        private:
+            TLRENDER_PRIVATE();
+        };
+    }
+}
@@ -0,0 +1,206 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/FileBatchPrivate.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace tl
+{
+    namespace file
+    {
+        bool BatchReadOptions::operator == (const BatchReadOptions& other) const
+        {
+            return
+                threadCount == other.threadCount &&
+                queueDepth == other.queueDepth &&
+                direct == other.direct;
+        }
+
+        bool BatchReadOptions::operator != (const BatchReadOptions& other) const
+        {
+            return !(*this == other);
+        }
+
+        bool BatchReadStats::operator == (const BatchReadStats& other) const
+        {
+            return
+                requests == other.requests &&
+                errors == other.errors &&
+                byteCount == other.byteCount &&
+                directBytes == other.directBytes;
+        }
+
+        bool BatchReadStats::operator != (const BatchReadStats& other) const
+        {
+            return !(*this == other);
+        }
+
+        void BatchRead::_init(const BatchReadOptions& options)
+        {
+            TLRENDER_P();
+            p.options = options;
+            p.options.threadCount = std::max(p.options.threadCount, static_cast<size_t>(1));
+            p.options.queueDepth = std::max(p.options.queueDepth, static_cast<size_t>(1));
+#if defined(TLRENDER_URING)
+            p.uring = _uringInit();
+            if (p.uring)
+            {
+                p.threads.push_back(std::thread(
+                    [this]
+                    {
+                        _uringThread();
+                    }));
+                return;
+            }
+#endif // TLRENDER_URING
+            for (size_t i = 0; i < p.options.threadCount; ++i)
+            {
+                p.threads.push_back(std::thread(
+                    [this]
+                    {
+                        _thread();
+                    }));
+            }
+        }
+
+        BatchRead::BatchRead() :
+            _p(new Private)
+        {}
+
+        BatchRead::~BatchRead()
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.stopped = true;
+            }
+            p.cv.notify_all();
+            for (auto& thread : p.threads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+#if defined(TLRENDER_URING)
+            if (p.uring)
+            {
+                io_uring_queue_exit(&p.ring);
+            }
+#endif // TLRENDER_URING
+        }
+
+        std::shared_ptr<BatchRead> BatchRead::create(const BatchReadOptions& options)
+        {
+            auto out = std::shared_ptr<BatchRead>(new BatchRead);
+            out->_init(options);
+            return out;
+        }
+
+        const BatchReadOptions& BatchRead::getOptions() const
+        {
+            return _p->options;
+        }
+
+        bool BatchRead::hasURing() const
+        {
+            return _p->uring;
+        }
+
+        BatchReadStats BatchRead::getStats() const
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex.mutex);
+            return _p->mutex.stats;
+        }
+
+        std::vector<std::future<void> > BatchRead::read(const std::vector<BatchReadRequest>& requests)
+        {
+            TLRENDER_P();
+            std::vector<std::future<void> > out;
+            out.reserve(requests.size());
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                for (const auto& request : requests)
+                {
+                    auto item = std::make_shared<BatchReadItem>();
+                    item->request = request;
+                    out.push_back(item->promise.get_future());
+                    p.mutex.items.push_back(item);
+                }
+            }
+            p.cv.notify_all();
+            return out;
+        }
+
+        std::future<void> BatchRead::read(const BatchReadRequest& request)
+        {
+            return std::move(read(std::vector<BatchReadRequest>({ request }))[0]);
+        }
+
+        void BatchRead::_thread()
+        {
+            TLRENDER_P();
+            while (true)
+            {
+                std::shared_ptr<BatchReadItem> item;
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    p.cv.wait(
+                        lock,
+                        [this]
+                        {
+                            return _p->mutex.stopped || !_p->mutex.items.empty();
+                        });
+                    if (p.mutex.stopped)
+                    {
+                        break;
+                    }
+                    item = p.mutex.items.front();
+                    p.mutex.items.pop_front();
+                }
+
+                BatchReadStats stats;
+                std::exception_ptr error;
+                try
+                {
+                    batchRead(item->request, p.options.direct, stats);
+                }
+                catch (const std::exception&)
+                {
+                    error = std::current_exception();
+                }
+
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    ++p.mutex.stats.requests;
+                    p.mutex.stats.errors += error ? 1 : 0;
+                    p.mutex.stats.byteCount += stats.byteCount;
+                    p.mutex.stats.directBytes += stats.directBytes;
+                }
+                if (error)
+                {
+                    item->promise.set_exception(error);
+                }
+                else
+                {
+                    item->promise.set_value();
+                }
+            }
+
+            // Cancel the remaining reads.
+            std::list<std::shared_ptr<BatchReadItem> > items;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                items.swap(p.mutex.items);
+            }
+            for (const auto& item : items)
+            {
+                item->promise.set_exception(std::make_exception_ptr(std::runtime_error(
+                    item->request.fileName + ": Read cancelled")));
+            }
+        }
+    }
+}
@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Util.h>
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tl
+{
+    namespace file
+    {
+        //! The alignment of the file position, buffer, and size required for
+        //! direct reads.
+        const size_t batchDirectAlignment = 4096;
+
+        //! Batch read options.
+        struct BatchReadOptions
+        {
+            //! The number of threads used when io_uring is not available.
+            size_t threadCount = 8;
+
+            //! The maximum number of reads submitted to io_uring at once.
+            size_t queueDepth = 64;
+
+            //! Read with O_DIRECT, bypassing the page cache. Only the parts of
+            //! a read that are aligned to batchDirectAlignment are read
+            //! directly, and file systems that do not support it are read
+            //! normally.
+            bool direct = false;
+
+            bool operator == (const BatchReadOptions&) const;
+            bool operator != (const BatchReadOptions&) const;
+        };
+
+        //! Batch read request.
+        struct BatchReadRequest
+        {
+            std::string fileName;
+            size_t      pos  = 0;
+            size_t      size = 0;
+
+            //! The buffer for the data, which must remain valid until the
+            //! read is finished. Buffers from the image pool are aligned for
+            //! direct reads.
+            uint8_t*    data = nullptr;
+        };
+
+        //! Batch read statistics.
+        struct BatchReadStats
+        {
+            size_t requests    = 0; //!< Requests finished
+            size_t errors      = 0; //!< Requests that failed
+            size_t byteCount   = 0; //!< Bytes read
+            size_t directBytes = 0; //!< Bytes read with O_DIRECT
+
+            bool operator == (const BatchReadStats&) const;
+            bool operator != (const BatchReadStats&) const;
+        };
+
+        //! Batch file reader.
+        //!
+        //! Many file ranges are read with a single call, for example the image
+        //! data of the frames in a sequence. On Linux the reads are submitted
+        //! to io_uring when it is available (TLRENDER_URING), otherwise they
+        //! are read by a pool of threads.
+        class BatchRead : public std::enable_shared_from_this<BatchRead>
+        {
+            TLRENDER_NON_COPYABLE(BatchRead);
+
+        protected:
+            void _init(const BatchReadOptions&);
+
+            BatchRead();
+
+        public:
+            ~BatchRead();
+
+            //! Create a new batch reader.
+            static std::shared_ptr<BatchRead> create(
+                const BatchReadOptions& = BatchReadOptions());
+
+            //! Get the options.
+            const BatchReadOptions& getOptions() const;
+
+            //! Get whether the reads are submitted to io_uring.
+            bool hasURing() const;
+
+            //! Get the statistics.
+            BatchReadStats getStats() const;
+
+            //! Read a batch of file ranges. The futures are ready when each
+            //! read is finished, and throw an exception if the read failed.
+            std::vector<std::future<void> > read(const std::vector<BatchReadRequest>&);
+
+            //! Read a file range.
+            std::future<void> read(const BatchReadRequest&);
+
+        private:
+            void _thread();
+#if defined(TLRENDER_URING)
+            bool _uringInit();
+            void _uringThread();
+#endif // TLRENDER_URING
+
+            TLRENDER_PRIVATE();
+        };
+    }
+}
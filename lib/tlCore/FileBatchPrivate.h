@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/FileBatch.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+
+#if defined(TLRENDER_URING)
+#include <liburing.h>
+#endif // TLRENDER_URING
+
+namespace tl
+{
+    namespace file
+    {
+        //! Read a file range with the current thread. Reads that are not
+        //! finished by io_uring are also finished with this function.
+        void batchRead(const BatchReadRequest&, bool direct, BatchReadStats&);
+
+        struct BatchReadItem
+        {
+            BatchReadRequest request;
+            std::promise<void> promise;
+        };
+
+        struct BatchRead::Private
+        {
+            BatchReadOptions options;
+            bool uring = false;
+
+            struct Mutex
+            {
+                std::list<std::shared_ptr<BatchReadItem> > items;
+                BatchReadStats stats;
+                bool stopped = false;
+                std::mutex mutex;
+            };
+            Mutex mutex;
+            std::condition_variable cv;
+            std::vector<std::thread> threads;
+
+#if defined(TLRENDER_URING)
+            struct io_uring ring;
+#endif // TLRENDER_URING
+        };
+    }
+}
@@ -0,0 +1,356 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/FileBatchPrivate.h>
+
+#include <tlCore/String.h>
+#include <tlCore/StringFormat.h>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <stdexcept>
+
+namespace tl
+{
+    namespace file
+    {
+        namespace
+        {
+            std::string getErrorString(int error)
+            {
+                std::string out;
+                char buf[string::cBufferSize] = "";
+#if defined(_GNU_SOURCE)
+                out = strerror_r(error, buf, string::cBufferSize);
+#else // _GNU_SOURCE
+                strerror_r(error, buf, string::cBufferSize);
+                out = buf;
+#endif // _GNU_SOURCE
+                return out;
+            }
+
+            std::string getOpenError(const std::string& fileName, int error)
+            {
+                return string::Format("{0}: Cannot open file: {1}").
+                    arg(fileName).
+                    arg(getErrorString(error));
+            }
+
+            std::string getReadError(const std::string& fileName, int error)
+            {
+                return error != 0 ?
+                    string::Format("{0}: Cannot read file: {1}").
+                        arg(fileName).
+                        arg(getErrorString(error)) :
+                    string::Format("{0}: Cannot read file").arg(fileName);
+            }
+
+            //! Get the number of bytes at the start of a request that can be
+            //! read directly.
+            size_t getDirectSize(const BatchReadRequest& request, bool direct)
+            {
+                size_t out = 0;
+                if (direct &&
+                    0 == request.pos % batchDirectAlignment &&
+                    0 == reinterpret_cast<uintptr_t>(request.data) % batchDirectAlignment)
+                {
+                    out = request.size / batchDirectAlignment * batchDirectAlignment;
+                }
+                return out;
+            }
+
+            int openFile(const std::string& fileName, bool direct)
+            {
+                int flags = O_RDONLY;
+#if defined(O_DIRECT)
+                if (direct)
+                {
+                    flags |= O_DIRECT;
+                }
+#else // O_DIRECT
+                if (direct)
+                {
+                    errno = EINVAL;
+                    return -1;
+                }
+#endif // O_DIRECT
+                int out = -1;
+                do
+                {
+                    out = ::open(fileName.c_str(), flags);
+                } while (-1 == out && EINTR == errno);
+                return out;
+            }
+
+            //! Read until the size is reached, the end of the file, or an
+            //! error. Returns the number of bytes read.
+            size_t readAll(int fd, uint8_t* data, size_t pos, size_t size, int& error)
+            {
+                size_t out = 0;
+                error = 0;
+                while (out < size)
+                {
+                    const ssize_t r = ::pread(fd, data + out, size - out, pos + out);
+                    if (r < 0)
+                    {
+                        if (EINTR == errno)
+                        {
+                            continue;
+                        }
+                        error = errno;
+                        break;
+                    }
+                    else if (0 == r)
+                    {
+                        break;
+                    }
+                    out += r;
+                }
+                return out;
+            }
+        }
+
+        void batchRead(const BatchReadRequest& request, bool direct, BatchReadStats& stats)
+        {
+            size_t done = 0;
+            int error = 0;
+
+            // Read the aligned part of the request directly. File systems
+            // that do not support direct reads fail to open or read, and are
+            // read normally below.
+            const size_t directSize = getDirectSize(request, direct);
+            if (directSize > 0)
+            {
+                const int fd = openFile(request.fileName, true);
+                if (fd != -1)
+                {
+                    done = readAll(fd, request.data, request.pos, directSize, error);
+                    done = done / batchDirectAlignment * batchDirectAlignment;
+                    ::close(fd);
+                    stats.directBytes += done;
+                    stats.byteCount += done;
+                }
+            }
+
+            // Read the remainder.
+            if (done < request.size)
+            {
+                const int fd = openFile(request.fileName, false);
+                if (-1 == fd)
+                {
+                    throw std::runtime_error(getOpenError(request.fileName, errno));
+                }
+                const size_t size = request.size - done;
+                const size_t r = readAll(fd, request.data + done, request.pos + done, size, error);
+                ::close(fd);
+                stats.byteCount += r;
+                if (r < size)
+                {
+                    throw std::runtime_error(getReadError(request.fileName, error));
+                }
+            }
+        }
+
+#if defined(TLRENDER_URING)
+        namespace
+        {
+            struct URingOp
+            {
+                std::shared_ptr<BatchReadItem> item;
+                int fd = -1;
+                bool direct = false;
+                size_t size = 0;
+                size_t done = 0;
+            };
+
+            void submit(struct io_uring* ring, URingOp* op)
+            {
+                struct io_uring_sqe* sqe = io_uring_get_sqe(ring);
+                io_uring_prep_read(
+                    sqe,
+                    op->fd,
+                    op->item->request.data + op->done,
+                    op->size - op->done,
+                    op->item->request.pos + op->done);
+                io_uring_sqe_set_data(sqe, op);
+            }
+        }
+
+        bool BatchRead::_uringInit()
+        {
+            TLRENDER_P();
+            return 0 == io_uring_queue_init(p.options.queueDepth, &p.ring, 0);
+        }
+
+        void BatchRead::_uringThread()
+        {
+            TLRENDER_P();
+            size_t inFlight = 0;
+            bool stopped = false;
+            while (!stopped || inFlight > 0)
+            {
+                // Get new requests, waiting only when there are no reads in
+                // flight.
+                std::list<std::shared_ptr<BatchReadItem> > items;
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    if (0 == inFlight)
+                    {
+                        p.cv.wait(
+                            lock,
+                            [this]
+                            {
+                                return _p->mutex.stopped || !_p->mutex.items.empty();
+                            });
+                    }
+                    stopped = p.mutex.stopped;
+                    if (stopped)
+                    {
+                        items.swap(p.mutex.items);
+                    }
+                    else
+                    {
+                        while (!p.mutex.items.empty() && inFlight + items.size() < p.options.queueDepth)
+                        {
+                            items.push_back(p.mutex.items.front());
+                            p.mutex.items.pop_front();
+                        }
+                    }
+                }
+                if (stopped)
+                {
+                    for (const auto& item : items)
+                    {
+                        item->promise.set_exception(std::make_exception_ptr(std::runtime_error(
+                            item->request.fileName + ": Read cancelled")));
+                    }
+                    items.clear();
+                }
+
+                // Open the files and submit the reads.
+                size_t submitted = 0;
+                for (const auto& item : items)
+                {
+                    auto op = new URingOp;
+                    op->item = item;
+                    op->size = getDirectSize(item->request, p.options.direct);
+                    if (op->size > 0)
+                    {
+                        op->fd = openFile(item->request.fileName, true);
+                        op->direct = op->fd != -1;
+                    }
+                    if (-1 == op->fd)
+                    {
+                        op->fd = openFile(item->request.fileName, false);
+                        op->size = item->request.size;
+                    }
+                    if (-1 == op->fd)
+                    {
+                        const std::string error = getOpenError(item->request.fileName, errno);
+                        {
+                            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                            ++p.mutex.stats.requests;
+                            ++p.mutex.stats.errors;
+                        }
+                        item->promise.set_exception(std::make_exception_ptr(std::runtime_error(error)));
+                        delete op;
+                        continue;
+                    }
+                    submit(&p.ring, op);
+                    ++submitted;
+                }
+                if (submitted > 0)
+                {
+                    io_uring_submit(&p.ring);
+                    inFlight += submitted;
+                }
+
+                // Handle the completed reads.
+                struct io_uring_cqe* cqe = nullptr;
+                struct __kernel_timespec timeout;
+                timeout.tv_sec = 0;
+                timeout.tv_nsec = 1000000;
+                if (inFlight > 0 && 0 == io_uring_wait_cqe_timeout(&p.ring, &cqe, &timeout))
+                {
+                    size_t resubmitted = 0;
+                    while (0 == io_uring_peek_cqe(&p.ring, &cqe))
+                    {
+                        auto op = static_cast<URingOp*>(io_uring_cqe_get_data(cqe));
+                        const int res = cqe->res;
+                        io_uring_cqe_seen(&p.ring, cqe);
+                        if (res > 0)
+                        {
+                            op->done += res;
+                            if (op->done < op->size)
+                            {
+                                // Short read.
+                                submit(&p.ring, op);
+                                ++resubmitted;
+                                continue;
+                            }
+                        }
+                        --inFlight;
+                        ::close(op->fd);
+
+                        // Finish the remainder of the request with the
+                        // current thread. This handles the unaligned end
+                        // of direct reads, and direct reads that failed.
+                        BatchReadStats stats;
+                        const size_t done = op->direct ?
+                            (op->done / batchDirectAlignment * batchDirectAlignment) :
+                            op->done;
+                        stats.byteCount = done;
+                        stats.directBytes = op->direct ? done : 0;
+                        std::exception_ptr error;
+                        if (done < op->item->request.size)
+                        {
+                            BatchReadRequest request = op->item->request;
+                            request.pos += done;
+                            request.size -= done;
+                            request.data += done;
+                            try
+                            {
+                                if (res < 0 && !op->direct)
+                                {
+                                    throw std::runtime_error(getReadError(request.fileName, -res));
+                                }
+                                batchRead(request, false, stats);
+                            }
+                            catch (const std::exception&)
+                            {
+                                error = std::current_exception();
+                            }
+                        }
+                        {
+                            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                            ++p.mutex.stats.requests;
+                            p.mutex.stats.errors += error ? 1 : 0;
+                            p.mutex.stats.byteCount += stats.byteCount;
+                            p.mutex.stats.directBytes += stats.directBytes;
+                        }
+                        if (error)
+                        {
+                            op->item->promise.set_exception(error);
+                        }
+                        else
+                        {
+                            op->item->promise.set_value();
+                        }
+                        delete op;
+                    }
+                    if (resubmitted > 0)
+                    {
+                        io_uring_submit(&p.ring);
+                    }
+                }
+            }
+        }
+#endif // TLRENDER_URING
+    }
+}
@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/FileBatchPrivate.h>
+
+#include <tlCore/FileIO.h>
+
+namespace tl
+{
+    namespace file
+    {
+        void batchRead(const BatchReadRequest& request, bool, BatchReadStats& stats)
+        {
+            // Direct reads are not supported.
+            auto io = FileIO::create(request.fileName, Mode::Read, ReadType::Normal);
+            io->setPos(request.pos);
+            io->read(request.data, request.size);
+            stats.byteCount += request.size;
+        }
+    }
+}
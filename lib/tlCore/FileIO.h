@@ -15,6 +15,8 @@ namespace tl
 {
     namespace file
     {
+        class PrefetchRead;
+
         //! File I/O modes.
         enum class Mode
         {
@@ -76,6 +78,10 @@ namespace tl
                 const std::string& fileName,
                 const MemoryRead&);
 
+            //! Create a read-only file I/O object that reads through a
+            //! prefetching file reader.
+            static std::shared_ptr<FileIO> create(const std::shared_ptr<PrefetchRead>&);
+
             //! Create a read-write temporary file I/O object.
             static std::shared_ptr<FileIO> createTemp();
 
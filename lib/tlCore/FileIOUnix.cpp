@@ -5,6 +5,7 @@
 #include <tlCore/FileIO.h>
 
 #include <tlCore/File.h>
+#include <tlCore/FilePrefetch.h>
 #include <tlCore/Memory.h>
 #include <tlCore/StringFormat.h>
 
@@ -119,6 +120,7 @@ namespace tl
             const uint8_t* memoryStart = nullptr;
             const uint8_t* memoryEnd = nullptr;
             const uint8_t* memoryP = nullptr;
+            std::shared_ptr<PrefetchRead> prefetch;
         };
 
         FileIO::FileIO() :
@@ -144,6 +146,17 @@ namespace tl
             out->_p->memoryP = memory.p;
             return out;
         }
+
+        std::shared_ptr<FileIO> FileIO::create(const std::shared_ptr<PrefetchRead>& prefetch)
+        {
+            auto out = std::shared_ptr<FileIO>(new FileIO);
+            out->_p->fileName = prefetch->getFileName();
+            out->_p->mode = Mode::Read;
+            out->_p->readType = ReadType::Normal;
+            out->_p->size = prefetch->getSize();
+            out->_p->prefetch = prefetch;
+            return out;
+        }
         
         std::shared_ptr<FileIO> FileIO::createTemp()
         {
@@ -179,7 +192,7 @@ namespace tl
         
         bool FileIO::isOpen() const
         {
-            return _p->f != -1 || _p->memoryStart;
+            return _p->f != -1 || _p->memoryStart || _p->prefetch;
         }
 
         const std::string& FileIO::getFileName() const
@@ -236,7 +249,7 @@ namespace tl
         {
             TLRENDER_P();
             bool out = false;
-            if (!p.memoryStart)
+            if (!p.memoryStart && !p.prefetch)
             {
                 out |= -1 == p.f;
             }
@@ -248,7 +261,7 @@ namespace tl
         {
             TLRENDER_P();
             
-            if (!p.memoryStart && -1 == p.f)
+            if (!p.memoryStart && !p.prefetch && -1 == p.f)
             {
                 throw std::runtime_error(getErrorMessage(ErrorType::Read, p.fileName));
             }
@@ -274,6 +287,17 @@ namespace tl
                     }
                     p.memoryP = memoryP;
                 }
+                else if (p.prefetch)
+                {
+                    if (p.prefetch->read(p.pos, in, size * wordSize) != size * wordSize)
+                    {
+                        throw std::runtime_error(getErrorMessage(ErrorType::Read, p.fileName));
+                    }
+                    if (p.endianConversion && wordSize > 1)
+                    {
+                        memory::endian(in, size, wordSize);
+                    }
+                }
                 else
                 {
                     const ssize_t r = ::read(p.f, in, size * wordSize);
@@ -444,6 +468,8 @@ namespace tl
                 p.f = -1;
             }
 
+            p.prefetch.reset();
+
             p.mode = Mode::First;
             p.pos  = 0;
             p.size = 0;
@@ -472,6 +498,13 @@ namespace tl
                         throw std::runtime_error(getErrorMessage(ErrorType::SeekMemoryMap, fileName));
                     }
                 }
+                else if (prefetch)
+                {
+                    if ((!seek ? in : (pos + in)) > size)
+                    {
+                        throw std::runtime_error(getErrorMessage(ErrorType::Seek, fileName));
+                    }
+                }
                 else
                 {
                     if (::lseek(f, in, ! seek ? SEEK_SET : SEEK_CUR) == (off_t)-1)
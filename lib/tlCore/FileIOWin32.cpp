@@ -5,6 +5,7 @@
 #include <tlCore/FileIO.h>
 
 #include <tlCore/Error.h>
+#include <tlCore/FilePrefetch.h>
 #include <tlCore/Memory.h>
 #include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
@@ -105,6 +106,7 @@ namespace tl
             const uint8_t* memoryStart = nullptr;
             const uint8_t* memoryEnd = nullptr;
             const uint8_t* memoryP = nullptr;
+            std::shared_ptr<PrefetchRead> prefetch;
         };
 
         FileIO::FileIO() :
@@ -131,6 +133,17 @@ namespace tl
             return out;
         }
 
+        std::shared_ptr<FileIO> FileIO::create(const std::shared_ptr<PrefetchRead>& prefetch)
+        {
+            auto out = std::shared_ptr<FileIO>(new FileIO);
+            out->_p->fileName = prefetch->getFileName();
+            out->_p->mode = Mode::Read;
+            out->_p->readType = ReadType::Normal;
+            out->_p->size = prefetch->getSize();
+            out->_p->prefetch = prefetch;
+            return out;
+        }
+
         std::shared_ptr<FileIO> FileIO::createTemp()
         {
             auto out = std::shared_ptr<FileIO>(new FileIO);
@@ -167,7 +180,7 @@ namespace tl
 
         bool FileIO::isOpen() const
         {
-            return _p->f != INVALID_HANDLE_VALUE || _p->memoryStart;
+            return _p->f != INVALID_HANDLE_VALUE || _p->memoryStart || _p->prefetch;
         }
 
         const std::string& FileIO::getFileName() const
@@ -224,7 +237,7 @@ namespace tl
         {
             TLRENDER_P();
             bool out = false;
-            if (!p.memoryStart)
+            if (!p.memoryStart && !p.prefetch)
             {
                 out |= p.f == INVALID_HANDLE_VALUE;
             }
@@ -236,7 +249,7 @@ namespace tl
         {
             TLRENDER_P();
 
-            if (!p.memoryStart && !p.f)
+            if (!p.memoryStart && !p.prefetch && !p.f)
             {
                 throw std::runtime_error(getErrorMessage(ErrorType::Read, p.fileName));
             }
@@ -262,6 +275,17 @@ namespace tl
                     }
                     p.memoryP = memoryP;
                 }
+                else if (p.prefetch)
+                {
+                    if (p.prefetch->read(p.pos, in, size * wordSize) != size * wordSize)
+                    {
+                        throw std::runtime_error(getErrorMessage(ErrorType::Read, p.fileName));
+                    }
+                    if (p.endianConversion && wordSize > 1)
+                    {
+                        memory::endian(in, size, wordSize);
+                    }
+                }
                 else
                 {
                     DWORD n;
@@ -464,6 +488,8 @@ namespace tl
                 p.f = INVALID_HANDLE_VALUE;
             }
 
+            p.prefetch.reset();
+
             p.mode = Mode::First;
             p.pos = 0;
             p.size = 0;
@@ -492,6 +518,13 @@ namespace tl
                         throw std::runtime_error(getErrorMessage(ErrorType::SeekMemoryMap, fileName));
                     }
                 }
+                else if (prefetch)
+                {
+                    if ((!seek ? value : (pos + value)) > size)
+                    {
+                        throw std::runtime_error(getErrorMessage(ErrorType::Seek, fileName));
+                    }
+                }
                 else
                 {
                     LARGE_INTEGER v;
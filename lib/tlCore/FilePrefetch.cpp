@@ -0,0 +1,623 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/FilePrefetch.h>
+
+#include <tlCore/FileIO.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tl
+{
+    namespace file
+    {
+        bool PrefetchOptions::operator == (const PrefetchOptions& other) const
+        {
+            return
+                blockSize == other.blockSize &&
+                readAhead == other.readAhead &&
+                maxInFlight == other.maxInFlight &&
+                maxBlocks == other.maxBlocks;
+        }
+
+        bool PrefetchOptions::operator != (const PrefetchOptions& other) const
+        {
+            return !(*this == other);
+        }
+
+        double PrefetchStats::getLatency() const
+        {
+            return blockCount > 0 ? (readTime / blockCount) : 0.0;
+        }
+
+        double PrefetchStats::getThroughput() const
+        {
+            return readTime > 0.0 ? (byteCount / readTime) : 0.0;
+        }
+
+        bool PrefetchStats::operator == (const PrefetchStats& other) const
+        {
+            return
+                hits == other.hits &&
+                waits == other.waits &&
+                misses == other.misses &&
+                blockCount == other.blockCount &&
+                byteCount == other.byteCount &&
+                readTime == other.readTime &&
+                maxReadTime == other.maxReadTime;
+        }
+
+        bool PrefetchStats::operator != (const PrefetchStats& other) const
+        {
+            return !(*this == other);
+        }
+
+        namespace
+        {
+            struct Task
+            {
+                uint64_t client = 0;
+                std::function<void(void)> func;
+            };
+        }
+
+        struct PrefetchPool::Private
+        {
+            std::vector<std::thread> threads;
+
+            struct Client
+            {
+                //! The number of queued and running tasks.
+                size_t tasks = 0;
+                bool removed = false;
+            };
+
+            struct Mutex
+            {
+                uint64_t clientID = 0;
+                std::map<uint64_t, Client> clients;
+                std::list<Task> tasks;
+                bool running = true;
+                std::condition_variable cv;
+                std::condition_variable clientCV;
+                std::mutex mutex;
+            };
+            Mutex mutex;
+        };
+
+        void PrefetchPool::_init(size_t threadCount)
+        {
+            TLRENDER_P();
+            threadCount = std::max(threadCount, static_cast<size_t>(1));
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                p.threads.push_back(std::thread(
+                    [this]
+                    {
+                        _run();
+                    }));
+            }
+        }
+
+        PrefetchPool::PrefetchPool() :
+            _p(new Private)
+        {}
+
+        PrefetchPool::~PrefetchPool()
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.running = false;
+            }
+            p.mutex.cv.notify_all();
+            for (auto& thread : p.threads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+        }
+
+        std::shared_ptr<PrefetchPool> PrefetchPool::create(size_t threadCount)
+        {
+            auto out = std::shared_ptr<PrefetchPool>(new PrefetchPool);
+            out->_init(threadCount);
+            return out;
+        }
+
+        size_t PrefetchPool::getThreadCount() const
+        {
+            return _p->threads.size();
+        }
+
+        uint64_t PrefetchPool::addClient()
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            const uint64_t out = ++p.mutex.clientID;
+            p.mutex.clients[out] = Private::Client();
+            return out;
+        }
+
+        void PrefetchPool::removeClient(uint64_t client)
+        {
+            TLRENDER_P();
+
+            // Stop accepting new tasks for the client.
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            auto i = p.mutex.clients.find(client);
+            if (i == p.mutex.clients.end() || i->second.removed)
+                return;
+            i->second.removed = true;
+
+            // Discard the pending tasks.
+            for (auto j = p.mutex.tasks.begin(); j != p.mutex.tasks.end();)
+            {
+                if (j->client == client)
+                {
+                    j = p.mutex.tasks.erase(j);
+                    --i->second.tasks;
+                }
+                else
+                {
+                    ++j;
+                }
+            }
+
+            // Wait for the running tasks.
+            p.mutex.clientCV.wait(
+                lock,
+                [this, client]
+                {
+                    return 0 == _p->mutex.clients[client].tasks;
+                });
+            p.mutex.clients.erase(client);
+        }
+
+        bool PrefetchPool::submit(uint64_t client, const std::function<void(void)>& func)
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                const auto i = p.mutex.clients.find(client);
+                if (i == p.mutex.clients.end() || i->second.removed)
+                    return false;
+                ++i->second.tasks;
+                Task task;
+                task.client = client;
+                task.func = func;
+                p.mutex.tasks.push_back(std::move(task));
+            }
+            p.mutex.cv.notify_one();
+            return true;
+        }
+
+        void PrefetchPool::_run()
+        {
+            TLRENDER_P();
+            while (true)
+            {
+                Task task;
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    p.mutex.cv.wait(
+                        lock,
+                        [this]
+                        {
+                            return !_p->mutex.running || !_p->mutex.tasks.empty();
+                        });
+                    if (!p.mutex.running)
+                    {
+                        break;
+                    }
+                    task = std::move(p.mutex.tasks.front());
+                    p.mutex.tasks.pop_front();
+                }
+                task.func();
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    --p.mutex.clients[task.client].tasks;
+                }
+                p.mutex.clientCV.notify_all();
+            }
+        }
+
+        namespace
+        {
+            struct Block
+            {
+                std::vector<uint8_t> data;
+                bool ready = false;
+                std::string error;
+                uint64_t used = 0;
+            };
+        }
+
+        struct PrefetchRead::Private
+        {
+            std::string fileName;
+            size_t size = 0;
+            PrefetchCallback callback;
+            PrefetchOptions options;
+            std::shared_ptr<PrefetchPool> pool;
+            uint64_t client = 0;
+
+            struct Mutex
+            {
+                std::map<size_t, std::shared_ptr<Block> > blocks;
+                std::list<size_t> queue;
+                std::list<std::vector<uint8_t> > buffers;
+                uint64_t used = 0;
+                //! The number of blocks submitted to the pool.
+                size_t tasks = 0;
+                PrefetchStats stats;
+                bool stopped = false;
+                std::mutex mutex;
+            };
+            Mutex mutex;
+            std::condition_variable readyCV;
+
+            void request(size_t block, bool priority);
+            void evict();
+        };
+
+        void PrefetchRead::_init(
+            const std::string& fileName,
+            size_t size,
+            const PrefetchCallback& callback,
+            const PrefetchOptions& options,
+            const std::shared_ptr<PrefetchPool>& pool)
+        {
+            TLRENDER_P();
+            p.fileName = fileName;
+            p.size = size;
+            p.callback = callback;
+            p.options = options;
+            p.options.blockSize = std::max(p.options.blockSize, static_cast<size_t>(1));
+            p.options.maxInFlight = std::max(p.options.maxInFlight, static_cast<size_t>(1));
+            p.options.maxBlocks = std::max(
+                p.options.maxBlocks,
+                p.options.maxInFlight + p.options.readAhead + 1);
+            p.pool = pool ? pool : PrefetchPool::create(p.options.maxInFlight);
+            p.client = p.pool->addClient();
+        }
+
+        PrefetchRead::PrefetchRead() :
+            _p(new Private)
+        {}
+
+        PrefetchRead::~PrefetchRead()
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.stopped = true;
+            }
+            p.pool->removeClient(p.client);
+        }
+
+        namespace
+        {
+            //! File handles shared by the prefetch threads.
+            struct Handles
+            {
+                std::string fileName;
+                std::list<std::shared_ptr<FileIO> > list;
+                std::mutex mutex;
+            };
+        }
+
+        std::shared_ptr<PrefetchRead> PrefetchRead::create(
+            const std::string& fileName,
+            const PrefetchOptions& options,
+            const std::shared_ptr<PrefetchPool>& pool)
+        {
+            auto handles = std::make_shared<Handles>();
+            handles->fileName = fileName;
+            auto io = FileIO::create(fileName, Mode::Read, ReadType::Normal);
+            const size_t size = io->getSize();
+            handles->list.push_back(io);
+            return create(
+                fileName,
+                size,
+                [handles](size_t pos, uint8_t* buf, size_t size)
+                {
+                    std::shared_ptr<FileIO> io;
+                    {
+                        std::unique_lock<std::mutex> lock(handles->mutex);
+                        if (!handles->list.empty())
+                        {
+                            io = handles->list.front();
+                            handles->list.pop_front();
+                        }
+                    }
+                    if (!io)
+                    {
+                        io = FileIO::create(handles->fileName, Mode::Read, ReadType::Normal);
+                    }
+                    io->setPos(pos);
+                    io->read(buf, size);
+                    std::unique_lock<std::mutex> lock(handles->mutex);
+                    handles->list.push_back(io);
+                },
+                options,
+                pool);
+        }
+
+        std::shared_ptr<PrefetchRead> PrefetchRead::create(
+            const std::string& fileName,
+            size_t size,
+            const PrefetchCallback& callback,
+            const PrefetchOptions& options,
+            const std::shared_ptr<PrefetchPool>& pool)
+        {
+            auto out = std::shared_ptr<PrefetchRead>(new PrefetchRead);
+            out->_init(fileName, size, callback, options, pool);
+            return out;
+        }
+
+        const std::string& PrefetchRead::getFileName() const
+        {
+            return _p->fileName;
+        }
+
+        size_t PrefetchRead::getSize() const
+        {
+            return _p->size;
+        }
+
+        const PrefetchOptions& PrefetchRead::getOptions() const
+        {
+            return _p->options;
+        }
+
+        PrefetchStats PrefetchRead::getStats() const
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex.mutex);
+            return _p->mutex.stats;
+        }
+
+        size_t PrefetchRead::read(size_t pos, void* buf, size_t size)
+        {
+            TLRENDER_P();
+            if (pos >= p.size || 0 == size)
+            {
+                return 0;
+            }
+            size = std::min(size, p.size - pos);
+            const size_t first = pos / p.options.blockSize;
+            const size_t last = (pos + size - 1) / p.options.blockSize;
+            uint8_t* out = static_cast<uint8_t*>(buf);
+            for (size_t i = first; i <= last; ++i)
+            {
+                std::shared_ptr<Block> block;
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    auto j = p.mutex.blocks.find(i);
+                    if (j == p.mutex.blocks.end())
+                    {
+                        ++p.mutex.stats.misses;
+                        p.request(i, true);
+                        j = p.mutex.blocks.find(i);
+                    }
+                    else if (j->second->ready)
+                    {
+                        ++p.mutex.stats.hits;
+                    }
+                    else
+                    {
+                        ++p.mutex.stats.waits;
+                        const auto k = std::find(p.mutex.queue.begin(), p.mutex.queue.end(), i);
+                        if (k != p.mutex.queue.end())
+                        {
+                            p.mutex.queue.splice(p.mutex.queue.begin(), p.mutex.queue, k);
+                        }
+                    }
+                    block = j->second;
+                    block->used = ++p.mutex.used;
+                    _schedule();
+                    p.readyCV.wait(
+                        lock,
+                        [block]
+                        {
+                            return block->ready;
+                        });
+                    if (!block->error.empty())
+                    {
+                        const auto k = p.mutex.blocks.find(i);
+                        if (k != p.mutex.blocks.end() && k->second == block)
+                        {
+                            p.mutex.blocks.erase(k);
+                        }
+                        throw std::runtime_error(block->error);
+                    }
+                }
+                const size_t blockPos = i * p.options.blockSize;
+                const size_t start = std::max(pos, blockPos);
+                const size_t end = std::min(pos + size, blockPos + block->data.size());
+                std::memcpy(out, block->data.data() + (start - blockPos), end - start);
+                out += end - start;
+            }
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                for (size_t i = 1; i <= p.options.readAhead; ++i)
+                {
+                    p.request(last + i, false);
+                }
+                _schedule();
+            }
+            return size;
+        }
+
+        void PrefetchRead::prefetch(size_t pos, size_t size)
+        {
+            TLRENDER_P();
+            if (pos >= p.size || 0 == size)
+            {
+                return;
+            }
+            size = std::min(size, p.size - pos);
+            const size_t first = pos / p.options.blockSize;
+            const size_t last = (pos + size - 1) / p.options.blockSize;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                for (size_t i = first; i <= last; ++i)
+                {
+                    p.request(i, false);
+                }
+                _schedule();
+            }
+        }
+
+        void PrefetchRead::_schedule()
+        {
+            // Called with the mutex locked. Each task submitted to the pool
+            // reads the block at the front of the queue, so the blocks are
+            // still read in priority order.
+            TLRENDER_P();
+            while (!p.mutex.stopped &&
+                p.mutex.tasks < p.options.maxInFlight &&
+                p.mutex.tasks < p.mutex.queue.size())
+            {
+                ++p.mutex.tasks;
+                if (!p.pool->submit(
+                    p.client,
+                    [this]
+                    {
+                        _readBlock();
+                    }))
+                {
+                    --p.mutex.tasks;
+                    break;
+                }
+            }
+        }
+
+        void PrefetchRead::_readBlock()
+        {
+            TLRENDER_P();
+            size_t index = 0;
+            std::shared_ptr<Block> block;
+            std::vector<uint8_t> data;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                while (!block && !p.mutex.stopped && !p.mutex.queue.empty())
+                {
+                    index = p.mutex.queue.front();
+                    p.mutex.queue.pop_front();
+                    const auto i = p.mutex.blocks.find(index);
+                    if (i != p.mutex.blocks.end())
+                    {
+                        block = i->second;
+                    }
+                }
+                if (!block)
+                {
+                    --p.mutex.tasks;
+                    return;
+                }
+                if (!p.mutex.buffers.empty())
+                {
+                    data = std::move(p.mutex.buffers.front());
+                    p.mutex.buffers.pop_front();
+                }
+            }
+
+            const size_t pos = index * p.options.blockSize;
+            const size_t size = std::min(p.options.blockSize, p.size - pos);
+            data.resize(size);
+            std::string error;
+            const auto t0 = std::chrono::steady_clock::now();
+            try
+            {
+                p.callback(pos, data.data(), size);
+            }
+            catch (const std::exception& e)
+            {
+                error = e.what();
+            }
+            const auto t1 = std::chrono::steady_clock::now();
+            const std::chrono::duration<double> diff = t1 - t0;
+
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                block->data = std::move(data);
+                block->error = error;
+                block->ready = true;
+                if (error.empty())
+                {
+                    ++p.mutex.stats.blockCount;
+                    p.mutex.stats.byteCount += size;
+                    p.mutex.stats.readTime += diff.count();
+                    p.mutex.stats.maxReadTime = std::max(p.mutex.stats.maxReadTime, diff.count());
+                }
+                p.evict();
+                --p.mutex.tasks;
+                _schedule();
+            }
+            p.readyCV.notify_all();
+        }
+
+        void PrefetchRead::Private::request(size_t index, bool priority)
+        {
+            if (index * options.blockSize >= size ||
+                mutex.blocks.find(index) != mutex.blocks.end() ||
+                (!priority && mutex.queue.size() >= options.maxBlocks))
+            {
+                return;
+            }
+            auto block = std::make_shared<Block>();
+            block->used = ++mutex.used;
+            mutex.blocks[index] = block;
+            if (priority)
+            {
+                mutex.queue.push_front(index);
+            }
+            else
+            {
+                mutex.queue.push_back(index);
+            }
+        }
+
+        void PrefetchRead::Private::evict()
+        {
+            // Only blocks that have been read are removed, blocks in flight
+            // are needed by the readers waiting for them.
+            while (mutex.blocks.size() > options.maxBlocks)
+            {
+                auto oldest = mutex.blocks.end();
+                for (auto i = mutex.blocks.begin(); i != mutex.blocks.end(); ++i)
+                {
+                    if (i->second->ready &&
+                        (oldest == mutex.blocks.end() || i->second->used < oldest->second->used))
+                    {
+                        oldest = i;
+                    }
+                }
+                if (oldest == mutex.blocks.end())
+                {
+                    break;
+                }
+                // Reuse the buffer if no readers are copying from it.
+                if (1 == oldest->second.use_count() &&
+                    mutex.buffers.size() < options.maxInFlight &&
+                    oldest->second->data.capacity() >= options.blockSize)
+                {
+                    mutex.buffers.push_back(std::move(oldest->second->data));
+                }
+                mutex.blocks.erase(oldest);
+            }
+        }
+    }
+}
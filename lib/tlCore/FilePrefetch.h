@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Memory.h>
+#include <tlCore/Util.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace tl
+{
+    namespace file
+    {
+        //! File prefetch options.
+        struct PrefetchOptions
+        {
+            //! The size of the blocks read from the file. Reads are aligned
+            //! to the block size.
+            size_t blockSize = 4 * memory::megabyte;
+
+            //! The number of blocks read ahead of the last read.
+            size_t readAhead = 4;
+
+            //! The maximum number of blocks read at the same time.
+            size_t maxInFlight = 4;
+
+            //! The maximum number of blocks held in memory.
+            size_t maxBlocks = 32;
+
+            bool operator == (const PrefetchOptions&) const;
+            bool operator != (const PrefetchOptions&) const;
+        };
+
+        //! File prefetch statistics.
+        struct PrefetchStats
+        {
+            size_t hits         = 0;  //!< Reads of blocks that were already read
+            size_t waits        = 0;  //!< Reads of blocks that were still in flight
+            size_t misses       = 0;  //!< Reads of blocks that were not requested
+            size_t blockCount   = 0;  //!< Blocks read from the file
+            size_t byteCount    = 0;  //!< Bytes read from the file
+            double readTime     = 0.0; //!< Total time spent reading blocks in seconds
+            double maxReadTime  = 0.0; //!< Maximum time spent reading a block in seconds
+
+            //! Get the average block read latency in seconds.
+            double getLatency() const;
+
+            //! Get the block read throughput in bytes per second.
+            double getThroughput() const;
+
+            bool operator == (const PrefetchStats&) const;
+            bool operator != (const PrefetchStats&) const;
+        };
+
+        //! Prefetch thread pool.
+        //!
+        //! The pool can be shared by prefetching readers, so that reading
+        //! many small files (for example an image sequence) does not start
+        //! and stop threads for every file. Tasks are submitted on behalf of
+        //! a client (usually a reader) and run in order.
+        class PrefetchPool : public std::enable_shared_from_this<PrefetchPool>
+        {
+            TLRENDER_NON_COPYABLE(PrefetchPool);
+
+        protected:
+            void _init(size_t threadCount);
+
+            PrefetchPool();
+
+        public:
+            ~PrefetchPool();
+
+            //! Create a new prefetch pool.
+            static std::shared_ptr<PrefetchPool> create(size_t threadCount);
+
+            //! Get the number of threads.
+            size_t getThreadCount() const;
+
+            //! Add a client.
+            uint64_t addClient();
+
+            //! Remove a client. Pending tasks for the client are discarded,
+            //! and this function blocks until the running tasks are
+            //! finished.
+            void removeClient(uint64_t);
+
+            //! Submit a task. Returns false if the client has been removed.
+            bool submit(uint64_t client, const std::function<void(void)>&);
+
+        private:
+            void _run();
+
+            TLRENDER_PRIVATE();
+        };
+
+        //! Callback for reading from a file. The arguments are the file
+        //! position, the buffer, and the number of bytes to read. The
+        //! callback must be thread safe and throw an exception on error.
+        typedef std::function<void(size_t, uint8_t*, size_t)> PrefetchCallback;
+
+        //! Prefetching file reader.
+        //!
+        //! Files are read in large blocks by a pool of threads, with the
+        //! blocks after the last read (or given by prefetch()) read in the
+        //! background. This reduces the number of small synchronous reads,
+        //! which is important for network file systems. If no pool is given
+        //! the reader creates its own, with PrefetchOptions::maxInFlight
+        //! threads.
+        class PrefetchRead : public std::enable_shared_from_this<PrefetchRead>
+        {
+            TLRENDER_NON_COPYABLE(PrefetchRead);
+
+        protected:
+            void _init(
+                const std::string& fileName,
+                size_t size,
+                const PrefetchCallback&,
+                const PrefetchOptions&,
+                const std::shared_ptr<PrefetchPool>&);
+
+            PrefetchRead();
+
+        public:
+            ~PrefetchRead();
+
+            //! Create a new prefetching file reader.
+            static std::shared_ptr<PrefetchRead> create(
+                const std::string& fileName,
+                const PrefetchOptions& = PrefetchOptions(),
+                const std::shared_ptr<PrefetchPool>& = nullptr);
+
+            //! Create a new prefetching file reader with a callback for
+            //! reading the file.
+            static std::shared_ptr<PrefetchRead> create(
+                const std::string& fileName,
+                size_t size,
+                const PrefetchCallback&,
+                const PrefetchOptions& = PrefetchOptions(),
+                const std::shared_ptr<PrefetchPool>& = nullptr);
+
+            //! Get the file name.
+            const std::string& getFileName() const;
+
+            //! Get the file size.
+            size_t getSize() const;
+
+            //! Get the options.
+            const PrefetchOptions& getOptions() const;
+
+            //! Get the statistics.
+            PrefetchStats getStats() const;
+
+            //! Read from the file. Returns the number of bytes read, which
+            //! is less than requested at the end of the file.
+            size_t read(size_t pos, void*, size_t size);
+
+            //! Request that a range of the file is read in the background,
+            //! for example the data needed by the next frames.
+            void prefetch(size_t pos, size_t size);
+
+        private:
+            void _schedule();
+            void _readBlock();
+
+            TLRENDER_PRIVATE();
+        };
+    }
+}
@@ -136,4 +136,19 @@ namespace tl
     }
 }
 
+namespace std
+{
+    template<>
+    struct hash<tl::image::FontInfo>
+    {
+        std::size_t operator() (const tl::image::FontInfo&) const noexcept;
+    };
+
+    template<>
+    struct hash<tl::image::GlyphInfo>
+    {
+        std::size_t operator() (const tl::image::GlyphInfo&) const noexcept;
+    };
+}
+
 #include <tlCore/FontSystemInline.h>
@@ -53,3 +53,24 @@ namespace tl
         }
     }
 }
+
+namespace std
+{
+    inline std::size_t hash<tl::image::FontInfo>::operator() (
+        const tl::image::FontInfo& value) const noexcept
+    {
+        std::size_t out = 0;
+        tl::memory::hashCombine(out, value.family);
+        tl::memory::hashCombine(out, value.size);
+        return out;
+    }
+
+    inline std::size_t hash<tl::image::GlyphInfo>::operator() (
+        const tl::image::GlyphInfo& value) const noexcept
+    {
+        std::size_t out = 0;
+        tl::memory::hashCombine(out, value.code);
+        tl::memory::hashCombine(out, value.fontInfo);
+        return out;
+    }
+}
@@ -6,6 +6,7 @@
 
 #include <tlCore/Assert.h>
 #include <tlCore/Error.h>
+#include <tlCore/ImagePool.h>
 #include <tlCore/String.h>
 
 #include <algorithm>
@@ -299,16 +300,137 @@ namespace tl
             return out;
         }
 
+        size_t getPlaneCount(PixelType value)
+        {
+            size_t out = 1;
+            switch (value)
+            {
+            case PixelType::YUV_420P_U8:
+            case PixelType::YUV_422P_U8:
+            case PixelType::YUV_444P_U8:
+            case PixelType::YUV_420P_U16:
+            case PixelType::YUV_422P_U16:
+            case PixelType::YUV_444P_U16: out = 3; break;
+            default: break;
+            }
+            return out;
+        }
+
+        Size getPlaneSize(const Info& info, size_t plane)
+        {
+            Size out(info.size.w, info.size.h);
+            if (plane > 0)
+            {
+                switch (info.pixelType)
+                {
+                case PixelType::YUV_420P_U8:
+                case PixelType::YUV_420P_U16:
+                    out.w = info.size.w / 2;
+                    out.h = info.size.h / 2;
+                    break;
+                case PixelType::YUV_422P_U8:
+                case PixelType::YUV_422P_U16:
+                    out.w = info.size.w / 2;
+                    break;
+                default: break;
+                }
+            }
+            return out;
+        }
+
+        size_t getPlaneRowByteCount(const Info& info, size_t plane)
+        {
+            size_t out = 0;
+            switch (info.pixelType)
+            {
+            case PixelType::YUV_420P_U8:
+            case PixelType::YUV_422P_U8:
+            case PixelType::YUV_444P_U8:
+                out = getPlaneSize(info, plane).w;
+                break;
+            case PixelType::YUV_420P_U16:
+            case PixelType::YUV_422P_U16:
+            case PixelType::YUV_444P_U16:
+                out = getPlaneSize(info, plane).w * 2;
+                break;
+            default:
+            {
+                Info row = info;
+                row.size.h = 1;
+                out = getDataByteCount(row);
+                break;
+            }
+            }
+            return out;
+        }
+
+        namespace
+        {
+            std::shared_ptr<uint8_t> allocate(size_t byteCount)
+            {
+                // The data is not initialized.
+                // 
+                //! \bug Allocate a bit of extra space since FFmpeg sws_scale()
+                //! seems to be reading past the end?
+                byteCount += 16;
+                std::shared_ptr<uint8_t> out;
+                std::shared_ptr<ImagePool> pool;
+                if (byteCount >= imagePoolMinSize)
+                {
+                    pool = getImagePool();
+                }
+                if (pool)
+                {
+                    out = pool->allocate(byteCount);
+                }
+                else
+                {
+                    out = std::shared_ptr<uint8_t>(
+                        new uint8_t[byteCount],
+                        std::default_delete<uint8_t[]>());
+                }
+                return out;
+            }
+        }
+
         void Image::_init(const Info& info)
         {
             _info = info;
             _dataByteCount = image::getDataByteCount(info);
-            // Use reserve() instead of resize() which can be faster since it
-            // does not initialize the data.
-            // 
-            //! \bug Allocate a bit of extra space since FFmpeg sws_scale()
-            //! seems to be reading past the end?
-            _data.reserve(_dataByteCount + 16);
+            _data = allocate(_dataByteCount);
+            const uint8_t* p = _data.get();
+            const size_t planeCount = getPlaneCount(info.pixelType);
+            for (size_t i = 0; i < planeCount; ++i)
+            {
+                Plane plane;
+                plane.data = p;
+                plane.stride = getPlaneRowByteCount(info, i);
+                _planes.push_back(plane);
+                p += plane.stride * getPlaneSize(info, i).h;
+            }
+        }
+
+        void Image::_copyPlanes() const
+        {
+            std::call_once(
+                _copyPlanesOnce,
+                [this]
+                {
+                    _data = allocate(_dataByteCount);
+                    uint8_t* p = _data.get();
+                    for (size_t i = 0; i < _planes.size(); ++i)
+                    {
+                        const size_t rowByteCount = getPlaneRowByteCount(_info, i);
+                        const int h = getPlaneSize(_info, i).h;
+                        for (int y = 0; y < h; ++y, p += rowByteCount)
+                        {
+                            std::memcpy(
+                                p,
+                                _planes[i].data + _planes[i].stride * y,
+                                rowByteCount);
+                        }
+                    }
+                });
         }
 
         Image::Image()
@@ -334,14 +456,69 @@ namespace tl
             return create(Info(w, h, pixelType));
         }
 
+        std::shared_ptr<Image> Image::create(
+            const Info& info,
+            const std::vector<Plane>& planes,
+            const std::shared_ptr<void>& storage)
+        {
+            TLRENDER_ASSERT(planes.size() == getPlaneCount(info.pixelType));
+            auto out = std::shared_ptr<Image>(new Image);
+            out->_info = info;
+            out->_dataByteCount = image::getDataByteCount(info);
+            out->_planes = planes;
+            out->_storage = storage;
+            return out;
+        }
+
         void Image::setTags(const Tags& value)
+        {
+            _tags = std::make_shared<const Tags>(value);
+        }
+
+        void Image::setTags(Tags&& value)
+        {
+            _tags = std::make_shared<const Tags>(std::move(value));
+        }
+
+        void Image::setTags(const std::shared_ptr<const Tags>& value)
         {
             _tags = value;
         }
 
+        void Image::setHDR(const std::shared_ptr<const HDRData>& value)
+        {
+            _hdr = value;
+        }
+
+        void Image::setRegion(const Size& displaySize, const math::Vector2i& pos)
+        {
+            _region = displaySize != _info.size || pos != math::Vector2i();
+            _displaySize = displaySize;
+            _dataPos = pos;
+        }
+
+        math::Box2i getDataBox(const Image& image, const math::Box2i& box)
+        {
+            const Size& displaySize = image.getDisplaySize();
+            math::Box2i out = getBox(displaySize.getAspect(), box);
+            if (image.isRegion() && displaySize.w > 0 && displaySize.h > 0)
+            {
+                const Size& size = image.getSize();
+                const math::Vector2i& pos = image.getDataPos();
+                const float sx = out.w() / static_cast<float>(displaySize.w);
+                const float sy = out.h() / static_cast<float>(displaySize.h);
+                out = math::Box2i(
+                    out.min.x + pos.x * sx,
+                    out.min.y + pos.y * sy,
+                    size.w * sx,
+                    size.h * sy);
+            }
+            return out;
+        }
+
         void Image::zero()
         {
-            std::memset(_data.data(), 0, _dataByteCount);
+            std::memset(getData(), 0, _dataByteCount);
         }
 
         void to_json(nlohmann::json& json, const Size& value)
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <tlCore/Box.h>
+#include <tlCore/HDR.h>
 #include <tlCore/Memory.h>
 #include <tlCore/Range.h>
 #include <tlCore/Util.h>
@@ -15,6 +16,7 @@
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -260,6 +262,22 @@ namespace tl
         //! Get the number of bytes used to store image data.
         std::size_t getDataByteCount(const Info&);
 
+        //! Get the number of planes used to store image data.
+        size_t getPlaneCount(PixelType);
+
+        //! Get the size of an image plane.
+        Size getPlaneSize(const Info&, size_t plane);
+
+        //! Get the number of bytes used to store a row of an image plane.
+        size_t getPlaneRowByteCount(const Info&, size_t plane);
+
+        //! Image plane.
+        struct Plane
+        {
+            const uint8_t* data   = nullptr; //!< The first row
+            size_t         stride = 0;       //!< The number of bytes between rows
+        };
+
         //! Image tags.
         typedef std::map<std::string, std::string> Tags;
 
@@ -276,7 +294,8 @@ namespace tl
         public:
             ~Image();
 
-            //! Create a new image.
+            //! Create a new image. The image data is allocated from the
+            //! image pool (see getImagePool()) and is not initialized.
             static std::shared_ptr<Image> create(const Info&);
 
             //! Create a new image.
@@ -285,6 +304,16 @@ namespace tl
             //! Create a new image.
             static std::shared_ptr<Image> create(int w, int h, PixelType);
 
+            //! Create a new image that references external storage, for
+            //! example a decoded video frame. The storage is kept alive
+            //! until the image is destroyed. There must be one plane for
+            //! each of getPlaneCount(), and the plane strides must be at
+            //! least getPlaneRowByteCount().
+            static std::shared_ptr<Image> create(
+                const Info&,
+                const std::vector<Plane>&,
+                const std::shared_ptr<void>& storage);
+
             //! Get the image information.
             const Info& getInfo() const;
 
@@ -309,28 +338,101 @@ namespace tl
             //! Get the image tags.
             const Tags& getTags() const;
 
+            //! Get the shared image tags. Images with the same tags can
+            //! share one immutable instance instead of copying them.
+            const std::shared_ptr<const Tags>& getSharedTags() const;
+
             //! Set the image tags.
             void setTags(const Tags&);
 
+            //! Set the image tags.
+            void setTags(Tags&&);
+
+            //! Set the shared image tags.
+            void setTags(const std::shared_ptr<const Tags>&);
+
+            //! Get the HDR metadata.
+            const std::shared_ptr<const HDRData>& getHDR() const;
+
+            //! Set the HDR metadata. The metadata is immutable and may be
+            //! shared between images.
+            void setHDR(const std::shared_ptr<const HDRData>&);
+
+            //! Is the image a region of a larger image?
+            bool isRegion() const;
+
+            //! Get the size of the whole image. This is the same as the
+            //! image size unless the image is a region.
+            const Size& getDisplaySize() const;
+
+            //! Get the position of the image data within the whole image,
+            //! in display coordinates.
+            const math::Vector2i& getDataPos() const;
+
+            //! Set the size of the whole image and the position of the
+            //! image data within it. This is used by readers that decode a
+            //! region of interest.
+            void setRegion(const Size& displaySize, const math::Vector2i& pos);
+
             //! Get the number of bytes used to store the image data.
             size_t getDataByteCount() const;
 
-            //! Get the image data.
+            //! Does the image reference external storage?
+            bool hasExternalData() const;
+
+            //! Get the image planes.
+            const std::vector<Plane>& getPlanes() const;
+
+            //! Get the image data. Images that reference external storage
+            //! are copied to contiguous data the first time this is called,
+            //! use getPlanes() to access the data without a copy.
             const uint8_t* getData() const;
 
-            //! Get the image data.
+            //! Get the image data. Images that reference external storage
+            //! are copied to contiguous data the first time this is called,
+            //! and changes to the data are not reflected in the planes.
             uint8_t* getData();
 
             //! Zero the image data.
             void zero();
 
         private:
+            void _copyPlanes() const;
+
             Info _info;
-            Tags _tags;
+            std::shared_ptr<const Tags> _tags;
+            std::shared_ptr<const HDRData> _hdr;
+            bool _region = false;
+            Size _displaySize;
+            math::Vector2i _dataPos;
             size_t _dataByteCount = 0;
-            std::vector<uint8_t> _data;
+            mutable std::shared_ptr<uint8_t> _data;
+            std::vector<Plane> _planes;
+            std::shared_ptr<void> _storage;
+            mutable std::once_flag _copyPlanesOnce;
         };
 
+        //! Get the box covered by the image data when the whole image is
+        //! fit within the given box. For images that are not regions this
+        //! is the same as getBox().
+        math::Box2i getDataBox(const Image&, const math::Box2i&);
+
+        //! \name Proxies
+        ///@{
+
+        //! Get the size of an image at a proxy level. Each level halves the
+        //! width and height, rounding up.
+        Size getProxySize(const Size&, int level);
+
+        //! Create a proxy of an image by averaging blocks of pixels. The
+        //! L, LA, RGB, RGBA, and planar YUV pixel types are supported
+        //! (except RGB_U10) with native endian data, for other images
+        //! nullptr is returned. The chroma planes of YUV images are
+        //! halved separately from the luma plane.
+        std::shared_ptr<Image> createProxy(const std::shared_ptr<Image>&, int level);
+
+        ///@}
+
         //! \name Serialize
         ///@{
 
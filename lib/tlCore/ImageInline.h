@@ -187,23 +187,67 @@ namespace tl
         }
 
         inline const Tags& Image::getTags() const
+        {
+            static const Tags empty;
+            return _tags ? *_tags : empty;
+        }
+
+        inline const std::shared_ptr<const Tags>& Image::getSharedTags() const
         {
             return _tags;
         }
 
+        inline const std::shared_ptr<const HDRData>& Image::getHDR() const
+        {
+            return _hdr;
+        }
+
+        inline bool Image::isRegion() const
+        {
+            return _region;
+        }
+
+        inline const Size& Image::getDisplaySize() const
+        {
+            return _region ? _displaySize : _info.size;
+        }
+
+        inline const math::Vector2i& Image::getDataPos() const
+        {
+            return _dataPos;
+        }
+
         inline size_t Image::getDataByteCount() const
         {
             return _dataByteCount;
         }
 
+        inline bool Image::hasExternalData() const
+        {
+            return _storage != nullptr;
+        }
+
+        inline const std::vector<Plane>& Image::getPlanes() const
+        {
+            return _planes;
+        }
+
         inline const uint8_t* Image::getData() const
         {
-            return _data.data();
+            if (_storage)
+            {
+                _copyPlanes();
+            }
+            return _data.get();
         }
 
         inline uint8_t* Image::getData()
         {
-            return _data.data();
+            if (_storage)
+            {
+                _copyPlanes();
+            }
+            return _data.get();
         }
     }
 }
@@ -0,0 +1,244 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/ImagePool.h>
+
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <new>
+
+namespace tl
+{
+    namespace image
+    {
+        bool ImagePoolStats::operator == (const ImagePoolStats& other) const
+        {
+            return
+                hits == other.hits &&
+                misses == other.misses &&
+                byteCount == other.byteCount &&
+                bufferCount == other.bufferCount &&
+                inUseByteCount == other.inUseByteCount;
+        }
+
+        bool ImagePoolStats::operator != (const ImagePoolStats& other) const
+        {
+            return !(*this == other);
+        }
+
+        namespace
+        {
+            uint8_t* alignedAlloc(size_t byteCount)
+            {
+                return static_cast<uint8_t*>(::operator new(
+                    byteCount,
+                    std::align_val_t(imagePoolAlignment)));
+            }
+
+            void alignedFree(uint8_t* p)
+            {
+                ::operator delete(p, std::align_val_t(imagePoolAlignment));
+            }
+        }
+
+        struct ImagePool::Private
+        {
+            size_t max = 0;
+            ImagePoolStats stats;
+
+            //! The buffers held for reuse, most recently released first.
+            std::list<std::pair<size_t, uint8_t*> > buffers;
+            mutable std::mutex mutex;
+        };
+
+        void ImagePool::_init(size_t max)
+        {
+            _p->max = max;
+        }
+
+        ImagePool::ImagePool() :
+            _p(new Private)
+        {}
+
+        ImagePool::~ImagePool()
+        {
+            clear();
+        }
+
+        std::shared_ptr<ImagePool> ImagePool::create(size_t max)
+        {
+            auto out = std::shared_ptr<ImagePool>(new ImagePool);
+            out->_init(max);
+            return out;
+        }
+
+        size_t ImagePool::getMax() const
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            return _p->max;
+        }
+
+        void ImagePool::setMax(size_t value)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                _p->max = value;
+            }
+            _trim(value);
+        }
+
+        ImagePoolStats ImagePool::getStats() const
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            return _p->stats;
+        }
+
+        void ImagePool::clear()
+        {
+            _trim(0);
+        }
+
+        std::shared_ptr<uint8_t> ImagePool::allocate(size_t byteCount)
+        {
+            TLRENDER_P();
+            const size_t sizeClass = getSizeClass(byteCount);
+            uint8_t* data = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                for (auto i = p.buffers.begin(); i != p.buffers.end(); ++i)
+                {
+                    if (sizeClass == i->first)
+                    {
+                        data = i->second;
+                        p.buffers.erase(i);
+                        p.stats.byteCount -= sizeClass;
+                        --p.stats.bufferCount;
+                        break;
+                    }
+                }
+                if (data)
+                {
+                    ++p.stats.hits;
+                }
+                else
+                {
+                    ++p.stats.misses;
+                }
+                p.stats.inUseByteCount += sizeClass;
+            }
+            if (!data)
+            {
+                data = alignedAlloc(sizeClass);
+            }
+            std::weak_ptr<ImagePool> weak(shared_from_this());
+            return std::shared_ptr<uint8_t>(
+                data,
+                [weak, sizeClass](uint8_t* data)
+                {
+                    if (auto pool = weak.lock())
+                    {
+                        pool->_release(data, sizeClass);
+                    }
+                    else
+                    {
+                        alignedFree(data);
+                    }
+                });
+        }
+
+        size_t ImagePool::getSizeClass(size_t value)
+        {
+            // Round up to a multiple of an eighth of the next power of two.
+            // The value is more than half of that power of two, so less
+            // than a quarter of the buffer is unused.
+            size_t out = 4096;
+            if (value > out)
+            {
+                size_t pow2 = 1;
+                while (pow2 < value)
+                {
+                    pow2 <<= 1;
+                }
+                const size_t step = pow2 / 8;
+                out = (value + step - 1) / step * step;
+            }
+            return out;
+        }
+
+        void ImagePool::_release(uint8_t* data, size_t sizeClass)
+        {
+            TLRENDER_P();
+            size_t max = 0;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.stats.inUseByteCount -= sizeClass;
+                max = p.max;
+                if (sizeClass <= max)
+                {
+                    p.buffers.push_front(std::make_pair(sizeClass, data));
+                    p.stats.byteCount += sizeClass;
+                    ++p.stats.bufferCount;
+                    data = nullptr;
+                }
+            }
+            if (data)
+            {
+                alignedFree(data);
+            }
+            else
+            {
+                _trim(max);
+            }
+        }
+
+        void ImagePool::_trim(size_t max)
+        {
+            TLRENDER_P();
+            std::list<std::pair<size_t, uint8_t*> > buffers;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                while (p.stats.byteCount > max && !p.buffers.empty())
+                {
+                    p.stats.byteCount -= p.buffers.back().first;
+                    --p.stats.bufferCount;
+                    buffers.splice(buffers.end(), p.buffers, std::prev(p.buffers.end()));
+                }
+            }
+            for (const auto& i : buffers)
+            {
+                alignedFree(i.second);
+            }
+        }
+
+        namespace
+        {
+            struct GlobalPool
+            {
+                std::shared_ptr<ImagePool> pool = ImagePool::create();
+                std::mutex mutex;
+            };
+
+            GlobalPool& getGlobalPool()
+            {
+                static GlobalPool globalPool;
+                return globalPool;
+            }
+        }
+
+        std::shared_ptr<ImagePool> getImagePool()
+        {
+            auto& globalPool = getGlobalPool();
+            std::unique_lock<std::mutex> lock(globalPool.mutex);
+            return globalPool.pool;
+        }
+
+        void setImagePool(const std::shared_ptr<ImagePool>& value)
+        {
+            auto& globalPool = getGlobalPool();
+            std::unique_lock<std::mutex> lock(globalPool.mutex);
+            globalPool.pool = value;
+        }
+    }
+}
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Memory.h>
+
+#include <memory>
+
+namespace tl
+{
+    namespace image
+    {
+        //! Image pool buffer alignment. Buffers are page aligned so they can
+        //! be used for direct file reads (see file::BatchRead).
+        const size_t imagePoolAlignment = 4096;
+
+        //! Image pool minimum buffer size. Smaller buffers are allocated
+        //! directly.
+        const size_t imagePoolMinSize = 64 * memory::kilobyte;
+
+        //! Image pool default maximum byte count.
+        const size_t imagePoolMax = memory::gigabyte;
+
+        //! Image pool statistics.
+        struct ImagePoolStats
+        {
+            size_t hits           = 0; //!< Allocations that reused a buffer
+            size_t misses         = 0; //!< Allocations that created a buffer
+            size_t byteCount      = 0; //!< Bytes held by the pool for reuse
+            size_t bufferCount    = 0; //!< Buffers held by the pool for reuse
+            size_t inUseByteCount = 0; //!< Bytes allocated from the pool and in use
+
+            bool operator == (const ImagePoolStats&) const;
+            bool operator != (const ImagePoolStats&) const;
+        };
+
+        //! Image buffer pool.
+        //!
+        //! Buffer sizes are rounded up to size classes, so images with
+        //! similar sizes can share buffers. Buffers are returned to the pool
+        //! when the last reference is released, and kept for reuse up to the
+        //! maximum byte count. The buffers are aligned and not initialized.
+        class ImagePool : public std::enable_shared_from_this<ImagePool>
+        {
+            TLRENDER_NON_COPYABLE(ImagePool);
+
+        protected:
+            void _init(size_t max);
+
+            ImagePool();
+
+        public:
+            ~ImagePool();
+
+            //! Create a new image pool.
+            static std::shared_ptr<ImagePool> create(size_t max = imagePoolMax);
+
+            //! Get the maximum number of bytes held for reuse.
+            size_t getMax() const;
+
+            //! Set the maximum number of bytes held for reuse.
+            void setMax(size_t);
+
+            //! Get the statistics.
+            ImagePoolStats getStats() const;
+
+            //! Release the buffers held for reuse.
+            void clear();
+
+            //! Allocate a buffer.
+            std::shared_ptr<uint8_t> allocate(size_t byteCount);
+
+            //! Get the size class for the given number of bytes.
+            static size_t getSizeClass(size_t);
+
+        private:
+            void _release(uint8_t*, size_t sizeClass);
+            void _trim(size_t max);
+
+            TLRENDER_PRIVATE();
+        };
+
+        //! Get the image pool used by Image::create().
+        std::shared_ptr<ImagePool> getImagePool();
+
+        //! Set the image pool used by Image::create(). Setting a null pool
+        //! disables pooling.
+        void setImagePool(const std::shared_ptr<ImagePool>&);
+    }
+}
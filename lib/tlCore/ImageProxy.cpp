@@ -0,0 +1,244 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/Image.h>
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define TLRENDER_IMAGE_SIMD
+#include <immintrin.h>
+#endif // __x86_64__ || _M_X64
+
+namespace tl
+{
+    namespace image
+    {
+        Size getProxySize(const Size& size, int level)
+        {
+            Size out = size;
+            for (int i = 0; i < level; ++i)
+            {
+                out.w = (out.w + 1) / 2;
+                out.h = (out.h + 1) / 2;
+            }
+            return out;
+        }
+
+        namespace
+        {
+            template<typename T>
+            inline T average(T a, T b, T c, T d)
+            {
+                return static_cast<T>((static_cast<uint64_t>(a) + b + c + d + 2) / 4);
+            }
+
+            template<>
+            inline F16_T average(F16_T a, F16_T b, F16_T c, F16_T d)
+            {
+                return (static_cast<float>(a) + b + c + d) * .25F;
+            }
+
+            template<>
+            inline F32_T average(F32_T a, F32_T b, F32_T c, F32_T d)
+            {
+                return (a + b + c + d) * .25F;
+            }
+
+#if defined(TLRENDER_IMAGE_SIMD)
+            // Average four output pixels at a time. Returns the number of
+            // output pixels processed.
+            size_t halveRowRGBA_U8(
+                const uint8_t* r0,
+                const uint8_t* r1,
+                uint8_t* out,
+                size_t count)
+            {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i two = _mm_set1_epi16(2);
+                size_t i = 0;
+                for (; i + 4 <= count; i += 4, r0 += 32, r1 += 32, out += 16)
+                {
+                    __m128i sums[2];
+                    for (size_t j = 0; j < 2; ++j)
+                    {
+                        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r0 + j * 16));
+                        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r1 + j * 16));
+                        const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+                        const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+                        const __m128i lo2 = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+                        const __m128i hi2 = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+                        sums[j] = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(lo2, hi2), two), 2);
+                    }
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(sums[0], sums[1]));
+                }
+                return i;
+            }
+
+            size_t halveRowRGBA_F32(
+                const float* r0,
+                const float* r1,
+                float* out,
+                size_t count)
+            {
+                const __m128 quarter = _mm_set1_ps(.25F);
+                for (size_t i = 0; i < count; ++i, r0 += 8, r1 += 8, out += 4)
+                {
+                    const __m128 sum = _mm_add_ps(
+                        _mm_add_ps(_mm_loadu_ps(r0), _mm_loadu_ps(r0 + 4)),
+                        _mm_add_ps(_mm_loadu_ps(r1), _mm_loadu_ps(r1 + 4)));
+                    _mm_storeu_ps(out, _mm_mul_ps(sum, quarter));
+                }
+                return count;
+            }
+#endif // TLRENDER_IMAGE_SIMD
+
+            template<typename T>
+            size_t halveRowSIMD(const T*, const T*, T*, size_t, size_t)
+            {
+                return 0;
+            }
+
+#if defined(TLRENDER_IMAGE_SIMD)
+            template<>
+            size_t halveRowSIMD(const U8_T* r0, const U8_T* r1, U8_T* out, size_t count, size_t channels)
+            {
+                return 4 == channels ? halveRowRGBA_U8(r0, r1, out, count) : 0;
+            }
+
+            template<>
+            size_t halveRowSIMD(const F32_T* r0, const F32_T* r1, F32_T* out, size_t count, size_t channels)
+            {
+                return 4 == channels ? halveRowRGBA_F32(r0, r1, out, count) : 0;
+            }
+#endif // TLRENDER_IMAGE_SIMD
+
+            template<typename T>
+            void halve(
+                const uint8_t* in,
+                size_t inStride,
+                const Size& inSize,
+                uint8_t* out,
+                size_t outStride,
+                const Size& outSize,
+                size_t channels)
+            {
+                for (int y = 0; y < outSize.h; ++y)
+                {
+                    const T* r0 = reinterpret_cast<const T*>(in + y * 2 * inStride);
+                    const T* r1 = reinterpret_cast<const T*>(in + std::min(y * 2 + 1, inSize.h - 1) * inStride);
+                    T* p = reinterpret_cast<T*>(out + y * outStride);
+
+                    // The pixels with a full pair of columns can use the
+                    // SIMD kernels, the remainder and the last odd column
+                    // use the scalar code.
+                    const size_t pairs = std::min(static_cast<size_t>(inSize.w / 2), static_cast<size_t>(outSize.w));
+                    const size_t simd = halveRowSIMD<T>(r0, r1, p, pairs, channels);
+                    for (size_t x = simd; x < static_cast<size_t>(outSize.w); ++x)
+                    {
+                        const size_t x0 = x * 2 * channels;
+                        const size_t x1 = std::min(x * 2 + 1, static_cast<size_t>(inSize.w - 1)) * channels;
+                        for (size_t c = 0; c < channels; ++c)
+                        {
+                            p[x * channels + c] = average(r0[x0 + c], r0[x1 + c], r1[x0 + c], r1[x1 + c]);
+                        }
+                    }
+                }
+            }
+        }
+
+        std::shared_ptr<Image> createProxy(const std::shared_ptr<Image>& image, int level)
+        {
+            if (!image || level <= 0)
+            {
+                return image;
+            }
+            const Info& info = image->getInfo();
+            const int bitDepth = getBitDepth(info.pixelType);
+            if (PixelType::RGB_U10 == info.pixelType ||
+                (bitDepth > 8 && info.layout.endian != memory::getEndian()))
+            {
+                return nullptr;
+            }
+
+            // The planes of planar YUV images are halved separately.
+            const size_t planeCount = getPlaneCount(info.pixelType);
+            const size_t channels = planeCount > 1 ? 1 : getChannelCount(info.pixelType);
+            void (*halveFunc)(const uint8_t*, size_t, const Size&, uint8_t*, size_t, const Size&, size_t) = nullptr;
+            switch (info.pixelType)
+            {
+            case PixelType::L_U8:
+            case PixelType::LA_U8:
+            case PixelType::RGB_U8:
+            case PixelType::RGBA_U8:
+            case PixelType::YUV_420P_U8:
+            case PixelType::YUV_422P_U8:
+            case PixelType::YUV_444P_U8:
+                halveFunc = halve<U8_T>;
+                break;
+            case PixelType::L_U16:
+            case PixelType::LA_U16:
+            case PixelType::RGB_U16:
+            case PixelType::RGBA_U16:
+            case PixelType::YUV_420P_U16:
+            case PixelType::YUV_422P_U16:
+            case PixelType::YUV_444P_U16:
+                halveFunc = halve<U16_T>;
+                break;
+            case PixelType::L_U32:
+            case PixelType::LA_U32:
+            case PixelType::RGB_U32:
+            case PixelType::RGBA_U32:
+                halveFunc = halve<U32_T>;
+                break;
+            case PixelType::L_F16:
+            case PixelType::LA_F16:
+            case PixelType::RGB_F16:
+            case PixelType::RGBA_F16:
+                halveFunc = halve<F16_T>;
+                break;
+            case PixelType::L_F32:
+            case PixelType::LA_F32:
+            case PixelType::RGB_F32:
+            case PixelType::RGBA_F32:
+                halveFunc = halve<F32_T>;
+                break;
+            default: break;
+            }
+            if (!halveFunc)
+            {
+                return nullptr;
+            }
+
+            // Halve the image once for each level.
+            std::shared_ptr<Image> out = image;
+            for (int i = 0; i < level && (out->getWidth() > 1 || out->getHeight() > 1); ++i)
+            {
+                Info outInfo = info;
+                outInfo.size = getProxySize(out->getSize(), 1);
+                auto tmp = Image::create(outInfo);
+                uint8_t* tmpData = tmp->getData();
+                for (size_t j = 0; j < planeCount; ++j)
+                {
+                    const Plane& plane = out->getPlanes()[j];
+                    const Size outPlaneSize = getPlaneSize(outInfo, j);
+                    const size_t outStride = getPlaneRowByteCount(outInfo, j);
+                    halveFunc(
+                        plane.data,
+                        plane.stride,
+                        getPlaneSize(out->getInfo(), j),
+                        tmpData,
+                        outStride,
+                        outPlaneSize,
+                        channels);
+                    tmpData += outStride * outPlaneSize.h;
+                }
+                out = tmp;
+            }
+            out->setTags(image->getSharedTags());
+            out->setHDR(image->getHDR());
+            return out;
+        }
+    }
+}
@@ -5,7 +5,11 @@
 #pragma once
 
 #include <cstdint>
-#include <map>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace tl
@@ -13,7 +17,11 @@ namespace tl
     namespace memory
     {
         //! Least recently used (LRU) cache.
-        template<typename T, typename U>
+        //!
+        //! Entries are stored in a hash map that points into a list
+        //! ordered by recency, so lookups, additions, and evictions are
+        //! constant time.
+        template<typename T, typename U, typename H = std::hash<T> >
         class LRUCache
         {
         public:
@@ -35,22 +43,84 @@ namespace tl
             bool contains(const T& key) const;
             bool get(const T& key, U& value) const;
 
+            //! Get a value without making it the most recently used.
+            bool peek(const T& key, U& value) const;
+
             void add(const T& key, const U& value, size_t size = 1);
             void remove(const T& key);
             void clear();
 
+            //! Get the keys, sorted.
             std::vector<T> getKeys() const;
+
+            //! Get the values, sorted by their keys.
             std::vector<U> getValues() const;
 
             ///@}
 
         private:
+            struct Item
+            {
+                T key;
+                U value;
+                size_t size = 0;
+            };
+
             void _maxUpdate();
+            std::vector<const Item*> _getSorted() const;
+
+            size_t _max = 10000;
+            size_t _size = 0;
+            mutable std::list<Item> _list;
+            std::unordered_map<T, typename std::list<Item>::iterator, H> _map;
+        };
+
+        //! Concurrent least recently used (LRU) cache.
+        //!
+        //! The entries are split across shards by their hash, each shard
+        //! with its own lock, so threads working on different keys do not
+        //! contend. The maximum size is divided evenly between the shards.
+        template<typename T, typename U, typename H = std::hash<T> >
+        class ConcurrentLRUCache
+        {
+        public:
+            ConcurrentLRUCache(size_t shardCount = 16);
+
+            //! \name Size
+            ///@{
+
+            size_t getMax() const;
+            size_t getSize() const;
+            size_t getCount() const;
+            float getPercentage() const;
+
+            void setMax(size_t);
+
+            ///@}
+
+            //! \name Contents
+            ///@{
+
+            bool contains(const T& key) const;
+            bool get(const T& key, U& value) const;
+
+            void add(const T& key, const U& value, size_t size = 1);
+            void remove(const T& key);
+            void clear();
+
+            ///@}
+
+        private:
+            struct Shard
+            {
+                LRUCache<T, U, H> cache;
+                mutable std::mutex mutex;
+            };
+
+            Shard& _getShard(const T&) const;
 
             size_t _max = 10000;
-            std::map<T, std::pair<U, size_t> > _map;
-            mutable std::map<T, int64_t> _counts;
-            mutable int64_t _counter = 0;
+            std::vector<std::unique_ptr<Shard> > _shards;
         };
     }
 }
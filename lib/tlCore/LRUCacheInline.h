@@ -8,37 +8,32 @@ namespace tl
 {
     namespace memory
     {
-        template<typename T, typename U>
-        inline std::size_t LRUCache<T, U>::getMax() const
+        template<typename T, typename U, typename H>
+        inline std::size_t LRUCache<T, U, H>::getMax() const
         {
             return _max;
         }
 
-        template<typename T, typename U>
-        inline std::size_t LRUCache<T, U>::getSize() const
+        template<typename T, typename U, typename H>
+        inline std::size_t LRUCache<T, U, H>::getSize() const
         {
-            size_t out = 0;
-            for (const auto& i : _map)
-            {
-                out += i.second.second;
-            }
-            return out;
+            return _size;
         }
 
-        template<typename T, typename U>
-        inline std::size_t LRUCache<T, U>::getCount() const
+        template<typename T, typename U, typename H>
+        inline std::size_t LRUCache<T, U, H>::getCount() const
         {
             return _map.size();
         }
 
-        template<typename T, typename U>
-        inline float LRUCache<T, U>::getPercentage() const
+        template<typename T, typename U, typename H>
+        inline float LRUCache<T, U, H>::getPercentage() const
         {
-            return getSize() / static_cast<float>(_max) * 100.F;
+            return _size / static_cast<float>(_max) * 100.F;
         }
 
-        template<typename T, typename U>
-        inline void LRUCache<T, U>::setMax(std::size_t value)
+        template<typename T, typename U, typename H>
+        inline void LRUCache<T, U, H>::setMax(std::size_t value)
         {
             if (value == _max)
                 return;
@@ -46,110 +41,239 @@ namespace tl
             _maxUpdate();
         }
 
-        template<typename T, typename U>
-        inline bool LRUCache<T, U>::contains(const T& key) const
+        template<typename T, typename U, typename H>
+        inline bool LRUCache<T, U, H>::contains(const T& key) const
         {
             return _map.find(key) != _map.end();
         }
 
-        template<typename T, typename U>
-        inline bool LRUCache<T, U>::get(const T& key, U& value) const
+        template<typename T, typename U, typename H>
+        inline bool LRUCache<T, U, H>::get(const T& key, U& value) const
         {
-            auto i = _map.find(key);
+            const auto i = _map.find(key);
             if (i != _map.end())
             {
-                value = i->second.first;
-                auto j = _counts.find(key);
-                if (j != _counts.end())
-                {
-                    ++_counter;
-                    j->second = _counter;
-                }
+                value = i->second->value;
+                _list.splice(_list.end(), _list, i->second);
                 return true;
             }
-            return i != _map.end();
+            return false;
         }
 
-        template<typename T, typename U>
-        inline void LRUCache<T, U>::add(const T& key, const U& value, size_t size)
+        template<typename T, typename U, typename H>
+        inline bool LRUCache<T, U, H>::peek(const T& key, U& value) const
         {
-            _map[key] = std::make_pair(value, size);
-            ++_counter;
-            _counts[key] = _counter;
-            _maxUpdate();
+            const auto i = _map.find(key);
+            if (i != _map.end())
+            {
+                value = i->second->value;
+                return true;
+            }
+            return false;
         }
 
-        template<typename T, typename U>
-        inline void LRUCache<T, U>::remove(const T& key)
+        template<typename T, typename U, typename H>
+        inline void LRUCache<T, U, H>::add(const T& key, const U& value, size_t size)
         {
             const auto i = _map.find(key);
             if (i != _map.end())
             {
-                _map.erase(i);
+                _size -= i->second->size;
+                i->second->value = value;
+                i->second->size = size;
+                _list.splice(_list.end(), _list, i->second);
             }
-            const auto j = _counts.find(key);
-            if (j != _counts.end())
+            else
             {
-                _counts.erase(j);
+                _list.push_back(Item{ key, value, size });
+                _map[key] = std::prev(_list.end());
             }
+            _size += size;
             _maxUpdate();
         }
 
-        template<typename T, typename U>
-        inline void LRUCache<T, U>::clear()
+        template<typename T, typename U, typename H>
+        inline void LRUCache<T, U, H>::remove(const T& key)
+        {
+            const auto i = _map.find(key);
+            if (i != _map.end())
+            {
+                _size -= i->second->size;
+                _list.erase(i->second);
+                _map.erase(i);
+            }
+        }
+
+        template<typename T, typename U, typename H>
+        inline void LRUCache<T, U, H>::clear()
         {
             _map.clear();
+            _list.clear();
+            _size = 0;
         }
 
-        template<typename T, typename U>
-        inline std::vector<T> LRUCache<T, U>::getKeys() const
+        template<typename T, typename U, typename H>
+        inline std::vector<T> LRUCache<T, U, H>::getKeys() const
         {
             std::vector<T> out;
-            for (const auto& i : _map)
+            out.reserve(_list.size());
+            for (const auto i : _getSorted())
             {
-                out.push_back(i.first);
+                out.push_back(i->key);
             }
             return out;
         }
 
-        template<typename T, typename U>
-        inline std::vector<U> LRUCache<T, U>::getValues() const
+        template<typename T, typename U, typename H>
+        inline std::vector<U> LRUCache<T, U, H>::getValues() const
         {
             std::vector<U> out;
-            for (const auto& i : _map)
+            out.reserve(_list.size());
+            for (const auto i : _getSorted())
             {
-                out.push_back(i.second.first);
+                out.push_back(i->value);
             }
             return out;
         }
 
-        template<typename T, typename U>
-        inline void LRUCache<T, U>::_maxUpdate()
+        template<typename T, typename U, typename H>
+        inline void LRUCache<T, U, H>::_maxUpdate()
         {
-            size_t size = getSize();
-            if (size > _max)
+            while (_size > _max && !_list.empty())
             {
-                std::map<int64_t, T> sorted;
-                for (const auto& i : _counts)
-                {
-                    sorted[i.second] = i.first;
-                }
-                while (getSize() > _max)
+                auto i = _list.begin();
+                _size -= i->size;
+                _map.erase(i->key);
+                _list.erase(i);
+            }
+        }
+
+        template<typename T, typename U, typename H>
+        inline std::vector<const typename LRUCache<T, U, H>::Item*> LRUCache<T, U, H>::_getSorted() const
+        {
+            std::vector<const Item*> out;
+            out.reserve(_list.size());
+            for (const auto& i : _list)
+            {
+                out.push_back(&i);
+            }
+            std::sort(
+                out.begin(),
+                out.end(),
+                [](const Item* a, const Item* b)
                 {
-                    auto begin = sorted.begin();
-                    auto i = _map.find(begin->second);
-                    if (i != _map.end())
-                    {
-                        _map.erase(i);
-                    }
-                    auto j = _counts.find(begin->second);
-                    if (j != _counts.end())
-                    {
-                        _counts.erase(j);
-                    }
-                    sorted.erase(begin);
-                }
+                    return a->key < b->key;
+                });
+            return out;
+        }
+
+        template<typename T, typename U, typename H>
+        inline ConcurrentLRUCache<T, U, H>::ConcurrentLRUCache(size_t shardCount)
+        {
+            for (size_t i = 0; i < std::max(shardCount, size_t(1)); ++i)
+            {
+                _shards.push_back(std::unique_ptr<Shard>(new Shard));
+            }
+            setMax(_max);
+        }
+
+        template<typename T, typename U, typename H>
+        inline std::size_t ConcurrentLRUCache<T, U, H>::getMax() const
+        {
+            return _max;
+        }
+
+        template<typename T, typename U, typename H>
+        inline std::size_t ConcurrentLRUCache<T, U, H>::getSize() const
+        {
+            size_t out = 0;
+            for (const auto& shard : _shards)
+            {
+                std::unique_lock<std::mutex> lock(shard->mutex);
+                out += shard->cache.getSize();
+            }
+            return out;
+        }
+
+        template<typename T, typename U, typename H>
+        inline std::size_t ConcurrentLRUCache<T, U, H>::getCount() const
+        {
+            size_t out = 0;
+            for (const auto& shard : _shards)
+            {
+                std::unique_lock<std::mutex> lock(shard->mutex);
+                out += shard->cache.getCount();
+            }
+            return out;
+        }
+
+        template<typename T, typename U, typename H>
+        inline float ConcurrentLRUCache<T, U, H>::getPercentage() const
+        {
+            return getSize() / static_cast<float>(_max) * 100.F;
+        }
+
+        template<typename T, typename U, typename H>
+        inline void ConcurrentLRUCache<T, U, H>::setMax(std::size_t value)
+        {
+            _max = value;
+            const size_t shardMax = value / _shards.size();
+            for (const auto& shard : _shards)
+            {
+                std::unique_lock<std::mutex> lock(shard->mutex);
+                shard->cache.setMax(shardMax);
             }
         }
+
+        template<typename T, typename U, typename H>
+        inline bool ConcurrentLRUCache<T, U, H>::contains(const T& key) const
+        {
+            const Shard& shard = _getShard(key);
+            std::unique_lock<std::mutex> lock(shard.mutex);
+            return shard.cache.contains(key);
+        }
+
+        template<typename T, typename U, typename H>
+        inline bool ConcurrentLRUCache<T, U, H>::get(const T& key, U& value) const
+        {
+            const Shard& shard = _getShard(key);
+            std::unique_lock<std::mutex> lock(shard.mutex);
+            return shard.cache.get(key, value);
+        }
+
+        template<typename T, typename U, typename H>
+        inline void ConcurrentLRUCache<T, U, H>::add(const T& key, const U& value, size_t size)
+        {
+            Shard& shard = _getShard(key);
+            std::unique_lock<std::mutex> lock(shard.mutex);
+            shard.cache.add(key, value, size);
+        }
+
+        template<typename T, typename U, typename H>
+        inline void ConcurrentLRUCache<T, U, H>::remove(const T& key)
+        {
+            Shard& shard = _getShard(key);
+            std::unique_lock<std::mutex> lock(shard.mutex);
+            shard.cache.remove(key);
+        }
+
+        template<typename T, typename U, typename H>
+        inline void ConcurrentLRUCache<T, U, H>::clear()
+        {
+            for (const auto& shard : _shards)
+            {
+                std::unique_lock<std::mutex> lock(shard->mutex);
+                shard->cache.clear();
+            }
+        }
+
+        template<typename T, typename U, typename H>
+        inline typename ConcurrentLRUCache<T, U, H>::Shard& ConcurrentLRUCache<T, U, H>::_getShard(const T& key) const
+        {
+            // Mix the hash so that the shards do not share the low bits used
+            // by the hash maps.
+            const uint64_t hash = static_cast<uint64_t>(H()(key)) * 11400714819323198485ULL;
+            return *_shards[(hash >> 32) % _shards.size()];
+        }
     }
 }
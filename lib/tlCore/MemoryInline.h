@@ -38,5 +38,11 @@ namespace tl
         {
             return value ^ (1 << bit);
         }
+
+        template<typename T>
+        inline void hashCombine(std::size_t& seed, const T& value)
+        {
+            seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
     }
 }
@@ -116,18 +116,9 @@ namespace tl
             {
                 if (layer.image)
                 {
-                    const auto& tags = layer.image->getTags();
-                    const auto k = tags.find("hdr");
-                    if (k != tags.end())
+                    if (const auto& hdr = layer.image->getHDR())
                     {
-                        out = std::shared_ptr<image::HDRData>(new image::HDRData);
-                        try
-                        {
-                            auto json = nlohmann::json::parse(k->second);
-                            from_json(json, *out);
-                        }
-                        catch (const std::exception&)
-                        {}
+                        out = std::shared_ptr<image::HDRData>(new image::HDRData(*hdr));
                         break;
                     }
                 }
@@ -380,72 +380,66 @@ namespace tl
 
         void Texture::copy(const std::shared_ptr<image::Image>& data)
         {
-            TLRENDER_P();
-#if defined(TLRENDER_API_GL_4_1)
-            if (p.pbo)
+            copy(data, 0, 0);
+        }
+
+        void Texture::copy(const std::shared_ptr<image::Image>& data, int x, int y)
+        {
+            const auto& info = data->getInfo();
+            if (data->hasExternalData())
             {
-                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, p.pbo);
-                if (void* buffer = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY))
-                {
-                    memcpy(
-                        buffer,
-                        data->getData(),
-                        data->getDataByteCount());
-                    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
-                    const auto& info = data->getInfo();
-                    glBindTexture(GL_TEXTURE_2D, p.id);
-                    glPixelStorei(GL_UNPACK_ALIGNMENT, info.layout.alignment);
-                    glPixelStorei(GL_UNPACK_SWAP_BYTES, info.layout.endian != memory::getEndian());
-                    glTexSubImage2D(
-                        GL_TEXTURE_2D,
-                        0,
-                        0,
-                        0,
-                        info.size.w,
-                        info.size.h,
-                        getTextureFormat(info.pixelType),
-                        getTextureType(info.pixelType),
-                        NULL);
-                }
-                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                const auto& plane = data->getPlanes()[0];
+                _copy(plane.data, info, plane.stride, x, y);
             }
             else
-#endif // TLRENDER_API_GL_4_1
             {
-                const auto& info = data->getInfo();
-                glBindTexture(GL_TEXTURE_2D, p.id);
-                glPixelStorei(GL_UNPACK_ALIGNMENT, info.layout.alignment);
-#if defined(TLRENDER_API_GL_4_1)
-                glPixelStorei(GL_UNPACK_SWAP_BYTES, info.layout.endian != memory::getEndian());
-#endif // TLRENDER_API_GL_4_1
-                glTexSubImage2D(
-                    GL_TEXTURE_2D,
-                    0,
-                    0,
-                    0,
-                    info.size.w,
-                    info.size.h,
-                    getTextureFormat(info.pixelType),
-                    getTextureType(info.pixelType),
-                    data->getData());
+                _copy(data->getData(), info, image::getPlaneRowByteCount(info, 0), x, y);
             }
         }
 
-        void Texture::copy(const std::shared_ptr<image::Image>& data, int x, int y)
+        void Texture::copy(const uint8_t* data, const image::Info& info)
+        {
+            _copy(data, info, image::getPlaneRowByteCount(info, 0), 0, 0);
+        }
+
+        void Texture::copy(const uint8_t* data, const image::Info& info, size_t stride)
+        {
+            _copy(data, info, stride, 0, 0);
+        }
+
+        void Texture::_copy(
+            const uint8_t* data,
+            const image::Info& info,
+            size_t stride,
+            int x,
+            int y)
         {
             TLRENDER_P();
+            const size_t rowByteCount = image::getPlaneRowByteCount(info, 0);
 #if defined(TLRENDER_API_GL_4_1)
             if (p.pbo)
             {
                 glBindBuffer(GL_PIXEL_UNPACK_BUFFER, p.pbo);
                 if (void* buffer = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY))
                 {
-                    memcpy(
-                        buffer,
-                        data->getData(),
-                        data->getDataByteCount());
+                    if (stride == rowByteCount)
+                    {
+                        memcpy(
+                            buffer,
+                            data,
+                            image::getDataByteCount(info));
+                    }
+                    else
+                    {
+                        for (int i = 0; i < info.size.h; ++i)
+                        {
+                            memcpy(
+                                reinterpret_cast<uint8_t*>(buffer) + rowByteCount * i,
+                                data + stride * i,
+                                rowByteCount);
+                        }
+                    }
                     glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
-                    const auto& info = data->getInfo();
                     glBindTexture(GL_TEXTURE_2D, p.id);
                     glPixelStorei(GL_UNPACK_ALIGNMENT, info.layout.alignment);
                     glPixelStorei(GL_UNPACK_SWAP_BYTES, info.layout.endian != memory::getEndian());
@@ -465,73 +459,67 @@ namespace tl
             else
 #endif // TLRENDER_API_GL_4_1
             {
-                const auto& info = data->getInfo();
                 glBindTexture(GL_TEXTURE_2D, p.id);
                 glPixelStorei(GL_UNPACK_ALIGNMENT, info.layout.alignment);
 #if defined(TLRENDER_API_GL_4_1)
                 glPixelStorei(GL_UNPACK_SWAP_BYTES, info.layout.endian != memory::getEndian());
 #endif // TLRENDER_API_GL_4_1
-                glTexSubImage2D(
-                    GL_TEXTURE_2D,
-                    0,
-                    x,
-                    y,
-                    info.size.w,
-                    info.size.h,
-                    getTextureFormat(info.pixelType),
-                    getTextureType(info.pixelType),
-                    data->getData());
-            }
-        }
-
-        void Texture::copy(const uint8_t* data, const image::Info& info)
-        {
-            TLRENDER_P();
-#if defined(TLRENDER_API_GL_4_1)
-            if (p.pbo)
-            {
-                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, p.pbo);
-                if (void* buffer = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY))
+                if (stride == rowByteCount)
                 {
-                    memcpy(
-                        buffer,
-                        data,
-                        image::getDataByteCount(info));
-                    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
-                    glBindTexture(GL_TEXTURE_2D, p.id);
-                    glPixelStorei(GL_UNPACK_ALIGNMENT, info.layout.alignment);
-                    glPixelStorei(GL_UNPACK_SWAP_BYTES, info.layout.endian != memory::getEndian());
                     glTexSubImage2D(
                         GL_TEXTURE_2D,
                         0,
-                        0,
-                        0,
+                        x,
+                        y,
                         info.size.w,
                         info.size.h,
                         getTextureFormat(info.pixelType),
                         getTextureType(info.pixelType),
-                        NULL);
+                        data);
                 }
-                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
-            }
-            else
-#endif // TLRENDER_API_GL_4_1
-            {
-                glBindTexture(GL_TEXTURE_2D, p.id);
-                glPixelStorei(GL_UNPACK_ALIGNMENT, info.layout.alignment);
+                else
+                {
 #if defined(TLRENDER_API_GL_4_1)
-                glPixelStorei(GL_UNPACK_SWAP_BYTES, info.layout.endian != memory::getEndian());
+                    // Use the row length when the stride is a whole number
+                    // of pixels, otherwise copy the rows one at a time.
+                    image::Info pixelInfo = info;
+                    pixelInfo.size = image::Size(1, 1);
+                    pixelInfo.layout.alignment = 1;
+                    const size_t pixelByteCount = image::getDataByteCount(pixelInfo);
+                    if (pixelByteCount > 0 && 0 == stride % pixelByteCount)
+                    {
+                        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+                        glPixelStorei(GL_UNPACK_ROW_LENGTH, stride / pixelByteCount);
+                        glTexSubImage2D(
+                            GL_TEXTURE_2D,
+                            0,
+                            x,
+                            y,
+                            info.size.w,
+                            info.size.h,
+                            getTextureFormat(info.pixelType),
+                            getTextureType(info.pixelType),
+                            data);
+                        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+                    }
+                    else
 #endif // TLRENDER_API_GL_4_1
-                glTexSubImage2D(
-                    GL_TEXTURE_2D,
-                    0,
-                    0,
-                    0,
-                    info.size.w,
-                    info.size.h,
-                    getTextureFormat(info.pixelType),
-                    getTextureType(info.pixelType),
-                    data);
+                    {
+                        for (int i = 0; i < info.size.h; ++i)
+                        {
+                            glTexSubImage2D(
+                                GL_TEXTURE_2D,
+                                0,
+                                x,
+                                y + i,
+                                info.size.w,
+                                1,
+                                getTextureFormat(info.pixelType),
+                                getTextureType(info.pixelType),
+                                data + stride * i);
+                        }
+                    }
+                }
             }
         }
 
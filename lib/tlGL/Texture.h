@@ -80,12 +80,22 @@ namespace tl
             void copy(const std::shared_ptr<image::Image>&, int x, int y);
             void copy(const uint8_t*, const image::Info&);
 
+            //! Copy image data with the given number of bytes between rows.
+            void copy(const uint8_t*, const image::Info&, size_t stride);
+
             ///@}
 
             //! Bind the texture.
             void bind();
 
         private:
+            void _copy(
+                const uint8_t*,
+                const image::Info&,
+                size_t stride,
+                int x,
+                int y);
+
             TLRENDER_PRIVATE();
         };
     }
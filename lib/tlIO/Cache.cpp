@@ -8,7 +8,10 @@
 #include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
 
+#include <algorithm>
+#include <map>
 #include <mutex>
+#include <unordered_map>
 
 namespace tl
 {
@@ -70,16 +73,175 @@ namespace tl
             return string::join(s, ';');
         }
 
+        namespace
+        {
+            const uint64_t fnvOffset = 14695981039346656037ULL;
+            const uint64_t fnvPrime = 1099511628211ULL;
+
+            inline uint64_t fnv(uint64_t hash, const void* data, size_t size)
+            {
+                const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    hash ^= p[i];
+                    hash *= fnvPrime;
+                }
+                return hash;
+            }
+
+            inline uint64_t fnv(uint64_t hash, uint64_t value)
+            {
+                return fnv(hash, &value, sizeof(uint64_t));
+            }
+
+            inline uint64_t fnv(uint64_t hash, double value)
+            {
+                return fnv(hash, &value, sizeof(double));
+            }
+
+            uint64_t getHash(const CacheKey& value)
+            {
+                uint64_t out = fnvOffset;
+                out = fnv(out, value.pathID);
+                out = fnv(out, value.value);
+                out = fnv(out, value.duration);
+                out = fnv(out, value.rate);
+                out = fnv(out, value.optionsHash);
+                return out;
+            }
+
+            struct PathIDs
+            {
+                std::unordered_map<std::string, uint64_t> ids;
+                std::mutex mutex;
+            };
+
+            PathIDs& getPathIDs()
+            {
+                static PathIDs pathIDs;
+                return pathIDs;
+            }
+        }
+
+        CacheKey::CacheKey()
+        {
+            hash = getHash(*this);
+        }
+
+        CacheKey::CacheKey(
+            uint64_t pathID,
+            const otime::RationalTime& time,
+            uint64_t optionsHash) :
+            pathID(pathID),
+            value(time.value()),
+            rate(time.rate()),
+            optionsHash(optionsHash)
+        {
+            hash = getHash(*this);
+        }
+
+        CacheKey::CacheKey(
+            uint64_t pathID,
+            const otime::TimeRange& timeRange,
+            uint64_t optionsHash) :
+            pathID(pathID),
+            value(timeRange.start_time().value()),
+            duration(timeRange.duration().rescaled_to(timeRange.start_time().rate()).value()),
+            rate(timeRange.start_time().rate()),
+            optionsHash(optionsHash)
+        {
+            hash = getHash(*this);
+        }
+
+        uint64_t getPathID(const file::Path& path)
+        {
+            const std::string key = path.get() + ';' + path.getNumber();
+            auto& pathIDs = getPathIDs();
+            std::unique_lock<std::mutex> lock(pathIDs.mutex);
+            const auto i = pathIDs.ids.find(key);
+            if (i != pathIDs.ids.end())
+            {
+                return i->second;
+            }
+            const uint64_t out = pathIDs.ids.size() + 1;
+            pathIDs.ids[key] = out;
+            return out;
+        }
+
+        uint64_t getOptionsHash(const Options& options)
+        {
+            return getOptionsHash(fnvOffset, options);
+        }
+
+        uint64_t getOptionsHash(uint64_t hash, const Options& options)
+        {
+            uint64_t out = hash;
+            for (const auto& i : options)
+            {
+                if ("Direction" == i.first)
+                {
+                    continue;
+                }
+                out = fnv(out, i.first.data(), i.first.size());
+                out = fnv(out, uint64_t(0));
+                out = fnv(out, i.second.data(), i.second.size());
+                out = fnv(out, uint64_t(0));
+            }
+            return out;
+        }
+
+        CacheKey getVideoCacheKey(
+            uint64_t pathID,
+            const otime::RationalTime& time,
+            uint64_t initOptionsHash,
+            const Options& frameOptions)
+        {
+            return CacheKey(pathID, time, getOptionsHash(initOptionsHash, frameOptions));
+        }
+
+        CacheKey getAudioCacheKey(
+            uint64_t pathID,
+            const otime::TimeRange& timeRange,
+            uint64_t initOptionsHash,
+            const Options& frameOptions)
+        {
+            return CacheKey(pathID, timeRange, getOptionsHash(initOptionsHash, frameOptions));
+        }
+
         struct Cache::Private
         {
             size_t max = memory::gigabyte;
-            memory::LRUCache<std::string, VideoData> video;
-            memory::LRUCache<std::string, AudioData> audio;
+            memory::LRUCache<CacheKey, VideoData> video;
+            memory::LRUCache<CacheKey, AudioData> audio;
+
+            //! Map images to their video cache keys. Entries may be stale
+            //! after the LRU cache evicts video, so they are checked before
+            //! use and pruned when the map grows. Pruning peeks at the LRU
+            //! cache so the order of the video is not changed.
+            std::unordered_map<const image::Image*, CacheKey> videoKeys;
+
+            //! Video for pinned images is moved out of the LRU cache so
+            //! that it is not evicted.
+            std::unordered_map<CacheKey, VideoData> pinnedVideo;
+
+            struct Pin
+            {
+                std::shared_ptr<image::Image> image;
+                size_t byteCount = 0;
+                std::map<uint64_t, size_t> owners;
+                std::vector<CacheKey> keys;
+            };
+            std::map<const image::Image*, Pin> pins;
+            size_t pinnedSize = 0;
+            uint64_t ownerID = 0;
+
             std::mutex mutex;
         };
 
         void Cache::_init()
         {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
             _maxUpdate();
         }
 
@@ -99,12 +261,15 @@ namespace tl
 
         size_t Cache::getMax() const
         {
-            return _p->max;
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.max;
         }
 
         void Cache::setMax(size_t value)
         {
             TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
             if (value == p.max)
                 return;
             p.max = value;
@@ -115,7 +280,7 @@ namespace tl
         {
             TLRENDER_P();
             std::unique_lock<std::mutex> lock(p.mutex);
-            return p.video.getSize() + p.audio.getSize();
+            return p.video.getSize() + p.audio.getSize() + p.pinnedSize;
         }
 
         float Cache::getPercentage() const
@@ -123,35 +288,87 @@ namespace tl
             TLRENDER_P();
             std::unique_lock<std::mutex> lock(p.mutex);
             return
-                (p.video.getSize() + p.audio.getSize()) /
-                static_cast<float>(p.video.getMax() + p.audio.getMax()) * 100.F;
+                (p.video.getSize() + p.audio.getSize() + p.pinnedSize) /
+                static_cast<float>(p.max) * 100.F;
         }
 
-        void Cache::addVideo(const std::string& key, const VideoData& videoData)
+        size_t Cache::getPinnedSize() const
         {
             TLRENDER_P();
             std::unique_lock<std::mutex> lock(p.mutex);
-            p.video.add(
-                key,
-                videoData,
-                videoData.image ? videoData.image->getDataByteCount() : 1);
+            return p.pinnedSize;
         }
 
-        bool Cache::containsVideo(const std::string& key) const
+        size_t Cache::getPinnedMax() const
         {
             TLRENDER_P();
             std::unique_lock<std::mutex> lock(p.mutex);
-            return p.video.contains(key);
+            return _getPinnedMax();
         }
 
-        bool Cache::getVideo(const std::string& key, VideoData& videoData) const
+        void Cache::addVideo(const CacheKey& key, const VideoData& videoData)
         {
             TLRENDER_P();
             std::unique_lock<std::mutex> lock(p.mutex);
-            return p.video.get(key, videoData);
+            const auto i = videoData.image ?
+                p.pins.find(videoData.image.get()) :
+                p.pins.end();
+            if (i != p.pins.end())
+            {
+                p.pinnedVideo[key] = videoData;
+                i->second.keys.push_back(key);
+            }
+            else
+            {
+                p.video.add(
+                    key,
+                    videoData,
+                    videoData.image ? videoData.image->getDataByteCount() : 1);
+                if (videoData.image)
+                {
+                    p.videoKeys[videoData.image.get()] = key;
+                    if (p.videoKeys.size() > p.video.getCount() * 2 + 100)
+                    {
+                        p.videoKeys.clear();
+                        for (const auto& j : p.video.getKeys())
+                        {
+                            VideoData value;
+                            if (p.video.peek(j, value) && value.image)
+                            {
+                                p.videoKeys[value.image.get()] = j;
+                            }
+                        }
+                    }
+                }
+            }
         }
 
-        void Cache::addAudio(const std::string& key, const AudioData& audioData)
+        bool Cache::containsVideo(const CacheKey& key) const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.video.contains(key) ||
+                p.pinnedVideo.find(key) != p.pinnedVideo.end();
+        }
+
+        bool Cache::getVideo(const CacheKey& key, VideoData& videoData) const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            bool out = p.video.get(key, videoData);
+            if (!out)
+            {
+                const auto i = p.pinnedVideo.find(key);
+                if (i != p.pinnedVideo.end())
+                {
+                    videoData = i->second;
+                    out = true;
+                }
+            }
+            return out;
+        }
+
+        void Cache::addAudio(const CacheKey& key, const AudioData& audioData)
         {
             TLRENDER_P();
             std::unique_lock<std::mutex> lock(p.mutex);
@@ -161,34 +378,168 @@ namespace tl
                 audioData.audio ? audioData.audio->getByteCount() : 1);
         }
 
-        bool Cache::containsAudio(const std::string& key) const
+        bool Cache::containsAudio(const CacheKey& key) const
         {
             TLRENDER_P();
             std::unique_lock<std::mutex> lock(p.mutex);
             return p.audio.contains(key);
         }
 
-        bool Cache::getAudio(const std::string& key, AudioData& audioData) const
+        bool Cache::getAudio(const CacheKey& key, AudioData& audioData) const
         {
             TLRENDER_P();
             std::unique_lock<std::mutex> lock(p.mutex);
             return p.audio.get(key, audioData);
         }
 
+        uint64_t Cache::addOwner()
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return ++p.ownerID;
+        }
+
+        void Cache::removeOwner(uint64_t owner)
+        {
+            unpinAll(owner);
+        }
+
+        bool Cache::pin(uint64_t owner, const std::shared_ptr<image::Image>& image)
+        {
+            TLRENDER_P();
+            if (!image)
+                return false;
+            std::unique_lock<std::mutex> lock(p.mutex);
+            auto i = p.pins.find(image.get());
+            if (i == p.pins.end())
+            {
+                Private::Pin pin;
+                pin.image = image;
+                pin.byteCount = image->getDataByteCount();
+                if (p.pinnedSize + pin.byteCount > _getPinnedMax())
+                {
+                    return false;
+                }
+
+                // Move the video out of the LRU cache.
+                const auto j = p.videoKeys.find(image.get());
+                if (j != p.videoKeys.end())
+                {
+                    VideoData videoData;
+                    if (p.video.get(j->second, videoData) && videoData.image == image)
+                    {
+                        p.video.remove(j->second);
+                        p.pinnedVideo[j->second] = videoData;
+                        pin.keys.push_back(j->second);
+                    }
+                    p.videoKeys.erase(j);
+                }
+
+                p.pinnedSize += pin.byteCount;
+                i = p.pins.insert(std::make_pair(image.get(), pin)).first;
+                _maxUpdate();
+            }
+            ++(i->second.owners[owner]);
+            return true;
+        }
+
+        void Cache::unpin(uint64_t owner, const std::shared_ptr<image::Image>& image)
+        {
+            TLRENDER_P();
+            if (!image)
+                return;
+            std::unique_lock<std::mutex> lock(p.mutex);
+            const auto i = p.pins.find(image.get());
+            if (i != p.pins.end())
+            {
+                const auto j = i->second.owners.find(owner);
+                if (j != i->second.owners.end())
+                {
+                    --(j->second);
+                    if (0 == j->second)
+                    {
+                        i->second.owners.erase(j);
+                    }
+                }
+                if (i->second.owners.empty())
+                {
+                    _release(image.get());
+                }
+            }
+        }
+
+        void Cache::unpinAll(uint64_t owner)
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            std::vector<const image::Image*> released;
+            for (auto& i : p.pins)
+            {
+                i.second.owners.erase(owner);
+                if (i.second.owners.empty())
+                {
+                    released.push_back(i.first);
+                }
+            }
+            for (const auto i : released)
+            {
+                _release(i);
+            }
+        }
+
         void Cache::clear()
         {
             TLRENDER_P();
             std::unique_lock<std::mutex> lock(p.mutex);
             p.video.clear();
             p.audio.clear();
+            p.videoKeys.clear();
+            p.pinnedVideo.clear();
+            for (auto& i : p.pins)
+            {
+                i.second.keys.clear();
+            }
+        }
+
+        size_t Cache::_getPinnedMax() const
+        {
+            TLRENDER_P();
+            const size_t audioMax = p.max * .1F;
+            return p.max - audioMax;
         }
 
         void Cache::_maxUpdate()
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            p.video.setMax(p.max * .9F);
-            p.audio.setMax(p.max * .1F);
+            const size_t videoMax = _getPinnedMax();
+            p.video.setMax(videoMax - std::min(videoMax, p.pinnedSize));
+            p.audio.setMax(p.max - videoMax);
+        }
+
+        void Cache::_release(const image::Image* image)
+        {
+            TLRENDER_P();
+            const auto i = p.pins.find(image);
+            if (i != p.pins.end())
+            {
+                const size_t byteCount = i->second.byteCount;
+                const std::vector<CacheKey> keys = i->second.keys;
+                p.pinnedSize -= std::min(p.pinnedSize, byteCount);
+                p.pins.erase(i);
+                _maxUpdate();
+
+                // Move the video back to the LRU cache.
+                for (const auto& key : keys)
+                {
+                    const auto j = p.pinnedVideo.find(key);
+                    if (j != p.pinnedVideo.end())
+                    {
+                        p.video.add(key, j->second, byteCount);
+                        p.videoKeys[image] = key;
+                        p.pinnedVideo.erase(j);
+                    }
+                }
+            }
         }
     }
 }
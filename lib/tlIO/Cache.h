@@ -31,7 +31,70 @@ namespace tl
             const Options& initOptions,
             const Options& frameOptions);
 
+        //! I/O cache key.
+        //!
+        //! Cache keys are small values that can be created without
+        //! allocating memory. The path is replaced by an interned ID, the
+        //! options are replaced by a hash, and the hash of the key is
+        //! computed up front so that comparisons can check it first.
+        struct CacheKey
+        {
+            CacheKey();
+            CacheKey(
+                uint64_t pathID,
+                const otime::RationalTime&,
+                uint64_t optionsHash);
+            CacheKey(
+                uint64_t pathID,
+                const otime::TimeRange&,
+                uint64_t optionsHash);
+
+            uint64_t pathID      = 0;
+            double   value       = 0.0;
+            double   duration    = 0.0;
+            double   rate        = 0.0;
+            uint64_t optionsHash = 0;
+            uint64_t hash        = 0;
+
+            bool operator == (const CacheKey&) const;
+            bool operator != (const CacheKey&) const;
+            bool operator < (const CacheKey&) const;
+        };
+
+        //! Get the interned ID for a path. The ID is the same for paths
+        //! that are equal.
+        uint64_t getPathID(const file::Path&);
+
+        //! Get a 64-bit hash of options. The "Direction" hint does not
+        //! change the decoded frames and is not included.
+        uint64_t getOptionsHash(const Options&);
+
+        //! Get a 64-bit hash of options combined with another hash.
+        uint64_t getOptionsHash(uint64_t, const Options&);
+
+        //! Get a video cache key.
+        CacheKey getVideoCacheKey(
+            uint64_t pathID,
+            const otime::RationalTime&,
+            uint64_t initOptionsHash,
+            const Options& frameOptions);
+
+        //! Get an audio cache key.
+        CacheKey getAudioCacheKey(
+            uint64_t pathID,
+            const otime::TimeRange&,
+            uint64_t initOptionsHash,
+            const Options& frameOptions);
+
         //! I/O cache.
+        //!
+        //! The cache is the shared store for decoded frames. Readers add
+        //! frames to the cache, and owners like the timeline player pin the
+        //! images they are holding on to. Pinned images are never evicted
+        //! and are counted against the same maximum size as the rest of the
+        //! cache, so the reported size matches the memory in use. Images
+        //! are no longer pinned once the video part of the maximum size is
+        //! used by pinned images.
         class Cache : public std::enable_shared_from_this<Cache>
         {
             TLRENDER_NON_COPYABLE(Cache);
@@ -59,31 +122,70 @@ namespace tl
             //! Get the current cache size as a percentage.
             float getPercentage() const;
 
+            //! Get the size of the pinned images in bytes.
+            size_t getPinnedSize() const;
+
+            //! Get the maximum size of the pinned images in bytes. This is
+            //! the video part of the maximum cache size.
+            size_t getPinnedMax() const;
+
             //! Add video to the cache.
-            void addVideo(const std::string& key, const VideoData&);
+            void addVideo(const CacheKey&, const VideoData&);
 
             //! Get whether the cache contains video.
-            bool containsVideo(const std::string& key) const;
+            bool containsVideo(const CacheKey&) const;
 
             //! Get video from the cache.
-            bool getVideo(const std::string& key, VideoData&) const;
+            bool getVideo(const CacheKey&, VideoData&) const;
 
             //! Add audio to the cache.
-            void addAudio(const std::string& key, const AudioData&);
+            void addAudio(const CacheKey&, const AudioData&);
 
             //! Get whether the cache contains audio.
-            bool containsAudio(const std::string& key) const;
+            bool containsAudio(const CacheKey&) const;
 
             //! Get audio from the cache.
-            bool getAudio(const std::string& key, AudioData&) const;
+            bool getAudio(const CacheKey&, AudioData&) const;
+
+            //! Add an owner. Owners pin images so that they are not
+            //! evicted from the cache.
+            uint64_t addOwner();
+
+            //! Remove an owner and release its pinned images.
+            void removeOwner(uint64_t);
+
+            //! Pin an image. Images are reference counted, an image pinned
+            //! more than once must be unpinned the same number of times.
+            //! Returns false if the image is not pinned because the pinned
+            //! images would go over the maximum size.
+            bool pin(uint64_t owner, const std::shared_ptr<image::Image>&);
+
+            //! Unpin an image.
+            void unpin(uint64_t owner, const std::shared_ptr<image::Image>&);
 
-            //! Clear the cache.
+            //! Unpin all of the images for an owner.
+            void unpinAll(uint64_t owner);
+
+            //! Clear the cache. Pinned images are not affected.
             void clear();
 
         private:
+            size_t _getPinnedMax() const;
             void _maxUpdate();
+            void _release(const image::Image*);
 
             TLRENDER_PRIVATE();
         };
     }
 }
+
+namespace std
+{
+    template<>
+    struct hash<tl::io::CacheKey>
+    {
+        std::size_t operator() (const tl::io::CacheKey&) const noexcept;
+    };
+}
+
+#include <tlIO/CacheInline.h>
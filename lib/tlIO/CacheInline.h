@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tuple>
+
+namespace tl
+{
+    namespace io
+    {
+        inline bool CacheKey::operator == (const CacheKey& other) const
+        {
+            return
+                hash == other.hash &&
+                pathID == other.pathID &&
+                value == other.value &&
+                duration == other.duration &&
+                rate == other.rate &&
+                optionsHash == other.optionsHash;
+        }
+
+        inline bool CacheKey::operator != (const CacheKey& other) const
+        {
+            return !(*this == other);
+        }
+
+        inline bool CacheKey::operator < (const CacheKey& other) const
+        {
+            return
+                std::tie(pathID, value, duration, rate, optionsHash) <
+                std::tie(other.pathID, other.value, other.duration, other.rate, other.optionsHash);
+        }
+    }
+}
+
+namespace std
+{
+    inline std::size_t hash<tl::io::CacheKey>::operator() (
+        const tl::io::CacheKey& value) const noexcept
+    {
+        return value.hash;
+    }
+}
@@ -10,6 +10,7 @@
 #include <tlCore/StringFormat.h>
 
 #include <array>
+#include <cstddef>
 #include <cstring>
 #include <sstream>
 
@@ -210,6 +211,47 @@ namespace tl
                     *in < _floatMax;
             }
 
+            //! Set the tags that can change per frame. Tags that are not
+            //! valid are removed.
+            void frameTags(const Header& header, image::Tags& tags)
+            {
+                if (cineon::isValid(header.file.time, 24))
+                {
+                    tags["Time"] = cineon::toString(header.file.time, 24);
+                }
+                else
+                {
+                    tags.erase("Time");
+                }
+                if (isValid(&header.film.id) &&
+                    isValid(&header.film.type) &&
+                    isValid(&header.film.offset) &&
+                    isValid(&header.film.prefix) &&
+                    isValid(&header.film.count))
+                {
+                    tags["Keycode"] = time::keycodeToString(
+                        header.film.id,
+                        header.film.type,
+                        header.film.prefix,
+                        header.film.count,
+                        header.film.offset);
+                }
+                else
+                {
+                    tags.erase("Keycode");
+                }
+                if (isValid(&header.film.frame))
+                {
+                    std::stringstream ss;
+                    ss << header.film.frame;
+                    tags["Film Frame"] = ss.str();
+                }
+                else
+                {
+                    tags.erase("Film Frame");
+                }
+            }
+
         } // namespace
 
         Header read(const std::shared_ptr<file::FileIO>& io, io::Info& info)
@@ -339,10 +381,6 @@ namespace tl
             info.video.push_back(imageInfo);
 
             // Tags.
-            if (isValid(out.file.time, 24))
-            {
-                info.tags["Time"] = toString(out.file.time, 24);
-            }
             if (isValid(&out.source.offset[0]) && isValid(&out.source.offset[1]))
             {
                 std::stringstream ss;
@@ -381,29 +419,10 @@ namespace tl
                 ss << out.source.gamma;
                 info.tags["Source Gamma"] = ss.str();
             }
-            if (isValid(&out.film.id) &&
-                isValid(&out.film.type) &&
-                isValid(&out.film.offset) &&
-                isValid(&out.film.prefix) &&
-                isValid(&out.film.count))
-            {
-                info.tags["Keycode"] = time::keycodeToString(
-                    out.film.id,
-                    out.film.type,
-                    out.film.prefix,
-                    out.film.count,
-                    out.film.offset);
-            }
             if (isValid(out.film.format, 32))
             {
                 info.tags["Film Format"] = toString(out.film.format, 32);
             }
-            if (isValid(&out.film.frame))
-            {
-                std::stringstream ss;
-                ss << out.film.frame;
-                info.tags["Film Frame"] = ss.str();
-            }
             if (isValid(&out.film.frameRate) && out.film.frameRate >= _minSpeed)
             {
                 std::stringstream ss;
@@ -419,6 +438,8 @@ namespace tl
                 info.tags["Film Slate"] = toString(out.film.slate, 200);
             }
 
+            frameTags(out, info.tags);
+
             // Set the file position.
             if (out.file.imageOffset)
             {
@@ -428,6 +449,34 @@ namespace tl
             return out;
         }
 
+        std::vector<math::SizeTRange> getFrameRanges()
+        {
+            const size_t film = sizeof(Header::File) + sizeof(Header::Image) + sizeof(Header::Source);
+            return
+            {
+                math::SizeTRange(offsetof(Header::File, name), offsetof(Header::File, pad) - 1),
+                math::SizeTRange(film + offsetof(Header::Film, offset), film + offsetof(Header::Film, format) - 1),
+                math::SizeTRange(film + offsetof(Header::Film, frame), film + offsetof(Header::Film, frameRate) - 1)
+            };
+        }
+
+        void updateFrameTags(const uint8_t* data, image::Tags& tags)
+        {
+            Header header;
+            std::memcpy(&header.file, data, sizeof(Header::File));
+            data += sizeof(Header::File);
+            std::memcpy(&header.image, data, sizeof(Header::Image));
+            data += sizeof(Header::Image);
+            std::memcpy(&header.source, data, sizeof(Header::Source));
+            data += sizeof(Header::Source);
+            std::memcpy(&header.film, data, sizeof(Header::Film));
+            if (magic[1] == header.file.magic)
+            {
+                cineon::convertEndian(header);
+            }
+            frameTags(header, tags);
+        }
+
         void write(const std::shared_ptr<file::FileIO>& io, const io::Info& info)
         {
             Header header;
@@ -591,12 +640,14 @@ namespace tl
 
         void Plugin::_init(
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             IPlugin::_init(
                 "Cineon",
                 { { ".cin", io::FileType::Sequence } },
                 cache,
+                decodePool,
                 logSystem);
         }
 
@@ -605,10 +656,11 @@ namespace tl
 
         std::shared_ptr<Plugin> Plugin::create(
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             auto out = std::shared_ptr<Plugin>(new Plugin);
-            out->_init(cache, logSystem);
+            out->_init(cache, decodePool, logSystem);
             return out;
         }
 
@@ -616,7 +668,7 @@ namespace tl
             const file::Path& path,
             const io::Options& options)
         {
-            return Read::create(path, options, _cache, _logSystem);
+            return Read::create(path, options, _cache, _decodePool, _logSystem);
         }
 
         std::shared_ptr<io::IRead> Plugin::read(
@@ -624,7 +676,7 @@ namespace tl
             const std::vector<file::MemoryRead>& memory,
             const io::Options& options)
         {
-            return Read::create(path, memory, options, _cache, _logSystem);
+            return Read::create(path, memory, options, _cache, _decodePool, _logSystem);
         }
 
         image::Info Plugin::getWriteInfo(
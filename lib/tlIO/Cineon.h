@@ -166,6 +166,15 @@ namespace tl
         //! Read a header.
         Header read(const std::shared_ptr<file::FileIO>&, io::Info&);
 
+        //! Get the header byte ranges that can change between the frames of
+        //! a sequence: the file name and time, the keycode, and the film
+        //! frame.
+        std::vector<math::SizeTRange> getFrameRanges();
+
+        //! Update the tags that can change between the frames of a sequence
+        //! from the header bytes.
+        void updateFrameTags(const uint8_t*, image::Tags&);
+
         //! Write a header.
         void write(const std::shared_ptr<file::FileIO>&, const io::Info&);
 
@@ -181,6 +190,7 @@ namespace tl
                 const std::vector<file::MemoryRead>&,
                 const io::Options&,
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
             Read();
@@ -193,6 +203,7 @@ namespace tl
                 const file::Path&,
                 const io::Options&,
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
             //! Create a new reader.
@@ -201,6 +212,7 @@ namespace tl
                 const std::vector<file::MemoryRead>&,
                 const io::Options&,
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
         protected:
@@ -212,6 +224,14 @@ namespace tl
                 const file::MemoryRead*,
                 const otime::RationalTime&,
                 const io::Options&) override;
+            void _parseHeader(
+                const std::shared_ptr<file::FileIO>&,
+                io::SequenceHeader&) override;
+            void _updateHeader(io::SequenceHeader&) override;
+            bool _getBatchInfo(
+                const std::string& fileName,
+                const io::Options&,
+                io::SequenceBatchInfo&) override;
         };
 
         //! Cineon writer.
@@ -250,6 +270,7 @@ namespace tl
         protected:
             void _init(
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
             Plugin();
@@ -258,6 +279,7 @@ namespace tl
             //! Create a new plugin.
             static std::shared_ptr<Plugin> create(
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
             std::shared_ptr<io::IRead> read(
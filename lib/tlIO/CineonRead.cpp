@@ -17,9 +17,10 @@ namespace tl
             const std::vector<file::MemoryRead>& memory,
             const io::Options& options,
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
-            ISequenceRead::_init(path, memory, options, cache, logSystem);
+            ISequenceRead::_init(path, memory, options, cache, decodePool, logSystem);
         }
 
         Read::Read()
@@ -34,10 +35,11 @@ namespace tl
             const file::Path& path,
             const io::Options& options,
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             auto out = std::shared_ptr<Read>(new Read);
-            out->_init(path, {}, options, cache, logSystem);
+            out->_init(path, {}, options, cache, decodePool, logSystem);
             return out;
         }
 
@@ -46,10 +48,11 @@ namespace tl
             const std::vector<file::MemoryRead>& memory,
             const io::Options& options,
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             auto out = std::shared_ptr<Read>(new Read);
-            out->_init(path, memory, options, cache, logSystem);
+            out->_init(path, memory, options, cache, decodePool, logSystem);
             return out;
         }
 
@@ -57,11 +60,10 @@ namespace tl
             const std::string& fileName,
             const file::MemoryRead* memory)
         {
-            io::Info out;
-            auto io = memory ?
-                file::FileIO::create(fileName, *memory) :
-                file::FileIO::create(fileName, file::Mode::Read);
-            const auto header = read(io, out);
+            auto io = _openFile(fileName, memory);
+            io::SequenceHeader header;
+            _readHeader(io, header);
+            io::Info out = header.info;
             float speed = _defaultSpeed;
             const auto i = out.tags.find("Film Frame Rate");
             if (i != out.tags.end())
@@ -78,21 +80,48 @@ namespace tl
             const std::string& fileName,
             const file::MemoryRead* memory,
             const otime::RationalTime& time,
-            const io::Options&)
+            const io::Options& options)
         {
             io::VideoData out;
             out.time = time;
 
-            auto io = memory ?
-                file::FileIO::create(fileName, *memory) :
-                file::FileIO::create(fileName, file::Mode::Read);
-            io::Info info;
-            read(io, info);
+            auto io = _openFile(fileName, memory);
+            io::SequenceHeader header;
+            _readHeader(io, header);
 
-            out.image = image::Image::create(info.video[0]);
-            out.image->setTags(info.tags);
-            io->read(out.image->getData(), image::getDataByteCount(info.video[0]));
+            out.image = _readImage(io, header.info.video[0], io::getProxyLevel(options));
+            out.image->setTags(std::move(header.info.tags));
             return out;
         }
+
+        void Read::_parseHeader(
+            const std::shared_ptr<file::FileIO>& io,
+            io::SequenceHeader& out)
+        {
+            read(io, out.info);
+            out.size = sizeof(Header::File) + sizeof(Header::Image) +
+                sizeof(Header::Source) + sizeof(Header::Film);
+            out.frameRanges = getFrameRanges();
+            out.offset = io->getPos();
+        }
+
+        void Read::_updateHeader(io::SequenceHeader& header)
+        {
+            updateFrameTags(header.data.data(), header.info.tags);
+        }
+
+        bool Read::_getBatchInfo(
+            const std::string& fileName,
+            const io::Options&,
+            io::SequenceBatchInfo& out)
+        {
+            auto io = file::FileIO::create(fileName, file::Mode::Read, file::ReadType::Normal);
+            io::SequenceHeader header;
+            _readHeader(io, header);
+            out.info = header.info.video[0];
+            out.tags = std::move(header.info.tags);
+            out.offset = header.offset;
+            return true;
+        }
     }
 }
@@ -11,6 +11,7 @@
 #include <tlCore/StringFormat.h>
 
 #include <array>
+#include <cstddef>
 #include <cstring>
 #include <sstream>
 
@@ -180,6 +181,53 @@ namespace tl
             {
                 return *(reinterpret_cast<const uint32_t*>(in)) != 0xffffffff;
             }
+
+            //! Set the tags that can change per frame. Tags that are not
+            //! valid are removed.
+            void frameTags(const Header& header, image::Tags& tags)
+            {
+                if (cineon::isValid(header.file.time, 24))
+                {
+                    tags["Time"] = cineon::toString(header.file.time, 24);
+                }
+                else
+                {
+                    tags.erase("Time");
+                }
+                if (cineon::isValid(header.film.id, 2) && cineon::isValid(header.film.type, 2) &&
+                    cineon::isValid(header.film.offset, 2) && cineon::isValid(header.film.prefix, 6) &&
+                    cineon::isValid(header.film.count, 4))
+                {
+                    tags["Keycode"] = time::keycodeToString(
+                        std::stoi(std::string(header.film.id, 2)),
+                        std::stoi(std::string(header.film.type, 2)),
+                        std::stoi(std::string(header.film.prefix, 6)),
+                        std::stoi(std::string(header.film.count, 4)),
+                        std::stoi(std::string(header.film.offset, 2)));
+                }
+                else
+                {
+                    tags.erase("Keycode");
+                }
+                if (isValid(&header.film.frame))
+                {
+                    std::stringstream ss;
+                    ss << header.film.frame;
+                    tags["Film Frame"] = ss.str();
+                }
+                else
+                {
+                    tags.erase("Film Frame");
+                }
+                if (isValid(&header.tv.timecode))
+                {
+                    tags["Timecode"] = time::timecodeToString(header.tv.timecode);
+                }
+                else
+                {
+                    tags.erase("Timecode");
+                }
+            }
         }
 
         Header read(
@@ -329,10 +377,6 @@ namespace tl
             info.video.push_back(imageInfo);
 
             // Tags.
-            if (cineon::isValid(out.file.time, 24))
-            {
-                info.tags["Time"] = cineon::toString(out.file.time, 24);
-            }
             if (cineon::isValid(out.file.creator, 100))
             {
                 info.tags["Creator"] = cineon::toString(out.file.creator, 100);
@@ -403,27 +447,10 @@ namespace tl
                 info.tags["Source Scan Size"] = ss.str();
             }
 
-            if (cineon::isValid(out.film.id, 2) && cineon::isValid(out.film.type, 2) &&
-                cineon::isValid(out.film.offset, 2) && cineon::isValid(out.film.prefix, 6) &&
-                cineon::isValid(out.film.count, 4))
-            {
-                info.tags["Keycode"] = time::keycodeToString(
-                    std::stoi(std::string(out.film.id, 2)),
-                    std::stoi(std::string(out.film.type, 2)),
-                    std::stoi(std::string(out.film.prefix, 6)),
-                    std::stoi(std::string(out.film.count, 4)),
-                    std::stoi(std::string(out.film.offset, 2)));
-            }
             if (cineon::isValid(out.film.format, 32))
             {
                 info.tags["Film Format"] = cineon::toString(out.film.format, 32);
             }
-            if (isValid(&out.film.frame))
-            {
-                std::stringstream ss;
-                ss << out.film.frame;
-                info.tags["Film Frame"] = ss.str();
-            }
             if (isValid(&out.film.sequence))
             {
                 std::stringstream ss;
@@ -457,10 +484,6 @@ namespace tl
                 info.tags["Film Slate"] = cineon::toString(out.film.slate, 100);
             }
 
-            if (isValid(&out.tv.timecode))
-            {
-                info.tags["Timecode"] = time::timecodeToString(out.tv.timecode);
-            }
             if (isValid(&out.tv.interlace))
             {
                 std::stringstream ss;
@@ -534,6 +557,8 @@ namespace tl
                 info.tags["TV Integration Times"] = ss.str();
             }
 
+            frameTags(out, info.tags);
+
             // Set the file position.
             if (out.file.imageOffset)
             {
@@ -543,6 +568,41 @@ namespace tl
             return out;
         }
 
+        std::vector<math::SizeTRange> getFrameRanges()
+        {
+            const size_t film = sizeof(Header::File) + sizeof(Header::Image) + sizeof(Header::Source);
+            const size_t tv = film + sizeof(Header::Film);
+            return
+            {
+                math::SizeTRange(offsetof(Header::File, name), offsetof(Header::File, creator) - 1),
+                math::SizeTRange(film + offsetof(Header::Film, offset), film + offsetof(Header::Film, format) - 1),
+                math::SizeTRange(film + offsetof(Header::Film, frame), film + offsetof(Header::Film, sequence) - 1),
+                math::SizeTRange(tv + offsetof(Header::TV, timecode), tv + offsetof(Header::TV, interlace) - 1)
+            };
+        }
+
+        void updateFrameTags(const uint8_t* data, image::Tags& tags)
+        {
+            Header header;
+            std::memcpy(&header.file, data, sizeof(Header::File));
+            data += sizeof(Header::File);
+            std::memcpy(&header.image, data, sizeof(Header::Image));
+            data += sizeof(Header::Image);
+            std::memcpy(&header.source, data, sizeof(Header::Source));
+            data += sizeof(Header::Source);
+            std::memcpy(&header.film, data, sizeof(Header::Film));
+            data += sizeof(Header::Film);
+            std::memcpy(&header.tv, data, sizeof(Header::TV));
+            const memory::Endian fileEndian = 0 == memcmp(&header.file.magic, magic[0], 4) ?
+                memory::Endian::MSB :
+                memory::Endian::LSB;
+            if (fileEndian != memory::getEndian())
+            {
+                convertEndian(header);
+            }
+            frameTags(header, tags);
+        }
+
         void write(
             const std::shared_ptr<file::FileIO>& io,
             const io::Info& info,
@@ -893,12 +953,14 @@ namespace tl
 
         void Plugin::_init(
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             IPlugin::_init(
                 "DPX",
                 { { ".dpx", io::FileType::Sequence } },
                 cache,
+                decodePool,
                 logSystem);
         }
 
@@ -907,10 +969,11 @@ namespace tl
 
         std::shared_ptr<Plugin> Plugin::create(
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             auto out = std::shared_ptr<Plugin>(new Plugin);
-            out->_init(cache, logSystem);
+            out->_init(cache, decodePool, logSystem);
             return out;
         }
 
@@ -918,7 +981,7 @@ namespace tl
             const file::Path& path,
             const io::Options& options)
         {
-            return Read::create(path, options, _cache, _logSystem);
+            return Read::create(path, options, _cache, _decodePool, _logSystem);
         }
 
         std::shared_ptr<io::IRead> Plugin::read(
@@ -926,7 +989,7 @@ namespace tl
             const std::vector<file::MemoryRead>& memory,
             const io::Options& options)
         {
-            return Read::create(path, memory, options, _cache, _logSystem);
+            return Read::create(path, memory, options, _cache, _decodePool, _logSystem);
         }
 
         image::Info Plugin::getWriteInfo(
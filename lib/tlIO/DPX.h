@@ -284,6 +284,15 @@ namespace tl
             io::Info&,
             Transfer&);
 
+        //! Get the header byte ranges that can change between the frames of
+        //! a sequence: the file name and time, the keycode, the film frame,
+        //! and the timecode.
+        std::vector<math::SizeTRange> getFrameRanges();
+
+        //! Update the tags that can change between the frames of a sequence
+        //! from the header bytes.
+        void updateFrameTags(const uint8_t*, image::Tags&);
+
         //! Write a header.
         void write(
             const std::shared_ptr<file::FileIO>&,
@@ -304,6 +313,7 @@ namespace tl
                 const std::vector<file::MemoryRead>&,
                 const io::Options&,
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
             Read();
@@ -316,6 +326,7 @@ namespace tl
                 const file::Path&,
                 const io::Options&,
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
             //! Create a new reader.
@@ -324,6 +335,7 @@ namespace tl
                 const std::vector<file::MemoryRead>&,
                 const io::Options&,
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
         protected:
@@ -335,6 +347,14 @@ namespace tl
                 const file::MemoryRead*,
                 const otime::RationalTime&,
                 const io::Options&) override;
+            void _parseHeader(
+                const std::shared_ptr<file::FileIO>&,
+                io::SequenceHeader&) override;
+            void _updateHeader(io::SequenceHeader&) override;
+            bool _getBatchInfo(
+                const std::string& fileName,
+                const io::Options&,
+                io::SequenceBatchInfo&) override;
         };
 
         //! DPX writer.
@@ -373,6 +393,7 @@ namespace tl
         protected:
             void _init(
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
             Plugin();
@@ -381,6 +402,7 @@ namespace tl
             //! Create a new plugin.
             static std::shared_ptr<Plugin> create(
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
             std::shared_ptr<io::IRead> read(
@@ -0,0 +1,326 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlIO/DecodePool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tl
+{
+    namespace io
+    {
+        namespace
+        {
+            struct Task
+            {
+                uint64_t client = 0;
+                int64_t priority = 0;
+                uint64_t sequence = 0;
+                std::function<void(void)> func;
+            };
+
+            struct Worker
+            {
+                std::vector<Task> tasks;
+                std::mutex mutex;
+                std::thread thread;
+            };
+
+            bool popTask(Worker& worker, Task& task)
+            {
+                bool out = false;
+                std::unique_lock<std::mutex> lock(worker.mutex);
+                if (!worker.tasks.empty())
+                {
+                    auto i = std::min_element(
+                        worker.tasks.begin(),
+                        worker.tasks.end(),
+                        [](const Task& a, const Task& b)
+                        {
+                            return a.priority < b.priority ||
+                                (a.priority == b.priority && a.sequence < b.sequence);
+                        });
+                    task = std::move(*i);
+                    worker.tasks.erase(i);
+                    out = true;
+                }
+                return out;
+            }
+
+            thread_local const void* currentPool = nullptr;
+            thread_local size_t currentWorker = 0;
+        }
+
+        struct DecodePool::Private
+        {
+            std::vector<std::unique_ptr<Worker> > workers;
+            std::atomic<size_t> pending;
+            std::atomic<size_t> active;
+            std::atomic<uint64_t> sequence;
+            std::atomic<size_t> nextWorker;
+
+            struct Client
+            {
+                //! The number of queued and running tasks.
+                size_t tasks = 0;
+                bool removed = false;
+            };
+
+            struct Mutex
+            {
+                uint64_t clientID = 0;
+                std::map<uint64_t, Client> clients;
+                size_t lent = 0;
+                bool running = true;
+                std::condition_variable cv;
+                std::condition_variable clientCV;
+                std::mutex mutex;
+            };
+            Mutex mutex;
+        };
+
+        void DecodePool::_init(size_t threadCount)
+        {
+            TLRENDER_P();
+            if (0 == threadCount)
+            {
+                threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+            }
+            p.pending = 0;
+            p.active = 0;
+            p.sequence = 0;
+            p.nextWorker = 0;
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                p.workers.push_back(std::unique_ptr<Worker>(new Worker));
+            }
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                p.workers[i]->thread = std::thread(
+                    [this, i]
+                    {
+                        _run(i);
+                    });
+            }
+        }
+
+        DecodePool::DecodePool() :
+            _p(new Private)
+        {}
+
+        DecodePool::~DecodePool()
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.running = false;
+            }
+            p.mutex.cv.notify_all();
+            for (auto& worker : p.workers)
+            {
+                if (worker->thread.joinable())
+                {
+                    worker->thread.join();
+                }
+            }
+        }
+
+        std::shared_ptr<DecodePool> DecodePool::create(size_t threadCount)
+        {
+            auto out = std::shared_ptr<DecodePool>(new DecodePool);
+            out->_init(threadCount);
+            return out;
+        }
+
+        size_t DecodePool::getThreadCount() const
+        {
+            return _p->workers.size();
+        }
+
+        uint64_t DecodePool::addClient()
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            const uint64_t out = ++p.mutex.clientID;
+            p.mutex.clients[out] = Private::Client();
+            return out;
+        }
+
+        void DecodePool::removeClient(uint64_t client)
+        {
+            TLRENDER_P();
+
+            // Stop accepting new tasks for the client.
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            auto i = p.mutex.clients.find(client);
+            if (i == p.mutex.clients.end() || i->second.removed)
+                return;
+            i->second.removed = true;
+
+            // Discard the pending tasks.
+            size_t removed = 0;
+            for (auto& worker : p.workers)
+            {
+                std::unique_lock<std::mutex> workerLock(worker->mutex);
+                const auto j = std::remove_if(
+                    worker->tasks.begin(),
+                    worker->tasks.end(),
+                    [client](const Task& value)
+                    {
+                        return value.client == client;
+                    });
+                removed += worker->tasks.end() - j;
+                worker->tasks.erase(j, worker->tasks.end());
+            }
+            p.pending -= removed;
+            i->second.tasks -= std::min(i->second.tasks, removed);
+
+            // Wait for the running tasks.
+            p.mutex.clientCV.wait(
+                lock,
+                [this, client]
+                {
+                    return 0 == _p->mutex.clients[client].tasks;
+                });
+            p.mutex.clients.erase(client);
+        }
+
+        bool DecodePool::submit(
+            uint64_t client,
+            int64_t priority,
+            const std::function<void(void)>& func)
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                const auto i = p.mutex.clients.find(client);
+                if (!p.mutex.running || i == p.mutex.clients.end() || i->second.removed)
+                    return false;
+                ++(i->second.tasks);
+
+                // Tasks submitted from a worker thread go to that worker's
+                // queue, otherwise they are distributed round-robin.
+                const size_t index = currentPool == this ?
+                    currentWorker :
+                    (p.nextWorker++ % p.workers.size());
+                Task task;
+                task.client = client;
+                task.priority = priority;
+                task.sequence = p.sequence++;
+                task.func = func;
+                {
+                    std::unique_lock<std::mutex> workerLock(p.workers[index]->mutex);
+                    p.workers[index]->tasks.push_back(std::move(task));
+                }
+                ++p.pending;
+            }
+            p.mutex.cv.notify_one();
+            return true;
+        }
+
+        size_t DecodePool::getPendingCount() const
+        {
+            return _p->pending;
+        }
+
+        size_t DecodePool::getActiveCount() const
+        {
+            return _p->active;
+        }
+
+        size_t DecodePool::lendThreads(size_t count)
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            const size_t busy = p.active + p.pending + p.mutex.lent;
+            const size_t idle = p.workers.size() > busy ? p.workers.size() - busy : 0;
+            const size_t out = std::min(count, idle);
+            p.mutex.lent += out;
+            return out;
+        }
+
+        void DecodePool::returnThreads(size_t count)
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.lent -= std::min(p.mutex.lent, count);
+            }
+            p.mutex.cv.notify_all();
+        }
+
+        size_t DecodePool::getLentCount() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            return p.mutex.lent;
+        }
+
+        void DecodePool::_run(size_t index)
+        {
+            TLRENDER_P();
+            currentPool = this;
+            currentWorker = index;
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    // Hold the task back while there are not enough
+                    // threads that are not lent.
+                    p.mutex.cv.wait(
+                        lock,
+                        [this]
+                        {
+                            return !_p->mutex.running ||
+                                (_p->pending > 0 &&
+                                    _p->active + _p->mutex.lent < _p->workers.size());
+                        });
+                    if (!p.mutex.running)
+                        break;
+                    ++p.active;
+                }
+
+                // Take a task from our own queue first, then steal from the
+                // other workers.
+                Task task;
+                bool found = popTask(*p.workers[index], task);
+                for (size_t i = 1; !found && i < p.workers.size(); ++i)
+                {
+                    found = popTask(*p.workers[(index + i) % p.workers.size()], task);
+                }
+                if (!found)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                        --p.active;
+                    }
+                    p.mutex.cv.notify_one();
+                    std::this_thread::yield();
+                    continue;
+                }
+                --p.pending;
+
+                task.func();
+
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    auto i = p.mutex.clients.find(task.client);
+                    if (i != p.mutex.clients.end() && i->second.tasks > 0)
+                    {
+                        --(i->second.tasks);
+                    }
+                    --p.active;
+                }
+                p.mutex.clientCV.notify_all();
+                p.mutex.cv.notify_one();
+            }
+        }
+    }
+}
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Util.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace tl
+{
+    namespace io
+    {
+        //! Decode thread pool.
+        //!
+        //! The pool is shared by all of the readers in a process. Each
+        //! worker thread has its own queue of tasks, and idle workers steal
+        //! tasks from the other queues. Tasks are submitted on behalf of a
+        //! client (usually a reader), and the tasks with the lowest priority
+        //! values run first.
+        class DecodePool : public std::enable_shared_from_this<DecodePool>
+        {
+            TLRENDER_NON_COPYABLE(DecodePool);
+
+        protected:
+            void _init(size_t threadCount);
+
+            DecodePool();
+
+        public:
+            ~DecodePool();
+
+            //! Create a new decode pool. If the thread count is zero the
+            //! hardware concurrency is used.
+            static std::shared_ptr<DecodePool> create(size_t threadCount = 0);
+
+            //! Get the number of threads.
+            size_t getThreadCount() const;
+
+            //! Add a client.
+            uint64_t addClient();
+
+            //! Remove a client. Pending tasks for the client are discarded,
+            //! and this function blocks until the running tasks are
+            //! finished.
+            void removeClient(uint64_t);
+
+            //! Submit a task. Returns false if the client has been removed.
+            bool submit(
+                uint64_t client,
+                int64_t priority,
+                const std::function<void(void)>&);
+
+            //! Get the number of pending tasks.
+            size_t getPendingCount() const;
+
+            //! Get the number of running tasks.
+            size_t getActiveCount() const;
+
+            //! Lend up to the given number of idle threads, for example to
+            //! decode a file with threads outside of the pool. Threads that
+            //! are running or will run the pending tasks are not idle. The
+            //! pool runs fewer tasks while threads are lent. Returns the
+            //! number of threads lent.
+            size_t lendThreads(size_t);
+
+            //! Return lent threads.
+            void returnThreads(size_t);
+
+            //! Get the number of lent threads.
+            size_t getLentCount() const;
+
+        private:
+            void _run(size_t);
+
+            TLRENDER_PRIVATE();
+        };
+    }
+}
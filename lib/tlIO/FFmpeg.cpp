@@ -189,6 +189,7 @@ namespace tl
                     { ".aiff", io::FileType::Audio }
                 },
                 cache,
+                nullptr,
                 logSystem);
 
             _logSystemWeak = logSystem;
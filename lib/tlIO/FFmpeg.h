@@ -6,6 +6,7 @@
 
 #include <tlIO/Plugin.h>
 
+#include <tlCore/FilePrefetch.h>
 #include <tlCore/HDR.h>
 
 extern "C"
@@ -39,6 +40,13 @@ namespace tl
         //! Number of threads.
         const size_t threadCount = 0;
 
+        //! Number of threads used to convert images for asynchronous
+        //! writing.
+        const size_t writeThreadCount = 4;
+
+        //! Maximum number of images queued for asynchronous writing.
+        const size_t writeQueueSize = 8;
+
         //! Software scaler flags.
         const int swsScaleFlags = SWS_FAST_BILINEAR;
 
@@ -70,7 +78,50 @@ namespace tl
         //! Get a label for a FFmpeg error code.
         std::string getErrorLabel(int);
 
+        //! FFmpeg reader statistics.
+        struct ReadStats
+        {
+            size_t videoRequests = 0; //!< Video frames requested
+            size_t videoDecoded  = 0; //!< Video frames decoded
+            size_t videoSeeks    = 0; //!< Video seeks
+
+            //! Get the number of decoded frames per requested frame.
+            float getDecodedPerRequest() const;
+
+            bool operator == (const ReadStats&) const;
+            bool operator != (const ReadStats&) const;
+        };
+
         //! FFmpeg reader
+        //!
+        //! Long-GOP movies are indexed ("FFmpeg/Index"), so seeks land on the
+        //! keyframe of the requested frame, and requests within the same GOP
+        //! are decoded forward without seeking. The index is built in the
+        //! background after the movie is opened, and seeks use the demuxer
+        //! until it is finished. The index is stored in a cache file
+        //! ("FFmpeg/IndexPath", by default in the temporary directory) that
+        //! is checked against the movie size and modification time.
+        //!
+        //! Requests with the "Direction" option set to "Reverse" decode the
+        //! GOP containing the frame forward once, and the following earlier
+        //! frames are served from a buffer. The buffer holds at most
+        //! "FFmpeg/ReverseBufferSize" frames.
+        //!
+        //! A movie can be decoded by more than one decoder
+        //! ("FFmpeg/VideoDecoderCount"), each with its own thread. Requests
+        //! are routed to the decoder that can reach them with the least
+        //! decoding, so independent playheads, like compare and scrubbing,
+        //! don't seek each other's decoder.
+        //!
+        //! Movies on network file systems can be read through a prefetching
+        //! reader ("FFmpeg/Prefetch"), which reads large blocks in the
+        //! background ("FFmpeg/PrefetchBlockSize", "FFmpeg/PrefetchReadAhead",
+        //! and "FFmpeg/PrefetchMaxInFlight"). Seeks prefetch the GOP of the
+        //! requested frame, and reverse playback the GOP before it.
+        //!
+        //! The "Proxy" option is ignored. Most codecs can not decode a lower
+        //! resolution, and filtering the frames on the decoder thread is
+        //! slower than drawing them at full resolution.
         class Read : public io::IRead
         {
         protected:
@@ -105,13 +156,32 @@ namespace tl
             std::future<io::VideoData> readVideo(
                 const otime::RationalTime&,
                 const io::Options& = io::Options()) override;
+            std::vector<std::future<io::VideoData> > readVideo(
+                const std::vector<otime::RationalTime>&,
+                const io::Options& = io::Options()) override;
             std::future<io::AudioData> readAudio(
                 const otime::TimeRange&,
                 const io::Options& = io::Options()) override;
             void cancelRequests() override;
 
+            //! Get the statistics of all the video decoders.
+            ReadStats getStats() const;
+
+            //! Get the statistics of each video decoder.
+            std::vector<ReadStats> getDecoderStats() const;
+
+            //! Get the prefetching reader statistics.
+            file::PrefetchStats getPrefetchStats() const;
+
+            //! Get whether the keyframe index is finished, or the movie is
+            //! not indexed. This is valid once the information is
+            //! available.
+            bool isIndexReady() const;
+
         private:
-            void _videoThread();
+            void _updateGOPSize(size_t keyframes);
+            size_t _getVideoDecoder(const otime::RationalTime&, bool reverse) const;
+            void _videoThread(size_t decoder);
             void _audioThread();
             void _cancelVideoRequests();
             void _cancelAudioRequests();
@@ -120,6 +190,19 @@ namespace tl
         };
 
         //! FFmpeg writer.
+        //!
+        //! If the information has audio, an AAC audio stream is added and
+        //! the audio from writeAudio() is resampled to the encoder format
+        //! and interleaved with the video. The audio starts at the time of
+        //! the first writeAudio() call.
+        //!
+        //! With asynchronous writing ("FFmpeg/WriteAsync"), writeVideo()
+        //! queues the image and returns. The images are converted by a pool
+        //! of threads ("FFmpeg/WriteThreadCount") and encoded in order by
+        //! another thread. writeVideo() blocks while the queue is full
+        //! ("FFmpeg/WriteQueueSize"). Images must not be modified after
+        //! they are written. Errors are reported by the following call to
+        //! writeVideo() or finish().
         class Write : public io::IWrite
         {
         protected:
@@ -145,9 +228,24 @@ namespace tl
                 const otime::RationalTime&,
                 const std::shared_ptr<image::Image>&,
                 const io::Options& = io::Options()) override;
+            void writeAudio(
+                const otime::TimeRange&,
+                const std::shared_ptr<audio::Audio>&,
+                const io::Options& = io::Options()) override;
+            void finish() override;
 
         private:
+            void _convert(
+                SwsContext*,
+                const otime::RationalTime&,
+                const std::shared_ptr<image::Image>&,
+                AVFrame*);
             void _encodeVideo(AVFrame*);
+            void _encodeAudio(size_t sampleCount);
+            void _encode(AVCodecContext*, AVStream*, AVPacket*, AVFrame*);
+            void _convertThread(size_t);
+            void _encodeThread();
+            void _stopThreads();
 
             TLRENDER_PRIVATE();
         };
@@ -8,6 +8,8 @@
 #include <tlCore/LogSystem.h>
 #include <tlCore/StringFormat.h>
 
+#include <algorithm>
+
 extern "C"
 {
 #include <libavutil/opt.h>
@@ -26,6 +28,11 @@ namespace tl
             size(size)
         {}
 
+        AVIOBufferData::AVIOBufferData(const std::shared_ptr<file::PrefetchRead>& prefetch) :
+            prefetch(prefetch),
+            size(prefetch->getSize())
+        {}
+
         int avIOBufferRead(void* opaque, uint8_t* buf, int bufSize)
         {
             AVIOBufferData* bufferData = static_cast<AVIOBufferData*>(opaque);
@@ -40,7 +47,21 @@ namespace tl
                 return AVERROR_EOF;
             }
 
-            memcpy(buf, bufferData->p + bufferData->offset, bufSizeClamped);
+            if (bufferData->prefetch)
+            {
+                try
+                {
+                    bufferData->prefetch->read(bufferData->offset, buf, bufSizeClamped);
+                }
+                catch (const std::exception&)
+                {
+                    return AVERROR(EIO);
+                }
+            }
+            else
+            {
+                memcpy(buf, bufferData->p + bufferData->offset, bufSizeClamped);
+            }
             bufferData->offset += bufSizeClamped;
 
             return bufSizeClamped;
@@ -63,6 +84,26 @@ namespace tl
             return offset;
         }
 
+        float ReadStats::getDecodedPerRequest() const
+        {
+            return videoRequests > 0 ?
+                (videoDecoded / static_cast<float>(videoRequests)) :
+                0.F;
+        }
+
+        bool ReadStats::operator == (const ReadStats& other) const
+        {
+            return
+                videoRequests == other.videoRequests &&
+                videoDecoded == other.videoDecoded &&
+                videoSeeks == other.videoSeeks;
+        }
+
+        bool ReadStats::operator != (const ReadStats& other) const
+        {
+            return !(*this == other);
+        }
+
         void Read::_init(
             const file::Path& path,
             const std::vector<file::MemoryRead>& memory,
@@ -116,36 +157,113 @@ namespace tl
                 std::stringstream ss(i->second);
                 ss >> p.options.videoBufferSize;
             }
+            i = options.find("FFmpeg/VideoDecoderCount");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.options.videoDecoderCount;
+            }
+            p.options.videoDecoderCount = std::max(p.options.videoDecoderCount, static_cast<size_t>(1));
+            i = options.find("FFmpeg/ReverseBufferSize");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.options.reverseBufferSize;
+            }
             i = options.find("FFmpeg/AudioBufferSize");
             if (i != options.end())
             {
                 std::stringstream ss(i->second);
                 ss >> p.options.audioBufferSize;
             }
+            i = options.find("FFmpeg/Index");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.options.index;
+            }
+            i = options.find("FFmpeg/IndexPath");
+            if (i != options.end())
+            {
+                p.options.indexPath = i->second;
+            }
+            i = options.find("FFmpeg/Prefetch");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.options.prefetch;
+            }
+            i = options.find("FFmpeg/PrefetchBlockSize");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.options.prefetchOptions.blockSize;
+            }
+            i = options.find("FFmpeg/PrefetchReadAhead");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.options.prefetchOptions.readAhead;
+            }
+            i = options.find("FFmpeg/PrefetchMaxInFlight");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.options.prefetchOptions.maxInFlight;
+            }
 
-            p.videoThread.running = true;
+            p.readVideo.resize(p.options.videoDecoderCount);
+            p.videoMutex.decoders.resize(p.options.videoDecoderCount);
+            p.stats.resize(p.options.videoDecoderCount);
+            for (size_t i = 0; i < p.options.videoDecoderCount; ++i)
+            {
+                p.videoThreads.push_back(std::unique_ptr<Private::VideoThread>(new Private::VideoThread));
+            }
+            p.videoRunning = true;
             p.audioThread.running = true;
-            p.videoThread.thread = std::thread(
+            p.videoThreads[0]->thread = std::thread(
                 [this, path]
                 {
                     TLRENDER_P();
                     try
                     {
-                        p.readVideo = std::make_shared<ReadVideo>(
+                        // The video decoders and audio share the
+                        // prefetching reader.
+                        if (p.options.prefetch && _memory.empty() && path.isFileProtocol())
+                        {
+                            auto prefetch = file::PrefetchRead::create(
+                                path.get(-1, file::PathType::Path),
+                                p.options.prefetchOptions);
+                            std::unique_lock<std::mutex> lock(p.statsMutex);
+                            p.prefetch = prefetch;
+                        }
+
+                        p.readVideo[0] = std::make_shared<ReadVideo>(
                             path.get(-1, path.isFileProtocol() ? file::PathType::Path : file::PathType::Full),
                             _memory,
+                            p.prefetch,
                             p.options);
-                        const auto& videoInfo = p.readVideo->getInfo();
+                        {
+                            std::unique_lock<std::mutex> lock(p.statsMutex);
+                            p.indexBuilder = p.readVideo[0]->getIndexBuilder();
+                        }
+                        const auto& videoInfo = p.readVideo[0]->getInfo();
                         if (videoInfo.isValid())
                         {
                             p.info.video.push_back(videoInfo);
-                            p.info.videoTime = p.readVideo->getTimeRange();
-                            p.info.tags = p.readVideo->getTags();
+                            p.info.videoTime = p.readVideo[0]->getTimeRange();
+                            p.info.tags = p.readVideo[0]->getTags();
+                        }
+                        {
+                            std::unique_lock<std::mutex> lock(p.videoMutex.mutex);
+                            _updateGOPSize(p.readVideo[0]->getIndex().keyframes.size());
+                            p.videoMutex.decoders[0].ready = true;
                         }
 
                         p.readAudio = std::make_shared<ReadAudio>(
                             path.get(-1, path.isFileProtocol() ? file::PathType::Path : file::PathType::Full),
                             _memory,
+                            p.prefetch,
                             p.info.videoTime.duration().rate(),
                             p.options);
                         p.info.audio = p.readAudio->getInfo();
@@ -179,7 +297,70 @@ namespace tl
                                 }
                             });
 
-                        _videoThread();
+                        // Start the other video decoders. They share the
+                        // index builder of the first decoder.
+                        for (size_t i = 1; i < p.videoThreads.size(); ++i)
+                        {
+                            p.videoThreads[i]->thread = std::thread(
+                                [this, path, i]
+                                {
+                                    TLRENDER_P();
+                                    try
+                                    {
+                                        p.readVideo[i] = std::make_shared<ReadVideo>(
+                                            path.get(-1, path.isFileProtocol() ? file::PathType::Path : file::PathType::Full),
+                                            _memory,
+                                            p.prefetch,
+                                            p.options,
+                                            p.readVideo[0]->getIndexBuilder());
+                                        {
+                                            std::unique_lock<std::mutex> lock(p.videoMutex.mutex);
+                                            p.videoMutex.decoders[i].ready = true;
+                                        }
+                                        _videoThread(i);
+                                    }
+                                    catch (const std::exception& e)
+                                    {
+                                        if (auto logSystem = _logSystem.lock())
+                                        {
+                                            const std::string id = string::Format("tl::io::ffmpeg::Read ({0}: {1})").
+                                                arg(__FILE__).
+                                                arg(__LINE__);
+                                            logSystem->print(id, string::Format("{0}: {1}").
+                                                arg(_path.get()).
+                                                arg(e.what()),
+                                                log::Type::Error);
+                                        }
+                                    }
+
+                                    // Hand the remaining requests back to the
+                                    // first decoder, or cancel them if it has
+                                    // stopped.
+                                    std::list<std::shared_ptr<Private::VideoRequest> > requests;
+                                    {
+                                        std::unique_lock<std::mutex> lock(p.videoMutex.mutex);
+                                        auto& decoder = p.videoMutex.decoders[i];
+                                        decoder.ready = false;
+                                        if (p.videoMutex.stopped)
+                                        {
+                                            requests = std::move(decoder.requests);
+                                        }
+                                        else
+                                        {
+                                            p.videoMutex.decoders[0].requests.splice(
+                                                p.videoMutex.decoders[0].requests.end(),
+                                                decoder.requests);
+                                        }
+                                    }
+                                    p.videoThreads[0]->cv.notify_one();
+                                    for (auto& request : requests)
+                                    {
+                                        request->promise.set_value(io::VideoData());
+                                    }
+                                });
+                        }
+
+                        _videoThread(0);
                     }
                     catch (const std::exception& e)
                     {
@@ -215,11 +396,14 @@ namespace tl
         Read::~Read()
         {
             TLRENDER_P();
-            p.videoThread.running = false;
+            p.videoRunning = false;
             p.audioThread.running = false;
-            if (p.videoThread.thread.joinable())
+            for (const auto& videoThread : p.videoThreads)
             {
-                p.videoThread.thread.join();
+                if (videoThread->thread.joinable())
+                {
+                    videoThread->thread.join();
+                }
             }
             if (p.audioThread.thread.joinable())
             {
@@ -266,7 +450,7 @@ namespace tl
             }
             if (valid)
             {
-                p.videoThread.cv.notify_one();
+                p.videoThreads[0]->cv.notify_one();
             }
             else
             {
@@ -283,19 +467,28 @@ namespace tl
             auto request = std::make_shared<Private::VideoRequest>();
             request->time = time;
             request->options = io::merge(options, _options);
+            request->options.erase("Proxy");
             auto future = request->promise.get_future();
+            const auto i = request->options.find("Direction");
+            const bool reverse = i != request->options.end() && "Reverse" == i->second;
             bool valid = false;
+            size_t decoder = 0;
             {
                 std::unique_lock<std::mutex> lock(p.videoMutex.mutex);
                 if (!p.videoMutex.stopped)
                 {
                     valid = true;
-                    p.videoMutex.videoRequests.push_back(request);
+                    decoder = _getVideoDecoder(time, reverse);
+                    auto& videoDecoder = p.videoMutex.decoders[decoder];
+                    videoDecoder.requests.push_back(request);
+                    videoDecoder.position = time + otime::RationalTime(reverse ? -1.0 : 1.0, time.rate());
+                    videoDecoder.reverse = reverse;
+                    videoDecoder.used = ++p.videoMutex.used;
                 }
             }
             if (valid)
             {
-                p.videoThread.cv.notify_one();
+                p.videoThreads[decoder]->cv.notify_one();
             }
             else
             {
@@ -304,6 +497,83 @@ namespace tl
             return future;
         }
 
+        std::vector<std::future<io::VideoData> > Read::readVideo(
+            const std::vector<otime::RationalTime>& times,
+            const io::Options& options)
+        {
+            TLRENDER_P();
+            io::Options optionsMerged = io::merge(options, _options);
+            optionsMerged.erase("Proxy");
+            const auto i = optionsMerged.find("Direction");
+            const bool reverse = i != optionsMerged.end() && "Reverse" == i->second;
+            std::vector<std::future<io::VideoData> > out;
+            std::vector<std::shared_ptr<Private::VideoRequest> > requests;
+            for (const auto& time : times)
+            {
+                auto request = std::make_shared<Private::VideoRequest>();
+                request->time = time;
+                request->options = optionsMerged;
+                out.push_back(request->promise.get_future());
+                requests.push_back(request);
+            }
+
+            // Route the requests in playback order, so consecutive frames
+            // are given to the same decoder and decoded without seeking.
+            std::vector<size_t> order(requests.size());
+            for (size_t j = 0; j < order.size(); ++j)
+            {
+                order[j] = j;
+            }
+            std::stable_sort(
+                order.begin(),
+                order.end(),
+                [&requests, reverse](size_t a, size_t b)
+                {
+                    return reverse ?
+                        requests[a]->time > requests[b]->time :
+                        requests[a]->time < requests[b]->time;
+                });
+            bool valid = false;
+            std::vector<bool> notify;
+            {
+                std::unique_lock<std::mutex> lock(p.videoMutex.mutex);
+                if (!p.videoMutex.stopped)
+                {
+                    valid = true;
+                    notify.resize(p.videoMutex.decoders.size(), false);
+                    for (const size_t j : order)
+                    {
+                        const auto& time = requests[j]->time;
+                        const size_t decoder = _getVideoDecoder(time, reverse);
+                        auto& videoDecoder = p.videoMutex.decoders[decoder];
+                        videoDecoder.requests.push_back(requests[j]);
+                        videoDecoder.position = time + otime::RationalTime(reverse ? -1.0 : 1.0, time.rate());
+                        videoDecoder.reverse = reverse;
+                        videoDecoder.used = ++p.videoMutex.used;
+                        notify[decoder] = true;
+                    }
+                }
+            }
+            if (valid)
+            {
+                for (size_t j = 0; j < notify.size(); ++j)
+                {
+                    if (notify[j])
+                    {
+                        p.videoThreads[j]->cv.notify_one();
+                    }
+                }
+            }
+            else
+            {
+                for (const auto& request : requests)
+                {
+                    request->promise.set_value(io::VideoData());
+                }
+            }
+            return out;
+        }
+
         std::future<io::AudioData> Read::readAudio(
             const otime::TimeRange& timeRange,
             const io::Options& options)
@@ -339,52 +609,158 @@ namespace tl
             _cancelAudioRequests();
         }
 
-        void Read::_videoThread()
+        ReadStats Read::getStats() const
         {
             TLRENDER_P();
-            p.videoThread.currentTime = p.info.videoTime.start_time();
-            p.readVideo->start();
-            p.videoThread.logTimer = std::chrono::steady_clock::now();
-            while (p.videoThread.running)
+            std::unique_lock<std::mutex> lock(p.statsMutex);
+            ReadStats out;
+            for (const auto& stats : p.stats)
             {
-                // Check requests.
+                out.videoRequests += stats.videoRequests;
+                out.videoDecoded += stats.videoDecoded;
+                out.videoSeeks += stats.videoSeeks;
+            }
+            return out;
+        }
+
+        std::vector<ReadStats> Read::getDecoderStats() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.statsMutex);
+            return p.stats;
+        }
+
+        file::PrefetchStats Read::getPrefetchStats() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.statsMutex);
+            return p.prefetch ? p.prefetch->getStats() : file::PrefetchStats();
+        }
+
+        bool Read::isIndexReady() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.statsMutex);
+            return !p.indexBuilder || p.indexBuilder->isReady();
+        }
+
+        void Read::_updateGOPSize(size_t keyframes)
+        {
+            TLRENDER_P();
+            if (keyframes > 0)
+            {
+                p.videoMutex.gopSize = std::max(
+                    p.info.videoTime.duration().value() / keyframes,
+                    1.0);
+            }
+        }
+
+        size_t Read::_getVideoDecoder(const otime::RationalTime& time, bool reverse) const
+        {
+            TLRENDER_P();
+
+            // The cost of a request is the number of frames decoded
+            // forward, or the GOP size if the decoder has to seek. Ties go
+            // to the least recently used decoder, so new playheads get
+            // their own decoder.
+            size_t out = 0;
+            double outCost = 0.0;
+            size_t outUsed = 0;
+            for (size_t i = 0; i < p.videoMutex.decoders.size(); ++i)
+            {
+                const auto& decoder = p.videoMutex.decoders[i];
+                if (i > 0 && !decoder.ready)
+                {
+                    continue;
+                }
+                double cost = p.videoMutex.gopSize;
+                if (time::isValid(decoder.position) && reverse == decoder.reverse)
+                {
+                    const double frames =
+                        (time.value() - decoder.position.rescaled_to(time.rate()).value()) *
+                        (reverse ? -1.0 : 1.0);
+                    if (frames >= 0.0 && frames < cost)
+                    {
+                        cost = frames;
+                    }
+                }
+                if (0 == i ||
+                    cost < outCost ||
+                    (cost == outCost && decoder.used < outUsed))
+                {
+                    out = i;
+                    outCost = cost;
+                    outUsed = decoder.used;
+                }
+            }
+            return out;
+        }
+
+        void Read::_videoThread(size_t decoder)
+        {
+            TLRENDER_P();
+            auto& videoThread = *p.videoThreads[decoder];
+            auto readVideo = p.readVideo[decoder];
+            videoThread.currentTime = p.info.videoTime.start_time();
+            readVideo->start();
+            videoThread.logTimer = std::chrono::steady_clock::now();
+            while (p.videoRunning)
+            {
+                // Check requests. Information requests are handled by the
+                // first decoder.
                 std::list<std::shared_ptr<Private::InfoRequest> > infoRequests;
                 std::shared_ptr<Private::VideoRequest> videoRequest;
                 {
                     std::unique_lock<std::mutex> lock(p.videoMutex.mutex);
-                    if (p.videoThread.cv.wait_for(
+                    if (videoThread.cv.wait_for(
                         lock,
                         std::chrono::milliseconds(p.options.requestTimeout),
-                        [this]
+                        [this, decoder]
                         {
                             return
-                                !_p->videoMutex.infoRequests.empty() ||
-                                !_p->videoMutex.videoRequests.empty();
+                                (0 == decoder && !_p->videoMutex.infoRequests.empty()) ||
+                                !_p->videoMutex.decoders[decoder].requests.empty();
                         }))
                     {
-                        infoRequests = std::move(p.videoMutex.infoRequests);
-                        if (!p.videoMutex.videoRequests.empty())
+                        if (0 == decoder)
+                        {
+                            infoRequests = std::move(p.videoMutex.infoRequests);
+                        }
+                        auto& requests = p.videoMutex.decoders[decoder].requests;
+                        if (!requests.empty())
                         {
-                            videoRequest = p.videoMutex.videoRequests.front();
-                            p.videoMutex.videoRequests.pop_front();
+                            videoRequest = requests.front();
+                            requests.pop_front();
                         }
                     }
                 }
 
+                // Use the index when it is finished.
+                if (readVideo->updateIndex())
+                {
+                    std::unique_lock<std::mutex> lock(p.videoMutex.mutex);
+                    _updateGOPSize(readVideo->getIndex().keyframes.size());
+                }
+
                 // Information requests.
                 for (auto& request : infoRequests)
                 {
                     request->promise.set_value(p.info);
                 }
+                if (videoRequest)
+                {
+                    std::unique_lock<std::mutex> lock(p.statsMutex);
+                    ++p.stats[decoder].videoRequests;
+                }
 
                 // Check the cache.
                 io::VideoData videoData;
                 if (videoRequest && _cache)
                 {
-                    const std::string cacheKey = io::getVideoCacheKey(
-                        _path,
+                    const auto cacheKey = io::getVideoCacheKey(
+                        _pathID,
                         videoRequest->time,
-                        _options,
+                        _optionsHash,
                         videoRequest->options);
                     if (_cache->getVideo(cacheKey, videoData))
                     {
@@ -393,67 +769,135 @@ namespace tl
                     }
                 }
 
-                // Seek.
+                // Reverse playback decodes whole GOPs forward and serves
+                // them backwards.
+                bool reverse = false;
+                if (videoRequest && readVideo->canReverse())
+                {
+                    const auto i = videoRequest->options.find("Direction");
+                    reverse = i != videoRequest->options.end() && "Reverse" == i->second;
+                }
+                std::shared_ptr<image::Image> reverseImage;
+                bool seek = false;
+                if (videoRequest && reverse)
+                {
+                    reverseImage = readVideo->readReverse(videoRequest->time, seek);
+                    videoThread.currentTime = time::invalidTime;
+                }
+                else if (videoRequest)
+                {
+                    readVideo->clearReverse();
+                }
+
+                // Seek, or decode forward if the request is in the same GOP.
                 if (videoRequest &&
-                    !videoRequest->time.strictly_equal(p.videoThread.currentTime))
+                    !reverse &&
+                    !videoRequest->time.strictly_equal(videoThread.currentTime))
                 {
-                    p.videoThread.currentTime = videoRequest->time;
-                    p.readVideo->seek(p.videoThread.currentTime);
+                    if (readVideo->canSkip(videoThread.currentTime, videoRequest->time))
+                    {
+                        readVideo->skip(videoRequest->time);
+                    }
+                    else
+                    {
+                        readVideo->seek(videoRequest->time);
+                        seek = true;
+                    }
+                    videoThread.currentTime = videoRequest->time;
                 }
 
                 // Process.
                 while (
                     videoRequest &&
-                    p.readVideo->isBufferEmpty() &&
-                    p.readVideo->isValid() &&
-                    _p->readVideo->process(p.videoThread.currentTime))
+                    !reverse &&
+                    readVideo->isBufferEmpty() &&
+                    readVideo->isValid() &&
+                    readVideo->process(videoThread.currentTime))
                     ;
 
+                if (videoRequest)
+                {
+                    std::unique_lock<std::mutex> lock(p.statsMutex);
+                    p.stats[decoder].videoDecoded = readVideo->getDecodedCount();
+                    p.stats[decoder].videoSeeks += seek ? 1 : 0;
+                }
+
                 // Handle request.
                 if (videoRequest)
                 {
                     io::VideoData data;
                     data.time = videoRequest->time;
-                    if (!p.readVideo->isBufferEmpty())
+                    if (reverse)
+                    {
+                        data.image = reverseImage;
+                    }
+                    else if (!readVideo->isBufferEmpty())
                     {
-                        data.image = p.readVideo->popBuffer();
+                        data.image = readVideo->popBuffer();
                     }
+
                     videoRequest->promise.set_value(data);
                     
                     if (_cache)
                     {
-                        const std::string cacheKey = io::getVideoCacheKey(
-                            _path,
+                        const auto cacheKey = io::getVideoCacheKey(
+                            _pathID,
                             videoRequest->time,
-                            _options,
+                            _optionsHash,
                             videoRequest->options);
                         _cache->addVideo(cacheKey, data);
                     }
 
-                    p.videoThread.currentTime += otime::RationalTime(1.0, p.info.videoTime.duration().rate());
+                    if (!reverse)
+                    {
+                        videoThread.currentTime += otime::RationalTime(1.0, p.info.videoTime.duration().rate());
+                    }
                 }
 
                 // Logging.
                 {
                     const auto now = std::chrono::steady_clock::now();
-                    const std::chrono::duration<float> diff = now - p.videoThread.logTimer;
+                    const std::chrono::duration<float> diff = now - videoThread.logTimer;
                     if (diff.count() > 10.F)
                     {
-                        p.videoThread.logTimer = now;
+                        videoThread.logTimer = now;
                         if (auto logSystem = _logSystem.lock())
                         {
                             const std::string id = string::Format("tl::io::ffmpeg::Read {0}").arg(this);
                             size_t requestsSize = 0;
                             {
                                 std::unique_lock<std::mutex> lock(p.videoMutex.mutex);
-                                requestsSize = p.videoMutex.videoRequests.size();
+                                requestsSize = p.videoMutex.decoders[decoder].requests.size();
                             }
+                            ReadStats stats;
+                            {
+                                std::unique_lock<std::mutex> lock(p.statsMutex);
+                                stats = p.stats[decoder];
+                            }
+                            const file::PrefetchStats prefetchStats = getPrefetchStats();
                             logSystem->print(id, string::Format(
                                 "\n"
                                 "    Path: {0}\n"
-                                "    Video requests: {1}").
+                                "    Video decoder: {1}/{2}\n"
+                                "    Video requests: {3}\n"
+                                "    Video keyframes: {4}\n"
+                                "    Video seeks: {5}\n"
+                                "    Video decoded frames per request: {6}\n"
+                                "    Prefetch hits/waits/misses: {7}/{8}/{9}\n"
+                                "    Prefetch throughput: {10}MB/s\n"
+                                "    Prefetch latency: {11}ms").
                                 arg(_path.get()).
-                                arg(requestsSize));
+                                arg(decoder + 1).
+                                arg(p.videoThreads.size()).
+                                arg(requestsSize).
+                                arg(readVideo->getIndex().keyframes.size()).
+                                arg(stats.videoSeeks).
+                                arg(stats.getDecodedPerRequest()).
+                                arg(prefetchStats.hits).
+                                arg(prefetchStats.waits).
+                                arg(prefetchStats.misses).
+                                arg(prefetchStats.getThroughput() / memory::megabyte).
+                                arg(prefetchStats.getLatency() * 1000.0));
                         }
                     }
                 }
@@ -500,10 +944,10 @@ namespace tl
                 io::AudioData audioData;
                 if (request && _cache)
                 {
-                    const std::string cacheKey = io::getAudioCacheKey(
-                        _path,
+                    const auto cacheKey = io::getAudioCacheKey(
+                        _pathID,
                         request->timeRange,
-                        _options,
+                        _optionsHash,
                         request->options);
                     if (_cache->getAudio(cacheKey, audioData))
                     {
@@ -558,10 +1002,10 @@ namespace tl
 
                     if (_cache)
                     {
-                        const std::string cacheKey = io::getAudioCacheKey(
-                            _path,
+                        const auto cacheKey = io::getAudioCacheKey(
+                            _pathID,
                             request->timeRange,
-                            _options,
+                            _optionsHash,
                             request->options);
                         _cache->addAudio(cacheKey, audioData);
                     }
@@ -604,7 +1048,10 @@ namespace tl
             {
                 std::unique_lock<std::mutex> lock(p.videoMutex.mutex);
                 infoRequests = std::move(p.videoMutex.infoRequests);
-                videoRequests = std::move(p.videoMutex.videoRequests);
+                for (auto& decoder : p.videoMutex.decoders)
+                {
+                    videoRequests.splice(videoRequests.end(), decoder.requests);
+                }
             }
             for (auto& request : infoRequests)
             {
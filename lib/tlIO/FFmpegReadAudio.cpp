@@ -13,12 +13,13 @@ namespace tl
         ReadAudio::ReadAudio(
             const std::string& fileName,
             const std::vector<file::MemoryRead>& memory,
+            const std::shared_ptr<file::PrefetchRead>& prefetch,
             double videoRate,
             const Options& options) :
             _fileName(fileName),
             _options(options)
         {
-            if (!memory.empty())
+            if (!memory.empty() || prefetch)
             {
                 _avFormatContext = avformat_alloc_context();
                 if (!_avFormatContext)
@@ -26,11 +27,16 @@ namespace tl
                     throw std::runtime_error(string::Format("{0}: Cannot allocate format context").arg(fileName));
                 }
 
-                _avIOBufferData = AVIOBufferData(memory[0].p, memory[0].size);
-                _avIOContextBuffer = static_cast<uint8_t*>(av_malloc(avIOContextBufferSize));
+                _avIOBufferData = !memory.empty() ?
+                    AVIOBufferData(memory[0].p, memory[0].size) :
+                    AVIOBufferData(prefetch);
+                const size_t bufferSize = !memory.empty() ?
+                    avIOContextBufferSize :
+                    avIOPrefetchBufferSize;
+                _avIOContextBuffer = static_cast<uint8_t*>(av_malloc(bufferSize));
                 _avIOContext = avio_alloc_context(
                     _avIOContextBuffer,
-                    avIOContextBufferSize,
+                    bufferSize,
                     0,
                     &_avIOBufferData,
                     &avIOBufferRead,
@@ -0,0 +1,307 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlIO/FFmpegReadPrivate.h>
+
+#include <tlCore/File.h>
+#include <tlCore/FileIO.h>
+#include <tlCore/FileInfo.h>
+#include <tlCore/Path.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+namespace tl
+{
+    namespace ffmpeg
+    {
+        int Index::getKeyframe(int64_t pts) const
+        {
+            int out = -1;
+            if (!keyframes.empty())
+            {
+                const auto i = std::upper_bound(
+                    keyframes.begin(),
+                    keyframes.end(),
+                    pts,
+                    [](int64_t value, const Keyframe& keyframe)
+                    {
+                        return value < keyframe.pts;
+                    });
+                out = i != keyframes.begin() ? (i - keyframes.begin() - 1) : 0;
+            }
+            return out;
+        }
+
+        namespace
+        {
+            const char indexMagic[] = "tlFFIDX1";
+            const size_t indexMagicSize = 8;
+
+            uint64_t fnv(const std::string& value)
+            {
+                uint64_t out = 14695981039346656037ULL;
+                for (const char c : value)
+                {
+                    out ^= static_cast<uint8_t>(c);
+                    out *= 1099511628211ULL;
+                }
+                return out;
+            }
+        }
+
+        std::string getIndexFileName(
+            const std::string& indexPath,
+            const std::string& fileName)
+        {
+            std::string dir = indexPath;
+            if (dir.empty())
+            {
+                dir = file::appendSeparator(file::getTemp()) + "tlRenderFFmpegIndex";
+            }
+            std::stringstream ss;
+            ss << file::appendSeparator(dir) <<
+                std::hex << std::setfill('0') << std::setw(16) << fnv(fileName) <<
+                ".idx";
+            return ss.str();
+        }
+
+        bool readIndex(
+            const std::string& indexFileName,
+            const std::string& fileName,
+            uint64_t fileSize,
+            int64_t fileTime,
+            Index& index)
+        {
+            bool out = false;
+            try
+            {
+                if (file::exists(indexFileName))
+                {
+                    auto io = file::FileIO::create(indexFileName, file::Mode::Read);
+                    char magic[indexMagicSize];
+                    io->read(magic, indexMagicSize);
+                    uint64_t header[4] = { 0, 0, 0, 0 };
+                    io->read(header, 4, sizeof(uint64_t));
+                    const uint64_t fileNameSize = header[2];
+                    const uint64_t keyframeCount = header[3];
+                    if (0 == std::memcmp(magic, indexMagic, indexMagicSize) &&
+                        fileSize == header[0] &&
+                        fileTime == static_cast<int64_t>(header[1]) &&
+                        io->getSize() ==
+                            indexMagicSize +
+                            sizeof(header) +
+                            fileNameSize +
+                            keyframeCount * 3 * sizeof(int64_t))
+                    {
+                        std::string s(fileNameSize, 0);
+                        io->read(&s[0], fileNameSize);
+                        if (s == fileName)
+                        {
+                            std::vector<int64_t> data(keyframeCount * 3);
+                            io->read(data.data(), data.size(), sizeof(int64_t));
+                            index.keyframes.resize(keyframeCount);
+                            for (size_t i = 0; i < keyframeCount; ++i)
+                            {
+                                index.keyframes[i].pts = data[i * 3];
+                                index.keyframes[i].dts = data[i * 3 + 1];
+                                index.keyframes[i].pos = data[i * 3 + 2];
+                            }
+                            out = true;
+                        }
+                    }
+                }
+            }
+            catch (const std::exception&)
+            {
+                // An invalid cache file is rebuilt.
+            }
+            return out;
+        }
+
+        void writeIndex(
+            const std::string& indexFileName,
+            const std::string& fileName,
+            uint64_t fileSize,
+            int64_t fileTime,
+            const Index& index)
+        {
+            try
+            {
+                const std::string dir = file::Path(indexFileName).getDirectory();
+                if (!dir.empty() && !file::exists(dir))
+                {
+                    file::mkdir(dir);
+                }
+                auto io = file::FileIO::create(indexFileName, file::Mode::Write);
+                io->write(indexMagic, indexMagicSize);
+                const uint64_t header[4] =
+                {
+                    fileSize,
+                    static_cast<uint64_t>(fileTime),
+                    fileName.size(),
+                    index.keyframes.size()
+                };
+                io->write(header, 4, sizeof(uint64_t));
+                io->write(fileName.data(), fileName.size());
+                std::vector<int64_t> data(index.keyframes.size() * 3);
+                for (size_t i = 0; i < index.keyframes.size(); ++i)
+                {
+                    data[i * 3] = index.keyframes[i].pts;
+                    data[i * 3 + 1] = index.keyframes[i].dts;
+                    data[i * 3 + 2] = index.keyframes[i].pos;
+                }
+                io->write(data.data(), data.size(), sizeof(int64_t));
+            }
+            catch (const std::exception&)
+            {
+                // The index cache is optional.
+            }
+        }
+
+        IndexBuilder::IndexBuilder(
+            const std::string& fileName,
+            const std::vector<file::MemoryRead>& memory,
+            int stream,
+            const std::string& indexPath) :
+            _fileName(fileName)
+        {
+            _ready = false;
+            _cancel = false;
+
+            // Read the index from the cache.
+            if (memory.empty())
+            {
+                const file::FileInfo fileInfo = file::FileInfo(file::Path(_fileName));
+                _fileSize = fileInfo.getSize();
+                _fileTime = fileInfo.getTime();
+                _indexFileName = getIndexFileName(indexPath, _fileName);
+                if (readIndex(_indexFileName, _fileName, _fileSize, _fileTime, _index))
+                {
+                    _ready = true;
+                    return;
+                }
+            }
+
+            _thread = std::thread(
+                [this, memory, stream]
+                {
+                    _build(memory, stream);
+                    _ready = true;
+                });
+        }
+
+        IndexBuilder::~IndexBuilder()
+        {
+            _cancel = true;
+            if (_thread.joinable())
+            {
+                _thread.join();
+            }
+        }
+
+        bool IndexBuilder::isReady() const
+        {
+            return _ready;
+        }
+
+        const Index& IndexBuilder::getIndex() const
+        {
+            return _index;
+        }
+
+        void IndexBuilder::_build(const std::vector<file::MemoryRead>& memory, int stream)
+        {
+            AVFormatContext* avFormatContext = nullptr;
+            AVIOBufferData avIOBufferData;
+            AVIOContext* avIOContext = nullptr;
+            if (!memory.empty())
+            {
+                avFormatContext = avformat_alloc_context();
+                if (!avFormatContext)
+                {
+                    return;
+                }
+                avIOBufferData = AVIOBufferData(memory[0].p, memory[0].size);
+                uint8_t* avIOContextBuffer = static_cast<uint8_t*>(av_malloc(avIOContextBufferSize));
+                avIOContext = avio_alloc_context(
+                    avIOContextBuffer,
+                    avIOContextBufferSize,
+                    0,
+                    &avIOBufferData,
+                    &avIOBufferRead,
+                    nullptr,
+                    &avIOBufferSeek);
+                if (!avIOContext)
+                {
+                    av_free(avIOContextBuffer);
+                    avformat_free_context(avFormatContext);
+                    return;
+                }
+                avFormatContext->pb = avIOContext;
+            }
+
+            // Read the packets of the video stream.
+            if (avformat_open_input(
+                &avFormatContext,
+                !avFormatContext ? _fileName.c_str() : nullptr,
+                nullptr,
+                nullptr) >= 0)
+            {
+                if (stream < static_cast<int>(avFormatContext->nb_streams))
+                {
+                    for (unsigned int i = 0; i < avFormatContext->nb_streams; ++i)
+                    {
+                        if (static_cast<int>(i) != stream)
+                        {
+                            avFormatContext->streams[i]->discard = AVDISCARD_ALL;
+                        }
+                    }
+                    Packet packet;
+                    while (!_cancel && av_read_frame(avFormatContext, packet.p) >= 0)
+                    {
+                        if (stream == packet.p->stream_index &&
+                            (packet.p->flags & AV_PKT_FLAG_KEY))
+                        {
+                            Index::Keyframe keyframe;
+                            keyframe.pts = packet.p->pts != AV_NOPTS_VALUE ? packet.p->pts : packet.p->dts;
+                            keyframe.dts = packet.p->dts != AV_NOPTS_VALUE ? packet.p->dts : packet.p->pts;
+                            keyframe.pos = packet.p->pos;
+                            if (keyframe.pts != AV_NOPTS_VALUE)
+                            {
+                                _index.keyframes.push_back(keyframe);
+                            }
+                        }
+                        av_packet_unref(packet.p);
+                    }
+                }
+                avformat_close_input(&avFormatContext);
+            }
+            if (avIOContext)
+            {
+                av_freep(&avIOContext->buffer);
+                avio_context_free(&avIOContext);
+            }
+
+            if (_cancel)
+            {
+                _index.keyframes.clear();
+                return;
+            }
+            std::sort(
+                _index.keyframes.begin(),
+                _index.keyframes.end(),
+                [](const Index::Keyframe& a, const Index::Keyframe& b)
+                {
+                    return a.pts < b.pts;
+                });
+            if (!_indexFileName.empty())
+            {
+                writeIndex(_indexFileName, _fileName, _fileSize, _fileTime, _index);
+            }
+        }
+    }
+}
@@ -26,8 +26,10 @@ namespace tl
         {
             AVIOBufferData();
             AVIOBufferData(const uint8_t* p, size_t size);
+            AVIOBufferData(const std::shared_ptr<file::PrefetchRead>&);
 
             const uint8_t* p = nullptr;
+            std::shared_ptr<file::PrefetchRead> prefetch;
             size_t size = 0;
             size_t offset = 0;
         };
@@ -36,6 +38,7 @@ namespace tl
         int64_t avIOBufferSeek(void* opaque, int64_t offset, int whence);
 
         const size_t avIOContextBufferSize = 4096;
+        const size_t avIOPrefetchBufferSize = 65536;
 
         struct Options
         {
@@ -44,16 +47,103 @@ namespace tl
             size_t threadCount = ffmpeg::threadCount;
             size_t requestTimeout = 5;
             size_t videoBufferSize = 4;
+            size_t videoDecoderCount = 1;
+            size_t reverseBufferSize = 24;
             otime::RationalTime audioBufferSize = otime::RationalTime(2.0, 1.0);
+            bool index = true;
+            std::string indexPath;
+            bool prefetch = false;
+            file::PrefetchOptions prefetchOptions;
+        };
+
+        //! Video keyframe index, used for random access. The timestamps are
+        //! in the stream time base.
+        struct Index
+        {
+            struct Keyframe
+            {
+                int64_t pts = 0;
+                int64_t dts = 0;
+                int64_t pos = -1;
+            };
+
+            //! The keyframes, sorted by presentation time. Each keyframe
+            //! starts a GOP that ends at the next keyframe.
+            std::vector<Keyframe> keyframes;
+
+            //! Get the keyframe of the GOP that contains the given
+            //! presentation time, or -1 if there are no keyframes.
+            int getKeyframe(int64_t pts) const;
+        };
+
+        //! Get the index cache file name for a movie.
+        std::string getIndexFileName(
+            const std::string& indexPath,
+            const std::string& fileName);
+
+        //! Read an index cache file. The index is only used if the file
+        //! size and modification time match the movie.
+        bool readIndex(
+            const std::string& indexFileName,
+            const std::string& fileName,
+            uint64_t fileSize,
+            int64_t fileTime,
+            Index&);
+
+        //! Write an index cache file.
+        void writeIndex(
+            const std::string& indexFileName,
+            const std::string& fileName,
+            uint64_t fileSize,
+            int64_t fileTime,
+            const Index&);
+
+        //! Build the keyframe index of a movie. The index is read from the
+        //! cache file when it is valid, otherwise the packets of the video
+        //! stream are read by a thread with its own format context, so
+        //! opening the movie does not wait for a pass over the whole file.
+        class IndexBuilder
+        {
+        public:
+            IndexBuilder(
+                const std::string& fileName,
+                const std::vector<file::MemoryRead>&,
+                int stream,
+                const std::string& indexPath);
+
+            ~IndexBuilder();
+
+            //! Get whether the index is finished.
+            bool isReady() const;
+
+            //! Get the index. This should only be used after isReady()
+            //! returns true.
+            const Index& getIndex() const;
+
+        private:
+            void _build(const std::vector<file::MemoryRead>&, int stream);
+
+            std::string _fileName;
+            std::string _indexFileName;
+            uint64_t _fileSize = 0;
+            int64_t _fileTime = 0;
+            Index _index;
+            std::atomic<bool> _ready;
+            std::atomic<bool> _cancel;
+            std::thread _thread;
         };
 
         class ReadVideo
         {
         public:
+            //! Create a video reader. The index is built unless an index
+            //! builder is given.
             ReadVideo(
                 const std::string& fileName,
                 const std::vector<file::MemoryRead>& memory,
-                const Options& options);
+                const std::shared_ptr<file::PrefetchRead>& prefetch,
+                const Options& options,
+                const std::shared_ptr<IndexBuilder>& indexBuilder = nullptr);
 
             ~ReadVideo();
 
@@ -62,15 +152,52 @@ namespace tl
             const otime::TimeRange& getTimeRange() const;
             const image::Tags& getTags() const;
 
+            const std::shared_ptr<IndexBuilder>& getIndexBuilder() const;
+            const Index& getIndex() const;
+
+            //! Use the index once the index builder is finished. Until then
+            //! seeks use the demuxer. Returns true if the index changed.
+            bool updateIndex();
+
+            size_t getDecodedCount() const;
+
             void start();
             void seek(const otime::RationalTime&);
             bool process(const otime::RationalTime& currentTime);
 
+            //! Get whether the given time can be reached by decoding
+            //! forward from the current time, without seeking.
+            bool canSkip(
+                const otime::RationalTime& currentTime,
+                const otime::RationalTime&) const;
+
+            //! Skip forward to the given time without seeking.
+            void skip(const otime::RationalTime&);
+
+            //! Get whether reverse playback can be decoded by GOP.
+            bool canReverse() const;
+
+            //! Read a frame for reverse playback. When the frame is not
+            //! buffered, the GOP containing it is decoded forward up to the
+            //! frame, keeping at most the reverse buffer size frames, and
+            //! "seek" is set. Frames later than the given time are released.
+            std::shared_ptr<image::Image> readReverse(
+                const otime::RationalTime&,
+                bool& seek);
+
+            //! Release the reverse playback buffer.
+            void clearReverse();
+
             bool isBufferEmpty() const;
             std::shared_ptr<image::Image> popBuffer();
 
         private:
+            void _initIndex(const std::vector<file::MemoryRead>&);
+            void _prefetch(int keyframe);
+            int64_t _getTimestamp(const otime::RationalTime&) const;
+            otime::RationalTime _getTime(int64_t timestamp) const;
             int _decode(const otime::RationalTime& currentTime);
+            std::shared_ptr<image::Image> _wrap();
             void _copy(const std::shared_ptr<image::Image>&);
 
             std::string _fileName;
@@ -78,6 +205,9 @@ namespace tl
             image::Info _info;
             otime::TimeRange _timeRange = time::invalidTimeRange;
             image::Tags _tags;
+            image::Tags _frameMetadata;
+            std::shared_ptr<const image::Tags> _frameTags;
+            std::shared_ptr<const image::HDRData> _frameHDR;
 
             AVFormatContext* _avFormatContext = nullptr;
             AVIOBufferData _avIOBufferData;
@@ -92,7 +222,11 @@ namespace tl
             AVPixelFormat _avInputPixelFormat = AV_PIX_FMT_NONE;
             AVPixelFormat _avOutputPixelFormat = AV_PIX_FMT_NONE;
             SwsContext* _swsContext = nullptr;
-            std::list<std::shared_ptr<image::Image> > _buffer;
+            std::shared_ptr<IndexBuilder> _indexBuilder;
+            Index _index;
+            size_t _decodedCount = 0;
+            std::list<std::pair<otime::RationalTime, std::shared_ptr<image::Image> > > _buffer;
+            std::map<otime::RationalTime, std::shared_ptr<image::Image> > _reverseBuffer;
             bool _eof = false;
         };
 
@@ -102,6 +236,7 @@ namespace tl
             ReadAudio(
                 const std::string& fileName,
                 const std::vector<file::MemoryRead>&,
+                const std::shared_ptr<file::PrefetchRead>&,
                 double videoRate,
                 const Options&);
 
@@ -147,8 +282,10 @@ namespace tl
         {
             Options options;
 
-            std::shared_ptr<ReadVideo> readVideo;
+            std::vector<std::shared_ptr<ReadVideo> > readVideo;
             std::shared_ptr<ReadAudio> readAudio;
+            std::shared_ptr<file::PrefetchRead> prefetch;
+            std::shared_ptr<IndexBuilder> indexBuilder;
 
             io::Info info;
             struct InfoRequest
@@ -162,24 +299,46 @@ namespace tl
                 io::Options options;
                 std::promise<io::VideoData> promise;
             };
+            struct VideoDecoder
+            {
+                //! Whether the decoder is ready for requests.
+                bool ready = false;
+
+                std::list<std::shared_ptr<VideoRequest> > requests;
+
+                //! The time the decoder is at after the requests are
+                //! handled.
+                otime::RationalTime position = time::invalidTime;
+                bool reverse = false;
+
+                //! When the decoder was last used, for choosing the least
+                //! recently used decoder.
+                size_t used = 0;
+            };
             struct VideoMutex
             {
                 std::list<std::shared_ptr<InfoRequest> > infoRequests;
-                std::list<std::shared_ptr<VideoRequest> > videoRequests;
-                //std::shared_ptr<VideoRequest> videoRequest;
+                std::vector<VideoDecoder> decoders;
+                size_t used = 0;
+
+                //! The average number of frames in a GOP, used to estimate
+                //! the cost of seeking.
+                double gopSize = 1.0;
                 bool stopped = false;
                 std::mutex mutex;
             };
             VideoMutex videoMutex;
+            std::vector<ReadStats> stats;
+            mutable std::mutex statsMutex;
             struct VideoThread
             {
                 otime::RationalTime currentTime = time::invalidTime;
                 std::chrono::steady_clock::time_point logTimer;
                 std::condition_variable cv;
                 std::thread thread;
-                std::atomic<bool> running;
             };
-            VideoThread videoThread;
+            std::vector<std::unique_ptr<VideoThread> > videoThreads;
+            std::atomic<bool> videoRunning;
 
             struct AudioRequest
             {
@@ -4,8 +4,11 @@
 
 #include <tlIO/FFmpegReadPrivate.h>
 
+#include <tlCore/File.h>
 #include <tlCore/StringFormat.h>
 
+#include <algorithm>
+
 extern "C"
 {
 #include <libavutil/imgutils.h>
@@ -20,11 +23,13 @@ namespace tl
         ReadVideo::ReadVideo(
             const std::string& fileName,
             const std::vector<file::MemoryRead>& memory,
-            const Options& options) :
+            const std::shared_ptr<file::PrefetchRead>& prefetch,
+            const Options& options,
+            const std::shared_ptr<IndexBuilder>& indexBuilder) :
             _fileName(fileName),
             _options(options)
         {
-            if (!memory.empty())
+            if (!memory.empty() || prefetch)
             {
                 _avFormatContext = avformat_alloc_context();
                 if (!_avFormatContext)
@@ -32,11 +37,16 @@ namespace tl
                     throw std::runtime_error(string::Format("{0}: Cannot allocate format context").arg(fileName));
                 }
 
-                _avIOBufferData = AVIOBufferData(memory[0].p, memory[0].size);
-                _avIOContextBuffer = static_cast<uint8_t*>(av_malloc(avIOContextBufferSize));
+                _avIOBufferData = !memory.empty() ?
+                    AVIOBufferData(memory[0].p, memory[0].size) :
+                    AVIOBufferData(prefetch);
+                const size_t bufferSize = !memory.empty() ?
+                    avIOContextBufferSize :
+                    avIOPrefetchBufferSize;
+                _avIOContextBuffer = static_cast<uint8_t*>(av_malloc(bufferSize));
                 _avIOContext = avio_alloc_context(
                     _avIOContextBuffer,
-                    avIOContextBufferSize,
+                    bufferSize,
                     0,
                     &_avIOBufferData,
                     &avIOBufferRead,
@@ -389,6 +399,16 @@ namespace tl
                     ss << _timeRange.start_time().rate() << " FPS";
                     _tags["Video Speed"] = ss.str();
                 }
+
+                if (indexBuilder)
+                {
+                    _indexBuilder = indexBuilder;
+                }
+                else
+                {
+                    _initIndex(memory);
+                }
+                updateIndex();
             }
         }
 
@@ -450,6 +470,32 @@ namespace tl
             return _tags;
         }
 
+        const std::shared_ptr<IndexBuilder>& ReadVideo::getIndexBuilder() const
+        {
+            return _indexBuilder;
+        }
+
+        const Index& ReadVideo::getIndex() const
+        {
+            return _index;
+        }
+
+        bool ReadVideo::updateIndex()
+        {
+            bool out = false;
+            if (_index.keyframes.empty() && _indexBuilder && _indexBuilder->isReady())
+            {
+                _index = _indexBuilder->getIndex();
+                out = !_index.keyframes.empty();
+            }
+            return out;
+        }
+
+        size_t ReadVideo::getDecodedCount() const
+        {
+            return _decodedCount;
+        }
+
         namespace
         {
             bool canCopy(AVPixelFormat in, AVPixelFormat out)
@@ -460,6 +506,22 @@ namespace tl
                      AV_PIX_FMT_RGBA    == in ||
                      AV_PIX_FMT_YUV420P == in);
             }
+
+            bool isEqual(const AVDictionary* dict, const image::Tags& tags)
+            {
+                size_t count = 0;
+                AVDictionaryEntry* tag = nullptr;
+                while ((tag = av_dict_get(dict, "", tag, AV_DICT_IGNORE_SUFFIX)))
+                {
+                    const auto i = tags.find(tag->key);
+                    if (i == tags.end() || i->second != tag->value)
+                    {
+                        return false;
+                    }
+                    ++count;
+                }
+                return count == tags.size();
+            }
         }
 
         void ReadVideo::start()
@@ -568,13 +630,18 @@ namespace tl
             {
                 avcodec_flush_buffers(_avCodecContext[_avStream]);
 
+                // Seek to the keyframe of the GOP if there is an index.
+                int64_t timestamp = _getTimestamp(time);
+                const int keyframe = _index.getKeyframe(timestamp);
+                if (keyframe != -1)
+                {
+                    timestamp = _index.keyframes[keyframe].dts;
+                    _prefetch(keyframe);
+                }
                 if (av_seek_frame(
                     _avFormatContext,
                     _avStream,
-                    av_rescale_q(
-                        time.value() - _timeRange.start_time().value(),
-                        swap(_avSpeed),
-                        _avFormatContext->streams[_avStream]->time_base),
+                    timestamp,
                     AVSEEK_FLAG_BACKWARD) < 0)
                 {
                     //! \todo How should this be handled?
@@ -585,6 +652,98 @@ namespace tl
             _eof = false;
         }
 
+        bool ReadVideo::canSkip(
+            const otime::RationalTime& currentTime,
+            const otime::RationalTime& time) const
+        {
+            bool out = false;
+            if (_avStream != -1 &&
+                !_index.keyframes.empty() &&
+                !_eof &&
+                time::isValid(currentTime) &&
+                time > currentTime)
+            {
+                out =
+                    _index.getKeyframe(_getTimestamp(currentTime)) ==
+                    _index.getKeyframe(_getTimestamp(time));
+            }
+            return out;
+        }
+
+        void ReadVideo::skip(const otime::RationalTime& time)
+        {
+            while (!_buffer.empty() && _buffer.front().first < time)
+            {
+                _buffer.pop_front();
+            }
+        }
+
+        bool ReadVideo::canReverse() const
+        {
+            return _avStream != -1 && !_index.keyframes.empty();
+        }
+
+        std::shared_ptr<image::Image> ReadVideo::readReverse(
+            const otime::RationalTime& time,
+            bool& seek)
+        {
+            seek = false;
+            auto i = _reverseBuffer.find(time);
+            if (i == _reverseBuffer.end() && canReverse())
+            {
+                // Decode forward from the keyframe, keeping the frames from
+                // the start of the GOP, or as many frames before the
+                // requested time as the buffer allows.
+                _reverseBuffer.clear();
+                const int keyframe = _index.getKeyframe(_getTimestamp(time));
+                const size_t size = std::max(_options.reverseBufferSize, static_cast<size_t>(1));
+                const otime::RationalTime start = std::max(
+                    _getTime(_index.keyframes[keyframe].pts),
+                    time - otime::RationalTime(size - 1, time.rate()));
+                this->seek(time);
+                seek = true;
+
+                // Read the previous GOP in the background while this one
+                // is decoded.
+                _prefetch(keyframe - 1);
+
+                bool done = false;
+                while (!done)
+                {
+                    const bool decoded = process(start);
+                    for (const auto& frame : _buffer)
+                    {
+                        if (frame.first <= time)
+                        {
+                            _reverseBuffer[frame.first] = frame.second;
+                        }
+                        if (frame.first >= time)
+                        {
+                            done = true;
+                        }
+                    }
+                    _buffer.clear();
+                    if (!decoded)
+                    {
+                        break;
+                    }
+                }
+                i = _reverseBuffer.find(time);
+            }
+            std::shared_ptr<image::Image> out;
+            if (i != _reverseBuffer.end())
+            {
+                out = i->second;
+                _reverseBuffer.erase(i, _reverseBuffer.end());
+            }
+            return out;
+        }
+
+        void ReadVideo::clearReverse()
+        {
+            _reverseBuffer.clear();
+        }
+
         bool ReadVideo::process(const otime::RationalTime& currentTime)
         {
             bool out = false;
@@ -667,12 +826,70 @@ namespace tl
             std::shared_ptr<image::Image> out;
             if (!_buffer.empty())
             {
-                out = _buffer.front();
+                out = _buffer.front().second;
                 _buffer.pop_front();
             }
             return out;
         }
 
+        void ReadVideo::_initIndex(const std::vector<file::MemoryRead>& memory)
+        {
+            // Intra-only codecs can seek to any frame and are not indexed.
+            // Only local files and memory are indexed, since the packets of
+            // the whole movie are read.
+            const AVCodecDescriptor* avCodecDescriptor = avcodec_descriptor_get(
+                _avCodecParameters[_avStream]->codec_id);
+            if (!_options.index ||
+                (avCodecDescriptor && (avCodecDescriptor->props & AV_CODEC_PROP_INTRA_ONLY)) ||
+                (memory.empty() && !file::exists(_fileName)))
+            {
+                return;
+            }
+            _indexBuilder = std::make_shared<IndexBuilder>(
+                _fileName,
+                memory,
+                _avStream,
+                _options.indexPath);
+        }
+
+        void ReadVideo::_prefetch(int keyframe)
+        {
+            if (_avIOBufferData.prefetch &&
+                keyframe >= 0 &&
+                keyframe < static_cast<int>(_index.keyframes.size()) &&
+                _index.keyframes[keyframe].pos >= 0)
+            {
+                const auto& options = _avIOBufferData.prefetch->getOptions();
+                const int64_t pos = _index.keyframes[keyframe].pos;
+                int64_t size = options.blockSize * options.readAhead;
+                if (keyframe + 1 < static_cast<int>(_index.keyframes.size()) &&
+                    _index.keyframes[keyframe + 1].pos > pos)
+                {
+                    size = _index.keyframes[keyframe + 1].pos - pos;
+                }
+                _avIOBufferData.prefetch->prefetch(pos, size);
+            }
+        }
+
+        int64_t ReadVideo::_getTimestamp(const otime::RationalTime& time) const
+        {
+            return av_rescale_q(
+                time.value() - _timeRange.start_time().value(),
+                swap(_avSpeed),
+                _avFormatContext->streams[_avStream]->time_base);
+        }
+
+        otime::RationalTime ReadVideo::_getTime(int64_t timestamp) const
+        {
+            return otime::RationalTime(
+                _timeRange.start_time().value() +
+                av_rescale_q(
+                    timestamp,
+                    _avFormatContext->streams[_avStream]->time_base,
+                    swap(_avFormatContext->streams[_avStream]->r_frame_rate)),
+                _timeRange.duration().rate());
+        }
+
         int ReadVideo::_decode(const otime::RationalTime& currentTime)
         {
             int out = 0;
@@ -683,36 +900,50 @@ namespace tl
                 {
                     return out;
                 }
+                ++_decodedCount;
                 const int64_t timestamp = _avFrame->pts != AV_NOPTS_VALUE ? _avFrame->pts : _avFrame->pkt_dts;
                 //std::cout << "video timestamp: " << timestamp << std::endl;
 
-                const otime::RationalTime time(
-                    _timeRange.start_time().value() +
-                    av_rescale_q(
-                        timestamp,
-                        _avFormatContext->streams[_avStream]->time_base,
-                        swap(_avFormatContext->streams[_avStream]->r_frame_rate)),
-                    _timeRange.duration().rate());
+                const otime::RationalTime time = _getTime(timestamp);
                 //std::cout << "video time: " << time << std::endl;
 
                 if (time >= currentTime)
                 {
                     //std::cout << "video time: " << time << std::endl;
-                    auto image = image::Image::create(_info);
-                    
-                    auto tags = _tags;
-                    AVDictionaryEntry* tag = nullptr;
-                    while ((tag = av_dict_get(_avFrame->metadata, "", tag, AV_DICT_IGNORE_SUFFIX)))
+                    auto image = _wrap();
+                    if (!image)
                     {
-                        tags[tag->key] = tag->value;
+                        image = image::Image::create(_info);
+                        _copy(image);
                     }
+
+                    // Frames with the same metadata share the tags and HDR
+                    // data instead of copying them.
+                    if (!_frameTags || !isEqual(_avFrame->metadata, _frameMetadata))
+                    {
+                        _frameMetadata.clear();
+                        AVDictionaryEntry* tag = nullptr;
+                        while ((tag = av_dict_get(_avFrame->metadata, "", tag, AV_DICT_IGNORE_SUFFIX)))
+                        {
+                            _frameMetadata[tag->key] = tag->value;
+                        }
+                        auto tags = _tags;
+                        for (const auto& i : _frameMetadata)
+                        {
+                            tags[i.first] = i.second;
+                        }
+                        _frameTags = std::make_shared<const image::Tags>(std::move(tags));
+                    }
+                    image->setTags(_frameTags);
                     image::HDRData hdrData;
                     toHDRData(_avFrame->side_data, _avFrame->nb_side_data, hdrData);
-                    tags["hdr"] = nlohmann::json(hdrData).dump();
-                    image->setTags(tags);
+                    if (!_frameHDR || *_frameHDR != hdrData)
+                    {
+                        _frameHDR = std::make_shared<const image::HDRData>(hdrData);
+                    }
+                    image->setHDR(_frameHDR);
 
-                    _copy(image);
-                    _buffer.push_back(image);
+                    _buffer.push_back(std::make_pair(time, image));
                     out = 1;
                     break;
                 }
@@ -720,6 +951,44 @@ namespace tl
             return out;
         }
 
+        std::shared_ptr<image::Image> ReadVideo::_wrap()
+        {
+            std::shared_ptr<image::Image> out;
+            if (canCopy(_avInputPixelFormat, _avOutputPixelFormat) &&
+                _avFrame->buf[0] &&
+                _avFrame->width == _info.size.w &&
+                _avFrame->height == _info.size.h)
+            {
+                // Reference the frame buffers instead of copying them.
+                const size_t planeCount = image::getPlaneCount(_info.pixelType);
+                std::vector<image::Plane> planes;
+                for (size_t i = 0; i < planeCount; ++i)
+                {
+                    if (_avFrame->linesize[i] < 0 ||
+                        static_cast<size_t>(_avFrame->linesize[i]) < image::getPlaneRowByteCount(_info, i))
+                    {
+                        return out;
+                    }
+                    image::Plane plane;
+                    plane.data = _avFrame->data[i];
+                    plane.stride = _avFrame->linesize[i];
+                    planes.push_back(plane);
+                }
+                AVFrame* avFrame = av_frame_clone(_avFrame);
+                if (avFrame)
+                {
+                    std::shared_ptr<AVFrame> storage(
+                        avFrame,
+                        [](AVFrame* value)
+                        {
+                            av_frame_free(&value);
+                        });
+                    out = image::Image::create(_info, planes, storage);
+                }
+            }
+            return out;
+        }
+
         void ReadVideo::_copy(const std::shared_ptr<image::Image>& image)
         {
             const auto& info = image->getInfo();
@@ -737,7 +1006,7 @@ namespace tl
                     {
                         std::memcpy(
                             data + w * 3 * i,
-                            data0 + linesize0 * 3 * i,
+                            data0 + linesize0 * i,
                             w * 3);
                     }
                     break;
@@ -755,7 +1024,7 @@ namespace tl
                     {
                         std::memcpy(
                             data + w * 4 * i,
-                            data0 + linesize0 * 4 * i,
+                            data0 + linesize0 * i,
                             w * 4);
                     }
                     break;
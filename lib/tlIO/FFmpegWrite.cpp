@@ -4,6 +4,7 @@
 
 #include <tlIO/FFmpeg.h>
 
+#include <tlCore/AudioResample.h>
 #include <tlCore/StringFormat.h>
 
 extern "C"
@@ -13,10 +14,47 @@ extern "C"
 #include <libavutil/opt.h>
 }
 
+#include <algorithm>
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+
 namespace tl
 {
     namespace ffmpeg
     {
+        namespace
+        {
+            SwsContext* createSwsContext(
+                const image::Size& size,
+                AVPixelFormat in,
+                AVPixelFormat out,
+                int threadCount)
+            {
+                SwsContext* swsContext = sws_alloc_context();
+                if (swsContext)
+                {
+                    av_opt_set_defaults(swsContext);
+                    av_opt_set_int(swsContext, "srcw", size.w, AV_OPT_SEARCH_CHILDREN);
+                    av_opt_set_int(swsContext, "srch", size.h, AV_OPT_SEARCH_CHILDREN);
+                    av_opt_set_int(swsContext, "src_format", in, AV_OPT_SEARCH_CHILDREN);
+                    av_opt_set_int(swsContext, "dstw", size.w, AV_OPT_SEARCH_CHILDREN);
+                    av_opt_set_int(swsContext, "dsth", size.h, AV_OPT_SEARCH_CHILDREN);
+                    av_opt_set_int(swsContext, "dst_format", out, AV_OPT_SEARCH_CHILDREN);
+                    av_opt_set_int(swsContext, "sws_flags", swsScaleFlags, AV_OPT_SEARCH_CHILDREN);
+                    av_opt_set_int(swsContext, "threads", threadCount, AV_OPT_SEARCH_CHILDREN);
+                    if (sws_init_context(swsContext, nullptr, nullptr) < 0)
+                    {
+                        sws_freeContext(swsContext);
+                        swsContext = nullptr;
+                    }
+                }
+                return swsContext;
+            }
+        }
+
         struct Write::Private
         {
             std::string fileName;
@@ -26,9 +64,54 @@ namespace tl
             AVPacket* avPacket = nullptr;
             AVFrame* avFrame = nullptr;
             AVPixelFormat avPixelFormatIn = AV_PIX_FMT_NONE;
-            AVFrame* avFrame2 = nullptr;
             SwsContext* swsContext = nullptr;
+
+            AVCodecContext* avAudioCodecContext = nullptr;
+            AVStream* avAudioStream = nullptr;
+            AVPacket* avAudioPacket = nullptr;
+            AVFrame* avAudioFrame = nullptr;
+            audio::Info audioInfo;
+            std::shared_ptr<audio::AudioResample> audioResample;
+            std::list<std::shared_ptr<audio::Audio> > audioBuffer;
+            int64_t audioPts = -1;
+
+            //! Video and audio packets can be written by different threads.
+            std::mutex muxMutex;
+
             bool opened = false;
+
+            bool async = false;
+            size_t threadCount = writeThreadCount;
+            size_t queueSize = writeQueueSize;
+
+            struct Frame
+            {
+                uint64_t index = 0;
+                otime::RationalTime time = time::invalidTime;
+                std::shared_ptr<image::Image> image;
+            };
+            struct Mutex
+            {
+                std::list<Frame> frames;
+
+                //! Converted frames waiting to be encoded in order. A null
+                //! frame means the conversion failed.
+                std::map<uint64_t, AVFrame*> converted;
+                uint64_t writeIndex = 0;
+                uint64_t encodeIndex = 0;
+
+                //! The number of frames written and not yet encoded.
+                size_t pending = 0;
+
+                std::string error;
+                bool stop = false;
+                std::mutex mutex;
+            };
+            Mutex mutex;
+            std::condition_variable cv;
+            std::vector<SwsContext*> swsContexts;
+            std::vector<std::thread> convertThreads;
+            std::thread encodeThread;
         };
 
         void Write::_init(
@@ -56,6 +139,26 @@ namespace tl
                 std::stringstream ss(option->second);
                 ss >> profile;
             }
+            option = options.find("FFmpeg/WriteAsync");
+            if (option != options.end())
+            {
+                std::stringstream ss(option->second);
+                ss >> p.async;
+            }
+            option = options.find("FFmpeg/WriteThreadCount");
+            if (option != options.end())
+            {
+                std::stringstream ss(option->second);
+                ss >> p.threadCount;
+            }
+            p.threadCount = std::max(p.threadCount, static_cast<size_t>(1));
+            option = options.find("FFmpeg/WriteQueueSize");
+            if (option != options.end())
+            {
+                std::stringstream ss(option->second);
+                ss >> p.queueSize;
+            }
+            p.queueSize = std::max(p.queueSize, static_cast<size_t>(1));
             switch (profile)
             {
             case Profile::H264:
@@ -147,6 +250,68 @@ namespace tl
             p.avVideoStream->time_base = { rational.second, rational.first };
             p.avVideoStream->avg_frame_rate = { rational.first, rational.second };
 
+            if (info.audio.isValid())
+            {
+                const AVCodec* avAudioCodec = avcodec_find_encoder(AV_CODEC_ID_AAC);
+                if (!avAudioCodec || !avAudioCodec->sample_fmts)
+                {
+                    throw std::runtime_error(string::Format("{0}: Cannot find audio encoder").arg(p.fileName));
+                }
+                p.avAudioCodecContext = avcodec_alloc_context3(avAudioCodec);
+                if (!p.avAudioCodecContext)
+                {
+                    throw std::runtime_error(string::Format("{0}: Cannot allocate context").arg(p.fileName));
+                }
+                p.avAudioStream = avformat_new_stream(p.avFormatContext, avAudioCodec);
+                if (!p.avAudioStream)
+                {
+                    throw std::runtime_error(string::Format("{0}: Cannot allocate stream").arg(p.fileName));
+                }
+                p.avAudioCodecContext->codec_type = AVMEDIA_TYPE_AUDIO;
+                p.avAudioCodecContext->sample_fmt = avAudioCodec->sample_fmts[0];
+                p.avAudioCodecContext->sample_rate = info.audio.sampleRate;
+                av_channel_layout_default(&p.avAudioCodecContext->ch_layout, info.audio.channelCount);
+                p.avAudioCodecContext->time_base = { 1, static_cast<int>(info.audio.sampleRate) };
+                if (p.avFormatContext->oformat->flags & AVFMT_GLOBALHEADER)
+                {
+                    p.avAudioCodecContext->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+                }
+                r = avcodec_open2(p.avAudioCodecContext, avAudioCodec, NULL);
+                if (r < 0)
+                {
+                    throw std::runtime_error(string::Format("{0}: {1}").arg(p.fileName).arg(getErrorLabel(r)));
+                }
+                r = avcodec_parameters_from_context(p.avAudioStream->codecpar, p.avAudioCodecContext);
+                if (r < 0)
+                {
+                    throw std::runtime_error(string::Format("{0}: {1}").arg(p.fileName).arg(getErrorLabel(r)));
+                }
+                p.avAudioStream->time_base = p.avAudioCodecContext->time_base;
+
+                // The audio is resampled to interleaved data, and split into
+                // planes if the encoder needs them.
+                p.audioInfo = audio::Info(
+                    info.audio.channelCount,
+                    toAudioType(av_get_packed_sample_fmt(p.avAudioCodecContext->sample_fmt)),
+                    info.audio.sampleRate);
+                if (audio::DataType::None == p.audioInfo.dataType)
+                {
+                    throw std::runtime_error(string::Format("{0}: Incompatible audio encoder").arg(p.fileName));
+                }
+                p.audioResample = audio::AudioResample::create(info.audio, p.audioInfo);
+
+                p.avAudioPacket = av_packet_alloc();
+                if (!p.avAudioPacket)
+                {
+                    throw std::runtime_error(string::Format("{0}: Cannot allocate packet").arg(p.fileName));
+                }
+                p.avAudioFrame = av_frame_alloc();
+                if (!p.avAudioFrame)
+                {
+                    throw std::runtime_error(string::Format("{0}: Cannot allocate frame").arg(p.fileName));
+                }
+            }
+
             for (const auto& i : info.tags)
             {
                 av_dict_set(&p.avFormatContext->metadata, i.first.c_str(), i.second.c_str(), 0);
@@ -186,11 +351,6 @@ namespace tl
                 throw std::runtime_error(string::Format("{0}: {1}").arg(p.fileName).arg(getErrorLabel(r)));
             }
 
-            p.avFrame2 = av_frame_alloc();
-            if (!p.avFrame2)
-            {
-                throw std::runtime_error(string::Format("{0}: Cannot allocate frame").arg(p.fileName));
-            }
             switch (videoInfo.pixelType)
             {
             case image::PixelType::L_U8:     p.avPixelFormatIn = AV_PIX_FMT_GRAY8;  break;
@@ -203,35 +363,48 @@ namespace tl
                 throw std::runtime_error(string::Format("{0}: Incompatible pixel type").arg(p.fileName));
                 break;
             }
-            /*p.swsContext = sws_getContext(
-                videoInfo.size.w,
-                videoInfo.size.h,
-                p.avPixelFormatIn,
-                videoInfo.size.w,
-                videoInfo.size.h,
-                p.avCodecContext->pix_fmt,
-                swsScaleFlags,
-                0,
-                0,
-                0);*/
-            p.swsContext = sws_alloc_context();
-            if (!p.swsContext)
+            if (!p.async)
             {
-                throw std::runtime_error(string::Format("{0}: Cannot allocate context").arg(p.fileName));
+                p.swsContext = createSwsContext(
+                    videoInfo.size,
+                    p.avPixelFormatIn,
+                    p.avCodecContext->pix_fmt,
+                    0);
+                if (!p.swsContext)
+                {
+                    throw std::runtime_error(string::Format("{0}: Cannot initialize sws context").arg(p.fileName));
+                }
             }
-            av_opt_set_defaults(p.swsContext);
-            r = av_opt_set_int(p.swsContext, "srcw", videoInfo.size.w, AV_OPT_SEARCH_CHILDREN);
-            r = av_opt_set_int(p.swsContext, "srch", videoInfo.size.h, AV_OPT_SEARCH_CHILDREN);
-            r = av_opt_set_int(p.swsContext, "src_format", p.avPixelFormatIn, AV_OPT_SEARCH_CHILDREN);
-            r = av_opt_set_int(p.swsContext, "dstw", videoInfo.size.w, AV_OPT_SEARCH_CHILDREN);
-            r = av_opt_set_int(p.swsContext, "dsth", videoInfo.size.h, AV_OPT_SEARCH_CHILDREN);
-            r = av_opt_set_int(p.swsContext, "dst_format", p.avCodecContext->pix_fmt, AV_OPT_SEARCH_CHILDREN);
-            r = av_opt_set_int(p.swsContext, "sws_flags", swsScaleFlags, AV_OPT_SEARCH_CHILDREN);
-            r = av_opt_set_int(p.swsContext, "threads", 0, AV_OPT_SEARCH_CHILDREN);
-            r = sws_init_context(p.swsContext, nullptr, nullptr);
-            if (r < 0)
+            else
             {
-                throw std::runtime_error(string::Format("{0}: Cannot initialize sws context").arg(p.fileName));
+                // Each conversion thread converts whole frames with its own
+                // context, so the contexts are not threaded.
+                for (size_t i = 0; i < p.threadCount; ++i)
+                {
+                    SwsContext* swsContext = createSwsContext(
+                        videoInfo.size,
+                        p.avPixelFormatIn,
+                        p.avCodecContext->pix_fmt,
+                        1);
+                    if (!swsContext)
+                    {
+                        throw std::runtime_error(string::Format("{0}: Cannot initialize sws context").arg(p.fileName));
+                    }
+                    p.swsContexts.push_back(swsContext);
+                }
+                for (size_t i = 0; i < p.threadCount; ++i)
+                {
+                    p.convertThreads.push_back(std::thread(
+                        [this, i]
+                        {
+                            _convertThread(i);
+                        }));
+                }
+                p.encodeThread = std::thread(
+                    [this]
+                    {
+                        _encodeThread();
+                    });
             }
 
             p.opened = true;
@@ -247,17 +420,22 @@ namespace tl
 
             if (p.opened)
             {
-                _encodeVideo(nullptr);
-                av_write_trailer(p.avFormatContext);
+                try
+                {
+                    finish();
+                }
+                catch (const std::exception&)
+                {}
             }
+            _stopThreads();
 
-            if (p.swsContext)
+            for (auto swsContext : p.swsContexts)
             {
-                sws_freeContext(p.swsContext);
+                sws_freeContext(swsContext);
             }
-            if (p.avFrame2)
+            if (p.swsContext)
             {
-                av_frame_free(&p.avFrame2);
+                sws_freeContext(p.swsContext);
             }
             if (p.avFrame)
             {
@@ -267,6 +445,18 @@ namespace tl
             {
                 av_packet_free(&p.avPacket);
             }
+            if (p.avAudioFrame)
+            {
+                av_frame_free(&p.avAudioFrame);
+            }
+            if (p.avAudioPacket)
+            {
+                av_packet_free(&p.avAudioPacket);
+            }
+            if (p.avAudioCodecContext)
+            {
+                avcodec_free_context(&p.avAudioCodecContext);
+            }
             if (p.avCodecContext)
             {
                 avcodec_free_context(&p.avCodecContext);
@@ -298,11 +488,137 @@ namespace tl
             const io::Options&)
         {
             TLRENDER_P();
+            if (p.async)
+            {
+                // Wait for room in the queue.
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    p.cv.wait(
+                        lock,
+                        [this]
+                        {
+                            return
+                                _p->mutex.pending < _p->queueSize ||
+                                !_p->mutex.error.empty();
+                        });
+                    if (!p.mutex.error.empty())
+                    {
+                        throw std::runtime_error(p.mutex.error);
+                    }
+                    Private::Frame frame;
+                    frame.index = p.mutex.writeIndex++;
+                    frame.time = time;
+                    frame.image = image;
+                    p.mutex.frames.push_back(frame);
+                    ++p.mutex.pending;
+                }
+                p.cv.notify_all();
+            }
+            else
+            {
+                _convert(p.swsContext, time, image, p.avFrame);
+                _encodeVideo(p.avFrame);
+            }
+        }
+
+        void Write::writeAudio(
+            const otime::TimeRange& timeRange,
+            const std::shared_ptr<audio::Audio>& audio,
+            const io::Options&)
+        {
+            TLRENDER_P();
+            if (p.avAudioCodecContext && audio)
+            {
+                if (p.audioPts < 0)
+                {
+                    p.audioPts = timeRange.start_time().rescaled_to(p.audioInfo.sampleRate).value();
+                }
+                if (auto resampled = p.audioResample->process(audio))
+                {
+                    p.audioBuffer.push_back(resampled);
+                }
+                const size_t frameSize = p.avAudioCodecContext->frame_size > 0 ?
+                    p.avAudioCodecContext->frame_size :
+                    1024;
+                while (audio::getSampleCount(p.audioBuffer) >= frameSize)
+                {
+                    _encodeAudio(frameSize);
+                }
+            }
+        }
+
+        void Write::finish()
+        {
+            TLRENDER_P();
+            if (!p.opened)
+            {
+                return;
+            }
+            p.opened = false;
+
+            // Wait for the queued frames to be encoded.
+            std::string error;
+            if (p.async)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    p.cv.wait(
+                        lock,
+                        [this]
+                        {
+                            return 0 == _p->mutex.pending;
+                        });
+                    error = p.mutex.error;
+                }
+                _stopThreads();
+            }
+
+            if (error.empty())
+            {
+                try
+                {
+                    // Encode the remaining audio and flush the encoders.
+                    if (p.avAudioCodecContext)
+                    {
+                        const size_t sampleCount = audio::getSampleCount(p.audioBuffer);
+                        if (sampleCount > 0)
+                        {
+                            _encodeAudio(sampleCount);
+                        }
+                        _encode(p.avAudioCodecContext, p.avAudioStream, p.avAudioPacket, nullptr);
+                    }
+                    _encodeVideo(nullptr);
+                }
+                catch (const std::exception& e)
+                {
+                    error = e.what();
+                }
+            }
+            const int r = av_write_trailer(p.avFormatContext);
+            if (!error.empty())
+            {
+                throw std::runtime_error(error);
+            }
+            if (r < 0)
+            {
+                throw std::runtime_error(string::Format("{0}: {1}").arg(p.fileName).arg(getErrorLabel(r)));
+            }
+        }
+
+        void Write::_convert(
+            SwsContext* swsContext,
+            const otime::RationalTime& time,
+            const std::shared_ptr<image::Image>& image,
+            AVFrame* avFrame)
+        {
+            TLRENDER_P();
 
             const auto& info = image->getInfo();
+            uint8_t* data[4] = { nullptr, nullptr, nullptr, nullptr };
+            int linesize[4] = { 0, 0, 0, 0 };
             av_image_fill_arrays(
-                p.avFrame2->data,
-                p.avFrame2->linesize,
+                data,
+                linesize,
                 image->getData(),
                 p.avPixelFormatIn,
                 info.size.w,
@@ -319,8 +635,8 @@ namespace tl
                 const size_t channelCount = image::getChannelCount(info.pixelType);
                 for (size_t i = 0; i < channelCount; i++)
                 {
-                    p.avFrame2->data[i] += p.avFrame2->linesize[i] * (info.size.h - 1);
-                    p.avFrame2->linesize[i] = -p.avFrame2->linesize[i];
+                    data[i] += linesize[i] * (info.size.h - 1);
+                    linesize[i] = -linesize[i];
                 }
                 break;
             }
@@ -337,27 +653,90 @@ namespace tl
             }
 
             sws_scale(
-                p.swsContext,
-                (uint8_t const* const*)p.avFrame2->data,
-                p.avFrame2->linesize,
+                swsContext,
+                (uint8_t const* const*)data,
+                linesize,
                 0,
                 p.avVideoStream->codecpar->height,
-                p.avFrame->data,
-                p.avFrame->linesize);
+                avFrame->data,
+                avFrame->linesize);
 
             const auto timeRational = time::toRational(time.rate());
-            p.avFrame->pts = av_rescale_q(
+            avFrame->pts = av_rescale_q(
                 time.value(),
                 { timeRational.second, timeRational.first },
-                p.avVideoStream->time_base);
-            _encodeVideo(p.avFrame);
+                p.avCodecContext->time_base);
         }
 
         void Write::_encodeVideo(AVFrame* frame)
         {
             TLRENDER_P();
+            _encode(p.avCodecContext, p.avVideoStream, p.avPacket, frame);
+        }
 
-            int r = avcodec_send_frame(p.avCodecContext, frame);
+        void Write::_encodeAudio(size_t sampleCount)
+        {
+            TLRENDER_P();
+
+            // Encoders only allow the last frame to be smaller than the
+            // frame size, unless they say otherwise, so pad it with
+            // silence.
+            size_t frameSampleCount = sampleCount;
+            if (p.avAudioCodecContext->frame_size > 0 &&
+                !(p.avAudioCodecContext->codec->capabilities & AV_CODEC_CAP_SMALL_LAST_FRAME))
+            {
+                frameSampleCount = std::max(
+                    sampleCount,
+                    static_cast<size_t>(p.avAudioCodecContext->frame_size));
+            }
+            auto audio = audio::Audio::create(p.audioInfo, frameSampleCount);
+            audio->zero();
+            audio::move(p.audioBuffer, audio->getData(), sampleCount * p.audioInfo.getByteCount());
+
+            av_frame_unref(p.avAudioFrame);
+            p.avAudioFrame->format = p.avAudioCodecContext->sample_fmt;
+            p.avAudioFrame->sample_rate = p.avAudioCodecContext->sample_rate;
+            p.avAudioFrame->nb_samples = frameSampleCount;
+            int r = av_channel_layout_copy(&p.avAudioFrame->ch_layout, &p.avAudioCodecContext->ch_layout);
+            if (r >= 0)
+            {
+                r = av_frame_get_buffer(p.avAudioFrame, 0);
+            }
+            if (r < 0)
+            {
+                throw std::runtime_error(string::Format("{0}: {1}").arg(p.fileName).arg(getErrorLabel(r)));
+            }
+            if (av_sample_fmt_is_planar(p.avAudioCodecContext->sample_fmt))
+            {
+                const auto planar = audio::planarDeinterleave(audio);
+                const size_t planeByteCount = frameSampleCount * audio::getByteCount(p.audioInfo.dataType);
+                for (size_t i = 0; i < p.audioInfo.channelCount; ++i)
+                {
+                    memcpy(
+                        p.avAudioFrame->extended_data[i],
+                        planar->getData() + i * planeByteCount,
+                        planeByteCount);
+                }
+            }
+            else
+            {
+                memcpy(p.avAudioFrame->data[0], audio->getData(), audio->getByteCount());
+            }
+            p.avAudioFrame->pts = p.audioPts;
+            p.audioPts += frameSampleCount;
+
+            _encode(p.avAudioCodecContext, p.avAudioStream, p.avAudioPacket, p.avAudioFrame);
+        }
+
+        void Write::_encode(
+            AVCodecContext* avCodecContext,
+            AVStream* avStream,
+            AVPacket* avPacket,
+            AVFrame* frame)
+        {
+            TLRENDER_P();
+
+            int r = avcodec_send_frame(avCodecContext, frame);
             if (r < 0)
             {
                 throw std::runtime_error(string::Format("{0}: Cannot write frame").arg(p.fileName));
@@ -365,7 +744,7 @@ namespace tl
 
             while (r >= 0)
             {
-                r = avcodec_receive_packet(p.avCodecContext, p.avPacket);
+                r = avcodec_receive_packet(avCodecContext, avPacket);
                 if (r == AVERROR(EAGAIN) || r == AVERROR_EOF)
                 {
                     return;
@@ -374,13 +753,173 @@ namespace tl
                 {
                     throw std::runtime_error(string::Format("{0}: Cannot write frame").arg(p.fileName));
                 }
-                r = av_interleaved_write_frame(p.avFormatContext, p.avPacket);
+                av_packet_rescale_ts(avPacket, avCodecContext->time_base, avStream->time_base);
+                avPacket->stream_index = avStream->index;
+                {
+                    std::unique_lock<std::mutex> lock(p.muxMutex);
+                    r = av_interleaved_write_frame(p.avFormatContext, avPacket);
+                }
                 if (r < 0)
                 {
                     throw std::runtime_error(string::Format("{0}: Cannot write frame").arg(p.fileName));
                 }
-                av_packet_unref(p.avPacket);
+                av_packet_unref(avPacket);
+            }
+        }
+
+        void Write::_convertThread(size_t index)
+        {
+            TLRENDER_P();
+            SwsContext* swsContext = p.swsContexts[index];
+            while (true)
+            {
+                Private::Frame frame;
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    p.cv.wait(
+                        lock,
+                        [this]
+                        {
+                            return
+                                !_p->mutex.frames.empty() ||
+                                _p->mutex.stop;
+                        });
+                    if (p.mutex.frames.empty())
+                    {
+                        break;
+                    }
+                    frame = p.mutex.frames.front();
+                    p.mutex.frames.pop_front();
+                }
+
+                AVFrame* avFrame = nullptr;
+                std::string error;
+                try
+                {
+                    avFrame = av_frame_alloc();
+                    if (!avFrame)
+                    {
+                        throw std::runtime_error(string::Format("{0}: Cannot allocate frame").arg(p.fileName));
+                    }
+                    avFrame->format = p.avVideoStream->codecpar->format;
+                    avFrame->width = p.avVideoStream->codecpar->width;
+                    avFrame->height = p.avVideoStream->codecpar->height;
+                    const int r = av_frame_get_buffer(avFrame, 0);
+                    if (r < 0)
+                    {
+                        throw std::runtime_error(string::Format("{0}: {1}").arg(p.fileName).arg(getErrorLabel(r)));
+                    }
+                    _convert(swsContext, frame.time, frame.image, avFrame);
+                }
+                catch (const std::exception& e)
+                {
+                    error = e.what();
+                    if (avFrame)
+                    {
+                        av_frame_free(&avFrame);
+                    }
+                }
+                frame.image.reset();
+
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    p.mutex.converted[frame.index] = avFrame;
+                    if (!error.empty() && p.mutex.error.empty())
+                    {
+                        p.mutex.error = error;
+                    }
+                }
+                p.cv.notify_all();
+            }
+        }
+
+        void Write::_encodeThread()
+        {
+            TLRENDER_P();
+            while (true)
+            {
+                // Encode the frames in the order they were written.
+                AVFrame* avFrame = nullptr;
+                bool encode = false;
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    p.cv.wait(
+                        lock,
+                        [this]
+                        {
+                            return
+                                _p->mutex.converted.find(_p->mutex.encodeIndex) != _p->mutex.converted.end() ||
+                                _p->mutex.stop;
+                        });
+                    const auto i = p.mutex.converted.find(p.mutex.encodeIndex);
+                    if (i == p.mutex.converted.end())
+                    {
+                        break;
+                    }
+                    avFrame = i->second;
+                    p.mutex.converted.erase(i);
+                    ++p.mutex.encodeIndex;
+                    encode = avFrame && p.mutex.error.empty();
+                }
+
+                std::string error;
+                if (encode)
+                {
+                    try
+                    {
+                        _encodeVideo(avFrame);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        error = e.what();
+                    }
+                }
+                if (avFrame)
+                {
+                    av_frame_free(&avFrame);
+                }
+
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    --p.mutex.pending;
+                    if (!error.empty() && p.mutex.error.empty())
+                    {
+                        p.mutex.error = error;
+                    }
+                }
+                p.cv.notify_all();
+            }
+        }
+
+        void Write::_stopThreads()
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.stop = true;
+            }
+            p.cv.notify_all();
+            for (auto& thread : p.convertThreads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+            p.convertThreads.clear();
+            if (p.encodeThread.joinable())
+            {
+                p.encodeThread.join();
+            }
+            for (const auto& i : p.mutex.converted)
+            {
+                AVFrame* avFrame = i.second;
+                if (avFrame)
+                {
+                    av_frame_free(&avFrame);
+                }
             }
+            p.mutex.converted.clear();
         }
     }
 }
@@ -4,6 +4,13 @@
 
 #include <tlIO/IO.h>
 
+#include <tlCore/Math.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
 namespace tl
 {
     namespace io
@@ -17,5 +24,58 @@ namespace tl
             }
             return out;
         }
+
+        int getProxyLevel(const Options& options)
+        {
+            int out = 0;
+            const auto i = options.find("Proxy");
+            if (i != options.end())
+            {
+                out = math::clamp(std::atoi(i->second.c_str()), 0, proxyLevelMax);
+            }
+            return out;
+        }
+
+        int getProxyLevel(double scale)
+        {
+            int out = 0;
+            if (scale > 0.0 && scale < 1.0)
+            {
+                out = std::min(
+                    static_cast<int>(std::floor(std::log2(1.0 / scale))),
+                    proxyLevelMax);
+            }
+            return out;
+        }
+
+        bool getROI(const Options& options, math::Box2i& out)
+        {
+            bool valid = false;
+            const auto i = options.find("ROI");
+            if (i != options.end())
+            {
+                try
+                {
+                    std::stringstream ss(i->second);
+                    math::Box2i box;
+                    ss >> box;
+                    if (box.isValid() && box.min.x >= 0 && box.min.y >= 0)
+                    {
+                        out = box;
+                        valid = true;
+                    }
+                }
+                catch (const std::exception&)
+                {}
+            }
+            return valid;
+        }
+
+        std::string getROIOption(const math::Box2i& value)
+        {
+            std::stringstream ss;
+            ss << value;
+            return ss.str();
+        }
     }
 }
@@ -82,10 +82,45 @@ namespace tl
         };
 
         //! Options.
+        //!
+        //! The "Direction" option is a playback direction hint, either
+        //! "Forward" or "Reverse", that readers may use to decode frames in
+        //! a more efficient order.
+        //!
+        //! The "Proxy" option is a resolution level, where each level halves
+        //! the width and height of the video (see image::getProxySize()).
+        //! Readers decode the smaller resolution directly when they can,
+        //! otherwise the decoded image is filtered with image::createProxy().
+        //! Images it does not support (for example RGB_U10) are returned at
+        //! full resolution, so check the image size. Movies are always
+        //! returned at full resolution, filtering them would hold up the
+        //! decoder thread.
+        //!
+        //! The "ROI" option is a region of interest in image coordinates
+        //! (see getROIOption()). Readers that can decode part of an image
+        //! return a region (see image::Image::setRegion()) that covers at
+        //! least the region of interest, other readers ignore it.
         typedef std::map<std::string, std::string> Options;
 
         //! Merge options.
         Options merge(const Options&, const Options&);
+
+        //! Maximum proxy level.
+        const int proxyLevelMax = 8;
+
+        //! Get the proxy level from the "Proxy" option.
+        int getProxyLevel(const Options&);
+
+        //! Get the proxy level for a display scale. This is the smallest
+        //! resolution that is not less than the display resolution.
+        int getProxyLevel(double scale);
+
+        //! Get the region of interest from the "ROI" option. Returns false
+        //! if the option is not set or is not valid.
+        bool getROI(const Options&, math::Box2i&);
+
+        //! Get the "ROI" option value for a region of interest.
+        std::string getROIOption(const math::Box2i&);
     }
 }
 
@@ -41,6 +41,7 @@ namespace tl
                 const std::vector<file::MemoryRead>&,
                 const io::Options&,
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
             Read();
@@ -53,6 +54,7 @@ namespace tl
                 const file::Path&,
                 const io::Options&,
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
             //! Create a new reader.
@@ -61,6 +63,7 @@ namespace tl
                 const std::vector<file::MemoryRead>&,
                 const io::Options&,
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
         protected:
@@ -117,6 +120,7 @@ namespace tl
             //! Create a new plugin.
             static std::shared_ptr<Plugin> create(
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
             std::shared_ptr<io::IRead> read(
@@ -7,6 +7,7 @@
 #include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
 
+#include <algorithm>
 #include <cstring>
 
 namespace tl
@@ -29,6 +30,7 @@ namespace tl
 
             bool jpegOpen(
                 FILE* f,
+                unsigned int scaleDenom,
                 jpeg_decompress_struct* decompress,
                 ErrorStruct* error)
             {
@@ -42,6 +44,8 @@ namespace tl
                 {
                     return false;
                 }
+                decompress->scale_num = 1;
+                decompress->scale_denom = scaleDenom;
                 if (!jpeg_start_decompress(decompress))
                 {
                     return false;
@@ -52,6 +56,7 @@ namespace tl
             bool jpegOpen(
                 const uint8_t* memoryPtr,
                 size_t memorySize,
+                unsigned int scaleDenom,
                 jpeg_decompress_struct* decompress,
                 ErrorStruct* error)
             {
@@ -65,6 +70,8 @@ namespace tl
                 {
                     return false;
                 }
+                decompress->scale_num = 1;
+                decompress->scale_denom = scaleDenom;
                 if (!jpeg_start_decompress(decompress))
                 {
                     return false;
@@ -106,8 +113,13 @@ namespace tl
             public:
                 File(
                     const std::string& fileName,
-                    const file::MemoryRead* memory)
+                    const file::MemoryRead* memory,
+                    int proxyLevel = 0)
                 {
+                    // Proxy levels are decoded with DCT scaling, which
+                    // supports up to 1/8 scale.
+                    const unsigned int scaleDenom = 1 << std::min(proxyLevel, 3);
+
                     std::memset(&_jpeg.decompress, 0, sizeof(jpeg_decompress_struct));
 
                     _jpeg.decompress.err = jpeg_std_error(&_error.pub);
@@ -119,7 +131,7 @@ namespace tl
                     }
                     if (memory)
                     {
-                        if (!jpegOpen(memory->p, memory->size, &_jpeg.decompress, &_error))
+                        if (!jpegOpen(memory->p, memory->size, scaleDenom, &_jpeg.decompress, &_error))
                         {
                             throw std::runtime_error(string::Format("{0}: Cannot open").arg(fileName));
                         }
@@ -138,7 +150,7 @@ namespace tl
                         {
                             throw std::runtime_error(string::Format("{0}: Cannot open").arg(fileName));
                         }
-                        if (!jpegOpen(_f.p, &_jpeg.decompress, &_error))
+                        if (!jpegOpen(_f.p, scaleDenom, &_jpeg.decompress, &_error))
                         {
                             throw std::runtime_error(string::Format("{0}: Cannot open").arg(fileName));
                         }
@@ -174,7 +186,9 @@ namespace tl
                     out.time = time;
                     const auto& info = _info.video[0];
                     out.image = image::Image::create(info);
-                    out.image->setTags(_info.tags);
+                    // The file is only read once, so move the tags instead of
+                    // copying them.
+                    out.image->setTags(std::move(_info.tags));
 
                     std::size_t scanlineByteCount = 0;
                     switch (info.pixelType)
@@ -235,9 +249,10 @@ namespace tl
             const std::vector<file::MemoryRead>& memory,
             const io::Options& options,
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
-            ISequenceRead::_init(path, memory, options, cache, logSystem);
+            ISequenceRead::_init(path, memory, options, cache, decodePool, logSystem);
         }
 
         Read::Read()
@@ -252,10 +267,11 @@ namespace tl
             const file::Path& path,
             const io::Options& options,
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             auto out = std::shared_ptr<Read>(new Read);
-            out->_init(path, {}, options, cache, logSystem);
+            out->_init(path, {}, options, cache, decodePool, logSystem);
             return out;
         }
 
@@ -264,10 +280,11 @@ namespace tl
             const std::vector<file::MemoryRead>& memory,
             const io::Options& options,
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             auto out = std::shared_ptr<Read>(new Read);
-            out->_init(path, memory, options, cache, logSystem);
+            out->_init(path, memory, options, cache, decodePool, logSystem);
             return out;
         }
 
@@ -286,9 +303,9 @@ namespace tl
             const std::string& fileName,
             const file::MemoryRead* memory,
             const otime::RationalTime& time,
-            const io::Options&)
+            const io::Options& options)
         {
-            return File(fileName, memory).read(fileName, time);
+            return File(fileName, memory, io::getProxyLevel(options)).read(fileName, time);
         }
     }
 }
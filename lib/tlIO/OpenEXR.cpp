@@ -17,7 +17,9 @@
 #include <ImfStdIO.h>
 #include <ImfThreading.h>
 
+#include <algorithm>
 #include <array>
+#include <thread>
 
 namespace tl
 {
@@ -838,15 +840,22 @@ namespace tl
 
         void Plugin::_init(
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             IPlugin::_init(
                 "OpenEXR",
                 { { ".exr", io::FileType::Sequence } },
                 cache,
+                decodePool,
                 logSystem);
 
-            Imf::setGlobalThreadCount(0);
+            // The OpenEXR thread pool is used for the chunk threads of
+            // the frame at the playhead, other frames are decoded without
+            // it (see io::sequenceChunkThreadsOption).
+            Imf::setGlobalThreadCount(decodePool ?
+                decodePool->getThreadCount() :
+                std::max(std::thread::hardware_concurrency(), 1U));
         }
 
         Plugin::Plugin()
@@ -854,10 +863,11 @@ namespace tl
             
         std::shared_ptr<Plugin> Plugin::create(
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             auto out = std::shared_ptr<Plugin>(new Plugin);
-            out->_init(cache, logSystem);
+            out->_init(cache, decodePool, logSystem);
             return out;
         }
 
@@ -865,7 +875,7 @@ namespace tl
             const file::Path& path,
             const io::Options& options)
         {
-            return Read::create(path, options, _cache, _logSystem);
+            return Read::create(path, options, _cache, _decodePool, _logSystem);
         }
 
         std::shared_ptr<io::IRead> Plugin::read(
@@ -873,7 +883,7 @@ namespace tl
             const std::vector<file::MemoryRead>& memory,
             const io::Options& options)
         {
-            return Read::create(path, memory, options, _cache, _logSystem);
+            return Read::create(path, memory, options, _cache, _decodePool, _logSystem);
         }
 
         image::Info Plugin::getWriteInfo(
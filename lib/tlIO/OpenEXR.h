@@ -53,6 +53,7 @@ namespace tl
                 const std::vector<file::MemoryRead>&,
                 const io::Options&,
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
             Read();
@@ -65,6 +66,7 @@ namespace tl
                 const file::Path&,
                 const io::Options&,
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
             //! Create a new reader.
@@ -73,6 +75,7 @@ namespace tl
                 const std::vector<file::MemoryRead>&,
                 const io::Options&,
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
         protected:
@@ -129,6 +132,7 @@ namespace tl
         protected:
             void _init(
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
             Plugin();
@@ -137,6 +141,7 @@ namespace tl
             //! Create a new plugin.
             static std::shared_ptr<Plugin> create(
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
             std::shared_ptr<io::IRead> read(
@@ -80,6 +80,7 @@ namespace tl
         public:
             IStream(const std::string& fileName);
             IStream(const std::string& fileName, const uint8_t*, size_t);
+            IStream(const std::shared_ptr<file::FileIO>&);
 
             virtual ~IStream();
 
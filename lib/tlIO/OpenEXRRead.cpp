@@ -10,6 +10,7 @@
 
 #include <ImfChannelList.h>
 #include <ImfRgbaFile.h>
+#include <ImfTiledInputFile.h>
 
 #include <array>
 #include <cstring>
@@ -45,6 +46,16 @@ namespace tl
             p.size = memorySize;
         }
 
+        IStream::IStream(const std::shared_ptr<file::FileIO>& f) :
+            Imf::IStream(f->getFileName().c_str()),
+            _p(new Private)
+        {
+            TLRENDER_P();
+            p.f = f;
+            p.p = p.f->getMemoryP();
+            p.size = p.f->getSize();
+        }
+
         IStream::~IStream()
         {}
 
@@ -139,26 +150,27 @@ namespace tl
             public:
                 File(
                     const std::string& fileName,
-                    const file::MemoryRead* memory,
+                    const std::shared_ptr<file::FileIO>& io,
                     ChannelGrouping channelGrouping,
+                    int threadCount,
                     const std::weak_ptr<log::System>& logSystemWeak)
                 {
                     // Open the file.
-                    if (memory)
-                    {
-                        _s.reset(new IStream(fileName.c_str(), memory->p, memory->size));
-                    }
-                    else
-                    {
-                        _s.reset(new IStream(fileName.c_str()));
-                    }
-                    _f.reset(new Imf::InputFile(*_s));
+                    _s.reset(new IStream(io));
+                    _f.reset(new Imf::InputFile(*_s, threadCount));
+                    _threadCount = threadCount;
 
                     // Get the display and data windows.
                     _displayWindow = fromImath(_f->header().displayWindow());
                     _dataWindow = fromImath(_f->header().dataWindow());
                     _intersectedWindow = _displayWindow.intersect(_dataWindow);
                     _fast = _displayWindow == _dataWindow;
+                    _tiled = _f->header().hasTileDescription();
+                    if (_tiled)
+                    {
+                        const Imf::LevelMode levelMode = _f->header().tileDescription().mode;
+                        _multiResolution = Imf::MIPMAP_LEVELS == levelMode || Imf::RIPMAP_LEVELS == levelMode;
+                    }
 
                     if (auto logSystem = logSystemWeak.lock())
                     {
@@ -242,37 +254,113 @@ namespace tl
                             static_cast<int>(_info.video.size()) - 1);
                     }
                     image::Info imageInfo = _info.video[layer];
-                    out.image = image::Image::create(imageInfo);
-                    out.image->setTags(_info.tags);
                     const size_t channels = image::getChannelCount(imageInfo.pixelType);
                     const size_t channelByteCount = image::getBitDepth(imageInfo.pixelType) / 8;
                     const size_t cb = channels * channelByteCount;
-                    const size_t scb = imageInfo.size.w * channels * channelByteCount;
-                    if (_fast)
+                    const int proxyLevel = io::getProxyLevel(options);
+                    math::Box2i roi;
+                    if (proxyLevel > 0 && _multiResolution && _fast)
                     {
-                        Imf::FrameBuffer frameBuffer;
-                        for (size_t c = 0; c < channels; ++c)
+                        // Read the proxy from the mip or rip map levels.
+                        _s->seekg(0);
+                        Imf::TiledInputFile tiled(*_s, _threadCount);
+                        const int level = std::min(
+                            proxyLevel,
+                            std::min(tiled.numXLevels(), tiled.numYLevels()) - 1);
+                        const math::Box2i levelWindow = fromImath(tiled.dataWindowForLevel(level, level));
+                        imageInfo.size.w = levelWindow.w();
+                        imageInfo.size.h = levelWindow.h();
+                        out.image = image::Image::create(imageInfo);
+                        out.image->setTags(std::move(_info.tags));
+                        tiled.setFrameBuffer(_getFrameBuffer(layer, out.image->getData(), levelWindow, cb, channelByteCount));
+                        tiled.readTiles(
+                            0, tiled.numXTiles(level) - 1,
+                            0, tiled.numYTiles(level) - 1,
+                            level, level);
+                        return out;
+                    }
+                    else if (0 == proxyLevel && _fast && io::getROI(options, roi))
+                    {
+                        // Read the tiles or scanlines that intersect the
+                        // region of interest.
+                        roi = math::Box2i(roi.min + _dataWindow.min, roi.max + _dataWindow.min).intersect(_dataWindow);
+                        if (roi.isValid() && roi != _dataWindow)
                         {
-                            const std::string& name = _layers[layer].channels[c].name;
-                            const math::Vector2i& sampling = _layers[layer].channels[c].sampling;
-                            frameBuffer.insert(
-                                name.c_str(),
-                                Imf::Slice(
-                                    _layers[layer].channels[c].pixelType,
-                                    reinterpret_cast<char*>(out.image->getData()) + (c * channelByteCount),
-                                    cb,
-                                    scb,
-                                    sampling.x,
-                                    sampling.y,
-                                    0.F));
+                            std::unique_ptr<Imf::TiledInputFile> tiled;
+                            math::Box2i region(
+                                math::Vector2i(_dataWindow.min.x, roi.min.y),
+                                math::Vector2i(_dataWindow.max.x, roi.max.y));
+                            math::Box2i tiles;
+                            if (_tiled)
+                            {
+                                _s->seekg(0);
+                                tiled.reset(new Imf::TiledInputFile(*_s, _threadCount));
+                                const Imf::TileDescription& td = tiled->header().tileDescription();
+                                tiles.min.x = (roi.min.x - _dataWindow.min.x) / static_cast<int>(td.xSize);
+                                tiles.min.y = (roi.min.y - _dataWindow.min.y) / static_cast<int>(td.ySize);
+                                tiles.max.x = (roi.max.x - _dataWindow.min.x) / static_cast<int>(td.xSize);
+                                tiles.max.y = (roi.max.y - _dataWindow.min.y) / static_cast<int>(td.ySize);
+                                region.min.x = _dataWindow.min.x + tiles.min.x * td.xSize;
+                                region.min.y = _dataWindow.min.y + tiles.min.y * td.ySize;
+                                region.max.x = std::min(
+                                    _dataWindow.min.x + (tiles.max.x + 1) * static_cast<int>(td.xSize) - 1,
+                                    _dataWindow.max.x);
+                                region.max.y = std::min(
+                                    _dataWindow.min.y + (tiles.max.y + 1) * static_cast<int>(td.ySize) - 1,
+                                    _dataWindow.max.y);
+                            }
+                            imageInfo.size.w = region.w();
+                            imageInfo.size.h = region.h();
+                            out.image = image::Image::create(imageInfo);
+                            out.image->setTags(std::move(_info.tags));
+                            out.image->setRegion(_info.video[layer].size, region.min - _dataWindow.min);
+                            const Imf::FrameBuffer frameBuffer = _getFrameBuffer(
+                                layer,
+                                out.image->getData(),
+                                region,
+                                cb,
+                                channelByteCount);
+                            if (tiled)
+                            {
+                                tiled->setFrameBuffer(frameBuffer);
+                                tiled->readTiles(tiles.min.x, tiles.max.x, tiles.min.y, tiles.max.y);
+                            }
+                            else
+                            {
+                                _f->setFrameBuffer(frameBuffer);
+                                _f->readPixels(region.min.y, region.max.y);
+                            }
+                            return out;
                         }
-                        _f->setFrameBuffer(frameBuffer);
+                    }
+                    out.image = image::Image::create(imageInfo);
+                    out.image->setTags(std::move(_info.tags));
+                    const size_t scb = imageInfo.size.w * channels * channelByteCount;
+                    if (_fast)
+                    {
+                        _f->setFrameBuffer(_getFrameBuffer(layer, out.image->getData(), _dataWindow, cb, channelByteCount));
                         _f->readPixels(_displayWindow.min.y, _displayWindow.max.y);
                     }
                     else
                     {
+                        // Read the intersected scanlines with a single
+                        // call, so the chunks can be decoded in parallel.
+                        // Sub-sampled channels are read a scanline at a
+                        // time.
+                        bool subsampled = false;
+                        for (size_t c = 0; c < channels; ++c)
+                        {
+                            const math::Vector2i& sampling = _layers[layer].channels[c].sampling;
+                            if (sampling.x != 1 || sampling.y != 1)
+                            {
+                                subsampled = true;
+                            }
+                        }
+                        const bool valid = _intersectedWindow.isValid();
+                        const size_t bufScanlineSize = _dataWindow.w() * cb;
+                        const size_t bufHeight = subsampled ? 1 : (valid ? _intersectedWindow.h() : 0);
+                        std::vector<char> buf(bufScanlineSize * bufHeight);
                         Imf::FrameBuffer frameBuffer;
-                        std::vector<char> buf(_dataWindow.w() * cb);
                         for (int c = 0; c < channels; ++c)
                         {
                             const std::string& name = _layers[layer].channels[c].name;
@@ -281,14 +369,21 @@ namespace tl
                                 name.c_str(),
                                 Imf::Slice(
                                     _layers[layer].channels[c].pixelType,
-                                    buf.data() - (_dataWindow.min.x * cb) + (c * channelByteCount),
+                                    buf.data() -
+                                        (_dataWindow.min.x * cb) -
+                                        (subsampled ? 0 : _intersectedWindow.min.y * bufScanlineSize) +
+                                        (c * channelByteCount),
                                     cb,
-                                    0,
+                                    subsampled ? 0 : bufScanlineSize,
                                     sampling.x,
                                     sampling.y,
                                     0.F));
                         }
                         _f->setFrameBuffer(frameBuffer);
+                        if (!subsampled && valid)
+                        {
+                            _f->readPixels(_intersectedWindow.min.y, _intersectedWindow.max.y);
+                        }
                         for (int y = _displayWindow.min.y; y <= _displayWindow.max.y; ++y)
                         {
                             uint8_t* p = out.image->getData() + ((y - _displayWindow.min.y) * scb);
@@ -299,10 +394,15 @@ namespace tl
                                 std::memset(p, 0, size);
                                 p += size;
                                 size = _intersectedWindow.w() * cb;
-                                _f->readPixels(y, y);
+                                if (subsampled)
+                                {
+                                    _f->readPixels(y, y);
+                                }
                                 std::memcpy(
                                     p,
-                                    buf.data() + std::max(_displayWindow.min.x - _dataWindow.min.x, 0) * cb,
+                                    buf.data() +
+                                        (subsampled ? 0 : (y - _intersectedWindow.min.y) * bufScanlineSize) +
+                                        std::max(_displayWindow.min.x - _dataWindow.min.x, 0) * cb,
                                     size);
                                 p += size;
                             }
@@ -313,9 +413,39 @@ namespace tl
                 }
 
             private:
+                // Get a frame buffer for reading the given window into
+                // interleaved image data.
+                Imf::FrameBuffer _getFrameBuffer(
+                    int layer,
+                    uint8_t* data,
+                    const math::Box2i& window,
+                    size_t cb,
+                    size_t channelByteCount) const
+                {
+                    Imf::FrameBuffer out;
+                    const size_t scb = window.w() * cb;
+                    for (size_t c = 0; c < _layers[layer].channels.size(); ++c)
+                    {
+                        out.insert(
+                            _layers[layer].channels[c].name.c_str(),
+                            Imf::Slice(
+                                _layers[layer].channels[c].pixelType,
+                                reinterpret_cast<char*>(data) -
+                                    (window.min.x * cb) -
+                                    (window.min.y * scb) +
+                                    (c * channelByteCount),
+                                cb,
+                                scb));
+                    }
+                    return out;
+                }
+
                 ChannelGrouping                 _channelGrouping = ChannelGrouping::Known;
                 std::unique_ptr<Imf::IStream>   _s;
                 std::unique_ptr<Imf::InputFile> _f;
+                int                             _threadCount = 0;
+                bool                            _tiled = false;
+                bool                            _multiResolution = false;
                 math::Box2i                    _displayWindow;
                 math::Box2i                    _dataWindow;
                 math::Box2i                    _intersectedWindow;
@@ -330,9 +460,10 @@ namespace tl
             const std::vector<file::MemoryRead>& memory,
             const io::Options& options,
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
-            ISequenceRead::_init(path, memory, options, cache, logSystem);
+            ISequenceRead::_init(path, memory, options, cache, decodePool, logSystem);
 
             auto option = options.find("OpenEXR/ChannelGrouping");
             if (option != options.end())
@@ -354,10 +485,11 @@ namespace tl
             const file::Path& path,
             const io::Options& options,
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             auto out = std::shared_ptr<Read>(new Read);
-            out->_init(path, {}, options, cache, logSystem);
+            out->_init(path, {}, options, cache, decodePool, logSystem);
             return out;
         }
 
@@ -366,10 +498,11 @@ namespace tl
             const std::vector<file::MemoryRead>& memory,
             const io::Options& options,
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             auto out = std::shared_ptr<Read>(new Read);
-            out->_init(path, memory, options, cache, logSystem);
+            out->_init(path, memory, options, cache, decodePool, logSystem);
             return out;
         }
 
@@ -377,7 +510,7 @@ namespace tl
             const std::string& fileName,
             const file::MemoryRead* memory)
         {
-            io::Info out = File(fileName, memory, _channelGrouping, _logSystem.lock()).getInfo();
+            io::Info out = File(fileName, _openFile(fileName, memory), _channelGrouping, 0, _logSystem.lock()).getInfo();
             float speed = _defaultSpeed;
             const auto i = out.tags.find("Frame Per Second");
             if (i != out.tags.end())
@@ -396,7 +529,18 @@ namespace tl
             const otime::RationalTime& time,
             const io::Options& options)
         {
-            return File(fileName, memory, _channelGrouping, _logSystem).read(fileName, time, options);
+            int threadCount = 0;
+            const auto i = options.find(io::sequenceChunkThreadsOption);
+            if (i != options.end())
+            {
+                threadCount = std::atoi(i->second.c_str());
+            }
+            return File(
+                fileName,
+                _openFile(fileName, memory),
+                _channelGrouping,
+                threadCount,
+                _logSystem).read(fileName, time, options);
         }
     }
 }
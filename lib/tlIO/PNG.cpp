@@ -31,6 +31,7 @@ namespace tl
 
         std::shared_ptr<Plugin> Plugin::create(
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             auto out = std::shared_ptr<Plugin>(new Plugin);
@@ -38,6 +39,7 @@ namespace tl
                 "PNG",
                 { { ".png", io::FileType::Sequence } },
                 cache,
+                decodePool,
                 logSystem);
             return out;
         }
@@ -46,7 +48,7 @@ namespace tl
             const file::Path& path,
             const io::Options& options)
         {
-            return Read::create(path, options, _cache, _logSystem);
+            return Read::create(path, options, _cache, _decodePool, _logSystem);
         }
 
         std::shared_ptr<io::IRead> Plugin::read(
@@ -54,7 +56,7 @@ namespace tl
             const std::vector<file::MemoryRead>& memory,
             const io::Options& options)
         {
-            return Read::create(path, memory, options, _cache, _logSystem);
+            return Read::create(path, memory, options, _cache, _decodePool, _logSystem);
         }
 
         image::Info Plugin::getWriteInfo(
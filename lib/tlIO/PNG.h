@@ -37,6 +37,7 @@ namespace tl
                 const std::vector<file::MemoryRead>&,
                 const io::Options&,
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
             Read();
@@ -49,6 +50,7 @@ namespace tl
                 const file::Path&,
                 const io::Options&,
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
             //! Create a new reader.
@@ -57,6 +59,7 @@ namespace tl
                 const std::vector<file::MemoryRead>&,
                 const io::Options&,
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
         protected:
@@ -110,6 +113,7 @@ namespace tl
             //! Create a new plugin.
             static std::shared_ptr<Plugin> create(
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
             std::shared_ptr<io::IRead> read(
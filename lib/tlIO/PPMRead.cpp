@@ -15,11 +15,9 @@ namespace tl
             class File
             {
             public:
-                File(const std::string& fileName, const file::MemoryRead* memory)
+                File(const std::string& fileName, const std::shared_ptr<file::FileIO>& io) :
+                    _io(io)
                 {
-                    _io = memory ?
-                        file::FileIO::create(fileName, *memory) :
-                        file::FileIO::create(fileName, file::Mode::Read);
 
                     char magic[] = { 0, 0, 0 };
                     _io->read(magic, 2);
@@ -87,6 +85,15 @@ namespace tl
                     _info.layout.endian = _data != Data::ASCII ? memory::Endian::MSB : memory::getEndian();
                 }
 
+                File(
+                    const std::shared_ptr<file::FileIO>& io,
+                    const image::Info& info,
+                    Data data) :
+                    _io(io),
+                    _data(data),
+                    _info(info)
+                {}
+
                 Data getData() const
                 {
                     return _data;
@@ -142,9 +149,10 @@ namespace tl
             const std::vector<file::MemoryRead>& memory,
             const io::Options& options,
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
-            ISequenceRead::_init(path, memory, options, cache, logSystem);
+            ISequenceRead::_init(path, memory, options, cache, decodePool, logSystem);
         }
 
         Read::Read()
@@ -159,10 +167,11 @@ namespace tl
             const file::Path& path,
             const io::Options& options,
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             auto out = std::shared_ptr<Read>(new Read);
-            out->_init(path, {}, options, cache, logSystem);
+            out->_init(path, {}, options, cache, decodePool, logSystem);
             return out;
         }
 
@@ -171,10 +180,11 @@ namespace tl
             const std::vector<file::MemoryRead>& memory,
             const io::Options& options,
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             auto out = std::shared_ptr<Read>(new Read);
-            out->_init(path, memory, options, cache, logSystem);
+            out->_init(path, memory, options, cache, decodePool, logSystem);
             return out;
         }
 
@@ -183,7 +193,9 @@ namespace tl
             const file::MemoryRead* memory)
         {
             io::Info out;
-            out.video.push_back(File(fileName, memory).getInfo());
+            io::SequenceHeader header;
+            _readHeader(_openFile(fileName, memory), header);
+            out.video = header.info.video;
             out.videoTime = otime::TimeRange::range_from_start_end_time_inclusive(
                 otime::RationalTime(_startFrame, _defaultSpeed),
                 otime::RationalTime(_endFrame, _defaultSpeed));
@@ -196,7 +208,38 @@ namespace tl
             const otime::RationalTime& time,
             const io::Options&)
         {
-            return File(fileName, memory).read(fileName, time);
+            auto io = _openFile(fileName, memory);
+            io::SequenceHeader header;
+            _readHeader(io, header);
+            return File(io, header.info.video[0], static_cast<Data>(header.flags)).read(fileName, time);
+        }
+
+        void Read::_parseHeader(
+            const std::shared_ptr<file::FileIO>& io,
+            io::SequenceHeader& out)
+        {
+            const File file(io->getFileName(), io);
+            out.info.video.push_back(file.getInfo());
+            out.flags = static_cast<uint32_t>(file.getData());
+            out.offset = io->getPos();
+            out.size = out.offset;
+        }
+
+        bool Read::_getBatchInfo(
+            const std::string& fileName,
+            const io::Options&,
+            io::SequenceBatchInfo& out)
+        {
+            auto io = file::FileIO::create(fileName, file::Mode::Read, file::ReadType::Normal);
+            io::SequenceHeader header;
+            _readHeader(io, header);
+            if (static_cast<Data>(header.flags) != Data::Binary)
+            {
+                return false;
+            }
+            out.info = header.info.video[0];
+            out.offset = header.offset;
+            return true;
         }
     }
 }
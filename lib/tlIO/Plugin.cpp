@@ -38,6 +38,8 @@ namespace tl
         {
             IIO::_init(path, options, cache, logSystem);
             _memory = memory;
+            _pathID = getPathID(path);
+            _optionsHash = getOptionsHash(options);
         }
 
         IRead::IRead()
@@ -53,6 +55,19 @@ namespace tl
             return std::future<VideoData>();
         }
 
+        std::vector<std::future<VideoData> > IRead::readVideo(
+            const std::vector<otime::RationalTime>& times,
+            const Options& options)
+        {
+            std::vector<std::future<VideoData> > out;
+            out.reserve(times.size());
+            for (const auto& time : times)
+            {
+                out.push_back(readVideo(time, options));
+            }
+            return out;
+        }
+
         std::future<AudioData> IRead::readAudio(
             const otime::TimeRange&,
             const Options&)
@@ -76,6 +91,15 @@ namespace tl
         IWrite::~IWrite()
         {}
 
+        void IWrite::writeAudio(
+            const otime::TimeRange&,
+            const std::shared_ptr<audio::Audio>&,
+            const Options&)
+        {}
+
+        void IWrite::finish()
+        {}
+
         struct IPlugin::Private
         {
             std::string name;
@@ -87,10 +111,12 @@ namespace tl
             const std::string& name,
             const std::map<std::string, FileType>& extensions,
             const std::shared_ptr<Cache>& cache,
+            const std::shared_ptr<DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             TLRENDER_P();
             _cache = cache;
+            _decodePool = decodePool;
             _logSystem = logSystem;
             p.name = name;
             p.extensions = extensions;
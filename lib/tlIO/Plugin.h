@@ -5,6 +5,7 @@
 #pragma once
 
 #include <tlIO/Cache.h>
+#include <tlIO/DecodePool.h>
 
 #include <tlCore/FileIO.h>
 
@@ -77,6 +78,14 @@ namespace tl
                 const otime::RationalTime&,
                 const Options& = Options());
 
+            //! Read video data for multiple times. The futures are returned
+            //! in the same order as the times. Readers can override this to
+            //! schedule the whole range at once, the default implementation
+            //! requests each time separately.
+            virtual std::vector<std::future<VideoData> > readVideo(
+                const std::vector<otime::RationalTime>&,
+                const Options& = Options());
+
             //! Read audio data.
             virtual std::future<AudioData> readAudio(
                 const otime::TimeRange&,
@@ -87,6 +96,10 @@ namespace tl
 
         protected:
             std::vector<file::MemoryRead> _memory;
+
+            //! The interned path and options hash used for cache keys.
+            uint64_t _pathID = 0;
+            uint64_t _optionsHash = 0;
         };
 
         //! Base class for writers.
@@ -110,6 +123,18 @@ namespace tl
                 const std::shared_ptr<image::Image>&,
                 const Options& = Options()) = 0;
 
+            //! Write audio data. The audio is written after the previous
+            //! audio, so it should be contiguous. Writers without audio
+            //! ignore it.
+            virtual void writeAudio(
+                const otime::TimeRange&,
+                const std::shared_ptr<audio::Audio>&,
+                const Options& = Options());
+
+            //! Finish writing. Writers that work asynchronously wait for the
+            //! pending data, and throw an exception if writing failed.
+            virtual void finish();
+
         protected:
             Info _info;
         };
@@ -124,6 +149,7 @@ namespace tl
                 const std::string& name,
                 const std::map<std::string, FileType>& extensions,
                 const std::shared_ptr<Cache>&,
+                const std::shared_ptr<DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
             IPlugin();
@@ -166,6 +192,7 @@ namespace tl
             bool _isWriteCompatible(const image::Info&, const Options&) const;
 
             std::shared_ptr<Cache> _cache;
+            std::shared_ptr<DecodePool> _decodePool;
             std::weak_ptr<log::System> _logSystem;
 
         private:
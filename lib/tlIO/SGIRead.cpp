@@ -108,46 +108,99 @@ namespace tl
                 }
             }
 
+            void interleave(
+                const std::shared_ptr<image::Image>& in,
+                const std::shared_ptr<image::Image>& out)
+            {
+                const image::Info& info = in->getInfo();
+                const size_t channels = image::getChannelCount(info.pixelType);
+                switch (image::getBitDepth(info.pixelType) / 8)
+                {
+                case 1:
+                    planarInterleave<uint8_t>(
+                        in->getData(),
+                        out->getData(),
+                        info.size.w,
+                        info.size.h,
+                        channels);
+                    break;
+                case 2:
+                    planarInterleave<uint16_t>(
+                        reinterpret_cast<const uint16_t*>(in->getData()),
+                        reinterpret_cast<uint16_t*>(out->getData()),
+                        info.size.w,
+                        info.size.h,
+                        channels);
+                    break;
+                default: break;
+                }
+            }
+
+            void readHeader(
+                const std::string& fileName,
+                const std::shared_ptr<file::FileIO>& io,
+                Header& header,
+                image::Info& info)
+            {
+                io->setEndianConversion(memory::getEndian() != memory::Endian::MSB);
+                io->readU16(&header.magic);
+                if (header.magic != 474)
+                {
+                    throw std::runtime_error(string::Format("{0}: {1}").
+                        arg(fileName).
+                        arg("Bad magic number"));
+                }
+                io->readU8(&header.storage);
+                io->readU8(&header.bytes);
+                io->readU16(&header.dimension);
+                io->readU16(&header.width);
+                io->readU16(&header.height);
+                io->readU16(&header.channels);
+                io->readU32(&header.pixelMin);
+                io->readU32(&header.pixelMax);
+                io->setEndianConversion(false);
+                io->setPos(512);
+
+                info.size.w = header.width;
+                info.size.h = header.height;
+                info.pixelType = image::getIntType(header.channels, 1 == header.bytes ? 8 : 16);
+                if (image::PixelType::None == info.pixelType)
+                {
+                    throw std::runtime_error(string::Format("{0}: {1}").
+                        arg(fileName).
+                        arg("Unsupported image type"));
+                }
+                info.layout.endian = memory::Endian::MSB;
+            }
+
             class File
             {
             public:
-                File(const std::string& fileName, const file::MemoryRead* memory)
+                File(
+                    const std::string& fileName,
+                    const std::shared_ptr<file::FileIO>& io,
+                    const image::Info& info,
+                    bool compressed) :
+                    _io(io),
+                    _info(info),
+                    _compressed(compressed)
                 {
-                    _io = memory ?
-                        file::FileIO::create(fileName, *memory) :
-                        file::FileIO::create(fileName, file::Mode::Read);
-                    _io->setEndianConversion(memory::getEndian() != memory::Endian::MSB);
-                    _io->readU16(&_header.magic);
-                    if (_header.magic != 474)
+                    if (_compressed)
                     {
-                        throw std::runtime_error(string::Format("{0}: {1}").
-                            arg(fileName).
-                            arg("Bad magic number"));
-                    }
-                    _io->readU8(&_header.storage);
-                    _io->readU8(&_header.bytes);
-                    _io->readU16(&_header.dimension);
-                    _io->readU16(&_header.width);
-                    _io->readU16(&_header.height);
-                    _io->readU16(&_header.channels);
-                    _io->readU32(&_header.pixelMin);
-                    _io->readU32(&_header.pixelMax);
-                    _io->setPos(512);
-                    if (_header.storage)
-                    {
-                        const size_t size = _header.height * _header.channels;
+                        const size_t size = _info.size.h * image::getChannelCount(_info.pixelType);
                         _rleOffset.resize(size);
                         _rleSize.resize(size);
+                        _io->setEndianConversion(memory::getEndian() != memory::Endian::MSB);
                         _io->readU32(_rleOffset.data(), size);
                         _io->readU32(_rleSize.data(), size);
+                        _io->setEndianConversion(false);
                     }
-                    _io->setEndianConversion(false);
 
                     const size_t ioSize = _io->getSize();
                     const size_t ioPos = _io->getPos();
                     const size_t fileDataByteCount = ioSize >= ioPos ? (ioSize - ioPos) : 0;
                     size_t dataByteCount = 0;
-                    if (_header.storage)
+                    if (_compressed)
                     {
                         for (auto i : _rleSize)
                         {
@@ -164,22 +217,6 @@ namespace tl
                             arg(fileName).
                             arg("Incomplete file"));
                     }
-
-                    _info.size.w = _header.width;
-                    _info.size.h = _header.height;
-                    _info.pixelType = image::getIntType(_header.channels, 1 == _header.bytes ? 8 : 16);
-                    if (image::PixelType::None == _info.pixelType)
-                    {
-                        throw std::runtime_error(string::Format("{0}: {1}").
-                            arg(fileName).
-                            arg("Unsupported image type"));
-                    }
-                    _info.layout.endian = memory::Endian::MSB;
-                }
-
-                const image::Info& getInfo() const
-                {
-                    return _info;
                 }
 
                 io::VideoData read(
@@ -196,7 +233,7 @@ namespace tl
                     const size_t bytes = image::getBitDepth(_info.pixelType) / 8;
                     const size_t dataByteCount = out.image->getDataByteCount();
                     auto tmp = image::Image::create(_info);
-                    if (!_header.storage)
+                    if (!_compressed)
                     {
                         _io->read(tmp->getData(), dataByteCount);
                     }
@@ -242,34 +279,14 @@ namespace tl
                         }
                     }
 
-                    switch (bytes)
-                    {
-                    case 1:
-                        planarInterleave<uint8_t>(
-                            tmp->getData(),
-                            out.image->getData(),
-                            _info.size.w,
-                            _info.size.h,
-                            channels);
-                        break;
-                    case 2:
-                        planarInterleave<uint16_t>(
-                            reinterpret_cast<const uint16_t*>(tmp->getData()),
-                            reinterpret_cast<uint16_t*>(out.image->getData()),
-                            _info.size.w,
-                            _info.size.h,
-                            channels);
-                        break;
-                    default: break;
-                    }
-
+                    interleave(tmp, out.image);
                     return out;
                 }
 
             private:
                 std::shared_ptr<file::FileIO> _io;
-                Header _header;
                 image::Info _info;
+                bool _compressed = false;
                 std::vector<uint32_t> _rleOffset;
                 std::vector<uint32_t> _rleSize;
             };
@@ -280,9 +297,10 @@ namespace tl
             const std::vector<file::MemoryRead>& memory,
             const io::Options& options,
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
-            ISequenceRead::_init(path, memory, options, cache, logSystem);
+            ISequenceRead::_init(path, memory, options, cache, decodePool, logSystem);
         }
 
         Read::Read()
@@ -297,10 +315,11 @@ namespace tl
             const file::Path& path,
             const io::Options& options,
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             auto out = std::shared_ptr<Read>(new Read);
-            out->_init(path, {}, options, cache, logSystem);
+            out->_init(path, {}, options, cache, decodePool, logSystem);
             return out;
         }
 
@@ -309,10 +328,11 @@ namespace tl
             const std::vector<file::MemoryRead>& memory,
             const io::Options& options,
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             auto out = std::shared_ptr<Read>(new Read);
-            out->_init(path, memory, options, cache, logSystem);
+            out->_init(path, memory, options, cache, decodePool, logSystem);
             return out;
         }
 
@@ -321,7 +341,9 @@ namespace tl
             const file::MemoryRead* memory)
         {
             io::Info out;
-            out.video.push_back(File(fileName, memory).getInfo());
+            io::SequenceHeader header;
+            _readHeader(_openFile(fileName, memory), header);
+            out.video = header.info.video;
             out.videoTime = otime::TimeRange::range_from_start_end_time_inclusive(
                 otime::RationalTime(_startFrame, _defaultSpeed),
                 otime::RationalTime(_endFrame, _defaultSpeed));
@@ -334,7 +356,54 @@ namespace tl
             const otime::RationalTime& time,
             const io::Options&)
         {
-            return File(fileName, memory).read(fileName, time);
+            auto io = _openFile(fileName, memory);
+            io::SequenceHeader header;
+            _readHeader(io, header);
+            return File(fileName, io, header.info.video[0], header.flags != 0).read(fileName, time);
+        }
+
+        void Read::_parseHeader(
+            const std::shared_ptr<file::FileIO>& io,
+            io::SequenceHeader& out)
+        {
+            Header header;
+            image::Info info;
+            readHeader(io->getFileName(), io, header, info);
+            out.info.video.push_back(info);
+            out.flags = header.storage;
+            out.offset = io->getPos();
+            out.size = out.offset;
+        }
+
+        bool Read::_getBatchInfo(
+            const std::string& fileName,
+            const io::Options&,
+            io::SequenceBatchInfo& out)
+        {
+            auto io = file::FileIO::create(fileName, file::Mode::Read, file::ReadType::Normal);
+            io::SequenceHeader header;
+            _readHeader(io, header);
+            if (header.flags != 0)
+            {
+                return false;
+            }
+            out.info = header.info.video[0];
+            out.offset = header.offset;
+            return true;
+        }
+
+        std::shared_ptr<image::Image> Read::_convertBatch(
+            const std::shared_ptr<image::Image>& image,
+            const io::SequenceBatchInfo& batchInfo)
+        {
+            // The image data is planar.
+            std::shared_ptr<image::Image> out = image;
+            if (image::getChannelCount(batchInfo.info.pixelType) > 1)
+            {
+                out = image::Image::create(batchInfo.info);
+                interleave(image, out);
+            }
+            return out;
         }
     }
 }
@@ -6,6 +6,10 @@
 
 #include <tlIO/Plugin.h>
 
+#include <tlCore/FileBatch.h>
+#include <tlCore/FilePrefetch.h>
+#include <tlCore/Range.h>
+
 namespace tl
 {
     namespace io
@@ -13,11 +17,52 @@ namespace tl
         //! Default speed for image sequences.
         const float sequenceDefaultSpeed = 24.F;
 
-        //! Number of threads.
+        //! Maximum number of frames decoded in parallel by a single reader.
         const size_t sequenceThreadCount = 16;
 
-        //! Timeout for requests.
-        const std::chrono::milliseconds sequenceRequestTimeout(5);
+        //! Per-frame option with the number of threads a reader may use to
+        //! decode the frame internally. It is set for the frame at the
+        //! playhead when the decode pool has idle threads, and the threads
+        //! are lent by the pool (see DecodePool::lendThreads()) while the
+        //! frame decodes. The maximum is set with the
+        //! "SequenceIO/ChunkThreadCount" option, where zero uses the decode
+        //! pool thread count and one disables it.
+        const std::string sequenceChunkThreadsOption = "SequenceIO/ChunkThreads";
+
+        //! Get the maximum number of frames a reader decodes in parallel,
+        //! given its thread count. While the decode pool has lent threads,
+        //! it is also limited to the pool threads that are not lent, and at
+        //! least one frame is decoded.
+        size_t getSequenceMaxTasks(size_t threadCount, const DecodePool&);
+
+        //! Information for reading the image data of a file with the batch
+        //! reader.
+        struct SequenceBatchInfo
+        {
+            image::Info info;
+            image::Tags tags;
+            size_t      offset = 0; //!< File position of the image data
+        };
+
+        //! Header template for the files of an image sequence. The header of
+        //! the first file is parsed and kept as the template. The headers of
+        //! the other files are compared with it byte for byte, apart from
+        //! the ranges that change per frame like the timecode, and the
+        //! parsed information is reused if they match.
+        struct SequenceHeader
+        {
+            size_t                        size = 0; //!< Number of header bytes compared, zero disables the template
+            std::vector<uint8_t>          data;     //!< Header bytes
+            std::vector<math::SizeTRange> frameRanges; //!< Sorted byte ranges that can change per frame
+            uint32_t                      flags = 0; //!< Format specific flags, for example the compression
+            size_t                        fileSize = 0;
+            Info                          info;
+            size_t                        offset = 0; //!< File position of the image data
+
+            //! Get whether the given header bytes match, ignoring the frame
+            //! ranges.
+            bool match(const std::vector<uint8_t>&) const;
+        };
 
         //! Base class for image sequence readers.
         class ISequenceRead : public IRead
@@ -28,6 +73,7 @@ namespace tl
                 const std::vector<file::MemoryRead>&,
                 const Options&,
                 const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<DecodePool>&,
                 const std::weak_ptr<log::System>&);
 
             ISequenceRead();
@@ -39,8 +85,17 @@ namespace tl
             std::future<VideoData> readVideo(
                 const otime::RationalTime&,
                 const Options& = Options()) override;
+            std::vector<std::future<VideoData> > readVideo(
+                const std::vector<otime::RationalTime>&,
+                const Options& = Options()) override;
             void cancelRequests() override;
 
+            //! Get the statistics of the batch reader. The batch reader is
+            //! shared by the sequence readers, so this includes all of their
+            //! batch reads. The statistics are empty without the
+            //! "SequenceIO/BatchRead" option.
+            file::BatchReadStats getBatchReadStats() const;
+
         protected:
             virtual Info _getInfo(
                 const std::string& fileName,
@@ -51,6 +106,62 @@ namespace tl
                 const otime::RationalTime&,
                 const Options&) = 0;
 
+            //! Parse the header of a file and set the file position to the
+            //! image data. Readers that use _readHeader() implement this.
+            virtual void _parseHeader(
+                const std::shared_ptr<file::FileIO>&,
+                SequenceHeader&);
+
+            //! Update the information that changes per frame, like the
+            //! timecode tags, from the header bytes. This is called for files
+            //! that match the header template.
+            virtual void _updateHeader(SequenceHeader&);
+
+            //! Read the header of a file using the header template, and set
+            //! the file position to the image data. Files that do not match
+            //! the template are parsed with _parseHeader(), and become the
+            //! new template. The template is disabled with the
+            //! "SequenceIO/HeaderTemplate" option.
+            void _readHeader(
+                const std::shared_ptr<file::FileIO>&,
+                SequenceHeader&);
+
+            //! Get the information for reading a file with the batch reader.
+            //! With the "SequenceIO/BatchRead" option, formats where the
+            //! image data is uncompressed at a fixed offset read it with
+            //! file::BatchRead instead of _readVideo(). The pending full
+            //! resolution requests are submitted together, up to the batch
+            //! reader queue depth. The option "SequenceIO/DirectIO" reads
+            //! the data with O_DIRECT. Returns false if the file cannot be
+            //! read this way, which is the default.
+            virtual bool _getBatchInfo(
+                const std::string& fileName,
+                const Options&,
+                SequenceBatchInfo&);
+
+            //! Convert an image read with the batch reader, for example
+            //! from planar to interleaved data. The default returns the
+            //! image.
+            virtual std::shared_ptr<image::Image> _convertBatch(
+                const std::shared_ptr<image::Image>&,
+                const SequenceBatchInfo&);
+
+            //! Open a file for reading. With the "SequenceIO/Prefetch"
+            //! option the file is read in large blocks in parallel, which
+            //! is faster on network file systems. The files share the
+            //! reader's prefetch threads.
+            std::shared_ptr<file::FileIO> _openFile(
+                const std::string& fileName,
+                const file::MemoryRead*) const;
+
+            //! Read uncompressed, interleaved image data from the current
+            //! file position. With a proxy level only every 2^level row and
+            //! column is read.
+            std::shared_ptr<image::Image> _readImage(
+                const std::shared_ptr<file::FileIO>&,
+                const image::Info&,
+                int proxyLevel = 0) const;
+
             //! \bug This must be called in the sub-class destructor.
             void _finish();
 
@@ -59,8 +170,12 @@ namespace tl
             float _defaultSpeed = sequenceDefaultSpeed;
 
         private:
-            void _thread();
-            void _finishRequests();
+            std::string _getFileName(
+                const otime::RationalTime&,
+                const file::MemoryRead**) const;
+            void _infoTask();
+            void _videoTask();
+            void _submitVideoTask(int64_t priority);
             void _cancelRequests();
 
             TLRENDER_PRIVATE();
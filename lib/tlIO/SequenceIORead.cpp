@@ -7,20 +7,79 @@
 #include <tlCore/Assert.h>
 #include <tlCore/File.h>
 #include <tlCore/LogSystem.h>
+#include <tlCore/Math.h>
 #include <tlCore/StringFormat.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <cstring>
+#include <limits>
 #include <sstream>
 
 namespace tl
 {
     namespace io
     {
+        namespace
+        {
+            std::shared_ptr<file::BatchRead> getBatchRead(bool direct)
+            {
+                // The batch readers are shared by all of the sequence
+                // readers, so the reads go through the same queue.
+                static std::mutex mutex;
+                static std::weak_ptr<file::BatchRead> batchRead[2];
+                std::unique_lock<std::mutex> lock(mutex);
+                auto out = batchRead[direct].lock();
+                if (!out)
+                {
+                    file::BatchReadOptions options;
+                    options.direct = direct;
+                    out = file::BatchRead::create(options);
+                    batchRead[direct] = out;
+                }
+                return out;
+            }
+        }
+
+        size_t getSequenceMaxTasks(size_t threadCount, const DecodePool& decodePool)
+        {
+            size_t out = threadCount;
+            const size_t lent = decodePool.getLentCount();
+            if (lent > 0)
+            {
+                const size_t poolThreads = decodePool.getThreadCount();
+                out = std::min(out, poolThreads > lent ? poolThreads - lent : 1);
+            }
+            return out;
+        }
+
+        bool SequenceHeader::match(const std::vector<uint8_t>& other) const
+        {
+            if (other.size() != data.size())
+            {
+                return false;
+            }
+            size_t pos = 0;
+            for (const auto& range : frameRanges)
+            {
+                const size_t end = std::min(range.getMin(), data.size());
+                if (end > pos && memcmp(data.data() + pos, other.data() + pos, end - pos) != 0)
+                {
+                    return false;
+                }
+                pos = std::max(pos, range.getMax() + 1);
+            }
+            return
+                pos >= data.size() ||
+                0 == memcmp(data.data() + pos, other.data() + pos, data.size() - pos);
+        }
+
         void ISequenceRead::_init(
             const file::Path& path,
             const std::vector<file::MemoryRead>& memory,
             const Options& options,
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             IRead::_init(path, memory, options, cache, logSystem);
@@ -49,46 +108,80 @@ namespace tl
                 std::stringstream ss(i->second);
                 ss >> p.threadCount;
             }
+            p.threadCount = std::max(p.threadCount, static_cast<size_t>(1));
+            i = options.find("SequenceIO/ChunkThreadCount");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.chunkThreadCount;
+            }
             i = options.find("SequenceIO/DefaultSpeed");
             if (i != options.end())
             {
                 std::stringstream ss(i->second);
                 ss >> _defaultSpeed;
             }
+            i = options.find("SequenceIO/Prefetch");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.prefetch;
+            }
+            i = options.find("SequenceIO/PrefetchBlockSize");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.prefetchOptions.blockSize;
+            }
+            i = options.find("SequenceIO/PrefetchMaxInFlight");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.prefetchOptions.maxInFlight;
+            }
+            i = options.find("SequenceIO/HeaderTemplate");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.headerTemplate;
+            }
+            bool batchRead = false;
+            i = options.find("SequenceIO/BatchRead");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> batchRead;
+            }
+            bool directIO = false;
+            i = options.find("SequenceIO/DirectIO");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> directIO;
+            }
+            if (batchRead && _memory.empty())
+            {
+                p.batchRead = getBatchRead(directIO);
+            }
+            if (p.prefetch && _memory.empty())
+            {
+                p.prefetchPool = file::PrefetchPool::create(p.prefetchOptions.maxInFlight);
+            }
 
-            p.thread.running = true;
-            p.thread.thread = std::thread(
-                [this, path]
+            // Readers created outside of the I/O system get their own pool.
+            p.decodePool = decodePool ? decodePool : DecodePool::create(p.threadCount);
+            p.decodeClient = p.decodePool->addClient();
+            if (0 == p.chunkThreadCount)
+            {
+                p.chunkThreadCount = p.decodePool->getThreadCount();
+            }
+            p.mutex.logTimer = std::chrono::steady_clock::now();
+            p.decodePool->submit(
+                p.decodeClient,
+                std::numeric_limits<int64_t>::min(),
+                [this]
                 {
-                    TLRENDER_P();
-                    try
-                    {
-                        p.info = _getInfo(
-                            path.get(-1, file::PathType::Path),
-                            !_memory.empty() ? &_memory[0] : nullptr);
-                        p.addTags(p.info);
-                        _thread();
-                    }
-                    catch (const std::exception& e)
-                    {
-                        //! \todo How should this be handled?
-                        if (auto logSystem = _logSystem.lock())
-                        {
-                            const std::string id = string::Format("tl::io::ISequenceRead ({0}: {1})").
-                                arg(__FILE__).
-                                arg(__LINE__);
-                            logSystem->print(id, string::Format("{0}: {1}").
-                                arg(_path.get()).
-                                arg(e.what()),
-                                log::Type::Error);
-                        }
-                    }
-                    _finishRequests();
-                    {
-                        std::unique_lock<std::mutex> lock(p.mutex.mutex);
-                        p.mutex.stopped = true;
-                    }
-                    _cancelRequests();
+                    _infoTask();
                 });
         }
 
@@ -105,22 +198,21 @@ namespace tl
             auto request = std::make_shared<Private::InfoRequest>();
             auto future = request->promise.get_future();
             bool valid = false;
+            Info info;
             {
                 std::unique_lock<std::mutex> lock(p.mutex.mutex);
-                if (!p.mutex.stopped)
+                if (p.mutex.infoValid)
                 {
                     valid = true;
+                    info = p.mutex.info;
+                }
+                else if (!p.mutex.stopped)
+                {
                     p.mutex.infoRequests.push_back(request);
+                    return future;
                 }
             }
-            if (valid)
-            {
-                p.thread.cv.notify_one();
-            }
-            else
-            {
-                request->promise.set_value(Info());
-            }
+            request->promise.set_value(valid ? info : Info());
             return future;
         }
 
@@ -133,210 +225,659 @@ namespace tl
             request->time = time;
             request->options = merge(options, _options);
             auto future = request->promise.get_future();
+
+            // Check the cache first so that cached frames don't need a task.
+            if (_cache)
+            {
+                VideoData videoData;
+                const auto cacheKey = getVideoCacheKey(
+                    _pathID,
+                    request->time,
+                    _optionsHash,
+                    request->options);
+                if (_cache->getVideo(cacheKey, videoData))
+                {
+                    request->promise.set_value(videoData);
+                    return future;
+                }
+            }
+
             bool valid = false;
+            bool submit = false;
+            int64_t priority = 0;
             {
                 std::unique_lock<std::mutex> lock(p.mutex.mutex);
                 if (!p.mutex.stopped)
                 {
                     valid = true;
+
+                    // The first request after the queue has drained is
+                    // assumed to be the playhead; the remaining requests are
+                    // decoded nearest to it first.
+                    if (p.mutex.videoRequests.empty() && 0 == p.mutex.inProgress)
+                    {
+                        p.mutex.playhead = time;
+                    }
                     p.mutex.videoRequests.push_back(request);
+                    if (p.mutex.tasks < p.getMaxTasks())
+                    {
+                        ++p.mutex.tasks;
+                        submit = true;
+                        priority = p.getPriority(time);
+                    }
                 }
             }
-            if (valid)
+            if (submit)
             {
-                p.thread.cv.notify_one();
+                _submitVideoTask(priority);
             }
-            else
+            else if (!valid)
             {
                 request->promise.set_value(VideoData());
             }
             return future;
         }
 
+        std::vector<std::future<VideoData> > ISequenceRead::readVideo(
+            const std::vector<otime::RationalTime>& times,
+            const Options& options)
+        {
+            TLRENDER_P();
+            const Options optionsMerged = merge(options, _options);
+            std::vector<std::future<VideoData> > out;
+            std::vector<std::shared_ptr<Private::VideoRequest> > requests;
+            for (const auto& time : times)
+            {
+                auto request = std::make_shared<Private::VideoRequest>();
+                request->time = time;
+                request->options = optionsMerged;
+                out.push_back(request->promise.get_future());
+                if (_cache)
+                {
+                    VideoData videoData;
+                    const auto cacheKey = getVideoCacheKey(
+                        _pathID,
+                        request->time,
+                        _optionsHash,
+                        request->options);
+                    if (_cache->getVideo(cacheKey, videoData))
+                    {
+                        request->promise.set_value(videoData);
+                        continue;
+                    }
+                }
+                requests.push_back(request);
+            }
+            if (requests.empty())
+            {
+                return out;
+            }
+
+            // Queue all of the requests with a single lock. The first time
+            // is the playhead if the queue has drained, as with a single
+            // request.
+            bool valid = false;
+            std::vector<int64_t> priorities;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                if (!p.mutex.stopped)
+                {
+                    valid = true;
+                    if (p.mutex.videoRequests.empty() && 0 == p.mutex.inProgress)
+                    {
+                        p.mutex.playhead = requests.front()->time;
+                    }
+                    for (const auto& request : requests)
+                    {
+                        p.mutex.videoRequests.push_back(request);
+                        if (p.mutex.tasks < p.getMaxTasks())
+                        {
+                            ++p.mutex.tasks;
+                            priorities.push_back(p.getPriority(request->time));
+                        }
+                    }
+                }
+            }
+            for (const auto priority : priorities)
+            {
+                _submitVideoTask(priority);
+            }
+            if (!valid)
+            {
+                for (const auto& request : requests)
+                {
+                    request->promise.set_value(VideoData());
+                }
+            }
+            return out;
+        }
+
         void ISequenceRead::cancelRequests()
         {
             _cancelRequests();
         }
 
+        file::BatchReadStats ISequenceRead::getBatchReadStats() const
+        {
+            TLRENDER_P();
+            return p.batchRead ? p.batchRead->getStats() : file::BatchReadStats();
+        }
+
+        void ISequenceRead::_parseHeader(
+            const std::shared_ptr<file::FileIO>&,
+            SequenceHeader&)
+        {}
+
+        void ISequenceRead::_updateHeader(SequenceHeader&)
+        {}
+
+        void ISequenceRead::_readHeader(
+            const std::shared_ptr<file::FileIO>& io,
+            SequenceHeader& out)
+        {
+            TLRENDER_P();
+            std::shared_ptr<SequenceHeader> header;
+            if (p.headerTemplate)
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                header = p.mutex.header;
+            }
+
+            // Compare the header with the template. The file size must
+            // also match, so incomplete files are still parsed and
+            // caught.
+            if (header && io->getSize() == header->fileSize)
+            {
+                out.data.resize(header->size);
+                io->read(out.data.data(), out.data.size());
+                if (header->match(out.data))
+                {
+                    out.size = header->size;
+                    out.frameRanges = header->frameRanges;
+                    out.flags = header->flags;
+                    out.fileSize = header->fileSize;
+                    out.info = header->info;
+                    out.offset = header->offset;
+                    _updateHeader(out);
+                    io->setPos(out.offset);
+                    return;
+                }
+                io->setPos(0);
+            }
+
+            // Parse the header and keep it as the new template.
+            out = SequenceHeader();
+            _parseHeader(io, out);
+            if (p.headerTemplate && out.size > 0)
+            {
+                const size_t pos = io->getPos();
+                out.fileSize = io->getSize();
+                out.data.resize(out.size);
+                io->setPos(0);
+                io->read(out.data.data(), out.data.size());
+                io->setPos(pos);
+                header = std::make_shared<SequenceHeader>(out);
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.header = header;
+            }
+        }
+
+        bool ISequenceRead::_getBatchInfo(
+            const std::string&,
+            const Options&,
+            SequenceBatchInfo&)
+        {
+            return false;
+        }
+
+        std::shared_ptr<image::Image> ISequenceRead::_convertBatch(
+            const std::shared_ptr<image::Image>& image,
+            const SequenceBatchInfo&)
+        {
+            return image;
+        }
+
+        std::shared_ptr<file::FileIO> ISequenceRead::_openFile(
+            const std::string& fileName,
+            const file::MemoryRead* memory) const
+        {
+            TLRENDER_P();
+            std::shared_ptr<file::FileIO> out;
+            if (memory)
+            {
+                out = file::FileIO::create(fileName, *memory);
+            }
+            else if (p.prefetchPool)
+            {
+                auto prefetch = file::PrefetchRead::create(
+                    fileName,
+                    p.prefetchOptions,
+                    p.prefetchPool);
+                prefetch->prefetch(0, prefetch->getSize());
+                out = file::FileIO::create(prefetch);
+            }
+            else
+            {
+                out = file::FileIO::create(fileName, file::Mode::Read);
+            }
+            return out;
+        }
+
+        std::shared_ptr<image::Image> ISequenceRead::_readImage(
+            const std::shared_ptr<file::FileIO>& io,
+            const image::Info& info,
+            int proxyLevel) const
+        {
+            std::shared_ptr<image::Image> out;
+            if (proxyLevel <= 0)
+            {
+                out = image::Image::create(info);
+                io->read(out->getData(), image::getDataByteCount(info));
+            }
+            else
+            {
+                image::Info proxyInfo = info;
+                proxyInfo.size = image::getProxySize(info.size, proxyLevel);
+                out = image::Image::create(proxyInfo);
+                image::Info pixelInfo = info;
+                pixelInfo.size = image::Size(1, 1);
+                pixelInfo.layout.alignment = 1;
+                const size_t pixelByteCount = image::getDataByteCount(pixelInfo);
+                const size_t rowByteCount = image::getPlaneRowByteCount(info, 0);
+                const size_t proxyRowByteCount = image::getPlaneRowByteCount(proxyInfo, 0);
+                const size_t step = static_cast<size_t>(1) << proxyLevel;
+                const size_t pos = io->getPos();
+                std::vector<uint8_t> row(rowByteCount);
+                for (int y = 0; y < proxyInfo.size.h; ++y)
+                {
+                    io->setPos(pos + y * step * rowByteCount);
+                    io->read(row.data(), rowByteCount);
+                    uint8_t* p = out->getData() + y * proxyRowByteCount;
+                    for (int x = 0; x < proxyInfo.size.w; ++x, p += pixelByteCount)
+                    {
+                        std::memcpy(p, row.data() + x * step * pixelByteCount, pixelByteCount);
+                    }
+                }
+            }
+            return out;
+        }
+
         void ISequenceRead::_finish()
         {
             TLRENDER_P();
-            p.thread.running = false;
-            if (p.thread.thread.joinable())
             {
-                p.thread.thread.join();
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.stopped = true;
+            }
+            p.decodePool->removeClient(p.decodeClient);
+            _cancelRequests();
+        }
+
+        void ISequenceRead::_infoTask()
+        {
+            TLRENDER_P();
+            Info info;
+            bool valid = false;
+            try
+            {
+                info = _getInfo(
+                    _path.get(-1, file::PathType::Path),
+                    !_memory.empty() ? &_memory[0] : nullptr);
+                p.addTags(info);
+                valid = true;
+            }
+            catch (const std::exception& e)
+            {
+                //! \todo How should this be handled?
+                if (auto logSystem = _logSystem.lock())
+                {
+                    const std::string id = string::Format("tl::io::ISequenceRead ({0}: {1})").
+                        arg(__FILE__).
+                        arg(__LINE__);
+                    logSystem->print(id, string::Format("{0}: {1}").
+                        arg(_path.get()).
+                        arg(e.what()),
+                        log::Type::Error);
+                }
+            }
+            std::list<std::shared_ptr<Private::InfoRequest> > infoRequests;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.infoValid = valid;
+                p.mutex.info = info;
+                if (!valid)
+                {
+                    p.mutex.stopped = true;
+                }
+                infoRequests = std::move(p.mutex.infoRequests);
+            }
+            for (const auto& request : infoRequests)
+            {
+                request->promise.set_value(info);
+            }
+            if (!valid)
+            {
+                _cancelRequests();
             }
         }
 
-        void ISequenceRead::_thread()
+        void ISequenceRead::_videoTask()
         {
             TLRENDER_P();
-            p.thread.logTimer = std::chrono::steady_clock::now();
-            while (p.thread.running)
-            {
-                // Check requests.
-                std::list<std::shared_ptr<Private::InfoRequest> > infoRequests;
-                std::list<std::shared_ptr<Private::VideoRequest> > videoRequests;
-                {
-                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
-                    if (p.thread.cv.wait_for(
-                        lock,
-                        sequenceRequestTimeout,
-                        [this]
+
+            std::shared_ptr<Private::VideoRequest> request;
+            std::vector<std::shared_ptr<Private::VideoRequest> > batchRequests;
+            size_t chunkThreads = 1;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                if (!p.mutex.stopped)
+                {
+                    request = p.popVideoRequest();
+                    if (request && p.batchRead && 0 == getProxyLevel(request->options))
+                    {
+                        // Take the other pending full resolution requests,
+                        // so that they are read with a single batch.
+                        batchRequests.push_back(request);
+                        request.reset();
+                        const size_t batchSize = p.batchRead->getOptions().queueDepth;
+                        for (auto i = p.mutex.videoRequests.begin();
+                            i != p.mutex.videoRequests.end() && batchRequests.size() < batchSize;)
                         {
-                            return
-                                !_p->mutex.infoRequests.empty() ||
-                                !_p->mutex.videoRequests.empty() ||
-                                !_p->thread.videoRequestsInProgress.empty();
-                        }))
+                            if (0 == getProxyLevel((*i)->options))
+                            {
+                                batchRequests.push_back(*i);
+                                i = p.mutex.videoRequests.erase(i);
+                            }
+                            else
+                            {
+                                ++i;
+                            }
+                        }
+                        p.mutex.inProgress += batchRequests.size();
+                    }
+                    else if (request)
                     {
-                        infoRequests = std::move(p.mutex.infoRequests);
-                        while (!p.mutex.videoRequests.empty() &&
-                            (p.thread.videoRequestsInProgress.size() + videoRequests.size()) < p.threadCount)
+                        ++p.mutex.inProgress;
+
+                        // The frame at the playhead is decoded with the
+                        // idle decode pool threads. The threads are lent
+                        // by the pool until it is done, so the read-ahead
+                        // frames of all the readers stay one file per
+                        // thread.
+                        if (p.chunkThreadCount > 1 &&
+                            0 == p.mutex.chunkThreads &&
+                            request->time == p.mutex.playhead)
                         {
-                            videoRequests.push_back(p.mutex.videoRequests.front());
-                            p.mutex.videoRequests.pop_front();
+                            p.mutex.chunkThreads = p.decodePool->lendThreads(p.chunkThreadCount - 1);
+                            chunkThreads = p.mutex.chunkThreads + 1;
                         }
                     }
                 }
+            }
 
-                // Information rquests.
-                for (const auto& request : infoRequests)
+            const auto finish = [this](
+                const std::shared_ptr<Private::VideoRequest>& request,
+                const VideoData& videoData)
+            {
+                request->promise.set_value(videoData);
+                if (_cache)
                 {
-                    request->promise.set_value(p.info);
+                    const auto cacheKey = getVideoCacheKey(
+                        _pathID,
+                        request->time,
+                        _optionsHash,
+                        request->options);
+                    _cache->addVideo(cacheKey, videoData);
                 }
+            };
 
-                // Initialize video requests.
-                while (!videoRequests.empty())
+            if (!batchRequests.empty())
+            {
+                // Get the file ranges of the requests. Images are allocated
+                // from the image pool, which is aligned for direct reads.
+                struct Batch
+                {
+                    std::shared_ptr<Private::VideoRequest> request;
+                    SequenceBatchInfo info;
+                    std::shared_ptr<image::Image> image;
+                    bool done = false;
+                };
+                std::vector<Batch> batches;
+                std::vector<file::BatchReadRequest> batchReadRequests;
+                std::vector<std::shared_ptr<Private::VideoRequest> > otherRequests;
+                for (const auto& request : batchRequests)
                 {
-                    auto request = videoRequests.front();
-                    videoRequests.pop_front();
+                    Batch batch;
+                    batch.request = request;
+                    bool valid = false;
+                    try
+                    {
+                        const file::MemoryRead* memory = nullptr;
+                        const std::string fileName = _getFileName(request->time, &memory);
+                        if (!memory && _getBatchInfo(fileName, request->options, batch.info))
+                        {
+                            batch.image = image::Image::create(batch.info.info);
+                            file::BatchReadRequest batchReadRequest;
+                            batchReadRequest.fileName = fileName;
+                            batchReadRequest.pos = batch.info.offset;
+                            batchReadRequest.size = batch.image->getDataByteCount();
+                            batchReadRequest.data = batch.image->getData();
+                            batchReadRequests.push_back(batchReadRequest);
+                            batches.push_back(std::move(batch));
+                            valid = true;
+                        }
+                    }
+                    catch (const std::exception&)
+                    {}
+                    if (!valid)
+                    {
+                        otherRequests.push_back(request);
+                    }
+                }
 
+                // Submit the reads with a single call, and read the files
+                // that cannot be batched while they are in flight.
+                std::vector<std::future<void> > futures;
+                if (!batchReadRequests.empty())
+                {
+                    futures = p.batchRead->read(batchReadRequests);
+                }
+                for (const auto& request : otherRequests)
+                {
                     VideoData videoData;
-                    const std::string cacheKey = getVideoCacheKey(
-                        _path,
-                        request->time,
-                        _options,
-                        request->options);
-                    if (_cache && _cache->getVideo(cacheKey, videoData))
+                    videoData.time = request->time;
+                    try
                     {
-                        request->promise.set_value(videoData);
+                        const file::MemoryRead* memory = nullptr;
+                        const std::string fileName = _getFileName(request->time, &memory);
+                        videoData = _readVideo(fileName, memory, request->time, request->options);
                     }
-                    else
+                    catch (const std::exception&)
+                    {
+                        //! \todo How should this be handled?
+                    }
+                    finish(request, videoData);
+                }
+
+                // Finish the requests as the reads complete. Wait for the
+                // oldest read, then finish every read that is ready.
+                size_t remaining = batches.size();
+                while (remaining > 0)
+                {
+                    for (size_t i = 0; i < batches.size(); ++i)
                     {
-                        bool seq = false;
-                        std::string fileName;
-                        if (!_path.getNumber().empty())
+                        if (!batches[i].done)
                         {
-                            seq = true;
-                            fileName = _path.get(
-                                static_cast<int>(request->time.value()),
-                                file::PathType::Path);
+                            futures[i].wait();
+                            break;
                         }
-                        else
+                    }
+                    for (size_t i = 0; i < batches.size(); ++i)
+                    {
+                        auto& batch = batches[i];
+                        if (!batch.done &&
+                            futures[i].wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                         {
-                            fileName = _path.get(-1, file::PathType::Path);
-                        }
-                        const otime::RationalTime time = request->time;
-                        const Options options = request->options;
-                        request->future = std::async(
-                            std::launch::async,
-                            [this, seq, fileName, time, options]
+                            VideoData videoData;
+                            videoData.time = batch.request->time;
+                            try
                             {
-                                VideoData out;
-                                try
-                                {
-                                    const int64_t frame = time.value();
-                                    const int64_t memoryIndex = seq ? (frame - _startFrame) : 0;
-                                    out = _readVideo(
-                                        fileName,
-                                        memoryIndex >= 0 && memoryIndex < _memory.size() ? &_memory[memoryIndex] : nullptr,
-                                        time,
-                                        options);
-                                }
-                                catch (const std::exception&)
-                                {
-                                    //! \todo How should this be handled?
-                                }
-                                return out;
-                            });
-                        p.thread.videoRequestsInProgress.push_back(request);
+                                futures[i].get();
+                                batch.image->setTags(batch.info.tags);
+                                videoData.image = _convertBatch(batch.image, batch.info);
+                            }
+                            catch (const std::exception&)
+                            {
+                                //! \todo How should this be handled?
+                            }
+                            finish(batch.request, videoData);
+                            batch.image.reset();
+                            batch.done = true;
+                            --remaining;
+                        }
                     }
                 }
+            }
 
-                // Check for finished video requests.
-                //if (!p.thread.videoRequestsInProgress.empty())
-                //{
-                //    std::cout << "in progress: " << p.thread.videoRequestsInProgress.size() << std::endl;
-                //}
-                auto requestIt = p.thread.videoRequestsInProgress.begin();
-                while (requestIt != p.thread.videoRequestsInProgress.end())
+            if (request)
+            {
+                VideoData videoData;
+                videoData.time = request->time;
+                try
                 {
-                    if ((*requestIt)->future.valid() &&
-                        (*requestIt)->future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    const file::MemoryRead* memory = nullptr;
+                    const std::string fileName = _getFileName(request->time, &memory);
+                    if (chunkThreads > 1)
                     {
-                        //std::cout << "finished: " << requestIt->time << std::endl;
-                        auto videoData = (*requestIt)->future.get();
-                        (*requestIt)->promise.set_value(videoData);
-                        
-                        if (_cache)
-                        {
-                            const std::string cacheKey = getVideoCacheKey(
-                                _path,
-                                (*requestIt)->time,
-                                _options,
-                                (*requestIt)->options);
-                            _cache->addVideo(cacheKey, videoData);
-                        }
-
-                        requestIt = p.thread.videoRequestsInProgress.erase(requestIt);
-                        continue;
+                        Options options = request->options;
+                        options[sequenceChunkThreadsOption] = string::Format("{0}").arg(chunkThreads);
+                        videoData = _readVideo(fileName, memory, request->time, options);
+                    }
+                    else
+                    {
+                        videoData = _readVideo(fileName, memory, request->time, request->options);
                     }
-                    ++requestIt;
+                    videoData.image = p.getProxy(videoData.image, request->options);
                 }
+                catch (const std::exception&)
+                {
+                    //! \todo How should this be handled?
+                }
+                finish(request, videoData);
+            }
 
-                // Logging.
-                if (auto logSystem = _logSystem.lock())
+            // Keep this task slot busy while there are requests, otherwise
+            // release it. Returning lent chunk threads can also start the
+            // task slots that were held back while they were in use.
+            size_t submit = 0;
+            int64_t priority = 0;
+            size_t requestsSize = 0;
+            size_t inProgress = 0;
+            bool log = false;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                if (request)
+                {
+                    --p.mutex.inProgress;
+                }
+                p.mutex.inProgress -= batchRequests.size();
+                if (chunkThreads > 1)
+                {
+                    p.decodePool->returnThreads(p.mutex.chunkThreads);
+                    p.mutex.chunkThreads = 0;
+                }
+                if (!p.mutex.stopped &&
+                    !p.mutex.videoRequests.empty() &&
+                    p.mutex.tasks <= p.getMaxTasks())
                 {
-                    const auto now = std::chrono::steady_clock::now();
-                    const std::chrono::duration<float> diff = now - p.thread.logTimer;
-                    if (diff.count() > 10.F)
+                    submit = 1;
+                    while (p.mutex.tasks < p.getMaxTasks() &&
+                        p.mutex.tasks < p.mutex.videoRequests.size())
                     {
-                        p.thread.logTimer = now;
-                        const std::string id = string::Format("tl::io::ISequenceRead {0}").arg(this);
-                        size_t requestsSize = 0;
-                        {
-                            std::unique_lock<std::mutex> lock(p.mutex.mutex);
-                            requestsSize = p.mutex.videoRequests.size();
-                        }
-                        logSystem->print(id, string::Format(
-                            "\n"
-                            "    Path: {0}\n"
-                            "    Requests: {1}, {2} in progress\n"
-                            "    Thread count: {3}").
-                            arg(_path.get()).
-                            arg(requestsSize).
-                            arg(p.thread.videoRequestsInProgress.size()).
-                            arg(p.threadCount));
+                        ++p.mutex.tasks;
+                        ++submit;
                     }
+                    priority = p.getPriority(p.mutex.videoRequests.front()->time);
+                    for (const auto& i : p.mutex.videoRequests)
+                    {
+                        priority = std::min(priority, p.getPriority(i->time));
+                    }
+                }
+                else
+                {
+                    --p.mutex.tasks;
+                }
+                const auto now = std::chrono::steady_clock::now();
+                const std::chrono::duration<float> diff = now - p.mutex.logTimer;
+                if (diff.count() > 10.F)
+                {
+                    p.mutex.logTimer = now;
+                    log = true;
+                    requestsSize = p.mutex.videoRequests.size();
+                    inProgress = p.mutex.inProgress;
+                }
+            }
+            for (size_t i = 0; i < submit; ++i)
+            {
+                _submitVideoTask(priority);
+            }
+
+            // Logging.
+            if (log)
+            {
+                if (auto logSystem = _logSystem.lock())
+                {
+                    const std::string id = string::Format("tl::io::ISequenceRead {0}").arg(this);
+                    logSystem->print(id, string::Format(
+                        "\n"
+                        "    Path: {0}\n"
+                        "    Requests: {1}, {2} in progress\n"
+                        "    Thread count: {3}, {4} in the decode pool\n"
+                        "    Decode pool pending: {5}").
+                        arg(_path.get()).
+                        arg(requestsSize).
+                        arg(inProgress).
+                        arg(p.threadCount).
+                        arg(p.decodePool->getThreadCount()).
+                        arg(p.decodePool->getPendingCount()));
                 }
             }
         }
 
-        void ISequenceRead::_finishRequests()
+        std::string ISequenceRead::_getFileName(
+            const otime::RationalTime& time,
+            const file::MemoryRead** memory) const
         {
-            TLRENDER_P();
-            for (auto& request : p.thread.videoRequestsInProgress)
+            std::string out;
+            int64_t memoryIndex = 0;
+            if (!_path.getNumber().empty())
+            {
+                const int64_t frame = time.value();
+                out = _path.get(static_cast<int>(frame), file::PathType::Path);
+                memoryIndex = frame - _startFrame;
+            }
+            else
             {
-                VideoData data;
-                data.time = request->time;
-                if (request->future.valid())
+                out = _path.get(-1, file::PathType::Path);
+            }
+            *memory = memoryIndex >= 0 && memoryIndex < _memory.size() ? &_memory[memoryIndex] : nullptr;
+            return out;
+        }
+
+        void ISequenceRead::_submitVideoTask(int64_t priority)
+        {
+            TLRENDER_P();
+            if (!p.decodePool->submit(
+                p.decodeClient,
+                priority,
+                [this]
                 {
-                    data = request->future.get();
-                }
-                request->promise.set_value(data);
+                    _videoTask();
+                }))
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                --p.mutex.tasks;
             }
-            p.thread.videoRequestsInProgress.clear();
         }
 
         void ISequenceRead::_cancelRequests()
@@ -348,6 +889,7 @@ namespace tl
                 std::unique_lock<std::mutex> lock(p.mutex.mutex);
                 infoRequests = std::move(p.mutex.infoRequests);
                 videoRequests = std::move(p.mutex.videoRequests);
+                p.mutex.playhead = time::invalidTime;
             }
             for (auto& request : infoRequests)
             {
@@ -359,6 +901,95 @@ namespace tl
             }
         }
 
+        int64_t ISequenceRead::Private::getPriority(const otime::RationalTime& time) const
+        {
+            int64_t out = 0;
+            if (time::isValid(mutex.playhead))
+            {
+                out = std::abs(
+                    static_cast<int64_t>(time.value()) -
+                    static_cast<int64_t>(mutex.playhead.rescaled_to(time.rate()).value()));
+            }
+            return out;
+        }
+
+        std::shared_ptr<image::Image> ISequenceRead::Private::getProxy(
+            const std::shared_ptr<image::Image>& image,
+            const Options& options)
+        {
+            std::shared_ptr<image::Image> out = image;
+            const int proxyLevel = getProxyLevel(options);
+            if (image && !image->isRegion() && proxyLevel > 0)
+            {
+                // Readers that do not decode the proxy level directly, or
+                // only part of the way, are finished with a box filter.
+                image::Size size;
+                {
+                    std::unique_lock<std::mutex> lock(mutex.mutex);
+                    if (!mutex.info.video.empty())
+                    {
+                        int layer = 0;
+                        const auto i = options.find("Layer");
+                        if (i != options.end())
+                        {
+                            layer = math::clamp(
+                                std::atoi(i->second.c_str()),
+                                0,
+                                static_cast<int>(mutex.info.video.size()) - 1);
+                        }
+                        size = mutex.info.video[layer].size;
+                    }
+                }
+                if (size.isValid())
+                {
+                    const image::Size proxySize = image::getProxySize(size, proxyLevel);
+                    image::Size imageSize = image->getSize();
+                    int level = 0;
+                    while ((imageSize.w > proxySize.w || imageSize.h > proxySize.h) &&
+                        level < proxyLevelMax)
+                    {
+                        imageSize = image::getProxySize(imageSize, 1);
+                        ++level;
+                    }
+                    if (level > 0)
+                    {
+                        if (auto proxy = image::createProxy(image, level))
+                        {
+                            out = proxy;
+                        }
+                    }
+                }
+            }
+            return out;
+        }
+
+        size_t ISequenceRead::Private::getMaxTasks() const
+        {
+            return getSequenceMaxTasks(threadCount, *decodePool);
+        }
+
+        std::shared_ptr<ISequenceRead::Private::VideoRequest> ISequenceRead::Private::popVideoRequest()
+        {
+            std::shared_ptr<VideoRequest> out;
+            auto best = mutex.videoRequests.end();
+            int64_t bestPriority = 0;
+            for (auto i = mutex.videoRequests.begin(); i != mutex.videoRequests.end(); ++i)
+            {
+                const int64_t priority = getPriority((*i)->time);
+                if (best == mutex.videoRequests.end() || priority < bestPriority)
+                {
+                    best = i;
+                    bestPriority = priority;
+                }
+            }
+            if (best != mutex.videoRequests.end())
+            {
+                out = *best;
+                mutex.videoRequests.erase(best);
+            }
+            return out;
+        }
+
         void ISequenceRead::Private::addTags(Info& info)
         {
             if (!info.video.empty())
@@ -6,11 +6,10 @@
 
 #include <tlIO/SequenceIO.h>
 
-#include <atomic>
-#include <condition_variable>
+#include <tlIO/DecodePool.h>
+
 #include <list>
 #include <mutex>
-#include <thread>
 
 namespace tl
 {
@@ -21,8 +20,15 @@ namespace tl
             void addTags(Info&);
 
             size_t threadCount = sequenceThreadCount;
+            size_t chunkThreadCount = 0;
+            bool prefetch = false;
+            bool headerTemplate = true;
+            file::PrefetchOptions prefetchOptions;
+            std::shared_ptr<file::PrefetchPool> prefetchPool;
+            std::shared_ptr<file::BatchRead> batchRead;
 
-            Info info;
+            std::shared_ptr<DecodePool> decodePool;
+            uint64_t decodeClient = 0;
 
             struct InfoRequest
             {
@@ -40,27 +46,31 @@ namespace tl
                 otime::RationalTime time = time::invalidTime;
                 Options options;
                 std::promise<VideoData> promise;
-                std::future<VideoData> future;
             };
 
+            int64_t getPriority(const otime::RationalTime&) const;
+            std::shared_ptr<image::Image> getProxy(
+                const std::shared_ptr<image::Image>&,
+                const Options&);
+            size_t getMaxTasks() const;
+            std::shared_ptr<VideoRequest> popVideoRequest();
+
             struct Mutex
             {
+                bool infoValid = false;
+                Info info;
                 std::list<std::shared_ptr<InfoRequest> > infoRequests;
                 std::list<std::shared_ptr<VideoRequest> > videoRequests;
+                std::shared_ptr<SequenceHeader> header;
+                otime::RationalTime playhead = time::invalidTime;
+                size_t tasks = 0;
+                size_t inProgress = 0;
+                size_t chunkThreads = 0;
+                std::chrono::steady_clock::time_point logTimer;
                 bool stopped = false;
                 std::mutex mutex;
             };
             Mutex mutex;
-
-            struct Thread
-            {
-                std::list<std::shared_ptr<VideoRequest> > videoRequestsInProgress;
-                std::chrono::steady_clock::time_point logTimer;
-                std::condition_variable cv;
-                std::thread thread;
-                std::atomic<bool> running;
-            };
-            Thread thread;
         };
     }
 }
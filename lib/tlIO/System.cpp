@@ -44,6 +44,7 @@ namespace tl
         struct System::Private
         {
             std::shared_ptr<Cache> cache;
+            std::shared_ptr<DecodePool> decodePool;
             std::vector<std::string> names;
         };
 
@@ -53,31 +54,32 @@ namespace tl
             TLRENDER_P();
 
             p.cache = Cache::create();
+            p.decodePool = DecodePool::create();
 
             if (auto context = _context.lock())
             {
                 auto logSystem = context->getLogSystem();
-                _plugins.push_back(cineon::Plugin::create(p.cache, logSystem));
-                _plugins.push_back(dpx::Plugin::create(p.cache, logSystem));
-                _plugins.push_back(ppm::Plugin::create(p.cache, logSystem));
-                _plugins.push_back(sgi::Plugin::create(p.cache, logSystem));
+                _plugins.push_back(cineon::Plugin::create(p.cache, p.decodePool, logSystem));
+                _plugins.push_back(dpx::Plugin::create(p.cache, p.decodePool, logSystem));
+                _plugins.push_back(ppm::Plugin::create(p.cache, p.decodePool, logSystem));
+                _plugins.push_back(sgi::Plugin::create(p.cache, p.decodePool, logSystem));
 #if defined(TLRENDER_STB)
-                _plugins.push_back(stb::Plugin::create(p.cache, logSystem));
+                _plugins.push_back(stb::Plugin::create(p.cache, p.decodePool, logSystem));
 #endif
 #if defined(TLRENDER_FFMPEG)
                 _plugins.push_back(ffmpeg::Plugin::create(p.cache, logSystem));
 #endif // TLRENDER_FFMPEG
 #if defined(TLRENDER_JPEG)
-                _plugins.push_back(jpeg::Plugin::create(p.cache, logSystem));
+                _plugins.push_back(jpeg::Plugin::create(p.cache, p.decodePool, logSystem));
 #endif // TLRENDER_JPEG
 #if defined(TLRENDER_EXR)
-                _plugins.push_back(exr::Plugin::create(p.cache, logSystem));
+                _plugins.push_back(exr::Plugin::create(p.cache, p.decodePool, logSystem));
 #endif // TLRENDER_EXR
 #if defined(TLRENDER_PNG)
-                _plugins.push_back(png::Plugin::create(p.cache, logSystem));
+                _plugins.push_back(png::Plugin::create(p.cache, p.decodePool, logSystem));
 #endif // TLRENDER_PNG
 #if defined(TLRENDER_TIFF)
-                _plugins.push_back(tiff::Plugin::create(p.cache, logSystem));
+                _plugins.push_back(tiff::Plugin::create(p.cache, p.decodePool, logSystem));
 #endif // TLRENDER_TIFF
 #if defined(TLRENDER_USD)
                 _plugins.push_back(usd::Plugin::create(p.cache, logSystem));
@@ -226,6 +228,11 @@ namespace tl
         {
             return _p->cache;
         }
+
+        const std::shared_ptr<DecodePool>& System::getDecodePool() const
+        {
+            return _p->decodePool;
+        }
     }
 }
 
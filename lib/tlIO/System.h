@@ -76,6 +76,9 @@ namespace tl
             //! Get the I/O cache.
             const std::shared_ptr<Cache>& getCache() const;
 
+            //! Get the decode thread pool.
+            const std::shared_ptr<DecodePool>& getDecodePool() const;
+
         private:
             std::vector<std::shared_ptr<IPlugin> > _plugins;
 
@@ -16,6 +16,7 @@ namespace tl
     {
         void Plugin::_init(
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             IPlugin::_init(
@@ -25,6 +26,7 @@ namespace tl
                     { ".tif", io::FileType::Sequence }
                 },
                 cache,
+                decodePool,
                 logSystem);
             TIFFSetErrorHandler(nullptr);
             TIFFSetWarningHandler(nullptr);
@@ -35,10 +37,11 @@ namespace tl
 
         std::shared_ptr<Plugin> Plugin::create(
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             auto out = std::shared_ptr<Plugin>(new Plugin);
-            out->_init(cache, logSystem);
+            out->_init(cache, decodePool, logSystem);
             return out;
         }
 
@@ -46,7 +49,7 @@ namespace tl
             const file::Path& path,
             const io::Options& options)
         {
-            return Read::create(path, options, _cache, _logSystem);
+            return Read::create(path, options, _cache, _decodePool, _logSystem);
         }
 
         std::shared_ptr<io::IRead> Plugin::read(
@@ -54,7 +57,7 @@ namespace tl
             const std::vector<file::MemoryRead>& memory,
             const io::Options& options)
         {
-            return Read::create(path, memory, options, _cache, _logSystem);
+            return Read::create(path, memory, options, _cache, _decodePool, _logSystem);
         }
 
         image::Info Plugin::getWriteInfo(
@@ -9,6 +9,8 @@
 
 #include <tiffio.h>
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 
 namespace tl
@@ -132,6 +134,20 @@ namespace tl
                     TIFFGetFieldDefaulted(_tiff.p, TIFFTAG_COMPRESSION, &tiffCompression);
                     TIFFGetFieldDefaulted(_tiff.p, TIFFTAG_PLANARCONFIG, &tiffPlanarConfig);
                     _planar = PLANARCONFIG_SEPARATE == tiffPlanarConfig;
+                    _tiled = TIFFIsTiled(_tiff.p);
+                    if (_tiled)
+                    {
+                        uint32_t tiffTileWidth = 0;
+                        uint32_t tiffTileHeight = 0;
+                        TIFFGetField(_tiff.p, TIFFTAG_TILEWIDTH, &tiffTileWidth);
+                        TIFFGetField(_tiff.p, TIFFTAG_TILELENGTH, &tiffTileHeight);
+                        _tileSize.w = tiffTileWidth;
+                        _tileSize.h = tiffTileHeight;
+                        if (!_tileSize.isValid())
+                        {
+                            throw std::runtime_error(string::Format("{0}: Cannot open").arg(fileName));
+                        }
+                    }
                     _samples = tiffSamples;
                     _sampleDepth = tiffSampleDepth;
                     _scanlineSize = tiffWidth * tiffSamples * tiffSampleDepth / 8;
@@ -201,22 +217,61 @@ namespace tl
 
                 io::VideoData read(
                     const std::string& fileName,
-                    const otime::RationalTime& time)
+                    const otime::RationalTime& time,
+                    const io::Options& options)
                 {
                     io::VideoData out;
                     out.time = time;
                     const auto& info = _info.video[0];
-                    out.image = image::Image::create(info);
-                    out.image->setTags(_info.tags);
 
-                    if (_planar)
+                    // Get the region to read. With a region of interest
+                    // only the intersecting tiles or scanlines are read. The
+                    // region is only used at full resolution, since proxies
+                    // are filtered from the whole image.
+                    const math::Box2i bounds(0, 0, info.size.w, info.size.h);
+                    math::Box2i region = bounds;
+                    math::Box2i roi;
+                    if (0 == io::getProxyLevel(options) && io::getROI(options, roi))
+                    {
+                        roi = roi.intersect(bounds);
+                        if (roi.isValid())
+                        {
+                            if (_tiled)
+                            {
+                                region.min.x = roi.min.x / _tileSize.w * _tileSize.w;
+                                region.min.y = roi.min.y / _tileSize.h * _tileSize.h;
+                                region.max.x = std::min((roi.max.x / _tileSize.w + 1) * _tileSize.w - 1, bounds.max.x);
+                                region.max.y = std::min((roi.max.y / _tileSize.h + 1) * _tileSize.h - 1, bounds.max.y);
+                            }
+                            else
+                            {
+                                region.min.y = roi.min.y;
+                                region.max.y = roi.max.y;
+                            }
+                        }
+                    }
+                    image::Info regionInfo = info;
+                    regionInfo.size.w = region.w();
+                    regionInfo.size.h = region.h();
+                    out.image = image::Image::create(regionInfo);
+                    out.image->setTags(std::move(_info.tags));
+                    if (region != bounds)
+                    {
+                        out.image->setRegion(info.size, region.min);
+                    }
+
+                    if (_tiled)
+                    {
+                        _readTiles(out.image->getData(), region);
+                    }
+                    else if (_planar)
                     {
                         std::vector<uint8_t> scanline;
                         scanline.resize(info.size.w * _sampleDepth / 8);
                         for (size_t sample = 0; sample < _samples; ++sample)
                         {
                             uint8_t* p = out.image->getData();
-                            for (uint16_t y = 0; y < info.size.h; ++y, p += _scanlineSize)
+                            for (int y = region.min.y; y <= region.max.y; ++y, p += _scanlineSize)
                             {
                                 if (TIFFReadScanline(_tiff.p, (tdata_t*)scanline.data(), y, sample) == -1)
                                 {
@@ -228,7 +283,7 @@ namespace tl
                                 {
                                     const uint8_t* inP = scanline.data();
                                     uint8_t* outP = p + sample;
-                                    for (uint16_t x = 0; x < info.size.w; ++x, ++inP, outP += _samples)
+                                    for (int x = 0; x < info.size.w; ++x, ++inP, outP += _samples)
                                     {
                                         *outP = *inP;
                                     }
@@ -238,7 +293,7 @@ namespace tl
                                 {
                                     const uint16_t* inP = reinterpret_cast<uint16_t*>(scanline.data());
                                     uint16_t* outP = reinterpret_cast<uint16_t*>(p) + sample;
-                                    for (uint16_t x = 0; x < info.size.w; ++x, ++inP, outP += _samples)
+                                    for (int x = 0; x < info.size.w; ++x, ++inP, outP += _samples)
                                     {
                                         *outP = *inP;
                                     }
@@ -248,7 +303,7 @@ namespace tl
                                 {
                                     const float* inP = reinterpret_cast<float*>(scanline.data());
                                     float* outP = reinterpret_cast<float*>(p) + sample;
-                                    for (uint16_t x = 0; x < info.size.w; ++x, ++inP, outP += _samples)
+                                    for (int x = 0; x < info.size.w; ++x, ++inP, outP += _samples)
                                     {
                                         *outP = *inP;
                                     }
@@ -263,7 +318,7 @@ namespace tl
                     else
                     {
                         uint8_t* p = out.image->getData();
-                        for (uint16_t y = 0; y < info.size.h; ++y, p += _scanlineSize)
+                        for (int y = region.min.y; y <= region.max.y; ++y, p += _scanlineSize)
                         {
                             if (TIFFReadScanline(_tiff.p, (tdata_t*)p, y) == -1)
                             {
@@ -276,6 +331,51 @@ namespace tl
                 }
 
             private:
+                // Read the tiles that cover the region. The region must start
+                // on a tile boundary.
+                void _readTiles(uint8_t* data, const math::Box2i& region)
+                {
+                    const size_t sampleByteCount = _sampleDepth / 8;
+                    const size_t pixelByteCount = _samples * sampleByteCount;
+                    const size_t rowByteCount = region.w() * pixelByteCount;
+                    const size_t tileRowByteCount = _tileSize.w * (_planar ? 1 : _samples) * sampleByteCount;
+                    std::vector<uint8_t> tile(TIFFTileSize(_tiff.p));
+                    for (size_t sample = 0; sample < (_planar ? _samples : 1); ++sample)
+                    {
+                        for (int ty = region.min.y; ty <= region.max.y; ty += _tileSize.h)
+                        {
+                            const int h = std::min(_tileSize.h, region.max.y - ty + 1);
+                            for (int tx = region.min.x; tx <= region.max.x; tx += _tileSize.w)
+                            {
+                                if (TIFFReadTile(_tiff.p, tile.data(), tx, ty, 0, sample) == -1)
+                                {
+                                    return;
+                                }
+                                const int w = std::min(_tileSize.w, region.max.x - tx + 1);
+                                for (int y = 0; y < h; ++y)
+                                {
+                                    const uint8_t* in = tile.data() + y * tileRowByteCount;
+                                    uint8_t* out = data +
+                                        (ty - region.min.y + y) * rowByteCount +
+                                        (tx - region.min.x) * pixelByteCount;
+                                    if (_planar)
+                                    {
+                                        out += sample * sampleByteCount;
+                                        for (int x = 0; x < w; ++x, in += sampleByteCount, out += pixelByteCount)
+                                        {
+                                            std::memcpy(out, in, sampleByteCount);
+                                        }
+                                    }
+                                    else
+                                    {
+                                        std::memcpy(out, in, w * pixelByteCount);
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+
                 struct TIFFData
                 {
                     ~TIFFData()
@@ -288,13 +388,15 @@ namespace tl
                     TIFF* p = nullptr;
                 };
 
-                TIFFData  _tiff;
-                Memory    _memory;
-                bool      _planar = false;
-                size_t    _samples = 0;
-                size_t    _sampleDepth = 0;
-                size_t    _scanlineSize = 0;
-                io::Info  _info;
+                TIFFData     _tiff;
+                Memory       _memory;
+                bool         _planar = false;
+                bool         _tiled = false;
+                math::Size2i _tileSize;
+                size_t       _samples = 0;
+                size_t       _sampleDepth = 0;
+                size_t       _scanlineSize = 0;
+                io::Info     _info;
             };
         }
 
@@ -303,9 +405,10 @@ namespace tl
             const std::vector<file::MemoryRead>& memory,
             const io::Options& options,
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
-            ISequenceRead::_init(path, memory, options, cache, logSystem);
+            ISequenceRead::_init(path, memory, options, cache, decodePool, logSystem);
         }
 
         Read::Read()
@@ -320,10 +423,11 @@ namespace tl
             const file::Path& path,
             const io::Options& options,
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             auto out = std::shared_ptr<Read>(new Read);
-            out->_init(path, {}, options, cache, logSystem);
+            out->_init(path, {}, options, cache, decodePool, logSystem);
             return out;
         }
 
@@ -332,10 +436,11 @@ namespace tl
             const std::vector<file::MemoryRead>& memory,
             const io::Options& options,
             const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
             const std::weak_ptr<log::System>& logSystem)
         {
             auto out = std::shared_ptr<Read>(new Read);
-            out->_init(path, memory, options, cache, logSystem);
+            out->_init(path, memory, options, cache, decodePool, logSystem);
             return out;
         }
 
@@ -354,9 +459,9 @@ namespace tl
             const std::string& fileName,
             const file::MemoryRead* memory,
             const otime::RationalTime& time,
-            const io::Options&)
+            const io::Options& options)
         {
-            return File(fileName, memory).read(fileName, time);
+            return File(fileName, memory).read(fileName, time, options);
         }
     }
 }
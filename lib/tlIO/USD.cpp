@@ -42,6 +42,7 @@ namespace tl
                     { ".usdz", io::FileType::Sequence }
                 },
                 cache,
+                nullptr,
                 logSystem);
             TLRENDER_P();
             p.render = Render::create(cache, logSystem);
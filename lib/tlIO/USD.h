@@ -59,6 +59,7 @@ namespace tl
                 const std::weak_ptr<log::System>&);
 
             std::future<io::Info> getInfo() override;
+            using io::IRead::readVideo;
             std::future<io::VideoData> readVideo(
                 const otime::RationalTime&,
                 const io::Options&) override;
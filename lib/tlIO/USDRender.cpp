@@ -563,10 +563,10 @@ namespace tl
                 io::VideoData videoData;
                 if (request && p.cache)
                 {
-                    const std::string cacheKey = io::getVideoCacheKey(
-                        request->path,
+                    const auto cacheKey = io::getVideoCacheKey(
+                        io::getPathID(request->path),
                         request->time,
-                        ioOptions,
+                        io::getOptionsHash(ioOptions),
                         {});
                     if (p.cache->getVideo(cacheKey, videoData))
                     {
@@ -619,7 +619,13 @@ namespace tl
 
                         if (p.cache)
                         {
-                            p.cache->addVideo(cacheKey, videoData);
+                            p.cache->addVideo(
+                                io::getVideoCacheKey(
+                                    io::getPathID(request->path),
+                                    request->time,
+                                    io::getOptionsHash(ioOptions),
+                                    {}),
+                                videoData);
                         }
 
                         request.reset();
@@ -845,7 +851,13 @@ namespace tl
 
                     if (p.cache)
                     {
-                        p.cache->addVideo(cacheKey, videoData);
+                        p.cache->addVideo(
+                            io::getVideoCacheKey(
+                                io::getPathID(request->path),
+                                request->time,
+                                io::getOptionsHash(ioOptions),
+                                {}),
+                            videoData);
                     }
                 }
 
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimeline/AudioOutput.h>
+
+#include <cstring>
+
+namespace tl
+{
+    namespace timeline
+    {
+        size_t audioOutput(
+            AudioOutputState& state,
+            uint8_t* out,
+            size_t sampleCount)
+        {
+            size_t count = 0;
+            audio::AudioRingBuffer* ringBuffer = state.ringBuffer.get();
+            if (ringBuffer)
+            {
+                // Discard the audio from before a reset once the audio
+                // thread has stopped writing it.
+                const uint64_t resetCount = state.resetCount;
+                const uint64_t flushCount = state.flushCount;
+                if (resetCount == flushCount && flushCount != state.resetAck)
+                {
+                    ringBuffer->skip(ringBuffer->getReadAvailable());
+                    state.frame = 0;
+                    state.resetAck = flushCount;
+                }
+
+                // Copy the audio from the ring buffer.
+                if (state.playing && resetCount == state.resetAck)
+                {
+                    count = ringBuffer->read(out, sampleCount);
+                    state.frame += count;
+                }
+            }
+
+            // Zero the remaining output audio data.
+            if (count < sampleCount)
+            {
+                const size_t byteCount = state.info.getByteCount();
+                std::memset(
+                    out + count * byteCount,
+                    0,
+                    (sampleCount - count) * byteCount);
+            }
+
+            return count;
+        }
+    }
+}
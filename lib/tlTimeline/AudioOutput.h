@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/AudioRingBuffer.h>
+
+#include <atomic>
+
+namespace tl
+{
+    namespace timeline
+    {
+        //! Audio output state shared between the player audio thread and
+        //! the audio device callback.
+        //!
+        //! Resets are handed from the player to the audio thread and then to
+        //! the callback: the player increments the reset count, the audio
+        //! thread sets the flush count when it has stopped writing the old
+        //! audio, and the callback discards the ring buffer and acknowledges
+        //! the reset.
+        struct AudioOutputState
+        {
+            std::atomic<bool>     playing    = { false };
+            std::atomic<uint64_t> resetCount = { 0 };
+            std::atomic<uint64_t> flushCount = { 0 };
+            std::atomic<uint64_t> resetAck   = { 0 };
+            std::atomic<int64_t>  frame      = { 0 }; //!< Samples consumed since the last reset
+
+            //! These should only be modified while the audio device stream
+            //! is stopped.
+            audio::Info info;
+            std::shared_ptr<audio::AudioRingBuffer> ringBuffer;
+        };
+
+        //! Fill an audio output buffer from the ring buffer, zeroing the
+        //! samples that are not available. This is called from the
+        //! real-time audio callback, it does not take any locks or allocate
+        //! memory. Returns the number of samples copied from the ring
+        //! buffer.
+        size_t audioOutput(
+            AudioOutputState&,
+            uint8_t*,
+            size_t sampleCount);
+    }
+}
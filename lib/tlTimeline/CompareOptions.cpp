@@ -185,6 +185,65 @@ namespace tl
             return getRenderSize(mode, sizes);
         }
 
+        math::Box2i getROI(const math::Box2f& view, const image::Size& size, int grid)
+        {
+            math::Box2i out;
+            if (size.isValid() && grid > 0)
+            {
+                const float pixelAspectRatio = size.pixelAspectRatio > 0.F ? size.pixelAspectRatio : 1.F;
+                const int x0 = std::floor(view.min.x / pixelAspectRatio / grid) - 1;
+                const int y0 = std::floor(view.min.y / grid) - 1;
+                const int x1 = std::floor(view.max.x / pixelAspectRatio / grid) + 1;
+                const int y1 = std::floor(view.max.y / grid) + 1;
+                const math::Box2i bounds(0, 0, size.w, size.h);
+                out = math::Box2i(
+                    math::Vector2i(x0 * grid, y0 * grid),
+                    math::Vector2i((x1 + 1) * grid - 1, (y1 + 1) * grid - 1)).intersect(bounds);
+                if (out == bounds)
+                {
+                    out = math::Box2i();
+                }
+            }
+            return out;
+        }
+
+        math::Box2f getNormalizedROI(const math::Box2i& roi, const image::Size& size)
+        {
+            math::Box2f out;
+            if (roi.isValid() && size.isValid())
+            {
+                out = math::Box2f(
+                    math::Vector2f(
+                        roi.min.x / static_cast<float>(size.w),
+                        roi.min.y / static_cast<float>(size.h)),
+                    math::Vector2f(
+                        (roi.max.x + 1) / static_cast<float>(size.w),
+                        (roi.max.y + 1) / static_cast<float>(size.h)));
+            }
+            return out;
+        }
+
+        math::Box2i getImageROI(const math::Box2f& roi, const image::Size& size)
+        {
+            math::Box2i out;
+            if (roi.isValid() && size.isValid())
+            {
+                const math::Box2i bounds(0, 0, size.w, size.h);
+                out = math::Box2i(
+                    math::Vector2i(
+                        std::floor(roi.min.x * size.w),
+                        std::floor(roi.min.y * size.h)),
+                    math::Vector2i(
+                        std::ceil(roi.max.x * size.w) - 1,
+                        std::ceil(roi.max.y * size.h) - 1)).intersect(bounds);
+                if (out == bounds || !out.isValid())
+                {
+                    out = math::Box2i();
+                }
+            }
+            return out;
+        }
+
         otime::RationalTime getCompareTime(
             const otime::RationalTime& sourceTime,
             const otime::TimeRange& sourceTimeRange,
@@ -64,6 +64,24 @@ namespace tl
         //! Get the render size for the given compare mode and video data.
         math::Size2i getRenderSize(CompareMode, const std::vector<VideoData>&);
 
+        //! Get the region of interest of an image from the visible part of
+        //! the render. The view is in render coordinates, which are scaled
+        //! horizontally by the pixel aspect ratio, and the region is in
+        //! image pixels. The region is expanded to a grid so that small
+        //! changes to the view do not change it. An empty box is returned
+        //! when the whole image is visible.
+        math::Box2i getROI(const math::Box2f& view, const image::Size&, int grid = 256);
+
+        //! Normalize a region of interest in image pixels, so that the image
+        //! covers zero to one. This lets the region be applied to images of
+        //! different resolutions that fill the same frame.
+        math::Box2f getNormalizedROI(const math::Box2i&, const image::Size&);
+
+        //! Convert a normalized region of interest to image pixels. The
+        //! region is expanded to whole pixels, and an empty box is returned
+        //! when it covers the whole image.
+        math::Box2i getImageROI(const math::Box2f&, const image::Size&);
+
         //! Get a compare time.
         otime::RationalTime getCompareTime(
             const otime::RationalTime& sourceTime,
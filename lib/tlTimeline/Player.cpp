@@ -6,7 +6,10 @@
 
 #include <tlTimeline/Util.h>
 
+#include <tlIO/System.h>
+
 #include <tlCore/Error.h>
+#include <tlCore/Math.h>
 #include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
 
@@ -14,6 +17,9 @@ namespace tl
 {
     namespace timeline
     {
+        TLRENDER_ENUM_IMPL(PlayerCacheMode, "Duration", "ByteCount");
+        TLRENDER_ENUM_SERIALIZE_IMPL(PlayerCacheMode);
+
         TLRENDER_ENUM_IMPL(Playback, "Stop", "Forward", "Reverse");
         TLRENDER_ENUM_SERIALIZE_IMPL(Playback);
 
@@ -46,10 +52,16 @@ namespace tl
             {
                 std::vector<std::string> lines;
                 lines.push_back(std::string());
+                lines.push_back(string::Format("    Cache mode: {0}").
+                    arg(playerOptions.cache.mode));
                 lines.push_back(string::Format("    Cache read ahead: {0}").
                     arg(playerOptions.cache.readAhead));
                 lines.push_back(string::Format("    Cache read behind: {0}").
                     arg(playerOptions.cache.readBehind));
+                lines.push_back(string::Format("    Cache video size: {0}MB").
+                    arg(playerOptions.cache.videoByteCount / memory::megabyte));
+                lines.push_back(string::Format("    Cache audio size: {0}MB").
+                    arg(playerOptions.cache.audioByteCount / memory::megabyte));
                 lines.push_back(string::Format("    Audio buffer frame count: {0}").
                     arg(playerOptions.audioBufferFrameCount));
                 lines.push_back(string::Format("    Mute timeout: {0}ms").
@@ -65,6 +77,12 @@ namespace tl
             p.timeline = timeline;
             p.timeRange = timeline->getTimeRange();
             p.ioInfo = timeline->getIOInfo();
+            if (auto ioSystem = context->getSystem<io::System>())
+            {
+                p.ioCache = ioSystem->getCache();
+                p.ioCacheOwner = p.ioCache->addOwner();
+                p.ioCacheCompareOwner = p.ioCache->addOwner();
+            }
 
             // Create observers.
             p.speed = observer::Value<double>::create(p.timeRange.duration().rate());
@@ -80,6 +98,8 @@ namespace tl
             p.ioOptions = observer::Value<io::Options>::create();
             p.videoLayer = observer::Value<int>::create(0);
             p.compareVideoLayers = observer::List<int>::create();
+            p.proxyLevel = observer::Value<int>::create(0);
+            p.roi = observer::Value<math::Box2f>::create(math::Box2f());
             p.currentVideoData = observer::List<VideoData>::create();
             p.audioDevice = observer::Value<audio::DeviceID>::create(playerOptions.audioDevice);
             p.volume = observer::Value<float>::create(1.F);
@@ -132,6 +152,23 @@ namespace tl
                 {
                     _thread();
                 });
+            if (p.hasAudio())
+            {
+                p.audioThread.thread = std::thread(
+                    [this]
+                    {
+                        TLRENDER_P();
+                        while (p.running)
+                        {
+                            const auto t0 = std::chrono::steady_clock::now();
+                            p.audioUpdate();
+                            time::sleep(
+                                p.playerOptions.sleepTimeout,
+                                t0,
+                                std::chrono::steady_clock::now());
+                        }
+                    });
+            }
         }
 
         Player::Player() :
@@ -146,6 +183,15 @@ namespace tl
             {
                 p.thread.thread.join();
             }
+            if (p.audioThread.thread.joinable())
+            {
+                p.audioThread.thread.join();
+            }
+            if (p.ioCache)
+            {
+                p.ioCache->removeOwner(p.ioCacheOwner);
+                p.ioCache->removeOwner(p.ioCacheCompareOwner);
+            }
 #if defined(TLRENDER_AUDIO)
             if (p.rtAudio && p.rtAudio->isStreamOpen())
             {
@@ -628,6 +674,51 @@ namespace tl
             }
         }
 
+        int Player::getProxyLevel() const
+        {
+            return _p->proxyLevel->get();
+        }
+
+        std::shared_ptr<observer::IValue<int> > Player::observeProxyLevel() const
+        {
+            return _p->proxyLevel;
+        }
+
+        void Player::setProxyLevel(int value)
+        {
+            TLRENDER_P();
+            if (p.proxyLevel->setIfChanged(math::clamp(value, 0, io::proxyLevelMax)))
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.proxyLevel = p.proxyLevel->get();
+                p.mutex.clearRequests = true;
+                p.mutex.clearCache = true;
+            }
+        }
+
+        const math::Box2f& Player::getROI() const
+        {
+            return _p->roi->get();
+        }
+
+        std::shared_ptr<observer::IValue<math::Box2f> > Player::observeROI() const
+        {
+            return _p->roi;
+        }
+
+        void Player::setROI(const math::Box2f& value)
+        {
+            TLRENDER_P();
+            const math::Box2f roi = value.isValid() ? value : math::Box2f();
+            if (p.roi->setIfChanged(roi))
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.roi = roi;
+                p.mutex.clearRequests = true;
+                p.mutex.clearCache = true;
+            }
+        }
+
         const std::vector<VideoData>& Player::getCurrentVideo() const
         {
             return _p->currentVideoData->get();
@@ -689,7 +780,11 @@ namespace tl
                 {
                     std::unique_lock<std::mutex> lock(p.audioMutex.mutex);
                     start = p.audioMutex.start;
-                    t = otime::RationalTime(p.audioMutex.frame, p.ioInfo.audio.sampleRate).rescaled_to(1.0).value();
+                    const size_t sampleRate = p.audioCallback.info.sampleRate;
+                    if (sampleRate > 0)
+                    {
+                        t = otime::RationalTime(p.audioCallback.frame, sampleRate).rescaled_to(1.0).value();
+                    }
                 }
                 else
                 {
@@ -752,6 +847,8 @@ namespace tl
                     p.thread.ioOptions = p.mutex.ioOptions;
                     p.thread.videoLayer = p.mutex.videoLayer;
                     p.thread.compareVideoLayers = p.mutex.compareVideoLayers;
+                    p.thread.proxyLevel = p.mutex.proxyLevel;
+                    p.thread.roi = p.mutex.roi;
                     p.thread.audioOffset = p.mutex.audioOffset;
                     clearRequests = p.mutex.clearRequests;
                     p.mutex.clearRequests = false;
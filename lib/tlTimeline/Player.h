@@ -23,9 +23,15 @@ namespace tl
             //! Cached video frames.
             std::vector<otime::TimeRange> videoFrames;
 
+            //! Cached video size in bytes.
+            size_t videoByteCount = 0;
+
             //! Cached audio frames.
             std::vector<otime::TimeRange> audioFrames;
 
+            //! Cached audio size in bytes.
+            size_t audioByteCount = 0;
+
             bool operator == (const PlayerCacheInfo&) const;
             bool operator != (const PlayerCacheInfo&) const;
         };
@@ -278,6 +284,28 @@ namespace tl
             //! Set the comparison video layers.
             void setCompareVideoLayers(const std::vector<int>&);
 
+            //! Get the proxy level. Each level halves the resolution of the
+            //! decoded images, zero is full resolution.
+            int getProxyLevel() const;
+
+            //! Observe the proxy level.
+            std::shared_ptr<observer::IValue<int> > observeProxyLevel() const;
+
+            //! Set the proxy level.
+            void setProxyLevel(int);
+
+            //! Get the region of interest, normalized to the timeline frame
+            //! (see getNormalizedROI()). Readers that support it only decode
+            //! this part of the image. An invalid box is the whole image.
+            const math::Box2f& getROI() const;
+
+            //! Observe the region of interest.
+            std::shared_ptr<observer::IValue<math::Box2f> > observeROI() const;
+
+            //! Set the region of interest. Changing the region of interest
+            //! clears the cache, so it should change in coarse steps.
+            void setROI(const math::Box2f&);
+
             //! Get the current video data.
             const std::vector<VideoData>& getCurrentVideo() const;
 
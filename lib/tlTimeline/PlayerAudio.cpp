@@ -9,6 +9,8 @@
 #include <tlCore/Assert.h>
 #include <tlCore/StringFormat.h>
 
+#include <cstring>
+
 namespace tl
 {
     namespace timeline
@@ -203,11 +205,6 @@ namespace tl
                     audioInfo.dataType != audio::DataType::None &&
                     audioInfo.sampleRate > 0)
                 {
-                    // These are OK to modify since the audio thread is stopped.
-                    audioMutex.reset = true;
-                    audioThread.info = audioInfo;
-                    audioThread.resample.reset();
-
                     try
                     {
                         RtAudio::StreamParameters rtParameters;
@@ -224,6 +221,24 @@ namespace tl
                             this,
                             nullptr,
                             rtAudioErrorCallback);
+
+                        // The ring buffer holds a few RtAudio buffers so
+                        // the audio thread has time to keep it filled.
+                        auto ringBuffer = audio::AudioRingBuffer::create(
+                            audioInfo,
+                            rtBufferFrames * 4);
+                        {
+                            std::unique_lock<std::mutex> lock(audioMutex.mutex);
+                            audioMutex.reset = true;
+                            audioMutex.info = audioInfo;
+                            audioMutex.ringBuffer = ringBuffer;
+                            ++audioCallback.resetCount;
+                        }
+
+                        // These are OK to modify since the stream is stopped.
+                        audioCallback.info = audioInfo;
+                        audioCallback.ringBuffer = ringBuffer;
+
                         rtAudio->startStream();
                     }
                     catch (const std::exception& e)
@@ -241,7 +256,8 @@ namespace tl
         {
             audioMutex.reset = true;
             audioMutex.start = time;
-            audioMutex.frame = 0;
+            ++audioCallback.resetCount;
+            audioCallback.frame = 0;
         }
 
         size_t Player::Private::getAudioChannelCount(
@@ -256,88 +272,112 @@ namespace tl
             return out;
         }
 
-#if defined(TLRENDER_AUDIO)
-        int Player::Private::rtAudioCallback(
-            void* outputBuffer,
-            void* inputBuffer,
-            unsigned int nFrames,
-            double streamTime,
-            RtAudioStreamStatus status,
-            void* userData)
+        void Player::Private::audioUpdate()
         {
-            auto p = reinterpret_cast<Player::Private*>(userData);
-
             // Get mutex protected values.
             Playback playback = Playback::Stop;
             double speed = 0.0;
             float volume = 1.F;
             bool mute = false;
             std::chrono::steady_clock::time_point muteTimeout;
-            double audioOffset = 0.0;
             bool reset = false;
-            otime::RationalTime start = time::invalidTime;
             {
-                std::unique_lock<std::mutex> lock(p->audioMutex.mutex);
-                playback = p->audioMutex.playback;
-                speed = p->audioMutex.speed;
-                volume = p->audioMutex.volume;
-                mute = p->audioMutex.mute;
-                muteTimeout = p->audioMutex.muteTimeout;
-                audioOffset = p->audioMutex.audioOffset;
-                reset = p->audioMutex.reset;
-                p->audioMutex.reset = false;
-                start = p->audioMutex.start;
+                std::unique_lock<std::mutex> lock(audioMutex.mutex);
+                playback = audioMutex.playback;
+                speed = audioMutex.speed;
+                volume = audioMutex.volume;
+                mute = audioMutex.mute;
+                muteTimeout = audioMutex.muteTimeout;
+                reset = audioMutex.reset;
+                audioMutex.reset = false;
                 if (reset)
                 {
-                    p->audioMutex.frame = 0;
+                    audioThread.start = audioMutex.start;
+                    audioThread.resetCount = audioCallback.resetCount;
+                    audioThread.info = audioMutex.info;
+                    audioThread.ringBuffer = audioMutex.ringBuffer;
                 }
             }
-            //std::cout << "playback: " << playback << std::endl;
-            //std::cout << "reset: " << reset << std::endl;
-            //std::cout << "start: " << start << std::endl;
+            audioCallback.playing = playback != Playback::Stop;
 
-            // Zero output audio data.
-            const audio::Info& outputInfo = p->audioThread.info;
-            std::memset(outputBuffer, 0, nFrames * outputInfo.getByteCount());
-
-            const audio::Info& inputInfo = p->ioInfo.audio;
-            if (playback != Playback::Stop && inputInfo.sampleRate > 0)
+            // Flush the audio resampler and buffer when the playback is
+            // reset, and ask the RtAudio callback to discard the audio
+            // that is already in the ring buffer.
+            if (reset)
             {
-                // Flush the audio resampler and buffer when the RtAudio
-                // playback is reset.
-                if (reset)
+                audioThread.inputFrame = 0;
+                audioThread.cacheRetryCount = 0;
+                if (audioThread.timeStretch)
                 {
-                    p->audioThread.inputFrame = 0;
-                    p->audioThread.outputFrame = 0;
-                    if (p->audioThread.resample)
-                    {
-                        p->audioThread.resample->flush();
-                    }
-                    p->audioThread.buffer.clear();
+                    audioThread.timeStretch->flush();
                 }
+                if (audioThread.resample)
+                {
+                    audioThread.resample->flush();
+                }
+                audioThread.buffer.clear();
+                audioCallback.flushCount = audioThread.resetCount;
+            }
 
-                // Create the audio resampler.
-                if (!p->audioThread.resample ||
-                    (p->audioThread.resample && p->audioThread.resample->getInputInfo() != p->ioInfo.audio))
+            const audio::Info& inputInfo = ioInfo.audio;
+            const audio::Info& outputInfo = audioThread.info;
+            const auto& ringBuffer = audioThread.ringBuffer;
+            if (playback == Playback::Stop ||
+                !ringBuffer ||
+                0 == inputInfo.sampleRate ||
+                0 == outputInfo.sampleRate ||
+                audioCallback.resetAck != audioThread.resetCount)
+            {
+                return;
+            }
+
+            // Create the audio resampler.
+            if (!audioThread.resample ||
+                (audioThread.resample &&
+                    (audioThread.resample->getInputInfo() != inputInfo ||
+                    audioThread.resample->getOutputInfo() != outputInfo)))
+            {
+                audioThread.resample = audio::AudioResample::create(
+                    inputInfo,
+                    outputInfo);
+            }
+
+            // Create the audio time stretch for off-speed playback. Speeds
+            // outside of the time stretch range are muted.
+            const double speedMult = speed / timeRange.duration().rate();
+            const bool timeStretch = speedMult != 1.0 &&
+                speedMult >= audio::timeStretchSpeedMin &&
+                speedMult <= audio::timeStretchSpeedMax;
+            const bool speedMute = speedMult != 1.0 && !timeStretch;
+            if (timeStretch)
+            {
+                if (!audioThread.timeStretch ||
+                    (audioThread.timeStretch && audioThread.timeStretch->getInfo() != inputInfo))
                 {
-                    p->audioThread.resample = audio::AudioResample::create(
-                        p->ioInfo.audio,
-                        p->audioThread.info);
+                    audioThread.timeStretch = audio::AudioTimeStretch::create(inputInfo);
                 }
+                audioThread.timeStretch->setSpeed(speedMult);
+            }
 
-                // Get audio from the cache.
-                int64_t size = otio::RationalTime(
-                    nFrames * 2 - getSampleCount(p->audioThread.buffer),
+            // Get audio from the cache. When the audio is time stretched
+            // the input is consumed at the playback speed.
+            const size_t bufferSampleCount = getSampleCount(audioThread.buffer);
+            const size_t writeAvailable = ringBuffer->getWriteAvailable();
+            if (writeAvailable > bufferSampleCount)
+            {
+                const int64_t requestSize = otio::RationalTime(
+                    (writeAvailable - bufferSampleCount) * (timeStretch ? speedMult : 1.0),
                     outputInfo.sampleRate).
                     rescaled_to(inputInfo.sampleRate).value();
-                int64_t t = (start - p->timeRange.start_time()).rescaled_to(inputInfo.sampleRate).value();
+                int64_t size = requestSize;
+                int64_t t = (audioThread.start - timeRange.start_time()).rescaled_to(inputInfo.sampleRate).value();
                 if (Playback::Forward == playback)
                 {
-                    t += p->audioThread.inputFrame;
+                    t += audioThread.inputFrame;
                 }
                 else
                 {
-                    t -= p->audioThread.inputFrame;
+                    t -= audioThread.inputFrame;
                 }
                 int64_t seconds = t / inputInfo.sampleRate;
                 int64_t offset = t - (seconds * inputInfo.sampleRate);
@@ -373,9 +413,9 @@ namespace tl
                 bool found = false;
                 if (size >= 0 && seconds >= 0 && offset >= 0)
                 {
-                    std::unique_lock<std::mutex> lock(p->audioMutex.mutex);
-                    auto j = p->audioMutex.audioDataCache.find(seconds);
-                    if (j != p->audioMutex.audioDataCache.end())
+                    std::unique_lock<std::mutex> lock(audioMutex.mutex);
+                    auto j = audioMutex.audioDataCache.find(seconds);
+                    if (j != audioMutex.audioDataCache.end())
                     {
                         audioData = j->second;
                         found = true;
@@ -388,7 +428,7 @@ namespace tl
                     std::vector<const uint8_t*> audioLayerP;
                     for (const auto& layer : audioData.layers)
                     {
-                        if (layer.audio && layer.audio->getInfo() == p->ioInfo.audio)
+                        if (layer.audio && layer.audio->getInfo() == inputInfo)
                         {
                             audioLayerP.push_back(
                                 layer.audio->getData() +
@@ -400,7 +440,7 @@ namespace tl
                     const auto now = std::chrono::steady_clock::now();
                     if (mute ||
                         now < muteTimeout ||
-                        speed != p->timeRange.duration().rate())
+                        speedMute)
                     {
                         volume = 0.F;
                     }
@@ -426,45 +466,77 @@ namespace tl
                         audio = tmp;
                     }
 
+                    // Time stretch the audio if necessary.
+                    if (timeStretch)
+                    {
+                        audio = audioThread.timeStretch->process(audio);
+                    }
+
                     // Resample the audio and add it to the buffer.
-                    p->audioThread.buffer.push_back(p->audioThread.resample->process(audio));
+                    if (audio->getSampleCount() > 0)
+                    {
+                        audioThread.buffer.push_back(audioThread.resample->process(audio));
+                    }
+                    audioThread.cacheRetryCount = 0;
+                    audioThread.inputFrame += size;
                 }
-
-                // Send audio data to RtAudio.
-                if (nFrames <= getSampleCount(p->audioThread.buffer))
+                else if (0 == bufferSampleCount && 0 == ringBuffer->getReadAvailable())
                 {
-                    audio::move(
-                        p->audioThread.buffer,
-                        reinterpret_cast<uint8_t*>(outputBuffer),
-                        nFrames);
+                    // The audio is not in the cache and the RtAudio callback
+                    // has run out of data, skip ahead with silence so the
+                    // audio stays in sync with the video.
+                    if (audioThread.cacheRetryCount > 1)
+                    {
+                        audioThread.cacheRetryCount = 0;
+                        auto silence = audio::Audio::create(outputInfo, writeAvailable);
+                        silence->zero();
+                        audioThread.buffer.push_back(silence);
+                        audioThread.inputFrame += requestSize;
+                    }
+                    else
+                    {
+                        audioThread.cacheRetryCount += 1;
+                    }
                 }
+            }
 
-                // Update the frame counters.
-                if (found || p->audioThread.cacheRetryCount > 1)
-                {
-                    p->audioThread.cacheRetryCount = 0;
-                    p->audioThread.inputFrame += (found && size >= 0) ?
-                        size :
-                        otio::RationalTime(
-                            nFrames,
-                            outputInfo.sampleRate).
-                        rescaled_to(inputInfo.sampleRate).value();
-                    p->audioThread.outputFrame += nFrames;
-                }
-                else
-                {
-                    p->audioThread.cacheRetryCount += 1;
-                }
-                const int64_t outputFrame = otio::RationalTime(
-                    p->audioThread.outputFrame,
-                    outputInfo.sampleRate).
-                    rescaled_to(inputInfo.sampleRate).value();
+            // Copy the buffered audio to the ring buffer.
+            while (!audioThread.buffer.empty())
+            {
+                auto audio = audioThread.buffer.front();
+                const size_t sampleCount = audio->getSampleCount();
+                const size_t count = ringBuffer->write(audio->getData(), sampleCount);
+                if (count < sampleCount)
                 {
-                    std::unique_lock<std::mutex> lock(p->audioMutex.mutex);
-                    p->audioMutex.frame = outputFrame;
+                    if (count > 0)
+                    {
+                        auto tmp = audio::Audio::create(outputInfo, sampleCount - count);
+                        std::memcpy(
+                            tmp->getData(),
+                            audio->getData() + count * outputInfo.getByteCount(),
+                            tmp->getByteCount());
+                        audioThread.buffer.front() = tmp;
+                    }
+                    break;
                 }
+                audioThread.buffer.pop_front();
             }
+        }
 
+#if defined(TLRENDER_AUDIO)
+        int Player::Private::rtAudioCallback(
+            void* outputBuffer,
+            void* inputBuffer,
+            unsigned int nFrames,
+            double streamTime,
+            RtAudioStreamStatus status,
+            void* userData)
+        {
+            auto p = reinterpret_cast<Player::Private*>(userData);
+            audioOutput(
+                p->audioCallback,
+                reinterpret_cast<uint8_t*>(outputBuffer),
+                nFrames);
             return 0;
         }
 
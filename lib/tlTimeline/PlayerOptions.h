@@ -5,21 +5,47 @@
 #pragma once
 
 #include <tlCore/AudioSystem.h>
+#include <tlCore/Memory.h>
 #include <tlCore/Time.h>
 
 namespace tl
 {
     namespace timeline
     {
+        //! Timeline player cache modes.
+        enum class PlayerCacheMode
+        {
+            Duration,
+            ByteCount,
+
+            Count,
+            First = Duration
+        };
+        TLRENDER_ENUM(PlayerCacheMode);
+        TLRENDER_ENUM_SERIALIZE(PlayerCacheMode);
+
         //! Timeline player cache options.
         struct PlayerCacheOptions
         {
-            //! Cache read ahead.
+            //! Cache mode.
+            PlayerCacheMode mode = PlayerCacheMode::Duration;
+
+            //! Cache read ahead. In the byte count mode the read ahead is
+            //! whatever is left of the video budget after the read behind.
             otime::RationalTime readAhead = otime::RationalTime(2.0, 1.0);
 
             //! Cache read behind.
             otime::RationalTime readBehind = otime::RationalTime(0.5, 1.0);
 
+            //! Video cache budget in bytes for the byte count mode. The
+            //! budget is shared with the compare timelines, and is limited
+            //! to the video part of the I/O cache maximum size. Zero uses
+            //! the whole I/O cache video budget.
+            size_t videoByteCount = 0;
+
+            //! Audio cache budget in bytes for the byte count mode.
+            size_t audioByteCount = 512 * memory::megabyte;
+
             bool operator == (const PlayerCacheOptions&) const;
             bool operator != (const PlayerCacheOptions&) const;
         };
@@ -9,8 +9,11 @@ namespace tl
         inline bool PlayerCacheOptions::operator == (const PlayerCacheOptions& other) const
         {
             return
+                mode == other.mode &&
                 readAhead == other.readAhead &&
-                readBehind == other.readBehind;
+                readBehind == other.readBehind &&
+                videoByteCount == other.videoByteCount &&
+                audioByteCount == other.audioByteCount;
         }
 
         inline bool PlayerCacheOptions::operator != (const PlayerCacheOptions& other) const
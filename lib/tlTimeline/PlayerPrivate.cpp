@@ -147,7 +147,14 @@ namespace tl
 
         void Player::Private::clearCache()
         {
+            if (ioCache)
+            {
+                ioCache->unpinAll(ioCacheOwner);
+                ioCache->unpinAll(ioCacheCompareOwner);
+            }
             thread.videoDataCache.clear();
+            thread.videoByteCount = 0;
+            thread.videoFrameByteCount = 0;
             {
                 std::unique_lock<std::mutex> lock(mutex.mutex);
                 mutex.cacheInfo = PlayerCacheInfo();
@@ -158,21 +165,178 @@ namespace tl
             }
         }
 
+        size_t Player::Private::getByteCount(const std::vector<VideoData>& value)
+        {
+            size_t out = 0;
+            for (const auto& videoData : value)
+            {
+                for (const auto& layer : videoData.layers)
+                {
+                    if (layer.image)
+                    {
+                        out += layer.image->getDataByteCount();
+                    }
+                    if (layer.imageB)
+                    {
+                        out += layer.imageB->getDataByteCount();
+                    }
+                }
+            }
+            return out;
+        }
+
+        size_t Player::Private::getVideoFrameByteCount() const
+        {
+            // Use the largest frame that has been cached, otherwise estimate
+            // the size from the I/O information.
+            size_t out = thread.videoFrameByteCount;
+            if (0 == out)
+            {
+                if (!ioInfo.video.empty())
+                {
+                    out += image::getDataByteCount(ioInfo.video[0]);
+                }
+                for (const auto& compare : thread.compare)
+                {
+                    const auto& compareIOInfo = compare->getIOInfo();
+                    if (!compareIOInfo.video.empty())
+                    {
+                        out += image::getDataByteCount(compareIOInfo.video[0]);
+                    }
+                }
+            }
+            return out;
+        }
+
+        size_t Player::Private::getVideoByteCount() const
+        {
+            // The video budget is limited to what can be pinned in the I/O
+            // cache, a budget of zero uses all of it.
+            size_t out = thread.cacheOptions.videoByteCount;
+            if (ioCache)
+            {
+                const size_t max = ioCache->getPinnedMax();
+                out = out > 0 ? std::min(out, max) : max;
+            }
+            return out;
+        }
+
+        int64_t Player::Private::getCacheDistance(const otime::RationalTime& value) const
+        {
+            // The distance wraps around the in/out range since the cache
+            // is looped.
+            const double rate = timeRange.duration().rate();
+            const int64_t duration = std::max(
+                thread.inOutRange.duration().rescaled_to(rate).value(),
+                1.0);
+            const int64_t d = (value - thread.currentTime).rescaled_to(rate).value();
+            const int64_t forward = ((d % duration) + duration) % duration;
+            const int64_t reverse = ((-d % duration) + duration) % duration;
+            return std::min(forward, reverse);
+        }
+
+        std::map<otime::RationalTime, std::vector<VideoData> >::iterator
+            Player::Private::eraseVideoCache(
+                const std::map<otime::RationalTime, std::vector<VideoData> >::iterator& value)
+        {
+            const size_t byteCount = getByteCount(value->second);
+            thread.videoByteCount -= std::min(thread.videoByteCount, byteCount);
+            unpinVideoCache(value->second);
+            return thread.videoDataCache.erase(value);
+        }
+
+        void Player::Private::pinVideoCache(const std::vector<VideoData>& value)
+        {
+            // The first video data is from the timeline, the rest are from
+            // the compare timelines. Images are not pinned once the I/O
+            // cache is full of pinned images, they are still held by the
+            // player cache until it is trimmed to the budget.
+            if (ioCache)
+            {
+                for (size_t i = 0; i < value.size(); ++i)
+                {
+                    const uint64_t owner = 0 == i ? ioCacheOwner : ioCacheCompareOwner;
+                    for (const auto& layer : value[i].layers)
+                    {
+                        ioCache->pin(owner, layer.image);
+                        ioCache->pin(owner, layer.imageB);
+                    }
+                }
+            }
+        }
+
+        void Player::Private::unpinVideoCache(const std::vector<VideoData>& value)
+        {
+            if (ioCache)
+            {
+                for (size_t i = 0; i < value.size(); ++i)
+                {
+                    const uint64_t owner = 0 == i ? ioCacheOwner : ioCacheCompareOwner;
+                    for (const auto& layer : value[i].layers)
+                    {
+                        ioCache->unpin(owner, layer.image);
+                        ioCache->unpin(owner, layer.imageB);
+                    }
+                }
+            }
+        }
+
         void Player::Private::cacheUpdate()
         {
+            // Get the read ahead and read behind.
+            otime::RationalTime readAheadRescaled = time::invalidTime;
+            otime::RationalTime readBehindRescaled = time::invalidTime;
+            otime::RationalTime audioReadAheadRescaled = time::invalidTime;
+            otime::RationalTime audioReadBehindRescaled = time::invalidTime;
+            const double rate = timeRange.duration().rate();
+            switch (thread.cacheOptions.mode)
+            {
+            case PlayerCacheMode::Duration:
+            {
+                const otime::RationalTime readAheadDivided(
+                    thread.cacheOptions.readAhead.value() / static_cast<double>(1 + thread.compare.size()),
+                    thread.cacheOptions.readAhead.rate());
+                readAheadRescaled = readAheadDivided.rescaled_to(rate).floor();
+                const otime::RationalTime readBehindDivided(
+                    thread.cacheOptions.readBehind.value() / static_cast<double>(1 + thread.compare.size()),
+                    thread.cacheOptions.readBehind.rate());
+                readBehindRescaled = readBehindDivided.rescaled_to(rate).floor();
+                audioReadAheadRescaled = readAheadRescaled;
+                audioReadBehindRescaled = readBehindRescaled;
+                break;
+            }
+            case PlayerCacheMode::ByteCount:
+            {
+                // Convert the video budget into a number of frames. The
+                // current frame is always cached, the read behind is
+                // filled next, and the rest of the budget goes to the read
+                // ahead.
+                const int64_t readBehind = thread.cacheOptions.readBehind.rescaled_to(rate).floor().value();
+                const size_t frameByteCount = getVideoFrameByteCount();
+                const size_t videoByteCount = getVideoByteCount();
+                const int64_t frames = frameByteCount > 0 ?
+                    (videoByteCount / frameByteCount) :
+                    0;
+                const int64_t behind = std::min(readBehind, std::max(frames - 1, int64_t(0)));
+                const int64_t ahead = std::max(frames - behind - 1, int64_t(0));
+                readAheadRescaled = otime::RationalTime(ahead, rate);
+                readBehindRescaled = otime::RationalTime(behind, rate);
+
+                // Convert the audio budget into a number of frames.
+                const size_t audioByteCount = ioInfo.audio.getByteCount() * ioInfo.audio.sampleRate;
+                const int64_t audioFrames = audioByteCount > 0 ?
+                    (thread.cacheOptions.audioByteCount / static_cast<double>(audioByteCount) * rate) :
+                    0;
+                const int64_t audioBehind = std::min(readBehind, std::max(audioFrames - 1, int64_t(0)));
+                const int64_t audioAhead = std::max(audioFrames - audioBehind - 1, int64_t(0));
+                audioReadAheadRescaled = otime::RationalTime(audioAhead, rate);
+                audioReadBehindRescaled = otime::RationalTime(audioBehind, rate);
+                break;
+            }
+            default: break;
+            }
+
             // Get the video ranges to be cached.
-            const otime::RationalTime readAheadDivided(
-                thread.cacheOptions.readAhead.value() / static_cast<double>(1 + thread.compare.size()),
-                thread.cacheOptions.readAhead.rate());
-            const otime::RationalTime readAheadRescaled = readAheadDivided.
-                rescaled_to(timeRange.duration().rate()).
-                floor();
-            const otime::RationalTime readBehindDivided(
-                thread.cacheOptions.readBehind.value() / static_cast<double>(1 + thread.compare.size()),
-                thread.cacheOptions.readBehind.rate());
-            const otime::RationalTime readBehindRescaled = readBehindDivided.
-                rescaled_to(timeRange.duration().rate()).
-                floor();
             otime::TimeRange videoRange = time::invalidTimeRange;
             switch (thread.cacheDirection)
             {
@@ -225,13 +389,13 @@ namespace tl
             {
             case CacheDirection::Forward:
                 audioRange = otime::TimeRange::range_from_start_end_time_inclusive(
-                    thread.currentTime - readBehindRescaled - audioOffsetBehind,
-                    thread.currentTime + readAheadRescaled + audioOffsetAhead);
+                    thread.currentTime - audioReadBehindRescaled - audioOffsetBehind,
+                    thread.currentTime + audioReadAheadRescaled + audioOffsetAhead);
                 break;
             case CacheDirection::Reverse:
                 audioRange = otime::TimeRange::range_from_start_end_time_inclusive(
-                    thread.currentTime - readAheadRescaled - audioOffsetAhead,
-                    thread.currentTime + readBehindRescaled + audioOffsetBehind);
+                    thread.currentTime - audioReadAheadRescaled - audioOffsetAhead,
+                    thread.currentTime + audioReadBehindRescaled + audioOffsetBehind);
                 break;
             default: break;
             }
@@ -260,7 +424,7 @@ namespace tl
                     });
                 if (j == videoRanges.end())
                 {
-                    videoCacheIt = thread.videoDataCache.erase(videoCacheIt);
+                    videoCacheIt = eraseVideoCache(videoCacheIt);
                 }
                 else
                 {
@@ -298,9 +462,11 @@ namespace tl
                 }
             }
 
-            // Get uncached video.
+            // Get uncached video. The times are gathered and requested
+            // together so the readers can see the whole range.
             if (!ioInfo.video.empty())
             {
+                std::vector<otime::RationalTime> times;
                 for (const auto& range : videoRanges)
                 {
                     switch (thread.cacheDirection)
@@ -312,32 +478,12 @@ namespace tl
                         const otime::RationalTime inc = otime::RationalTime(1.0, range.duration().rate());
                         for (otime::RationalTime time = start; time <= end; time += inc)
                         {
-                            const auto i = thread.videoDataCache.find(time);
-                            if (i == thread.videoDataCache.end())
+                            if (thread.videoDataCache.find(time) == thread.videoDataCache.end() &&
+                                thread.videoDataRequests.find(time) == thread.videoDataRequests.end())
                             {
-                                const auto j = thread.videoDataRequests.find(time);
-                                if (j == thread.videoDataRequests.end())
-                                {
-                                    //std::cout << this << " video request: " << time << std::endl;
-                                    auto& request = thread.videoDataRequests[time];
-                                    request.clear();
-                                    io::Options ioOptions2 = thread.ioOptions;
-                                    ioOptions2["Layer"] = string::Format("{0}").arg(thread.videoLayer);
-                                    request.push_back(timeline->getVideo(time, ioOptions2));
-                                    for (size_t i = 0; i < thread.compare.size(); ++i)
-                                    {
-                                        const otime::RationalTime time2 = timeline::getCompareTime(
-                                            time,
-                                            timeRange,
-                                            thread.compare[i]->getTimeRange(),
-                                            thread.compareTime);
-                                        ioOptions2["Layer"] = string::Format("{0}").
-                                            arg(i < thread.compareVideoLayers.size() ?
-                                                thread.compareVideoLayers[i] :
-                                                thread.videoLayer);
-                                        request.push_back(thread.compare[i]->getVideo(time2, ioOptions2));
-                                    }
-                                }
+                                //std::cout << this << " video request: " << time << std::endl;
+                                thread.videoDataRequests[time].clear();
+                                times.push_back(time);
                             }
                         }
                         break;
@@ -349,32 +495,12 @@ namespace tl
                         const auto inc = otime::RationalTime(1.0, range.duration().rate());
                         for (auto time = start; time >= end; time -= inc)
                         {
-                            const auto i = thread.videoDataCache.find(time);
-                            if (i == thread.videoDataCache.end())
+                            if (thread.videoDataCache.find(time) == thread.videoDataCache.end() &&
+                                thread.videoDataRequests.find(time) == thread.videoDataRequests.end())
                             {
-                                const auto j = thread.videoDataRequests.find(time);
-                                if (j == thread.videoDataRequests.end())
-                                {
-                                    //std::cout << this << " video request: " << time << std::endl;
-                                    auto& request = thread.videoDataRequests[time];
-                                    request.clear();
-                                    io::Options ioOptions2 = thread.ioOptions;
-                                    ioOptions2["Layer"] = string::Format("{0}").arg(thread.videoLayer);
-                                    request.push_back(timeline->getVideo(time, ioOptions2));
-                                    for (size_t i = 0; i < thread.compare.size(); ++i)
-                                    {
-                                        const otime::RationalTime time2 = timeline::getCompareTime(
-                                            time,
-                                            timeRange,
-                                            thread.compare[i]->getTimeRange(),
-                                            thread.compareTime);
-                                        ioOptions2["Layer"] = string::Format("{0}").
-                                            arg(i < thread.compareVideoLayers.size() ?
-                                                thread.compareVideoLayers[i] :
-                                                thread.videoLayer);
-                                        request.push_back(thread.compare[i]->getVideo(time2, ioOptions2));
-                                    }
-                                }
+                                //std::cout << this << " video request: " << time << std::endl;
+                                thread.videoDataRequests[time].clear();
+                                times.push_back(time);
                             }
                         }
                         break;
@@ -382,6 +508,55 @@ namespace tl
                     default: break;
                     }
                 }
+                if (!times.empty())
+                {
+                    io::Options ioOptions2 = thread.ioOptions;
+                    ioOptions2["Layer"] = string::Format("{0}").arg(thread.videoLayer);
+                    if (thread.proxyLevel > 0)
+                    {
+                        ioOptions2["Proxy"] = string::Format("{0}").arg(thread.proxyLevel);
+                    }
+                    if (thread.roi.isValid())
+                    {
+                        ioOptions2["Timeline/ROI"] = getROIOption(thread.roi);
+                    }
+                    if (CacheDirection::Reverse == thread.cacheDirection)
+                    {
+                        ioOptions2["Direction"] = "Reverse";
+                    }
+                    auto requests = timeline->getVideo(times, ioOptions2);
+                    for (size_t i = 0; i < times.size() && i < requests.size(); ++i)
+                    {
+                        thread.videoDataRequests[times[i]].push_back(std::move(requests[i]));
+                    }
+
+                    // The region of interest is normalized to the frame of
+                    // the first timeline, and the comparison timelines may
+                    // be placed elsewhere in the view, so they are read in
+                    // full.
+                    ioOptions2.erase("Timeline/ROI");
+                    for (size_t i = 0; i < thread.compare.size(); ++i)
+                    {
+                        std::vector<otime::RationalTime> times2;
+                        for (const auto& time : times)
+                        {
+                            times2.push_back(timeline::getCompareTime(
+                                time,
+                                timeRange,
+                                thread.compare[i]->getTimeRange(),
+                                thread.compareTime));
+                        }
+                        ioOptions2["Layer"] = string::Format("{0}").
+                            arg(i < thread.compareVideoLayers.size() ?
+                                thread.compareVideoLayers[i] :
+                                thread.videoLayer);
+                        requests = thread.compare[i]->getVideo(times2, ioOptions2);
+                        for (size_t j = 0; j < times.size() && j < requests.size(); ++j)
+                        {
+                            thread.videoDataRequests[times[j]].push_back(std::move(requests[j]));
+                        }
+                    }
+                }
             }
 
             // Get uncached audio.
@@ -458,6 +633,8 @@ namespace tl
                 {
                     const otime::RationalTime time = videoDataRequestsIt->first;
                     auto& videoDataCache = thread.videoDataCache[time];
+                    thread.videoByteCount -= std::min(thread.videoByteCount, getByteCount(videoDataCache));
+                    unpinVideoCache(videoDataCache);
                     videoDataCache.clear();
                     for (auto videoDataRequestIt = videoDataRequestsIt->second.begin();
                         videoDataRequestIt != videoDataRequestsIt->second.end();
@@ -467,6 +644,10 @@ namespace tl
                         videoData.time = time;
                         videoDataCache.push_back(videoData);
                     }
+                    pinVideoCache(videoDataCache);
+                    const size_t byteCount = getByteCount(videoDataCache);
+                    thread.videoByteCount += byteCount;
+                    thread.videoFrameByteCount = std::max(thread.videoFrameByteCount, byteCount);
                     videoDataRequestsIt = thread.videoDataRequests.erase(videoDataRequestsIt);
                 }
                 else
@@ -475,6 +656,32 @@ namespace tl
                 }
             }
 
+            // Keep the video cache within the budget by removing the frames
+            // farthest from the current time.
+            const size_t videoByteCount = getVideoByteCount();
+            if (PlayerCacheMode::ByteCount == thread.cacheOptions.mode &&
+                thread.videoByteCount > videoByteCount)
+            {
+                std::vector<std::pair<int64_t, otime::RationalTime> > distances;
+                for (const auto& i : thread.videoDataCache)
+                {
+                    if (i.first != thread.currentTime)
+                    {
+                        distances.push_back(std::make_pair(
+                            getCacheDistance(i.first),
+                            i.first));
+                    }
+                }
+                std::sort(distances.begin(), distances.end());
+                for (auto i = distances.rbegin();
+                    i != distances.rend() &&
+                    thread.videoByteCount > videoByteCount;
+                    ++i)
+                {
+                    eraseVideoCache(thread.videoDataCache.find(i->second));
+                }
+            }
+
             // Check for finished audio.
             auto audioDataRequestsIt = thread.audioDataRequests.begin();
             while (audioDataRequestsIt != thread.audioDataRequests.end())
@@ -507,15 +714,34 @@ namespace tl
                 {
                     cachedVideoFrames.push_back(i.first);
                 }
-                const float cachedVideoPercentage = cachedVideoFrames.size() /
-                    static_cast<float>(readAheadDivided.rescaled_to(timeRange.duration().rate()).value() +
-                        readBehindDivided.rescaled_to(timeRange.duration().rate()).value()) *
-                    100.F;
+                float cachedVideoPercentage = 0.F;
+                switch (thread.cacheOptions.mode)
+                {
+                case PlayerCacheMode::Duration:
+                    cachedVideoPercentage = cachedVideoFrames.size() /
+                        static_cast<float>(readAheadRescaled.value() + readBehindRescaled.value()) *
+                        100.F;
+                    break;
+                case PlayerCacheMode::ByteCount:
+                    cachedVideoPercentage = videoByteCount > 0 ?
+                        (thread.videoByteCount / static_cast<float>(videoByteCount) * 100.F) :
+                        0.F;
+                    break;
+                default: break;
+                }
                 std::vector<otime::RationalTime> cachedAudioFrames;
+                size_t cachedAudioByteCount = 0;
                 {
                     std::unique_lock<std::mutex> lock(audioMutex.mutex);
                     for (const auto& i : audioMutex.audioDataCache)
                     {
+                        for (const auto& layer : i.second.layers)
+                        {
+                            if (layer.audio)
+                            {
+                                cachedAudioByteCount += layer.audio->getByteCount();
+                            }
+                        }
                         cachedAudioFrames.push_back(otime::RationalTime(
                             timeRange.start_time().rescaled_to(1.0).value() + i.first,
                             1.0));
@@ -534,7 +760,9 @@ namespace tl
                     std::unique_lock<std::mutex> lock(mutex.mutex);
                     mutex.cacheInfo.videoPercentage = cachedVideoPercentage;
                     mutex.cacheInfo.videoFrames = cachedVideoRanges;
+                    mutex.cacheInfo.videoByteCount = thread.videoByteCount;
                     mutex.cacheInfo.audioFrames = cachedAudioRanges;
+                    mutex.cacheInfo.audioByteCount = cachedAudioByteCount;
                 }
             }
         }
@@ -624,23 +852,26 @@ namespace tl
                 "    Current time: {1}\n"
                 "    In/out range: {2}\n"
                 "    I/O options: {3}\n"
-                "    Cache: {4} read ahead, {5} read behind\n"
-                "    Video: {6} requests, {7} cached\n"
-                "    Audio: {8} requests, {9} cached\n"
-                "    {10}\n"
-                "    {11}\n"
-                "    {12}\n"
+                "    Cache: {4}, {5} read ahead, {6} read behind\n"
+                "    Video: {7} requests, {8} cached, {9}MB\n"
+                "    Audio: {10} requests, {11} cached, {12}MB\n"
+                "    {13}\n"
+                "    {14}\n"
+                "    {15}\n"
                 "    (T=current time, V=cached video, A=cached audio)").
                 arg(timeline->getPath().get()).
                 arg(currentTime).
                 arg(inOutRange).
                 arg(string::join(ioOptionStrings, ", ")).
+                arg(cacheOptions->get().mode).
                 arg(cacheOptions->get().readAhead).
                 arg(cacheOptions->get().readBehind).
                 arg(thread.videoDataRequests.size()).
                 arg(thread.videoDataCache.size()).
+                arg(cacheInfo.videoByteCount / memory::megabyte).
                 arg(thread.audioDataRequests.size()).
                 arg(audioDataCacheSize).
+                arg(cacheInfo.audioByteCount / memory::megabyte).
                 arg(currentTimeDisplay).
                 arg(cachedVideoFramesDisplay).
                 arg(cachedAudioFramesDisplay));
@@ -6,9 +6,14 @@
 
 #include <tlTimeline/Player.h>
 
+#include <tlTimeline/AudioOutput.h>
 #include <tlTimeline/Util.h>
 
+#include <tlIO/Cache.h>
+
 #include <tlCore/AudioResample.h>
+#include <tlCore/AudioRingBuffer.h>
+#include <tlCore/AudioTimeStretch.h>
 #include <tlCore/LRUCache.h>
 
 #if defined(TLRENDER_AUDIO)
@@ -29,12 +34,21 @@ namespace tl
 
             void clearRequests();
             void clearCache();
+            static size_t getByteCount(const std::vector<VideoData>&);
+            size_t getVideoFrameByteCount() const;
+            size_t getVideoByteCount() const;
+            int64_t getCacheDistance(const otime::RationalTime&) const;
+            std::map<otime::RationalTime, std::vector<VideoData> >::iterator eraseVideoCache(
+                const std::map<otime::RationalTime, std::vector<VideoData> >::iterator&);
+            void pinVideoCache(const std::vector<VideoData>&);
+            void unpinVideoCache(const std::vector<VideoData>&);
             void cacheUpdate();
 
             bool hasAudio() const;
             void playbackReset(const otime::RationalTime&);
             void audioInit(const std::shared_ptr<system::Context>&);
             void audioReset(const otime::RationalTime&);
+            void audioUpdate();
             static size_t getAudioChannelCount(
                 const audio::Info& input,
                 const audio::Info& output);
@@ -57,6 +71,9 @@ namespace tl
             std::shared_ptr<Timeline> timeline;
             otime::TimeRange timeRange = time::invalidTimeRange;
             io::Info ioInfo;
+            std::shared_ptr<io::Cache> ioCache;
+            uint64_t ioCacheOwner = 0;
+            uint64_t ioCacheCompareOwner = 0;
 
             std::shared_ptr<observer::Value<double> > speed;
             std::shared_ptr<observer::Value<Playback> > playback;
@@ -68,6 +85,8 @@ namespace tl
             std::shared_ptr<observer::Value<io::Options> > ioOptions;
             std::shared_ptr<observer::Value<int> > videoLayer;
             std::shared_ptr<observer::List<int> > compareVideoLayers;
+            std::shared_ptr<observer::Value<int> > proxyLevel;
+            std::shared_ptr<observer::Value<math::Box2f> > roi;
             std::shared_ptr<observer::List<VideoData> > currentVideoData;
             std::shared_ptr<observer::Value<audio::DeviceID> > audioDevice;
             std::shared_ptr<observer::Value<float> > volume;
@@ -96,6 +115,8 @@ namespace tl
                 io::Options ioOptions;
                 int videoLayer = 0;
                 std::vector<int> compareVideoLayers;
+                int proxyLevel = 0;
+                math::Box2f roi;
                 std::vector<VideoData> currentVideoData;
                 double audioOffset = 0.0;
                 std::vector<AudioData> currentAudioData;
@@ -118,11 +139,15 @@ namespace tl
                 io::Options ioOptions;
                 int videoLayer = 0;
                 std::vector<int> compareVideoLayers;
+                int proxyLevel = 0;
+                math::Box2f roi;
                 double audioOffset = 0.0;
                 CacheDirection cacheDirection = CacheDirection::Forward;
                 PlayerCacheOptions cacheOptions;
                 std::map<otime::RationalTime, std::vector<VideoRequest> > videoDataRequests;
                 std::map<otime::RationalTime, std::vector<VideoData> > videoDataCache;
+                size_t videoByteCount = 0;
+                size_t videoFrameByteCount = 0;
                 std::map<int64_t, AudioRequest> audioDataRequests;
                 std::chrono::steady_clock::time_point cacheTimer;
                 std::chrono::steady_clock::time_point logTimer;
@@ -141,23 +166,32 @@ namespace tl
                 std::map<int64_t, AudioData> audioDataCache;
                 bool reset = false;
                 otime::RationalTime start = time::invalidTime;
-                int64_t frame = 0;
+                audio::Info info;
+                std::shared_ptr<audio::AudioRingBuffer> ringBuffer;
                 std::mutex mutex;
             };
             AudioMutex audioMutex;
 
+            //! The audio thread fills the ring buffer that is consumed by
+            //! the RtAudio callback.
             struct AudioThread
             {
+                otime::RationalTime start = time::invalidTime;
+                uint64_t resetCount = 0;
                 audio::Info info;
                 int64_t inputFrame = 0;
-                int64_t outputFrame = 0;
                 size_t cacheRetryCount = 0;
+                std::shared_ptr<audio::AudioTimeStretch> timeStretch;
                 std::shared_ptr<audio::AudioResample> resample;
                 std::list<std::shared_ptr<audio::Audio> > buffer;
-                std::shared_ptr<audio::Audio> silence;
+                std::shared_ptr<audio::AudioRingBuffer> ringBuffer;
+                std::thread thread;
             };
             AudioThread audioThread;
 
+            //! Values shared with the RtAudio callback.
+            AudioOutputState audioCallback;
+
             struct NoAudio
             {
                 std::chrono::steady_clock::time_point playbackTimer;
@@ -13,6 +13,8 @@
 #include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
 
+#include <sstream>
+
 namespace tl
 {
     namespace timeline
@@ -47,6 +49,36 @@ namespace tl
             return !(*this == other);
         }
 
+        bool getROI(const io::Options& options, math::Box2f& out)
+        {
+            bool valid = false;
+            const auto i = options.find("Timeline/ROI");
+            if (i != options.end())
+            {
+                try
+                {
+                    std::stringstream ss(i->second);
+                    math::Box2f box;
+                    ss >> box;
+                    if (box.isValid())
+                    {
+                        out = box;
+                        valid = true;
+                    }
+                }
+                catch (const std::exception&)
+                {}
+            }
+            return valid;
+        }
+
+        std::string getROIOption(const math::Box2f& value)
+        {
+            std::stringstream ss;
+            ss << value;
+            return ss.str();
+        }
+
         void Timeline::_init(
             const otio::SerializableObject::Retainer<otio::Timeline>& otioTimeline,
             const std::shared_ptr<system::Context>& context,
@@ -260,7 +292,7 @@ namespace tl
             auto request = std::make_shared<Private::VideoRequest>();
             request->id = p.requestId;
             request->time = time;
-            request->options = options;
+            request->options = std::make_shared<const io::Options>(options);
             VideoRequest out;
             out.id = p.requestId;
             out.future = request->promise.get_future();
@@ -284,6 +316,54 @@ namespace tl
             return out;
         }
 
+        std::vector<VideoRequest> Timeline::getVideo(
+            const std::vector<otime::RationalTime>& times,
+            const io::Options& options)
+        {
+            TLRENDER_P();
+            const auto sharedOptions = std::make_shared<const io::Options>(options);
+            std::vector<std::shared_ptr<Private::VideoRequest> > requests;
+            std::vector<VideoRequest> out;
+            for (const auto& time : times)
+            {
+                (p.requestId)++;
+                auto request = std::make_shared<Private::VideoRequest>();
+                request->id = p.requestId;
+                request->batch = requests.empty() ? request->id : requests.front()->id;
+                request->time = time;
+                request->options = sharedOptions;
+                requests.push_back(request);
+                VideoRequest videoRequest;
+                videoRequest.id = p.requestId;
+                videoRequest.future = request->promise.get_future();
+                out.push_back(std::move(videoRequest));
+            }
+            bool valid = false;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                if (!p.mutex.stopped)
+                {
+                    valid = true;
+                    p.mutex.videoRequests.insert(
+                        p.mutex.videoRequests.end(),
+                        requests.begin(),
+                        requests.end());
+                }
+            }
+            if (valid)
+            {
+                p.thread.cv.notify_one();
+            }
+            else
+            {
+                for (const auto& request : requests)
+                {
+                    request->promise.set_value(VideoData());
+                }
+            }
+            return out;
+        }
+
         AudioRequest Timeline::getAudio(
             double seconds,
             const io::Options& options)
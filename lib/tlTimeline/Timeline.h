@@ -69,6 +69,16 @@ namespace tl
             const std::shared_ptr<system::Context>&,
             const Options& = Options());
 
+        //! Get the region of interest from the "Timeline/ROI" option. The
+        //! region is normalized to the timeline frame, and each clip reader
+        //! is given it in its own image coordinates (see io::getROI()).
+        //! Returns false if the option is not set or is not valid.
+        bool getROI(const io::Options&, math::Box2f&);
+
+        //! Get the "Timeline/ROI" option value for a normalized region of
+        //! interest (see getNormalizedROI()).
+        std::string getROIOption(const math::Box2f&);
+
         //! Video request.
         struct VideoRequest
         {
@@ -177,6 +187,14 @@ namespace tl
                 const otime::RationalTime&,
                 const io::Options& = io::Options());
 
+            //! Get video data for multiple times. The requests share the
+            //! options and are queued together, so the readers can see the
+            //! whole range of upcoming frames. The batch is started as a
+            //! whole, even if it is larger than the video request count.
+            std::vector<VideoRequest> getVideo(
+                const std::vector<otime::RationalTime>&,
+                const io::Options& = io::Options());
+
             //! Get audio data.
             AudioRequest getAudio(
                 double seconds,
@@ -4,6 +4,7 @@
 
 #include <tlTimeline/TimelinePrivate.h>
 
+#include <tlTimeline/CompareOptions.h>
 #include <tlTimeline/Util.h>
 
 #include <tlIO/System.h>
@@ -13,6 +14,10 @@
 
 #include <opentimelineio/transition.h>
 
+#include <algorithm>
+#include <map>
+#include <sstream>
+
 namespace tl
 {
     namespace timeline
@@ -159,8 +164,16 @@ namespace tl
                 while (!mutex.videoRequests.empty() &&
                     (thread.videoRequestsInProgress.size() + newVideoRequests.size()) < options.videoRequestCount)
                 {
-                    newVideoRequests.push_back(mutex.videoRequests.front());
-                    mutex.videoRequests.pop_front();
+                    // The requests of a batch are taken together, so the
+                    // readers receive them with a single call.
+                    const uint64_t batch = mutex.videoRequests.front()->batch;
+                    do
+                    {
+                        newVideoRequests.push_back(mutex.videoRequests.front());
+                        mutex.videoRequests.pop_front();
+                    } while (batch != 0 &&
+                        !mutex.videoRequests.empty() &&
+                        batch == mutex.videoRequests.front()->batch);
                 }
                 while (!mutex.audioRequests.empty() &&
                     (thread.audioRequestsInProgress.size() + newAudioRequests.size()) < options.audioRequestCount)
@@ -170,7 +183,10 @@ namespace tl
                 }
             }
 
-            // Traverse the timeline for new video requests.
+            // Traverse the timeline for new video requests. The clip reads
+            // are gathered and issued together so the readers see all of
+            // the requested frames at once.
+            std::vector<VideoRead> videoReads;
             for (auto& request : newVideoRequests)
             {
                 try
@@ -187,10 +203,8 @@ namespace tl
                                 if (range.has_value() && range.value().contains(requestTime))
                                 {
                                     VideoLayerData videoData;
-                                    if (auto otioClip = dynamic_cast<const otio::Clip*>(otioItem))
-                                    {
-                                        videoData.image = readVideo(otioClip, requestTime, request->options);
-                                    }
+                                    const otio::Clip* clip = dynamic_cast<const otio::Clip*>(otioItem);
+                                    const otio::Clip* clipB = nullptr;
                                     const auto neighbors = otioTrack->neighbors_of(otioItem, &errorStatus);
                                     if (auto otioTransition = dynamic_cast<otio::Transition*>(neighbors.second.value))
                                     {
@@ -202,30 +216,36 @@ namespace tl
                                                 range.value().end_time_inclusive().value() - otioTransition->in_offset().value(),
                                                 range.value().end_time_inclusive().value() + otioTransition->out_offset().value() + 1.0);
                                             const auto transitionNeighbors = otioTrack->neighbors_of(otioTransition, &errorStatus);
-                                            if (const auto otioClipB = dynamic_cast<otio::Clip*>(transitionNeighbors.second.value))
-                                            {
-                                                videoData.imageB = readVideo(otioClipB, requestTime, request->options);
-                                            }
+                                            clipB = dynamic_cast<const otio::Clip*>(transitionNeighbors.second.value);
                                         }
                                     }
                                     if (auto otioTransition = dynamic_cast<otio::Transition*>(neighbors.first.value))
                                     {
                                         if (requestTime < range.value().start_time() + otioTransition->out_offset())
                                         {
-                                            std::swap(videoData.image, videoData.imageB);
+                                            std::swap(clip, clipB);
                                             videoData.transition = toTransition(otioTransition->transition_type());
                                             videoData.transitionValue = transitionValue(
                                                 requestTime.value(),
                                                 range.value().start_time().value() - otioTransition->in_offset().value() - 1.0,
                                                 range.value().start_time().value() + otioTransition->out_offset().value());
                                             const auto transitionNeighbors = otioTrack->neighbors_of(otioTransition, &errorStatus);
-                                            if (const auto otioClipB = dynamic_cast<otio::Clip*>(transitionNeighbors.first.value))
+                                            if (const auto otioClipB = dynamic_cast<const otio::Clip*>(transitionNeighbors.first.value))
                                             {
-                                                videoData.image = readVideo(otioClipB, requestTime, request->options);
+                                                clip = otioClipB;
                                             }
                                         }
                                     }
+                                    const size_t layer = request->layerData.size();
                                     request->layerData.push_back(std::move(videoData));
+                                    if (clip)
+                                    {
+                                        videoReads.push_back({ clip, requestTime, request, layer, false });
+                                    }
+                                    if (clipB)
+                                    {
+                                        videoReads.push_back({ clipB, requestTime, request, layer, true });
+                                    }
                                 }
                             }
                         }
@@ -238,6 +258,7 @@ namespace tl
 
                 thread.videoRequestsInProgress.push_back(request);
             }
+            readVideo(videoReads);
 
             // Traverse the timeline for new audio requests.
             for (auto& request : newAudioRequests)
@@ -486,27 +507,82 @@ namespace tl
             return out;
         }
 
-        std::future<io::VideoData> Timeline::Private::readVideo(
-            const otio::Clip* clip,
-            const otime::RationalTime& time,
-            const io::Options& options)
+        void Timeline::Private::readVideo(const std::vector<VideoRead>& videoReads)
         {
-            std::future<io::VideoData> out;
-            io::Options optionsMerged = io::merge(options, this->options.ioOptions);
-            optionsMerged["USD/cameraName"] = clip->name();
-            auto read = getRead(clip, optionsMerged);
-            const auto timeRangeOpt = clip->trimmed_range_in_parent();
-            if (read && timeRangeOpt.has_value())
+            // Group the reads by clip and options, so each reader gets a
+            // single request with all of its frames.
+            std::map<std::pair<const otio::Clip*, const io::Options*>, std::vector<size_t> > groups;
+            for (size_t i = 0; i < videoReads.size(); ++i)
             {
-                const io::Info& ioInfo = read->getInfo().get();
-                const auto mediaTime = timeline::toVideoMediaTime(
-                    time,
-                    timeRangeOpt.value(),
-                    clip->trimmed_range(),
-                    ioInfo.videoTime.duration().rate());
-                out = read->readVideo(mediaTime, optionsMerged);
+                const auto& videoRead = videoReads[i];
+                groups[std::make_pair(videoRead.clip, videoRead.request->options.get())].push_back(i);
+            }
+            for (const auto& group : groups)
+            {
+                try
+                {
+                    const otio::Clip* clip = group.first.first;
+                    io::Options optionsMerged = io::merge(*group.first.second, this->options.ioOptions);
+                    optionsMerged["USD/cameraName"] = clip->name();
+                    math::Box2f roi;
+                    const bool hasROI = timeline::getROI(optionsMerged, roi);
+                    optionsMerged.erase("Timeline/ROI");
+                    auto read = getRead(clip, optionsMerged);
+                    const auto timeRangeOpt = clip->trimmed_range_in_parent();
+                    if (read && timeRangeOpt.has_value())
+                    {
+                        const io::Info& ioInfo = read->getInfo().get();
+
+                        // The region of interest is normalized to the
+                        // timeline frame, convert it to the image
+                        // coordinates of this clip.
+                        if (hasROI && !ioInfo.video.empty())
+                        {
+                            size_t layer = 0;
+                            const auto i = optionsMerged.find("Layer");
+                            if (i != optionsMerged.end())
+                            {
+                                std::stringstream ss(i->second);
+                                ss >> layer;
+                            }
+                            layer = std::min(layer, ioInfo.video.size() - 1);
+                            const math::Box2i clipROI = getImageROI(roi, ioInfo.video[layer].size);
+                            if (clipROI.isValid())
+                            {
+                                optionsMerged["ROI"] = io::getROIOption(clipROI);
+                            }
+                        }
+
+                        std::vector<otime::RationalTime> mediaTimes;
+                        for (const size_t i : group.second)
+                        {
+                            mediaTimes.push_back(timeline::toVideoMediaTime(
+                                videoReads[i].time,
+                                timeRangeOpt.value(),
+                                clip->trimmed_range(),
+                                ioInfo.videoTime.duration().rate()));
+                        }
+                        auto futures = read->readVideo(mediaTimes, optionsMerged);
+                        for (size_t i = 0; i < group.second.size() && i < futures.size(); ++i)
+                        {
+                            const auto& videoRead = videoReads[group.second[i]];
+                            auto& layerData = videoRead.request->layerData[videoRead.layer];
+                            if (videoRead.imageB)
+                            {
+                                layerData.imageB = std::move(futures[i]);
+                            }
+                            else
+                            {
+                                layerData.image = std::move(futures[i]);
+                            }
+                        }
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    //! \todo How should this be handled?
+                }
             }
-            return out;
         }
 
         std::future<io::AudioData> Timeline::Private::readAudio(
@@ -35,10 +35,6 @@ namespace tl
             std::shared_ptr<io::IRead> getRead(
                 const otio::Clip*,
                 const io::Options&);
-            std::future<io::VideoData> readVideo(
-                const otio::Clip*,
-                const otime::RationalTime&,
-                const io::Options&);
             std::future<io::AudioData> readAudio(
                 const otio::Clip*,
                 const otime::TimeRange&,
@@ -76,12 +72,22 @@ namespace tl
                 VideoRequest(VideoRequest&&) = default;
 
                 uint64_t id = 0;
+                uint64_t batch = 0; //!< ID of the first request in a batch, zero for single requests
                 otime::RationalTime time = time::invalidTime;
-                io::Options options;
+                std::shared_ptr<const io::Options> options;
                 std::promise<VideoData> promise;
 
                 std::vector<VideoLayerData> layerData;
             };
+            struct VideoRead
+            {
+                const otio::Clip* clip = nullptr;
+                otime::RationalTime time = time::invalidTime;
+                std::shared_ptr<VideoRequest> request;
+                size_t layer = 0;
+                bool imageB = false;
+            };
+            void readVideo(const std::vector<VideoRead>&);
 
             struct AudioLayerData
             {
@@ -0,0 +1,803 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineCPU/RenderPrivate.h>
+
+#include <tlCore/Context.h>
+#include <tlCore/String.h>
+#include <tlCore/StringFormat.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace tl
+{
+    namespace timeline_cpu
+    {
+        namespace
+        {
+            // The number of rows that are processed by each task.
+            const int tileHeight = 16;
+
+            // Areas smaller than this are drawn without the worker threads.
+            const int parallelPixelCountMin = 128 * 128;
+
+            bool isFloat(image::PixelType value)
+            {
+                bool out = false;
+                switch (value)
+                {
+                case image::PixelType::L_F16:
+                case image::PixelType::L_F32:
+                case image::PixelType::LA_F16:
+                case image::PixelType::LA_F32:
+                case image::PixelType::RGB_F16:
+                case image::PixelType::RGB_F32:
+                case image::PixelType::RGBA_F16:
+                case image::PixelType::RGBA_F32:
+                    out = true;
+                    break;
+                default: break;
+                }
+                return out;
+            }
+        }
+
+        std::shared_ptr<image::Image> Render::Private::getBuffer(
+            const std::string& name,
+            const math::Size2i& size)
+        {
+            auto& buffer = buffers[name];
+            if (!buffer || buffer->getSize() != image::Size(size.w, size.h))
+            {
+                buffer = image::Image::create(size.w, size.h, image::PixelType::RGBA_F32);
+            }
+            return buffer;
+        }
+
+        math::Box2i Render::Private::getBounds() const
+        {
+            math::Box2i out;
+            if (target)
+            {
+                out = math::Box2i(0, 0, target->getWidth(), target->getHeight());
+                out = out.intersect(viewport);
+                if (clipRectEnabled)
+                {
+                    out = out.intersect(clipRect);
+                }
+            }
+            return out;
+        }
+
+        math::Vector2f Render::Private::toPixel(
+            const math::Matrix4x4f& m,
+            const math::Vector2f& value) const
+        {
+            const math::Vector4f v = m * math::Vector4f(value.x, value.y, 0.F, 1.F);
+            const float x = v.w != 0.F ? (v.x / v.w) : v.x;
+            const float y = v.w != 0.F ? (v.y / v.w) : v.y;
+            return math::Vector2f(
+                viewport.min.x + (x + 1.F) * .5F * viewport.w(),
+                viewport.min.y + (1.F - y) * .5F * viewport.h());
+        }
+
+        void Render::Private::parallel(
+            const math::Box2i& box,
+            const std::function<void(int, int)>& func)
+        {
+            const int w = box.w();
+            const int h = box.h();
+            if (w <= 0 || h <= 0)
+                return;
+            currentStats.pixels += w * h;
+            if (threads.threads.empty() || w * h < parallelPixelCountMin)
+            {
+                func(box.min.y, box.max.y);
+                return;
+            }
+            {
+                std::unique_lock<std::mutex> lock(threads.mutex);
+                threads.func = func;
+                threads.y = box.min.y;
+                threads.h = h;
+                threads.tileHeight = tileHeight;
+                threads.tileCount = (h + tileHeight - 1) / tileHeight;
+                threads.tile = 0;
+                threads.active = threads.threads.size();
+                ++threads.generation;
+            }
+            threads.cv.notify_all();
+            threadsRun();
+            std::unique_lock<std::mutex> lock(threads.mutex);
+            threads.doneCV.wait(
+                lock,
+                [this]
+                {
+                    return 0 == threads.active;
+                });
+            threads.func = nullptr;
+        }
+
+        void Render::Private::threadsRun()
+        {
+            int tile = 0;
+            while ((tile = threads.tile.fetch_add(1)) < threads.tileCount)
+            {
+                const int y0 = threads.y + tile * threads.tileHeight;
+                const int y1 = std::min(y0 + threads.tileHeight, threads.y + threads.h) - 1;
+                threads.func(y0, y1);
+            }
+        }
+
+        void Render::Private::fillBox(
+            const math::Vector2f& min,
+            const math::Vector2f& max,
+            const math::Matrix4x4f& m,
+            const Blend& blend,
+            const BoxShader& shader)
+        {
+            // Map the pixel centers back to the box coordinates.
+            const math::Vector2f p00 = toPixel(m, min);
+            const math::Vector2f p10 = toPixel(m, math::Vector2f(max.x, min.y));
+            const math::Vector2f p01 = toPixel(m, math::Vector2f(min.x, max.y));
+            const math::Vector2f e1 = p10 - p00;
+            const math::Vector2f e2 = p01 - p00;
+            const float det = e1.x * e2.y - e1.y * e2.x;
+            if (std::abs(det) < 1.0e-6F)
+                return;
+            const float dudx = e2.y / det;
+            const float dudy = -e2.x / det;
+            const float dvdx = -e1.y / det;
+            const float dvdy = e1.x / det;
+
+            const float xs[] = { p00.x, p10.x, p01.x, p10.x + e2.x };
+            const float ys[] = { p00.y, p10.y, p01.y, p10.y + e2.y };
+            const math::Box2i box = math::Box2i(
+                math::Vector2i(
+                    static_cast<int>(std::floor(*std::min_element(xs, xs + 4))),
+                    static_cast<int>(std::floor(*std::min_element(ys, ys + 4)))),
+                math::Vector2i(
+                    static_cast<int>(std::ceil(*std::max_element(xs, xs + 4))),
+                    static_cast<int>(std::ceil(*std::max_element(ys, ys + 4))))).
+                intersect(getBounds());
+            if (box.w() <= 0 || box.h() <= 0)
+                return;
+
+            const int targetWidth = target->getWidth();
+            float* targetData = reinterpret_cast<float*>(target->getData());
+            const bool clamp = !isFloat(renderOptions.colorBuffer);
+            parallel(
+                box,
+                [this, &box, &p00, dudx, dudy, dvdx, dvdy, &blend, &shader,
+                    targetWidth, targetData, clamp](int y0, int y1)
+                {
+                    const int w = box.w();
+                    std::vector<float> span(w * 4);
+                    for (int y = y0; y <= y1; ++y)
+                    {
+                        const float dx = box.min.x + .5F - p00.x;
+                        const float dy = y + .5F - p00.y;
+                        const float u = dx * dudx + dy * dudy;
+                        const float v = dx * dvdx + dy * dvdy;
+                        int x0 = -1;
+                        int x1 = -1;
+                        for (int x = 0; x < w; ++x)
+                        {
+                            const float uu = u + x * dudx;
+                            const float vv = v + x * dvdx;
+                            if (uu >= 0.F && uu < 1.F && vv >= 0.F && vv < 1.F)
+                            {
+                                if (x0 < 0)
+                                {
+                                    x0 = x;
+                                }
+                                x1 = x;
+                            }
+                            else if (x0 >= 0)
+                            {
+                                break;
+                            }
+                        }
+                        if (x0 >= 0)
+                        {
+                            const size_t count = x1 - x0 + 1;
+                            shader(u + x0 * dudx, v + x0 * dvdx, dudx, dvdx, count, span.data());
+                            const size_t offset = y * targetWidth + box.min.x + x0;
+                            blendSpan(
+                                span.data(),
+                                targetData + offset * 4,
+                                count,
+                                blend,
+                                maskEnabled ? mask.data() + offset : nullptr,
+                                clamp);
+                        }
+                    }
+                });
+        }
+
+        void Render::Private::fillTriangles(
+            const std::vector<math::Vector2f>& v,
+            const std::vector<math::Vector4f>& c,
+            const image::Color4f& color,
+            const Blend& blend)
+        {
+            const math::Box2i bounds = getBounds();
+            if (bounds.w() <= 0 || bounds.h() <= 0)
+                return;
+            const int targetWidth = target->getWidth();
+            float* targetData = reinterpret_cast<float*>(target->getData());
+            const bool clamp = !isFloat(renderOptions.colorBuffer);
+            for (size_t i = 0; i + 2 < v.size(); i += 3)
+            {
+                math::Vector2f p[3] =
+                {
+                    toPixel(transform, v[i]),
+                    toPixel(transform, v[i + 1]),
+                    toPixel(transform, v[i + 2])
+                };
+                math::Vector4f pc[3];
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    const math::Vector4f tmp = i + j < c.size() ?
+                        c[i + j] :
+                        math::Vector4f(1.F, 1.F, 1.F, 1.F);
+                    pc[j] = math::Vector4f(
+                        tmp.x * color.r,
+                        tmp.y * color.g,
+                        tmp.z * color.b,
+                        tmp.w * color.a);
+                }
+                float area =
+                    (p[1].x - p[0].x) * (p[2].y - p[0].y) -
+                    (p[1].y - p[0].y) * (p[2].x - p[0].x);
+                if (0.F == area)
+                    continue;
+                if (area < 0.F)
+                {
+                    std::swap(p[1], p[2]);
+                    std::swap(pc[1], pc[2]);
+                    area = -area;
+                }
+
+                const math::Box2i box = math::Box2i(
+                    math::Vector2i(
+                        static_cast<int>(std::floor(std::min({ p[0].x, p[1].x, p[2].x }))),
+                        static_cast<int>(std::floor(std::min({ p[0].y, p[1].y, p[2].y })))),
+                    math::Vector2i(
+                        static_cast<int>(std::ceil(std::max({ p[0].x, p[1].x, p[2].x }))),
+                        static_cast<int>(std::ceil(std::max({ p[0].y, p[1].y, p[2].y }))))).
+                    intersect(bounds);
+                if (box.w() <= 0 || box.h() <= 0)
+                    continue;
+
+                // Edge functions, with a consistent rule for pixels that
+                // lie exactly on an edge shared by two triangles.
+                struct Edge
+                {
+                    float a = 0.F;
+                    float b = 0.F;
+                    float c = 0.F;
+                    bool inclusive = false;
+                };
+                Edge edges[3];
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    const math::Vector2f& e0 = p[(j + 1) % 3];
+                    const math::Vector2f& e1 = p[(j + 2) % 3];
+                    const float dx = e1.x - e0.x;
+                    const float dy = e1.y - e0.y;
+                    edges[j].a = -dy / area;
+                    edges[j].b = dx / area;
+                    edges[j].c = (dy * e0.x - dx * e0.y) / area;
+                    edges[j].inclusive = dy > 0.F || (0.F == dy && dx < 0.F);
+                }
+                parallel(
+                    box,
+                    [this, &box, &edges, &pc, &blend, targetWidth, targetData, clamp](int y0, int y1)
+                    {
+                        const int w = box.w();
+                        std::vector<float> span(w * 4);
+                        for (int y = y0; y <= y1; ++y)
+                        {
+                            const float py = y + .5F;
+                            int x0 = -1;
+                            int x1 = -1;
+                            float* spanP = span.data();
+                            for (int x = 0; x < w; ++x)
+                            {
+                                const float px = box.min.x + x + .5F;
+                                float b[3];
+                                bool inside = true;
+                                for (size_t j = 0; j < 3 && inside; ++j)
+                                {
+                                    b[j] = edges[j].a * px + edges[j].b * py + edges[j].c;
+                                    inside = b[j] > 0.F || (0.F == b[j] && edges[j].inclusive);
+                                }
+                                if (inside)
+                                {
+                                    if (x0 < 0)
+                                    {
+                                        x0 = x;
+                                    }
+                                    x1 = x;
+                                    spanP[0] = b[0] * pc[0].x + b[1] * pc[1].x + b[2] * pc[2].x;
+                                    spanP[1] = b[0] * pc[0].y + b[1] * pc[1].y + b[2] * pc[2].y;
+                                    spanP[2] = b[0] * pc[0].z + b[1] * pc[1].z + b[2] * pc[2].z;
+                                    spanP[3] = b[0] * pc[0].w + b[1] * pc[1].w + b[2] * pc[2].w;
+                                    spanP += 4;
+                                }
+                                else if (x0 >= 0)
+                                {
+                                    break;
+                                }
+                            }
+                            if (x0 >= 0)
+                            {
+                                const size_t offset = y * targetWidth + box.min.x + x0;
+                                blendSpan(
+                                    span.data(),
+                                    targetData + offset * 4,
+                                    x1 - x0 + 1,
+                                    blend,
+                                    maskEnabled ? mask.data() + offset : nullptr,
+                                    clamp);
+                            }
+                        }
+                    });
+            }
+        }
+
+        void Render::Private::colorSpan(float* p, size_t count) const
+        {
+#if defined(TLRENDER_OCIO)
+            OCIO::PackedImageDesc desc(p, count, 1, 4);
+            switch (lutOptions.order)
+            {
+            case timeline::LUTOrder::PreColorConfig:
+                if (lutProcessor)
+                {
+                    lutProcessor->apply(desc);
+                }
+                if (ocioProcessor)
+                {
+                    ocioProcessor->apply(desc);
+                }
+                break;
+            case timeline::LUTOrder::PostColorConfig:
+                if (ocioProcessor)
+                {
+                    ocioProcessor->apply(desc);
+                }
+                if (lutProcessor)
+                {
+                    lutProcessor->apply(desc);
+                }
+                break;
+            default: break;
+            }
+#endif // TLRENDER_OCIO
+        }
+
+        void Render::_init(
+            const std::shared_ptr<system::Context>& context,
+            const std::shared_ptr<ImageCache>& imageCache,
+            size_t threadCount)
+        {
+            IRender::_init(context);
+            TLRENDER_P();
+
+            p.imageCache = imageCache;
+            if (!p.imageCache)
+            {
+                p.imageCache = std::make_shared<ImageCache>();
+            }
+
+            if (0 == threadCount)
+            {
+                threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+            }
+            for (size_t i = 1; i < threadCount; ++i)
+            {
+                p.threads.threads.push_back(std::thread(
+                    [this]
+                    {
+                        TLRENDER_P();
+                        size_t generation = 0;
+                        while (true)
+                        {
+                            {
+                                std::unique_lock<std::mutex> lock(p.threads.mutex);
+                                p.threads.cv.wait(
+                                    lock,
+                                    [this, generation]
+                                    {
+                                        return
+                                            _p->threads.stop ||
+                                            _p->threads.generation != generation;
+                                    });
+                                if (p.threads.stop)
+                                    break;
+                                generation = p.threads.generation;
+                            }
+                            p.threadsRun();
+                            {
+                                std::unique_lock<std::mutex> lock(p.threads.mutex);
+                                --p.threads.active;
+                            }
+                            p.threads.doneCV.notify_one();
+                        }
+                    }));
+            }
+
+            p.logTimer = std::chrono::steady_clock::now();
+        }
+
+        Render::Render() :
+            _p(new Private)
+        {}
+
+        Render::~Render()
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.threads.mutex);
+                p.threads.stop = true;
+            }
+            p.threads.cv.notify_all();
+            for (auto& thread : p.threads.threads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+        }
+
+        std::shared_ptr<Render> Render::create(
+            const std::shared_ptr<system::Context>& context,
+            const std::shared_ptr<ImageCache>& imageCache,
+            size_t threadCount)
+        {
+            auto out = std::shared_ptr<Render>(new Render);
+            out->_init(context, imageCache, threadCount);
+            return out;
+        }
+
+        const std::shared_ptr<ImageCache>& Render::getImageCache() const
+        {
+            return _p->imageCache;
+        }
+
+        const std::shared_ptr<image::Image>& Render::getFrameBuffer() const
+        {
+            return _p->frameBuffer;
+        }
+
+        void Render::copyImage(const std::shared_ptr<image::Image>& value) const
+        {
+            TLRENDER_P();
+            if (!value || !p.frameBuffer || !value->isValid())
+                return;
+            const auto& info = value->getInfo();
+            const int w = std::min(info.size.w, p.frameBuffer->getWidth());
+            const int h = std::min(info.size.h, p.frameBuffer->getHeight());
+            const int frameBufferWidth = p.frameBuffer->getWidth();
+            const int frameBufferHeight = p.frameBuffer->getHeight();
+            const size_t rowByteCount = value->getDataByteCount() / info.size.h;
+            const float* frameBufferData = reinterpret_cast<const float*>(p.frameBuffer->getData());
+            uint8_t* data = value->getData();
+            p.parallel(
+                math::Box2i(0, 0, w, h),
+                [w, frameBufferWidth, frameBufferHeight, rowByteCount, frameBufferData, data, &info](int y0, int y1)
+                {
+                    for (int y = y0; y <= y1; ++y)
+                    {
+                        copySpan(
+                            frameBufferData + (frameBufferHeight - 1 - y) * frameBufferWidth * 4,
+                            data + y * rowByteCount,
+                            w,
+                            info.pixelType);
+                    }
+                });
+        }
+
+        void Render::begin(
+            const math::Size2i& renderSize,
+            const timeline::RenderOptions& renderOptions)
+        {
+            TLRENDER_P();
+
+            p.timer = std::chrono::steady_clock::now();
+
+            p.renderSize = renderSize;
+            p.renderOptions = renderOptions;
+            p.imageCache->setMax(renderOptions.textureCacheByteCount);
+
+            if (!p.frameBuffer ||
+                p.frameBuffer->getSize() != image::Size(renderSize.w, renderSize.h))
+            {
+                p.frameBuffer = image::Image::create(
+                    renderSize.w,
+                    renderSize.h,
+                    image::PixelType::RGBA_F32);
+                p.frameBuffer->zero();
+            }
+            p.target = p.frameBuffer;
+            p.maskEnabled = false;
+
+            setViewport(math::Box2i(0, 0, renderSize.w, renderSize.h));
+            if (renderOptions.clear)
+            {
+                clearViewport(renderOptions.clearColor);
+            }
+            setTransform(math::ortho(
+                0.F,
+                static_cast<float>(renderSize.w),
+                static_cast<float>(renderSize.h),
+                0.F,
+                -1.F,
+                1.F));
+        }
+
+        void Render::end()
+        {
+            TLRENDER_P();
+
+            const auto now = std::chrono::steady_clock::now();
+            const auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(now - p.timer);
+            p.currentStats.time = diff.count();
+            p.stats.push_back(p.currentStats);
+            p.currentStats = Private::Stats();
+            while (p.stats.size() > 60)
+            {
+                p.stats.pop_front();
+            }
+
+            const std::chrono::duration<float> logDiff = now - p.logTimer;
+            if (logDiff.count() > 10.F)
+            {
+                p.logTimer = now;
+                if (auto context = _context.lock())
+                {
+                    Private::Stats average;
+                    const size_t size = p.stats.size();
+                    if (size > 0)
+                    {
+                        for (const auto& i : p.stats)
+                        {
+                            average.time += i.time;
+                            average.rects += i.rects;
+                            average.meshes += i.meshes;
+                            average.meshTriangles += i.meshTriangles;
+                            average.text += i.text;
+                            average.textures += i.textures;
+                            average.images += i.images;
+                            average.pixels += i.pixels;
+                        }
+                        average.time /= p.stats.size();
+                        average.rects /= p.stats.size();
+                        average.meshes /= p.stats.size();
+                        average.meshTriangles /= p.stats.size();
+                        average.text /= p.stats.size();
+                        average.textures /= p.stats.size();
+                        average.images /= p.stats.size();
+                        average.pixels /= p.stats.size();
+                    }
+
+                    context->log(
+                        string::Format("tl::timeline::CPURender {0}").arg(this),
+                        string::Format(
+                            "\n"
+                            "    Average render time: {0}ms\n"
+                            "    Average rectangle count: {1}\n"
+                            "    Average mesh count: {2}\n"
+                            "    Average mesh triangles: {3}\n"
+                            "    Average text count: {4}\n"
+                            "    Average texture count: {5}\n"
+                            "    Average image count: {6}\n"
+                            "    Average pixel count: {7}\n"
+                            "    Thread count: {8}").
+                        arg(average.time).
+                        arg(average.rects).
+                        arg(average.meshes).
+                        arg(average.meshTriangles).
+                        arg(average.text).
+                        arg(average.textures).
+                        arg(average.images).
+                        arg(average.pixels).
+                        arg(p.threads.threads.size() + 1));
+                }
+            }
+        }
+
+        math::Size2i Render::getRenderSize() const
+        {
+            return _p->renderSize;
+        }
+
+        void Render::setRenderSize(const math::Size2i& value)
+        {
+            _p->renderSize = value;
+        }
+
+        math::Box2i Render::getViewport() const
+        {
+            return _p->viewport;
+        }
+
+        void Render::setViewport(const math::Box2i& value)
+        {
+            _p->viewport = value;
+        }
+
+        void Render::clearViewport(const image::Color4f& value)
+        {
+            TLRENDER_P();
+            if (!p.target)
+                return;
+
+            // The same as glClear(), the clear is limited by the clipping
+            // rectangle but not the viewport.
+            math::Box2i box(0, 0, p.target->getWidth(), p.target->getHeight());
+            if (p.clipRectEnabled)
+            {
+                box = box.intersect(p.clipRect);
+            }
+            const int targetWidth = p.target->getWidth();
+            float* targetData = reinterpret_cast<float*>(p.target->getData());
+            p.parallel(
+                box,
+                [&box, &value, targetWidth, targetData](int y0, int y1)
+                {
+                    const float color[] = { value.r, value.g, value.b, value.a };
+                    for (int y = y0; y <= y1; ++y)
+                    {
+                        float* p = targetData + (y * targetWidth + box.min.x) * 4;
+                        for (int x = box.min.x; x <= box.max.x; ++x, p += 4)
+                        {
+                            std::copy(color, color + 4, p);
+                        }
+                    }
+                });
+        }
+
+        bool Render::getClipRectEnabled() const
+        {
+            return _p->clipRectEnabled;
+        }
+
+        void Render::setClipRectEnabled(bool value)
+        {
+            _p->clipRectEnabled = value;
+        }
+
+        math::Box2i Render::getClipRect() const
+        {
+            return _p->clipRect;
+        }
+
+        void Render::setClipRect(const math::Box2i& value)
+        {
+            _p->clipRect = value;
+        }
+
+        math::Matrix4x4f Render::getTransform() const
+        {
+            return _p->transform;
+        }
+
+        void Render::setTransform(const math::Matrix4x4f& value)
+        {
+            _p->transform = value;
+        }
+
+        void Render::setOCIOOptions(const timeline::OCIOOptions& value)
+        {
+            TLRENDER_P();
+            if (value == p.ocioOptions)
+                return;
+
+#if defined(TLRENDER_OCIO)
+            p.ocioProcessor.reset();
+#endif // TLRENDER_OCIO
+
+            p.ocioOptions = value;
+
+#if defined(TLRENDER_OCIO)
+            if (p.ocioOptions.enabled &&
+                !p.ocioOptions.input.empty() &&
+                !p.ocioOptions.display.empty() &&
+                !p.ocioOptions.view.empty())
+            {
+                OCIO::ConstConfigRcPtr config;
+                if (!p.ocioOptions.fileName.empty())
+                {
+                    config = OCIO::Config::CreateFromFile(p.ocioOptions.fileName.c_str());
+                }
+                else
+                {
+                    config = OCIO::GetCurrentConfig();
+                }
+                if (!config)
+                {
+                    throw std::runtime_error("Cannot get OCIO configuration");
+                }
+
+                auto transform = OCIO::DisplayViewTransform::Create();
+                if (!transform)
+                {
+                    throw std::runtime_error("Cannot create OCIO transform");
+                }
+                transform->setSrc(p.ocioOptions.input.c_str());
+                transform->setDisplay(p.ocioOptions.display.c_str());
+                transform->setView(p.ocioOptions.view.c_str());
+
+                auto lvp = OCIO::LegacyViewingPipeline::Create();
+                if (!lvp)
+                {
+                    throw std::runtime_error("Cannot create OCIO viewing pipeline");
+                }
+                lvp->setDisplayViewTransform(transform);
+                lvp->setLooksOverrideEnabled(true);
+                lvp->setLooksOverride(p.ocioOptions.look.c_str());
+
+                auto processor = lvp->getProcessor(config, config->getCurrentContext());
+                if (!processor)
+                {
+                    throw std::runtime_error("Cannot get OCIO processor");
+                }
+                p.ocioProcessor = processor->getDefaultCPUProcessor();
+                if (!p.ocioProcessor)
+                {
+                    throw std::runtime_error("Cannot get OCIO CPU processor");
+                }
+            }
+#endif // TLRENDER_OCIO
+        }
+
+        void Render::setLUTOptions(const timeline::LUTOptions& value)
+        {
+            TLRENDER_P();
+            if (value == p.lutOptions)
+                return;
+
+#if defined(TLRENDER_OCIO)
+            p.lutProcessor.reset();
+#endif // TLRENDER_OCIO
+
+            p.lutOptions = value;
+
+#if defined(TLRENDER_OCIO)
+            if (p.lutOptions.enabled && !p.lutOptions.fileName.empty())
+            {
+                auto config = OCIO::Config::CreateRaw();
+                if (!config)
+                {
+                    throw std::runtime_error("Cannot create OCIO configuration");
+                }
+
+                auto transform = OCIO::FileTransform::Create();
+                if (!transform)
+                {
+                    throw std::runtime_error("Cannot create OCIO transform");
+                }
+                transform->setSrc(p.lutOptions.fileName.c_str());
+                transform->validate();
+
+                auto processor = config->getProcessor(transform);
+                if (!processor)
+                {
+                    throw std::runtime_error("Cannot get OCIO processor");
+                }
+                p.lutProcessor = processor->getDefaultCPUProcessor();
+                if (!p.lutProcessor)
+                {
+                    throw std::runtime_error("Cannot get OCIO CPU processor");
+                }
+            }
+#endif // TLRENDER_OCIO
+        }
+    }
+}
@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTimeline/IRender.h>
+
+#include <tlCore/LRUCache.h>
+
+namespace tl
+{
+    //! Timeline CPU support
+    namespace timeline_cpu
+    {
+        //! Image cache. The images are converted to RGBA F32 for sampling.
+        typedef memory::LRUCache<
+            std::shared_ptr<image::Image>,
+            std::shared_ptr<image::Image> > ImageCache;
+
+        //! Software renderer.
+        //!
+        //! The renderer draws into an RGBA F32 frame buffer on the CPU, so it
+        //! does not require a display or an OpenGL context. The rendering
+        //! matches the OpenGL renderer, including the compare modes, display
+        //! options, and color management.
+        //!
+        //! \todo Drawing OpenGL textures with drawTexture() is not supported.
+        class Render : public timeline::IRender
+        {
+            TLRENDER_NON_COPYABLE(Render);
+
+        protected:
+            void _init(
+                const std::shared_ptr<system::Context>&,
+                const std::shared_ptr<ImageCache>&,
+                size_t threadCount);
+
+            Render();
+
+        public:
+            virtual ~Render();
+
+            //! Create a new renderer. The thread count includes the calling
+            //! thread, zero uses the number of hardware threads.
+            static std::shared_ptr<Render> create(
+                const std::shared_ptr<system::Context>&,
+                const std::shared_ptr<ImageCache>& = nullptr,
+                size_t threadCount = 0);
+
+            //! Get the image cache.
+            const std::shared_ptr<ImageCache>& getImageCache() const;
+
+            //! Get the frame buffer. The frame buffer is RGBA F32 and the
+            //! first row is the top of the render.
+            const std::shared_ptr<image::Image>& getFrameBuffer() const;
+
+            //! Copy the frame buffer to an image with the same size as the
+            //! render. The pixel data is converted to the image pixel type
+            //! and the rows are ordered from bottom to top, the same as
+            //! glReadPixels().
+            void copyImage(const std::shared_ptr<image::Image>&) const;
+
+            void begin(
+                const math::Size2i&,
+                const timeline::RenderOptions& = timeline::RenderOptions()) override;
+            void end() override;
+
+            math::Size2i getRenderSize() const override;
+            void setRenderSize(const math::Size2i&) override;
+            math::Box2i getViewport() const override;
+            void setViewport(const math::Box2i&) override;
+            void clearViewport(const image::Color4f&) override;
+            bool getClipRectEnabled() const override;
+            void setClipRectEnabled(bool) override;
+            math::Box2i getClipRect() const override;
+            void setClipRect(const math::Box2i&) override;
+            math::Matrix4x4f getTransform() const override;
+            void setTransform(const math::Matrix4x4f&) override;
+            void setOCIOOptions(const timeline::OCIOOptions&) override;
+            void setLUTOptions(const timeline::LUTOptions&) override;
+
+            void drawRect(
+                const math::Box2i&,
+                const image::Color4f&) override;
+            void drawMesh(
+                const geom::TriangleMesh2&,
+                const math::Vector2i& position,
+                const image::Color4f&) override;
+            void drawColorMesh(
+                const geom::TriangleMesh2&,
+                const math::Vector2i& position,
+                const image::Color4f&) override;
+            void drawText(
+                const std::vector<std::shared_ptr<image::Glyph> >& glyphs,
+                const math::Vector2i& position,
+                const image::Color4f&) override;
+            void drawTexture(
+                unsigned int,
+                const math::Box2i&,
+                const image::Color4f& = image::Color4f(1.F, 1.F, 1.F)) override;
+            void drawImage(
+                const std::shared_ptr<image::Image>&,
+                const math::Box2i&,
+                const image::Color4f& = image::Color4f(1.F, 1.F, 1.F),
+                const timeline::ImageOptions& = timeline::ImageOptions()) override;
+            void drawVideo(
+                const std::vector<timeline::VideoData>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<timeline::ImageOptions>& = {},
+                const std::vector<timeline::DisplayOptions>& = {},
+                const timeline::CompareOptions& = timeline::CompareOptions(),
+                const timeline::BackgroundOptions& = timeline::BackgroundOptions()) override;
+
+        private:
+            void _drawBackground(
+                const std::vector<math::Box2i>&,
+                const timeline::BackgroundOptions&);
+            void _drawVideoA(
+                const std::vector<timeline::VideoData>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<timeline::ImageOptions>&,
+                const std::vector<timeline::DisplayOptions>&,
+                const timeline::CompareOptions&);
+            void _drawVideoB(
+                const std::vector<timeline::VideoData>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<timeline::ImageOptions>&,
+                const std::vector<timeline::DisplayOptions>&,
+                const timeline::CompareOptions&);
+            void _drawVideoWipe(
+                const std::vector<timeline::VideoData>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<timeline::ImageOptions>&,
+                const std::vector<timeline::DisplayOptions>&,
+                const timeline::CompareOptions&);
+            void _drawVideoOverlay(
+                const std::vector<timeline::VideoData>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<timeline::ImageOptions>&,
+                const std::vector<timeline::DisplayOptions>&,
+                const timeline::CompareOptions&);
+            void _drawVideoDifference(
+                const std::vector<timeline::VideoData>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<timeline::ImageOptions>&,
+                const std::vector<timeline::DisplayOptions>&,
+                const timeline::CompareOptions&);
+            void _drawVideoTile(
+                const std::vector<timeline::VideoData>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<timeline::ImageOptions>&,
+                const std::vector<timeline::DisplayOptions>&,
+                const timeline::CompareOptions&);
+            void _drawVideo(
+                const timeline::VideoData&,
+                const math::Box2i&,
+                const std::shared_ptr<timeline::ImageOptions>&,
+                const timeline::DisplayOptions&);
+            void _drawVideoOffscreen(
+                const std::string& buffer,
+                const timeline::VideoData&,
+                const math::Size2i&,
+                const std::shared_ptr<timeline::ImageOptions>&,
+                const timeline::DisplayOptions&);
+
+            TLRENDER_PRIVATE();
+        };
+    }
+}
@@ -0,0 +1,804 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineCPU/RenderPrivate.h>
+
+#include <tlCore/Math.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define TLRENDER_CPU_SSE
+#include <emmintrin.h>
+#endif // __SSE2__ || _M_X64
+
+namespace tl
+{
+    namespace timeline_cpu
+    {
+        Blend::Blend(BlendFactor src, BlendFactor dst) :
+            srcRGB(src),
+            dstRGB(dst),
+            srcAlpha(src),
+            dstAlpha(dst)
+        {}
+
+        Blend::Blend(
+            BlendFactor srcRGB,
+            BlendFactor dstRGB,
+            BlendFactor srcAlpha,
+            BlendFactor dstAlpha) :
+            srcRGB(srcRGB),
+            dstRGB(dstRGB),
+            srcAlpha(srcAlpha),
+            dstAlpha(dstAlpha)
+        {}
+
+        namespace
+        {
+            // Chroma plane upsampling weights, the same as sampling the
+            // chroma texture with linear filtering.
+            struct ChromaSample
+            {
+                int i0 = 0;
+                int i1 = 0;
+                float f = 0.F;
+            };
+
+            ChromaSample getChromaSample(int i, int size, int chromaSize)
+            {
+                ChromaSample out;
+                if (chromaSize > 0)
+                {
+                    const float c = (i + .5F) * chromaSize / static_cast<float>(size) - .5F;
+                    const float c0 = std::floor(c);
+                    out.i0 = math::clamp(static_cast<int>(c0), 0, chromaSize - 1);
+                    out.i1 = math::clamp(static_cast<int>(c0) + 1, 0, chromaSize - 1);
+                    out.f = c - c0;
+                }
+                return out;
+            }
+
+            template<typename T>
+            float getYUVSample(const image::Plane& plane, const ChromaSample& x, const ChromaSample& y)
+            {
+                const T* row0 = reinterpret_cast<const T*>(plane.data + y.i0 * plane.stride);
+                const T* row1 = reinterpret_cast<const T*>(plane.data + y.i1 * plane.stride);
+                const float a = row0[x.i0] + (row0[x.i1] - row0[x.i0]) * x.f;
+                const float b = row1[x.i0] + (row1[x.i1] - row1[x.i0]) * x.f;
+                return a + (b - a) * y.f;
+            }
+
+            template<typename T>
+            void copyTextureYUV(
+                const image::Image& in,
+                image::Image& out,
+                int w2,
+                int h2,
+                float scale,
+                int y0,
+                int y1)
+            {
+                const int w = in.getWidth();
+                const int h = in.getHeight();
+                const auto& planes = in.getPlanes();
+                std::vector<ChromaSample> xSamples(w);
+                for (int x = 0; x < w; ++x)
+                {
+                    xSamples[x] = getChromaSample(x, w, w2);
+                }
+                for (int y = y0; y <= y1; ++y)
+                {
+                    const ChromaSample ySample = getChromaSample(y, h, h2);
+                    const T* yP = reinterpret_cast<const T*>(planes[0].data + y * planes[0].stride);
+                    float* outP = reinterpret_cast<float*>(out.getData()) + y * w * 4;
+                    for (int x = 0; x < w; ++x, outP += 4)
+                    {
+                        outP[0] = yP[x] * scale;
+                        outP[1] = getYUVSample<T>(planes[1], xSamples[x], ySample) * scale;
+                        outP[2] = getYUVSample<T>(planes[2], xSamples[x], ySample) * scale;
+                        outP[3] = 1.F;
+                    }
+                }
+            }
+
+            template<typename T>
+            void copyTextureRow(
+                const T* in,
+                float* out,
+                int w,
+                int channelCount,
+                float scale)
+            {
+                for (int x = 0; x < w; ++x, in += channelCount, out += 4)
+                {
+                    out[0] = 0.F;
+                    out[1] = 0.F;
+                    out[2] = 0.F;
+                    out[3] = 1.F;
+                    for (int c = 0; c < channelCount; ++c)
+                    {
+                        out[c] = static_cast<float>(in[c]) * scale;
+                    }
+                }
+            }
+        }
+
+        void copyTexture(const image::Image& in, image::Image& out, int y0, int y1)
+        {
+            const auto& info = in.getInfo();
+            const int w = info.size.w;
+            const int h = info.size.h;
+            switch (info.pixelType)
+            {
+            case image::PixelType::YUV_420P_U8:
+                copyTextureYUV<uint8_t>(in, out, w / 2, h / 2, 1.F / 255.F, y0, y1);
+                return;
+            case image::PixelType::YUV_422P_U8:
+                copyTextureYUV<uint8_t>(in, out, w / 2, h, 1.F / 255.F, y0, y1);
+                return;
+            case image::PixelType::YUV_444P_U8:
+                copyTextureYUV<uint8_t>(in, out, w, h, 1.F / 255.F, y0, y1);
+                return;
+            case image::PixelType::YUV_420P_U16:
+                copyTextureYUV<uint16_t>(in, out, w / 2, h / 2, 1.F / 65535.F, y0, y1);
+                return;
+            case image::PixelType::YUV_422P_U16:
+                copyTextureYUV<uint16_t>(in, out, w / 2, h, 1.F / 65535.F, y0, y1);
+                return;
+            case image::PixelType::YUV_444P_U16:
+                copyTextureYUV<uint16_t>(in, out, w, h, 1.F / 65535.F, y0, y1);
+                return;
+            default: break;
+            }
+
+            const int channelCount = image::getChannelCount(info.pixelType);
+            const int bitDepth = image::getBitDepth(info.pixelType);
+            size_t wordSize = 0;
+            size_t wordCount = 0;
+            size_t pixelByteCount = 0;
+            switch (info.pixelType)
+            {
+            case image::PixelType::RGB_U10:
+                wordSize = 4;
+                wordCount = w;
+                pixelByteCount = 4;
+                break;
+            case image::PixelType::ARGB_4444_Premult:
+                wordSize = 2;
+                wordCount = w;
+                pixelByteCount = 2;
+                break;
+            default:
+                wordSize = bitDepth / 8;
+                wordCount = w * channelCount;
+                pixelByteCount = channelCount * wordSize;
+                break;
+            }
+            const auto& plane = in.getPlanes()[0];
+            const size_t rowByteCount = image::getAlignedByteCount(
+                w * pixelByteCount,
+                info.layout.alignment);
+            const bool swap = wordSize > 1 && info.layout.endian != memory::getEndian();
+            std::vector<uint8_t> tmp(swap ? rowByteCount : 0);
+            for (int y = y0; y <= y1; ++y)
+            {
+                const uint8_t* inP = plane.data + y * plane.stride;
+                if (swap)
+                {
+                    memory::endian(inP, tmp.data(), wordCount, wordSize);
+                    inP = tmp.data();
+                }
+                float* outP = reinterpret_cast<float*>(out.getData()) + y * w * 4;
+                switch (info.pixelType)
+                {
+                case image::PixelType::L_U8:
+                case image::PixelType::LA_U8:
+                case image::PixelType::RGB_U8:
+                case image::PixelType::RGBA_U8:
+                    copyTextureRow(inP, outP, w, channelCount, 1.F / 255.F);
+                    break;
+                case image::PixelType::L_U16:
+                case image::PixelType::LA_U16:
+                case image::PixelType::RGB_U16:
+                case image::PixelType::RGBA_U16:
+                    copyTextureRow(
+                        reinterpret_cast<const uint16_t*>(inP),
+                        outP,
+                        w,
+                        channelCount,
+                        1.F / 65535.F);
+                    break;
+                case image::PixelType::L_U32:
+                case image::PixelType::LA_U32:
+                case image::PixelType::RGB_U32:
+                case image::PixelType::RGBA_U32:
+                    copyTextureRow(
+                        reinterpret_cast<const uint32_t*>(inP),
+                        outP,
+                        w,
+                        channelCount,
+                        1.F / 4294967295.F);
+                    break;
+                case image::PixelType::L_F16:
+                case image::PixelType::LA_F16:
+                case image::PixelType::RGB_F16:
+                case image::PixelType::RGBA_F16:
+                    copyTextureRow(
+                        reinterpret_cast<const image::F16_T*>(inP),
+                        outP,
+                        w,
+                        channelCount,
+                        1.F);
+                    break;
+                case image::PixelType::L_F32:
+                case image::PixelType::LA_F32:
+                case image::PixelType::RGB_F32:
+                case image::PixelType::RGBA_F32:
+                    copyTextureRow(
+                        reinterpret_cast<const float*>(inP),
+                        outP,
+                        w,
+                        channelCount,
+                        1.F);
+                    break;
+                case image::PixelType::RGB_U10:
+                {
+                    const image::U10* p = reinterpret_cast<const image::U10*>(inP);
+                    for (int x = 0; x < w; ++x, ++p, outP += 4)
+                    {
+                        outP[0] = p->r / 1023.F;
+                        outP[1] = p->g / 1023.F;
+                        outP[2] = p->b / 1023.F;
+                        outP[3] = 1.F;
+                    }
+                    break;
+                }
+                case image::PixelType::ARGB_4444_Premult:
+                {
+                    const uint16_t* p = reinterpret_cast<const uint16_t*>(inP);
+                    for (int x = 0; x < w; ++x, ++p, outP += 4)
+                    {
+                        outP[0] = ((*p >> 8) & 15) / 15.F;
+                        outP[1] = ((*p >> 4) & 15) / 15.F;
+                        outP[2] = (*p & 15) / 15.F;
+                        outP[3] = ((*p >> 12) & 15) / 15.F;
+                    }
+                    break;
+                }
+                default:
+                    std::memset(outP, 0, w * 4 * sizeof(float));
+                    break;
+                }
+            }
+        }
+
+        void sampleSpan(
+            const image::Image& texture,
+            timeline::ImageFilter filter,
+            float u,
+            float v,
+            float du,
+            float dv,
+            size_t count,
+            float* out)
+        {
+            const int w = texture.getWidth();
+            const int h = texture.getHeight();
+            const float* data = reinterpret_cast<const float*>(texture.getData());
+            switch (filter)
+            {
+            case timeline::ImageFilter::Nearest:
+                for (size_t i = 0; i < count; ++i, u += du, v += dv, out += 4)
+                {
+                    const int x = math::clamp(static_cast<int>(std::floor(u * w)), 0, w - 1);
+                    const int y = math::clamp(static_cast<int>(std::floor(v * h)), 0, h - 1);
+                    std::memcpy(out, data + (y * w + x) * 4, 4 * sizeof(float));
+                }
+                break;
+            case timeline::ImageFilter::Linear:
+                for (size_t i = 0; i < count; ++i, u += du, v += dv, out += 4)
+                {
+                    const float fx = u * w - .5F;
+                    const float fy = v * h - .5F;
+                    const float x0f = std::floor(fx);
+                    const float y0f = std::floor(fy);
+                    const float tx = fx - x0f;
+                    const float ty = fy - y0f;
+                    const int x0 = math::clamp(static_cast<int>(x0f), 0, w - 1);
+                    const int x1 = math::clamp(static_cast<int>(x0f) + 1, 0, w - 1);
+                    const int y0 = math::clamp(static_cast<int>(y0f), 0, h - 1);
+                    const int y1 = math::clamp(static_cast<int>(y0f) + 1, 0, h - 1);
+                    const float* p00 = data + (y0 * w + x0) * 4;
+                    const float* p10 = data + (y0 * w + x1) * 4;
+                    const float* p01 = data + (y1 * w + x0) * 4;
+                    const float* p11 = data + (y1 * w + x1) * 4;
+#if defined(TLRENDER_CPU_SSE)
+                    const __m128 txV = _mm_set1_ps(tx);
+                    const __m128 tyV = _mm_set1_ps(ty);
+                    const __m128 a = _mm_loadu_ps(p00);
+                    const __m128 b = _mm_loadu_ps(p01);
+                    const __m128 top = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(p10), a), txV));
+                    const __m128 bottom = _mm_add_ps(b, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(p11), b), txV));
+                    _mm_storeu_ps(out, _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), tyV)));
+#else // TLRENDER_CPU_SSE
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        const float top = p00[c] + (p10[c] - p00[c]) * tx;
+                        const float bottom = p01[c] + (p11[c] - p01[c]) * tx;
+                        out[c] = top + (bottom - top) * ty;
+                    }
+#endif // TLRENDER_CPU_SSE
+                }
+                break;
+            default: break;
+            }
+        }
+
+        namespace
+        {
+            // The blending factors are computed as "a * alpha + b".
+            void getBlendFactor(BlendFactor value, float& a, float& b)
+            {
+                switch (value)
+                {
+                case BlendFactor::Zero:             a = 0.F;  b = 0.F; break;
+                case BlendFactor::One:              a = 0.F;  b = 1.F; break;
+                case BlendFactor::SrcAlpha:         a = 1.F;  b = 0.F; break;
+                case BlendFactor::OneMinusSrcAlpha: a = -1.F; b = 1.F; break;
+                default: break;
+                }
+            }
+        }
+
+        void blendSpan(
+            const float* in,
+            float* out,
+            size_t count,
+            const Blend& blend,
+            const uint8_t* mask,
+            bool clamp)
+        {
+            float srcA[4];
+            float srcB[4];
+            float dstA[4];
+            float dstB[4];
+            getBlendFactor(blend.srcRGB, srcA[0], srcB[0]);
+            getBlendFactor(blend.dstRGB, dstA[0], dstB[0]);
+            getBlendFactor(blend.srcAlpha, srcA[3], srcB[3]);
+            getBlendFactor(blend.dstAlpha, dstA[3], dstB[3]);
+            srcA[1] = srcA[2] = srcA[0];
+            srcB[1] = srcB[2] = srcB[0];
+            dstA[1] = dstA[2] = dstA[0];
+            dstB[1] = dstB[2] = dstB[0];
+#if defined(TLRENDER_CPU_SSE)
+            const __m128 srcAV = _mm_loadu_ps(srcA);
+            const __m128 srcBV = _mm_loadu_ps(srcB);
+            const __m128 dstAV = _mm_loadu_ps(dstA);
+            const __m128 dstBV = _mm_loadu_ps(dstB);
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.F);
+            for (size_t i = 0; i < count; ++i, in += 4, out += 4)
+            {
+                if (mask && !mask[i])
+                    continue;
+                const __m128 s = _mm_loadu_ps(in);
+                const __m128 d = _mm_loadu_ps(out);
+                const __m128 alpha = _mm_shuffle_ps(s, s, _MM_SHUFFLE(3, 3, 3, 3));
+                const __m128 sf = _mm_add_ps(_mm_mul_ps(srcAV, alpha), srcBV);
+                const __m128 df = _mm_add_ps(_mm_mul_ps(dstAV, alpha), dstBV);
+                __m128 r = _mm_add_ps(_mm_mul_ps(s, sf), _mm_mul_ps(d, df));
+                if (clamp)
+                {
+                    r = _mm_min_ps(_mm_max_ps(r, zero), one);
+                }
+                _mm_storeu_ps(out, r);
+            }
+#else // TLRENDER_CPU_SSE
+            for (size_t i = 0; i < count; ++i, in += 4, out += 4)
+            {
+                if (mask && !mask[i])
+                    continue;
+                const float alpha = in[3];
+                for (size_t c = 0; c < 4; ++c)
+                {
+                    float r =
+                        in[c] * (srcA[c] * alpha + srcB[c]) +
+                        out[c] * (dstA[c] * alpha + dstB[c]);
+                    if (clamp)
+                    {
+                        r = math::clamp(r, 0.F, 1.F);
+                    }
+                    out[c] = r;
+                }
+            }
+#endif // TLRENDER_CPU_SSE
+        }
+
+        namespace
+        {
+            template<typename T>
+            void copySpanInt(
+                const float* in,
+                T* out,
+                size_t count,
+                size_t channelCount,
+                float max)
+            {
+                for (size_t i = 0; i < count; ++i, in += 4, out += channelCount)
+                {
+                    for (size_t c = 0; c < channelCount; ++c)
+                    {
+                        const size_t ci = (2 == channelCount && 1 == c) ? 3 : c;
+                        out[c] = static_cast<T>(math::clamp(in[ci], 0.F, 1.F) * max + .5F);
+                    }
+                }
+            }
+
+            template<typename T>
+            void copySpanFloat(
+                const float* in,
+                T* out,
+                size_t count,
+                size_t channelCount)
+            {
+                for (size_t i = 0; i < count; ++i, in += 4, out += channelCount)
+                {
+                    for (size_t c = 0; c < channelCount; ++c)
+                    {
+                        const size_t ci = (2 == channelCount && 1 == c) ? 3 : c;
+                        out[c] = in[ci];
+                    }
+                }
+            }
+        }
+
+        void copySpan(
+            const float* in,
+            uint8_t* out,
+            size_t count,
+            image::PixelType pixelType)
+        {
+            const size_t channelCount = image::getChannelCount(pixelType);
+            switch (pixelType)
+            {
+            case image::PixelType::RGBA_U8:
+            {
+                size_t i = 0;
+#if defined(TLRENDER_CPU_SSE)
+                const __m128 zero = _mm_setzero_ps();
+                const __m128 one = _mm_set1_ps(1.F);
+                const __m128 scale = _mm_set1_ps(255.F);
+                const __m128 half = _mm_set1_ps(.5F);
+                for (; i + 4 <= count; i += 4)
+                {
+                    __m128i v[4];
+                    for (size_t j = 0; j < 4; ++j)
+                    {
+                        const __m128 f = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + (i + j) * 4), zero), one);
+                        v[j] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(f, scale), half));
+                    }
+                    const __m128i lo = _mm_packs_epi32(v[0], v[1]);
+                    const __m128i hi = _mm_packs_epi32(v[2], v[3]);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4), _mm_packus_epi16(lo, hi));
+                }
+#endif // TLRENDER_CPU_SSE
+                copySpanInt(in + i * 4, out + i * 4, count - i, 4, 255.F);
+                break;
+            }
+            case image::PixelType::L_U8:
+            case image::PixelType::LA_U8:
+            case image::PixelType::RGB_U8:
+                copySpanInt(in, out, count, channelCount, 255.F);
+                break;
+            case image::PixelType::L_U16:
+            case image::PixelType::LA_U16:
+            case image::PixelType::RGB_U16:
+            case image::PixelType::RGBA_U16:
+                copySpanInt(in, reinterpret_cast<uint16_t*>(out), count, channelCount, 65535.F);
+                break;
+            case image::PixelType::L_U32:
+            case image::PixelType::LA_U32:
+            case image::PixelType::RGB_U32:
+            case image::PixelType::RGBA_U32:
+                for (size_t i = 0; i < count; ++i, in += 4)
+                {
+                    uint32_t* p = reinterpret_cast<uint32_t*>(out) + i * channelCount;
+                    for (size_t c = 0; c < channelCount; ++c)
+                    {
+                        const size_t ci = (2 == channelCount && 1 == c) ? 3 : c;
+                        p[c] = static_cast<uint32_t>(math::clamp(in[ci], 0.F, 1.F) * 4294967295.0 + .5);
+                    }
+                }
+                break;
+            case image::PixelType::L_F16:
+            case image::PixelType::LA_F16:
+            case image::PixelType::RGB_F16:
+            case image::PixelType::RGBA_F16:
+                copySpanFloat(in, reinterpret_cast<image::F16_T*>(out), count, channelCount);
+                break;
+            case image::PixelType::L_F32:
+            case image::PixelType::LA_F32:
+            case image::PixelType::RGB_F32:
+            case image::PixelType::RGBA_F32:
+                copySpanFloat(in, reinterpret_cast<float*>(out), count, channelCount);
+                break;
+            case image::PixelType::RGB_U10:
+            {
+                image::U10* p = reinterpret_cast<image::U10*>(out);
+                for (size_t i = 0; i < count; ++i, in += 4, ++p)
+                {
+                    p->r = static_cast<uint32_t>(math::clamp(in[0], 0.F, 1.F) * 1023.F + .5F);
+                    p->g = static_cast<uint32_t>(math::clamp(in[1], 0.F, 1.F) * 1023.F + .5F);
+                    p->b = static_cast<uint32_t>(math::clamp(in[2], 0.F, 1.F) * 1023.F + .5F);
+                    p->pad = 0;
+                }
+                break;
+            }
+            default: break;
+            }
+        }
+
+        ImageData::ImageData(
+            const image::Info& info,
+            const image::Color4f& color,
+            const timeline::ImageOptions& imageOptions) :
+            channelCount(image::getChannelCount(info.pixelType)),
+            videoLevels(info.videoLevels),
+            yuvCoefficients(image::getYUVCoefficients(info.yuvCoefficients)),
+            color(color)
+        {
+            switch (info.pixelType)
+            {
+            case image::PixelType::YUV_420P_U8:
+            case image::PixelType::YUV_422P_U8:
+            case image::PixelType::YUV_444P_U8:
+            case image::PixelType::YUV_420P_U16:
+            case image::PixelType::YUV_422P_U16:
+            case image::PixelType::YUV_444P_U16:
+                yuv = true;
+                break;
+            default: break;
+            }
+            switch (imageOptions.videoLevels)
+            {
+            case timeline::InputVideoLevels::FullRange:
+                videoLevels = image::VideoLevels::FullRange;
+                break;
+            case timeline::InputVideoLevels::LegalRange:
+                videoLevels = image::VideoLevels::LegalRange;
+                break;
+            default: break;
+            }
+        }
+
+        void imageSpan(float* p, size_t count, const ImageData& data)
+        {
+            const math::Vector4f& k = data.yuvCoefficients;
+            const bool legalRange = image::VideoLevels::LegalRange == data.videoLevels;
+            for (size_t i = 0; i < count; ++i, p += 4)
+            {
+                if (data.yuv)
+                {
+                    float y = p[0];
+                    float cb = p[1];
+                    float cr = p[2];
+                    if (legalRange)
+                    {
+                        y = (y - (16.F / 255.F)) * (255.F / (235.F - 16.F));
+                        cb = (cb - (16.F / 255.F)) * (255.F / (240.F - 16.F));
+                        cr = (cr - (16.F / 255.F)) * (255.F / (240.F - 16.F));
+                    }
+                    cb -= .5F;
+                    cr -= .5F;
+                    p[0] = y + (k.x * cr);
+                    p[1] = y - (k.y * cr) - (k.z * cb);
+                    p[2] = y + (k.w * cb);
+                    p[3] = 1.F;
+                }
+                else
+                {
+                    if (legalRange)
+                    {
+                        p[0] = (p[0] - (16.F / 255.F)) * (255.F / (235.F - 16.F));
+                        p[1] = (p[1] - (16.F / 255.F)) * (255.F / (240.F - 16.F));
+                        p[2] = (p[2] - (16.F / 255.F)) * (255.F / (240.F - 16.F));
+                    }
+                    switch (data.channelCount)
+                    {
+                    case 1:
+                        p[1] = p[2] = p[0];
+                        p[3] = 1.F;
+                        break;
+                    case 2:
+                        p[3] = p[1];
+                        p[1] = p[2] = p[0];
+                        break;
+                    case 3:
+                        p[3] = 1.F;
+                        break;
+                    default: break;
+                    }
+                }
+                p[0] *= data.color.r;
+                p[1] *= data.color.g;
+                p[2] *= data.color.b;
+                p[3] *= data.color.a;
+            }
+        }
+
+        namespace
+        {
+            float knee(float x, float f)
+            {
+                return logf(x * f + 1.F) / f;
+            }
+
+            float knee2(float x, float y)
+            {
+                float f0 = 0.F;
+                float f1 = 1.F;
+                while (knee(x, f1) > y)
+                {
+                    f0 = f1;
+                    f1 = f1 * 2.F;
+                }
+                for (size_t i = 0; i < 30; ++i)
+                {
+                    const float f2 = (f0 + f1) / 2.F;
+                    if (knee(x, f2) < y)
+                    {
+                        f1 = f2;
+                    }
+                    else
+                    {
+                        f0 = f2;
+                    }
+                }
+                return (f0 + f1) / 2.F;
+            }
+        }
+
+        DisplayData::DisplayData(const timeline::DisplayOptions& displayOptions) :
+            videoLevels(displayOptions.videoLevels),
+            colorAdd(displayOptions.color.add),
+            levels(displayOptions.levels),
+            softClip(displayOptions.softClip.enabled ? displayOptions.softClip.value : 0.F),
+            channels(displayOptions.channels)
+        {
+            colorEnabled =
+                displayOptions.color != timeline::Color() &&
+                displayOptions.color.enabled;
+            if (colorEnabled)
+            {
+                colorMatrix = timeline::color(displayOptions.color);
+            }
+            colorInvert = displayOptions.color.enabled ? displayOptions.color.invert : false;
+            levelsEnabled = displayOptions.levels.enabled;
+            const float gamma =
+                displayOptions.levels.gamma > 0.F ?
+                (1.F / displayOptions.levels.gamma) :
+                1000000.F;
+            levels.gamma = gamma;
+            exrDisplayEnabled = displayOptions.exrDisplay.enabled;
+            if (exrDisplayEnabled)
+            {
+                const float k = powf(2.F, displayOptions.exrDisplay.kneeLow);
+                exrDisplay[0] = powf(2.F, displayOptions.exrDisplay.exposure + 2.47393F);
+                exrDisplay[1] = displayOptions.exrDisplay.defog;
+                exrDisplay[2] = k;
+                exrDisplay[3] = knee2(
+                    powf(2.F, displayOptions.exrDisplay.kneeHigh) - k,
+                    powf(2.F, 3.5F) - k);
+                exrDisplay[4] = gamma;
+            }
+        }
+
+        void displaySpan(float* p, size_t count, const DisplayData& data)
+        {
+            const float* m = data.colorMatrix.e;
+            const float exrScale = data.exrDisplayEnabled ? powf(2.F, -3.5F * data.exrDisplay[4]) : 1.F;
+            for (size_t i = 0; i < count; ++i, p += 4)
+            {
+                if (image::VideoLevels::LegalRange == data.videoLevels)
+                {
+                    const float scale = (940.F - 64.F) / 1023.F;
+                    const float offset = 64.F / 1023.F;
+                    p[0] = p[0] * scale + offset;
+                    p[1] = p[1] * scale + offset;
+                    p[2] = p[2] * scale + offset;
+                }
+                if (data.colorEnabled)
+                {
+                    // The same as multiplying a row vector by the matrix in
+                    // the OpenGL shader.
+                    const float tmp[4] =
+                    {
+                        p[0] + data.colorAdd.x,
+                        p[1] + data.colorAdd.y,
+                        p[2] + data.colorAdd.z,
+                        1.F
+                    };
+                    for (size_t j = 0; j < 3; ++j)
+                    {
+                        p[j] =
+                            tmp[0] * m[j * 4 + 0] +
+                            tmp[1] * m[j * 4 + 1] +
+                            tmp[2] * m[j * 4 + 2] +
+                            tmp[3] * m[j * 4 + 3];
+                    }
+                }
+                if (data.colorInvert)
+                {
+                    p[0] = 1.F - p[0];
+                    p[1] = 1.F - p[1];
+                    p[2] = 1.F - p[2];
+                }
+                if (data.levelsEnabled)
+                {
+                    for (size_t c = 0; c < 3; ++c)
+                    {
+                        float tmp = (p[c] - data.levels.inLow) / data.levels.inHigh;
+                        if (tmp >= 0.F)
+                        {
+                            tmp = powf(tmp, data.levels.gamma);
+                        }
+                        p[c] = tmp * data.levels.outHigh + data.levels.outLow;
+                    }
+                }
+                if (data.exrDisplayEnabled)
+                {
+                    const float v = data.exrDisplay[0];
+                    const float d = data.exrDisplay[1];
+                    const float k = data.exrDisplay[2];
+                    const float f = data.exrDisplay[3];
+                    const float g = data.exrDisplay[4];
+                    for (size_t c = 0; c < 3; ++c)
+                    {
+                        float tmp = std::max(0.F, p[c] - d) * v;
+                        if (tmp > k)
+                        {
+                            tmp = k + knee(tmp - k, f);
+                        }
+                        if (tmp > 0.F)
+                        {
+                            tmp = powf(tmp, g);
+                        }
+                        p[c] = tmp * exrScale;
+                    }
+                }
+                if (data.softClip > 0.F)
+                {
+                    const float tmp = 1.F - data.softClip;
+                    for (size_t c = 0; c < 3; ++c)
+                    {
+                        if (p[c] > tmp)
+                        {
+                            p[c] = tmp + (1.F - expf(-(p[c] - tmp) / data.softClip)) * data.softClip;
+                        }
+                    }
+                }
+            }
+        }
+
+        void channelsSpan(float* p, size_t count, timeline::Channels channels)
+        {
+            size_t c = 0;
+            switch (channels)
+            {
+            case timeline::Channels::Red:   c = 0; break;
+            case timeline::Channels::Green: c = 1; break;
+            case timeline::Channels::Blue:  c = 2; break;
+            case timeline::Channels::Alpha: c = 3; break;
+            default: return;
+            }
+            for (size_t i = 0; i < count; ++i, p += 4)
+            {
+                p[0] = p[1] = p[2] = p[c];
+            }
+        }
+    }
+}
@@ -0,0 +1,280 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineCPU/RenderPrivate.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace tl
+{
+    namespace timeline_cpu
+    {
+        namespace
+        {
+            void getTriangles(
+                const geom::TriangleMesh2& mesh,
+                const math::Vector2i& position,
+                bool colors,
+                std::vector<math::Vector2f>& v,
+                std::vector<math::Vector4f>& c)
+            {
+                v.reserve(mesh.triangles.size() * 3);
+                if (colors)
+                {
+                    c.reserve(mesh.triangles.size() * 3);
+                }
+                for (const auto& triangle : mesh.triangles)
+                {
+                    for (const auto& vertex : triangle.v)
+                    {
+                        v.push_back(vertex.v ?
+                            math::Vector2f(
+                                mesh.v[vertex.v - 1].x + position.x,
+                                mesh.v[vertex.v - 1].y + position.y) :
+                            math::Vector2f());
+                        if (colors)
+                        {
+                            c.push_back(vertex.c ?
+                                mesh.c[vertex.c - 1] :
+                                math::Vector4f(1.F, 1.F, 1.F, 1.F));
+                        }
+                    }
+                }
+            }
+        }
+
+        std::shared_ptr<image::Image> Render::Private::getTexture(
+            const std::shared_ptr<image::Image>& image,
+            bool cache)
+        {
+            std::shared_ptr<image::Image> out;
+            if (!cache || !imageCache->get(image, out))
+            {
+                const auto& info = image->getInfo();
+                out = image::Image::create(info.size.w, info.size.h, image::PixelType::RGBA_F32);
+                parallel(
+                    math::Box2i(0, 0, info.size.w, info.size.h),
+                    [&image, &out](int y0, int y1)
+                    {
+                        copyTexture(*image, *out, y0, y1);
+                    });
+                if (cache)
+                {
+                    imageCache->add(image, out, out->getDataByteCount());
+                }
+            }
+            return out;
+        }
+
+        void Render::drawRect(
+            const math::Box2i& box,
+            const image::Color4f& color)
+        {
+            TLRENDER_P();
+            ++(p.currentStats.rects);
+            p.fillBox(
+                math::Vector2f(box.min.x, box.min.y),
+                math::Vector2f(box.max.x + 1, box.max.y + 1),
+                p.transform,
+                Blend(BlendFactor::SrcAlpha, BlendFactor::OneMinusSrcAlpha),
+                [&color](float, float, float, float, size_t count, float* out)
+                {
+                    for (size_t i = 0; i < count; ++i, out += 4)
+                    {
+                        out[0] = color.r;
+                        out[1] = color.g;
+                        out[2] = color.b;
+                        out[3] = color.a;
+                    }
+                });
+        }
+
+        void Render::drawMesh(
+            const geom::TriangleMesh2& mesh,
+            const math::Vector2i& position,
+            const image::Color4f& color)
+        {
+            TLRENDER_P();
+            ++(p.currentStats.meshes);
+            p.currentStats.meshTriangles += mesh.triangles.size();
+            if (!mesh.triangles.empty())
+            {
+                std::vector<math::Vector2f> v;
+                std::vector<math::Vector4f> c;
+                getTriangles(mesh, position, false, v, c);
+                p.fillTriangles(
+                    v,
+                    c,
+                    color,
+                    Blend(BlendFactor::SrcAlpha, BlendFactor::OneMinusSrcAlpha));
+            }
+        }
+
+        void Render::drawColorMesh(
+            const geom::TriangleMesh2& mesh,
+            const math::Vector2i& position,
+            const image::Color4f& color)
+        {
+            TLRENDER_P();
+            ++(p.currentStats.meshes);
+            p.currentStats.meshTriangles += mesh.triangles.size();
+            if (!mesh.triangles.empty())
+            {
+                std::vector<math::Vector2f> v;
+                std::vector<math::Vector4f> c;
+                getTriangles(mesh, position, true, v, c);
+                p.fillTriangles(
+                    v,
+                    c,
+                    color,
+                    Blend(BlendFactor::SrcAlpha, BlendFactor::OneMinusSrcAlpha));
+            }
+        }
+
+        void Render::drawText(
+            const std::vector<std::shared_ptr<image::Glyph> >& glyphs,
+            const math::Vector2i& pos,
+            const image::Color4f& color)
+        {
+            TLRENDER_P();
+            ++(p.currentStats.text);
+
+            int x = 0;
+            int32_t rsbDeltaPrev = 0;
+            for (const auto& glyph : glyphs)
+            {
+                if (glyph)
+                {
+                    if (rsbDeltaPrev - glyph->lsbDelta > 32)
+                    {
+                        x -= 1;
+                    }
+                    else if (rsbDeltaPrev - glyph->lsbDelta < -31)
+                    {
+                        x += 1;
+                    }
+                    rsbDeltaPrev = glyph->rsbDelta;
+
+                    if (glyph->image && glyph->image->isValid())
+                    {
+                        const math::Vector2i& offset = glyph->offset;
+                        const int w = glyph->image->getWidth();
+                        const int h = glyph->image->getHeight();
+                        const math::Box2i box(
+                            pos.x + x + offset.x,
+                            pos.y - offset.y,
+                            w,
+                            h);
+                        const size_t rowByteCount = glyph->image->getDataByteCount() / h;
+                        const uint8_t* data = glyph->image->getData();
+                        p.fillBox(
+                            math::Vector2f(box.min.x, box.min.y),
+                            math::Vector2f(box.max.x + 1, box.max.y + 1),
+                            p.transform,
+                            Blend(BlendFactor::SrcAlpha, BlendFactor::OneMinusSrcAlpha),
+                            [&color, w, h, rowByteCount, data](
+                                float u, float v, float du, float dv, size_t count, float* out)
+                            {
+                                for (size_t i = 0; i < count; ++i, u += du, v += dv, out += 4)
+                                {
+                                    const int tx = math::clamp(static_cast<int>(u * w), 0, w - 1);
+                                    const int ty = math::clamp(static_cast<int>(v * h), 0, h - 1);
+                                    out[0] = color.r;
+                                    out[1] = color.g;
+                                    out[2] = color.b;
+                                    out[3] = color.a * data[ty * rowByteCount + tx] / 255.F;
+                                }
+                            });
+                    }
+
+                    x += glyph->advance;
+                }
+            }
+        }
+
+        void Render::drawTexture(
+            unsigned int,
+            const math::Box2i&,
+            const image::Color4f&)
+        {
+            // OpenGL textures cannot be drawn by the software renderer.
+            TLRENDER_P();
+            ++(p.currentStats.textures);
+        }
+
+        void Render::drawImage(
+            const std::shared_ptr<image::Image>& image,
+            const math::Box2i& box,
+            const image::Color4f& color,
+            const timeline::ImageOptions& imageOptions)
+        {
+            TLRENDER_P();
+            ++(p.currentStats.images);
+
+            const auto& info = image->getInfo();
+            const auto texture = p.getTexture(image, imageOptions.cache);
+            const ImageData imageData(info, color, imageOptions);
+
+            Blend blend;
+            switch (imageOptions.alphaBlend)
+            {
+            case timeline::AlphaBlend::None:
+                blend = Blend(
+                    BlendFactor::One,
+                    BlendFactor::Zero,
+                    BlendFactor::One,
+                    BlendFactor::Zero);
+                break;
+            case timeline::AlphaBlend::Straight:
+                blend = Blend(
+                    BlendFactor::SrcAlpha,
+                    BlendFactor::OneMinusSrcAlpha,
+                    BlendFactor::One,
+                    BlendFactor::OneMinusSrcAlpha);
+                break;
+            case timeline::AlphaBlend::Premultiplied:
+                blend = Blend(
+                    BlendFactor::One,
+                    BlendFactor::OneMinusSrcAlpha,
+                    BlendFactor::One,
+                    BlendFactor::OneMinusSrcAlpha);
+                break;
+            default: break;
+            }
+
+            const bool mirrorX = info.layout.mirror.x;
+            const bool mirrorY = info.layout.mirror.y;
+            const int textureWidth = texture->getWidth();
+            const int textureHeight = texture->getHeight();
+            const timeline::ImageFilters& filters = imageOptions.imageFilters;
+            p.fillBox(
+                math::Vector2f(box.min.x, box.min.y),
+                math::Vector2f(box.max.x + 1, box.max.y + 1),
+                p.transform,
+                blend,
+                [&texture, &imageData, &filters, mirrorX, mirrorY, textureWidth, textureHeight](
+                    float u, float v, float du, float dv, size_t count, float* out)
+                {
+                    // The image data starts at the bottom unless it is
+                    // mirrored, the same as the OpenGL texture.
+                    const float tu = mirrorX ? (1.F - u) : u;
+                    const float tv = mirrorY ? v : (1.F - v);
+                    const float tdu = mirrorX ? -du : du;
+                    const float tdv = mirrorY ? dv : -dv;
+                    const float texels = std::hypot(tdu * textureWidth, tdv * textureHeight);
+                    sampleSpan(
+                        *texture,
+                        texels > 1.F ? filters.minify : filters.magnify,
+                        tu,
+                        tv,
+                        tdu,
+                        tdv,
+                        count,
+                        out);
+                    imageSpan(out, count, imageData);
+                });
+        }
+    }
+}
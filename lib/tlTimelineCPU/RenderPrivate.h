@@ -0,0 +1,277 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTimelineCPU/Render.h>
+
+#if defined(TLRENDER_OCIO)
+#include <OpenColorIO/OpenColorIO.h>
+#endif // TLRENDER_OCIO
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#if defined(TLRENDER_OCIO)
+namespace OCIO = OCIO_NAMESPACE;
+#endif // TLRENDER_OCIO
+
+namespace tl
+{
+    namespace timeline_cpu
+    {
+        //! \name Pixel Kernels
+        //!
+        //! The kernels operate on spans of RGBA F32 pixels. They use SSE
+        //! when it is available, with one pixel per register.
+        ///@{
+
+        //! Blending factors.
+        enum class BlendFactor
+        {
+            Zero,
+            One,
+            SrcAlpha,
+            OneMinusSrcAlpha
+        };
+
+        //! Blending function, the same as glBlendFuncSeparate().
+        struct Blend
+        {
+            Blend() = default;
+            Blend(BlendFactor src, BlendFactor dst);
+            Blend(
+                BlendFactor srcRGB,
+                BlendFactor dstRGB,
+                BlendFactor srcAlpha,
+                BlendFactor dstAlpha);
+
+            BlendFactor srcRGB   = BlendFactor::SrcAlpha;
+            BlendFactor dstRGB   = BlendFactor::OneMinusSrcAlpha;
+            BlendFactor srcAlpha = BlendFactor::SrcAlpha;
+            BlendFactor dstAlpha = BlendFactor::OneMinusSrcAlpha;
+        };
+
+        //! Convert the given rows of an image to an RGBA F32 texture. The
+        //! channels are normalized and stored the same as an OpenGL texture,
+        //! YUV images are stored as Y, Cb, Cr with the chroma planes
+        //! upsampled.
+        void copyTexture(
+            const image::Image& in,
+            image::Image&       out,
+            int                 y0,
+            int                 y1);
+
+        //! Sample a span of pixels from an RGBA F32 texture. The texture
+        //! coordinates are clamped to the edge.
+        void sampleSpan(
+            const image::Image&    texture,
+            timeline::ImageFilter,
+            float                  u,
+            float                  v,
+            float                  du,
+            float                  dv,
+            size_t                 count,
+            float*                 out);
+
+        //! Blend a span of pixels onto the destination. The mask is
+        //! optional, and pixels with a zero mask value are not drawn.
+        void blendSpan(
+            const float*   in,
+            float*         out,
+            size_t         count,
+            const Blend&,
+            const uint8_t* mask,
+            bool           clamp);
+
+        //! Copy a span of pixels to the given pixel type.
+        void copySpan(
+            const float*     in,
+            uint8_t*         out,
+            size_t           count,
+            image::PixelType);
+
+        //! Image shading data.
+        struct ImageData
+        {
+            ImageData(
+                const image::Info&,
+                const image::Color4f&,
+                const timeline::ImageOptions&);
+
+            int                channelCount = 0;
+            bool               yuv          = false;
+            image::VideoLevels videoLevels  = image::VideoLevels::FullRange;
+            math::Vector4f     yuvCoefficients;
+            image::Color4f     color;
+        };
+
+        //! Apply the image shading to a span of sampled pixels. This is the
+        //! same as sampleTexture() in the OpenGL image shader.
+        void imageSpan(float*, size_t count, const ImageData&);
+
+        //! Display shading data.
+        struct DisplayData
+        {
+            DisplayData(const timeline::DisplayOptions&);
+
+            image::VideoLevels videoLevels       = image::VideoLevels::FullRange;
+            bool               colorEnabled      = false;
+            math::Vector3f     colorAdd;
+            math::Matrix4x4f   colorMatrix;
+            bool               colorInvert       = false;
+            bool               levelsEnabled     = false;
+            timeline::Levels   levels;
+            bool               exrDisplayEnabled = false;
+            float              exrDisplay[5]     = { 0.F, 0.F, 0.F, 0.F, 0.F };
+            float              softClip          = 0.F;
+            timeline::Channels channels          = timeline::Channels::Color;
+        };
+
+        //! Apply the display color transformations to a span of pixels.
+        void displaySpan(float*, size_t count, const DisplayData&);
+
+        //! Apply the display channels swizzle to a span of pixels.
+        void channelsSpan(float*, size_t count, timeline::Channels);
+
+        ///@}
+
+        //! Box shading function. The arguments are the box coordinates of
+        //! the first pixel, the increments per pixel, the number of pixels,
+        //! and the output span.
+        typedef std::function<void(float u, float v, float du, float dv, size_t, float*)> BoxShader;
+
+        struct Render::Private
+        {
+            math::Size2i renderSize;
+            timeline::OCIOOptions ocioOptions;
+            timeline::LUTOptions lutOptions;
+            timeline::RenderOptions renderOptions;
+
+#if defined(TLRENDER_OCIO)
+            OCIO::ConstCPUProcessorRcPtr ocioProcessor;
+            OCIO::ConstCPUProcessorRcPtr lutProcessor;
+#endif // TLRENDER_OCIO
+
+            math::Box2i viewport;
+            math::Matrix4x4f transform;
+            bool clipRectEnabled = false;
+            math::Box2i clipRect;
+
+            std::shared_ptr<image::Image> frameBuffer;
+            std::shared_ptr<image::Image> target;
+            std::vector<uint8_t> mask;
+            bool maskEnabled = false;
+            std::map<std::string, std::shared_ptr<image::Image> > buffers;
+            std::shared_ptr<ImageCache> imageCache;
+
+            struct Threads
+            {
+                std::vector<std::thread> threads;
+                std::function<void(int, int)> func;
+                int y = 0;
+                int tileCount = 0;
+                int tileHeight = 0;
+                int h = 0;
+                std::atomic<int> tile;
+                size_t generation = 0;
+                size_t active = 0;
+                bool stop = false;
+                std::mutex mutex;
+                std::condition_variable cv;
+                std::condition_variable doneCV;
+            };
+            Threads threads;
+
+            std::chrono::steady_clock::time_point timer;
+            struct Stats
+            {
+                int time = 0;
+                size_t rects = 0;
+                size_t meshes = 0;
+                size_t meshTriangles = 0;
+                size_t text = 0;
+                size_t textures = 0;
+                size_t images = 0;
+                size_t pixels = 0;
+            };
+            Stats currentStats;
+            std::list<Stats> stats;
+            std::chrono::steady_clock::time_point logTimer;
+
+            //! Get a buffer, creating it if necessary.
+            std::shared_ptr<image::Image> getBuffer(
+                const std::string&,
+                const math::Size2i&);
+
+            //! Get the texture for an image, converting it if necessary.
+            std::shared_ptr<image::Image> getTexture(
+                const std::shared_ptr<image::Image>&,
+                bool cache);
+
+            //! Get the bounds of the current target that can be drawn into.
+            math::Box2i getBounds() const;
+
+            //! Transform a point to pixel coordinates.
+            math::Vector2f toPixel(
+                const math::Matrix4x4f&,
+                const math::Vector2f&) const;
+
+            //! Run a function over the rows in parallel.
+            void parallel(
+                const math::Box2i&,
+                const std::function<void(int, int)>&);
+            void threadsRun();
+
+            //! Fill a box, with the box coordinates from (0, 0) at the
+            //! top left to (1, 1) at the bottom right.
+            void fillBox(
+                const math::Vector2f& min,
+                const math::Vector2f& max,
+                const math::Matrix4x4f&,
+                const Blend&,
+                const BoxShader&);
+
+            //! Fill triangles. The colors are optional.
+            void fillTriangles(
+                const std::vector<math::Vector2f>& v,
+                const std::vector<math::Vector4f>& c,
+                const image::Color4f&,
+                const Blend&);
+
+            //! Draw a buffer, with the first row at the top of the box.
+            void drawBuffer(
+                const std::shared_ptr<image::Image>&,
+                const math::Box2i&,
+                const timeline::ImageFilters&,
+                const image::Mirror&,
+                const Blend&,
+                const std::function<void(float*, size_t)>& = nullptr);
+
+            //! Apply the color management to a span of pixels.
+            void colorSpan(float*, size_t count) const;
+
+            //! Drawing state.
+            struct State
+            {
+                std::shared_ptr<image::Image> target;
+                math::Box2i viewport;
+                math::Matrix4x4f transform;
+                bool clipRectEnabled = false;
+                bool maskEnabled = false;
+            };
+            State getState() const;
+            void setState(const State&);
+
+            //! Set the drawing state to the given buffer, which is cleared.
+            void setBuffer(const std::shared_ptr<image::Image>&);
+        };
+    }
+}
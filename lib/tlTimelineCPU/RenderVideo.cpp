@@ -0,0 +1,615 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineCPU/RenderPrivate.h>
+
+#include <tlCore/Math.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace tl
+{
+    namespace timeline_cpu
+    {
+        Render::Private::State Render::Private::getState() const
+        {
+            State out;
+            out.target = target;
+            out.viewport = viewport;
+            out.transform = transform;
+            out.clipRectEnabled = clipRectEnabled;
+            out.maskEnabled = maskEnabled;
+            return out;
+        }
+
+        void Render::Private::setState(const State& value)
+        {
+            target = value.target;
+            viewport = value.viewport;
+            transform = value.transform;
+            clipRectEnabled = value.clipRectEnabled;
+            maskEnabled = value.maskEnabled;
+        }
+
+        void Render::Private::setBuffer(const std::shared_ptr<image::Image>& value)
+        {
+            value->zero();
+            target = value;
+            viewport = math::Box2i(0, 0, value->getWidth(), value->getHeight());
+            transform = math::ortho(
+                0.F,
+                static_cast<float>(value->getWidth()),
+                static_cast<float>(value->getHeight()),
+                0.F,
+                -1.F,
+                1.F);
+            clipRectEnabled = false;
+            maskEnabled = false;
+        }
+
+        void Render::Private::drawBuffer(
+            const std::shared_ptr<image::Image>& buffer,
+            const math::Box2i& box,
+            const timeline::ImageFilters& filters,
+            const image::Mirror& mirror,
+            const Blend& blend,
+            const std::function<void(float*, size_t)>& shade)
+        {
+            const int bufferWidth = buffer->getWidth();
+            const int bufferHeight = buffer->getHeight();
+            fillBox(
+                math::Vector2f(box.min.x, box.min.y),
+                math::Vector2f(box.max.x + 1, box.max.y + 1),
+                transform,
+                blend,
+                [&buffer, &filters, &mirror, &shade, bufferWidth, bufferHeight](
+                    float u, float v, float du, float dv, size_t count, float* out)
+                {
+                    const float tu = mirror.x ? (1.F - u) : u;
+                    const float tv = mirror.y ? (1.F - v) : v;
+                    const float tdu = mirror.x ? -du : du;
+                    const float tdv = mirror.y ? -dv : dv;
+                    const float texels = std::hypot(tdu * bufferWidth, tdv * bufferHeight);
+                    sampleSpan(
+                        *buffer,
+                        texels > 1.F ? filters.minify : filters.magnify,
+                        tu,
+                        tv,
+                        tdu,
+                        tdv,
+                        count,
+                        out);
+                    if (shade)
+                    {
+                        shade(out, count);
+                    }
+                });
+        }
+
+        void Render::drawVideo(
+            const std::vector<timeline::VideoData>& videoData,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<timeline::ImageOptions>& imageOptions,
+            const std::vector<timeline::DisplayOptions>& displayOptions,
+            const timeline::CompareOptions& compareOptions,
+            const timeline::BackgroundOptions& backgroundOptions)
+        {
+            //! \todo Render the background only if there is valid video data and a
+            //! valid layer?
+            if (!videoData.empty() && !videoData.front().layers.empty())
+            {
+                _drawBackground(boxes, backgroundOptions);
+            }
+            switch (compareOptions.mode)
+            {
+            case timeline::CompareMode::A:
+                _drawVideoA(
+                    videoData,
+                    boxes,
+                    imageOptions,
+                    displayOptions,
+                    compareOptions);
+                break;
+            case timeline::CompareMode::B:
+                _drawVideoB(
+                    videoData,
+                    boxes,
+                    imageOptions,
+                    displayOptions,
+                    compareOptions);
+                break;
+            case timeline::CompareMode::Wipe:
+                _drawVideoWipe(
+                    videoData,
+                    boxes,
+                    imageOptions,
+                    displayOptions,
+                    compareOptions);
+                break;
+            case timeline::CompareMode::Overlay:
+                _drawVideoOverlay(
+                    videoData,
+                    boxes,
+                    imageOptions,
+                    displayOptions,
+                    compareOptions);
+                break;
+            case timeline::CompareMode::Difference:
+                if (videoData.size() > 1)
+                {
+                    _drawVideoDifference(
+                        videoData,
+                        boxes,
+                        imageOptions,
+                        displayOptions,
+                        compareOptions);
+                }
+                else
+                {
+                    _drawVideoA(
+                        videoData,
+                        boxes,
+                        imageOptions,
+                        displayOptions,
+                        compareOptions);
+                }
+                break;
+            case timeline::CompareMode::Horizontal:
+            case timeline::CompareMode::Vertical:
+            case timeline::CompareMode::Tile:
+                _drawVideoTile(
+                    videoData,
+                    boxes,
+                    imageOptions,
+                    displayOptions,
+                    compareOptions);
+                break;
+            default: break;
+            }
+        }
+
+        void Render::_drawBackground(
+            const std::vector<math::Box2i>& boxes,
+            const timeline::BackgroundOptions& options)
+        {
+            for (const auto& box : boxes)
+            {
+                switch (options.type)
+                {
+                case timeline::Background::Solid:
+                    drawRect(box, options.color0);
+                    break;
+                case timeline::Background::Checkers:
+                    drawColorMesh(
+                        geom::checkers(box, options.color0, options.color1, options.checkersSize),
+                        math::Vector2i(),
+                        image::Color4f(1.F, 1.F, 1.F));
+                    break;
+                case timeline::Background::Gradient:
+                {
+                    geom::TriangleMesh2 mesh;
+                    mesh.v.push_back(math::Vector2f(box.min.x, box.min.y));
+                    mesh.v.push_back(math::Vector2f(box.max.x, box.min.y));
+                    mesh.v.push_back(math::Vector2f(box.max.x, box.max.y));
+                    mesh.v.push_back(math::Vector2f(box.min.x, box.max.y));
+                    mesh.c.push_back(math::Vector4f(
+                        options.color0.r,
+                        options.color0.g,
+                        options.color0.b,
+                        options.color0.a));
+                    mesh.c.push_back(math::Vector4f(
+                        options.color1.r,
+                        options.color1.g,
+                        options.color1.b,
+                        options.color1.a));
+                    mesh.triangles.push_back({
+                        geom::Vertex2(1, 0, 1),
+                        geom::Vertex2(2, 0, 1),
+                        geom::Vertex2(3, 0, 2), });
+                    mesh.triangles.push_back({
+                        geom::Vertex2(3, 0, 2),
+                        geom::Vertex2(4, 0, 2),
+                        geom::Vertex2(1, 0, 1), });
+                    drawColorMesh(
+                        mesh,
+                        math::Vector2i(),
+                        image::Color4f(1.F, 1.F, 1.F));
+                    break;
+                }
+                default: break;
+                }
+            }
+        }
+
+        void Render::_drawVideoA(
+            const std::vector<timeline::VideoData>& videoData,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<timeline::ImageOptions>& imageOptions,
+            const std::vector<timeline::DisplayOptions>& displayOptions,
+            const timeline::CompareOptions& compareOptions)
+        {
+            if (!videoData.empty() && !boxes.empty())
+            {
+                _drawVideo(
+                    videoData[0],
+                    boxes[0],
+                    !imageOptions.empty() ? std::make_shared<timeline::ImageOptions>(imageOptions[0]) : nullptr,
+                    !displayOptions.empty() ? displayOptions[0] : timeline::DisplayOptions());
+            }
+        }
+
+        void Render::_drawVideoB(
+            const std::vector<timeline::VideoData>& videoData,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<timeline::ImageOptions>& imageOptions,
+            const std::vector<timeline::DisplayOptions>& displayOptions,
+            const timeline::CompareOptions& compareOptions)
+        {
+            if (videoData.size() > 1 && boxes.size() > 1)
+            {
+                _drawVideo(
+                    videoData[1],
+                    boxes[1],
+                    imageOptions.size() > 1 ? std::make_shared<timeline::ImageOptions>(imageOptions[1]) : nullptr,
+                    displayOptions.size() > 1 ? displayOptions[1] : timeline::DisplayOptions());
+            }
+        }
+
+        void Render::_drawVideoWipe(
+            const std::vector<timeline::VideoData>& videoData,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<timeline::ImageOptions>& imageOptions,
+            const std::vector<timeline::DisplayOptions>& displayOptions,
+            const timeline::CompareOptions& compareOptions)
+        {
+            TLRENDER_P();
+
+            float radius = 0.F;
+            float x = 0.F;
+            float y = 0.F;
+            if (!boxes.empty())
+            {
+                radius = std::max(boxes[0].w(), boxes[0].h()) * 2.5F;
+                x = boxes[0].w() * compareOptions.wipeCenter.x;
+                y = boxes[0].h() * compareOptions.wipeCenter.y;
+            }
+            const float rotation = compareOptions.wipeRotation;
+            math::Vector2f pts[4];
+            for (size_t i = 0; i < 4; ++i)
+            {
+                float rad = math::deg2rad(rotation + 90.F * i + 90.F);
+                pts[i].x = cos(rad) * radius + x;
+                pts[i].y = sin(rad) * radius + y;
+            }
+
+            // The mask replaces the OpenGL stencil buffer.
+            if (!p.target)
+                return;
+            const int targetWidth = p.target->getWidth();
+            const int targetHeight = p.target->getHeight();
+            p.mask.resize(targetWidth * targetHeight);
+            const math::Box2i bounds = p.getBounds();
+            auto fillMask = [&p, &bounds, targetWidth](const math::Vector2f& a, const math::Vector2f& b, const math::Vector2f& c)
+            {
+                std::fill(p.mask.begin(), p.mask.end(), 0);
+                const math::Vector2f v[3] =
+                {
+                    p.toPixel(p.transform, a),
+                    p.toPixel(p.transform, b),
+                    p.toPixel(p.transform, c)
+                };
+                const float area =
+                    (v[1].x - v[0].x) * (v[2].y - v[0].y) -
+                    (v[1].y - v[0].y) * (v[2].x - v[0].x);
+                const float sign = area < 0.F ? -1.F : 1.F;
+                p.parallel(
+                    bounds,
+                    [&p, &bounds, &v, sign, targetWidth](int y0, int y1)
+                    {
+                        for (int y = y0; y <= y1; ++y)
+                        {
+                            uint8_t* maskP = p.mask.data() + y * targetWidth;
+                            const float py = y + .5F;
+                            for (int x = bounds.min.x; x <= bounds.max.x; ++x)
+                            {
+                                const float px = x + .5F;
+                                bool inside = true;
+                                for (size_t i = 0; i < 3 && inside; ++i)
+                                {
+                                    const math::Vector2f& e0 = v[i];
+                                    const math::Vector2f& e1 = v[(i + 1) % 3];
+                                    inside = sign * (
+                                        (e1.x - e0.x) * (py - e0.y) -
+                                        (e1.y - e0.y) * (px - e0.x)) >= 0.F;
+                                }
+                                maskP[x] = inside ? 1 : 0;
+                            }
+                        }
+                    });
+            };
+
+            const bool maskEnabled = p.maskEnabled;
+            fillMask(pts[0], pts[1], pts[2]);
+            p.maskEnabled = true;
+            if (!videoData.empty() && !boxes.empty())
+            {
+                _drawVideo(
+                    videoData[0],
+                    boxes[0],
+                    !imageOptions.empty() ? std::make_shared<timeline::ImageOptions>(imageOptions[0]) : nullptr,
+                    !displayOptions.empty() ? displayOptions[0] : timeline::DisplayOptions());
+            }
+
+            fillMask(pts[2], pts[3], pts[0]);
+            if (videoData.size() > 1 && boxes.size() > 1)
+            {
+                _drawVideo(
+                    videoData[1],
+                    boxes[1],
+                    imageOptions.size() > 1 ? std::make_shared<timeline::ImageOptions>(imageOptions[1]) : nullptr,
+                    displayOptions.size() > 1 ? displayOptions[1] : timeline::DisplayOptions());
+            }
+            p.maskEnabled = maskEnabled;
+        }
+
+        void Render::_drawVideoOverlay(
+            const std::vector<timeline::VideoData>& videoData,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<timeline::ImageOptions>& imageOptions,
+            const std::vector<timeline::DisplayOptions>& displayOptions,
+            const timeline::CompareOptions& compareOptions)
+        {
+            TLRENDER_P();
+
+            if (videoData.size() > 1 && boxes.size() > 1)
+            {
+                _drawVideo(
+                    videoData[1],
+                    boxes[1],
+                    imageOptions.size() > 1 ? std::make_shared<timeline::ImageOptions>(imageOptions[1]) : nullptr,
+                    displayOptions.size() > 1 ? displayOptions[1] : timeline::DisplayOptions());
+            }
+            if (!videoData.empty() && !boxes.empty())
+            {
+                _drawVideoOffscreen(
+                    "overlay",
+                    videoData[0],
+                    boxes[0].getSize(),
+                    !imageOptions.empty() ? std::make_shared<timeline::ImageOptions>(imageOptions[0]) : nullptr,
+                    !displayOptions.empty() ? displayOptions[0] : timeline::DisplayOptions());
+
+                const float overlay = compareOptions.overlay;
+                p.drawBuffer(
+                    p.buffers["overlay"],
+                    boxes[0],
+                    !displayOptions.empty() ? displayOptions[0].imageFilters : timeline::ImageFilters(),
+                    image::Mirror(),
+                    Blend(
+                        BlendFactor::SrcAlpha,
+                        BlendFactor::OneMinusSrcAlpha,
+                        BlendFactor::One,
+                        BlendFactor::One),
+                    [overlay](float* p, size_t count)
+                    {
+                        for (size_t i = 0; i < count; ++i, p += 4)
+                        {
+                            p[3] *= overlay;
+                        }
+                    });
+            }
+        }
+
+        void Render::_drawVideoDifference(
+            const std::vector<timeline::VideoData>& videoData,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<timeline::ImageOptions>& imageOptions,
+            const std::vector<timeline::DisplayOptions>& displayOptions,
+            const timeline::CompareOptions& compareOptions)
+        {
+            TLRENDER_P();
+            if (videoData.size() > 1 && !boxes.empty())
+            {
+                const math::Size2i size = boxes[0].getSize();
+                _drawVideoOffscreen(
+                    "difference0",
+                    videoData[0],
+                    size,
+                    !imageOptions.empty() ? std::make_shared<timeline::ImageOptions>(imageOptions[0]) : nullptr,
+                    !displayOptions.empty() ? displayOptions[0] : timeline::DisplayOptions());
+                _drawVideoOffscreen(
+                    "difference1",
+                    videoData[1],
+                    size,
+                    imageOptions.size() > 1 ? std::make_shared<timeline::ImageOptions>(imageOptions[1]) : nullptr,
+                    displayOptions.size() > 1 ? displayOptions[1] : timeline::DisplayOptions());
+
+                // Combine the buffers, the same as the OpenGL difference
+                // shader.
+                const auto& buffer0 = p.buffers["difference0"];
+                const auto& buffer1 = p.buffers["difference1"];
+                auto difference = p.getBuffer("difference", size);
+                float* differenceData = reinterpret_cast<float*>(difference->getData());
+                const float* data0 = reinterpret_cast<const float*>(buffer0->getData());
+                const float* data1 = reinterpret_cast<const float*>(buffer1->getData());
+                p.parallel(
+                    math::Box2i(0, 0, size.w, size.h),
+                    [size, differenceData, data0, data1](int y0, int y1)
+                    {
+                        const size_t offset = y0 * size.w * 4;
+                        const size_t count = (y1 - y0 + 1) * size.w;
+                        float* out = differenceData + offset;
+                        const float* in0 = data0 + offset;
+                        const float* in1 = data1 + offset;
+                        for (size_t i = 0; i < count; ++i, out += 4, in0 += 4, in1 += 4)
+                        {
+                            out[0] = std::abs(in0[0] - in1[0]);
+                            out[1] = std::abs(in0[1] - in1[1]);
+                            out[2] = std::abs(in0[2] - in1[2]);
+                            out[3] = std::max(in0[3], in1[3]);
+                        }
+                    });
+
+                p.drawBuffer(
+                    difference,
+                    boxes[0],
+                    !displayOptions.empty() ? displayOptions[0].imageFilters : timeline::ImageFilters(),
+                    image::Mirror(),
+                    Blend(
+                        BlendFactor::One,
+                        BlendFactor::OneMinusSrcAlpha,
+                        BlendFactor::One,
+                        BlendFactor::One));
+            }
+        }
+
+        void Render::_drawVideoTile(
+            const std::vector<timeline::VideoData>& videoData,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<timeline::ImageOptions>& imageOptions,
+            const std::vector<timeline::DisplayOptions>& displayOptions,
+            const timeline::CompareOptions& compareOptions)
+        {
+            for (size_t i = 0; i < videoData.size() && i < boxes.size(); ++i)
+            {
+                _drawVideo(
+                    videoData[i],
+                    boxes[i],
+                    i < imageOptions.size() ? std::make_shared<timeline::ImageOptions>(imageOptions[i]) : nullptr,
+                    i < displayOptions.size() ? displayOptions[i] : timeline::DisplayOptions());
+            }
+        }
+
+        void Render::_drawVideo(
+            const timeline::VideoData& videoData,
+            const math::Box2i& box,
+            const std::shared_ptr<timeline::ImageOptions>& imageOptions,
+            const timeline::DisplayOptions& displayOptions)
+        {
+            TLRENDER_P();
+
+            const math::Size2i size = box.getSize();
+            const math::Box2i bufferBox(0, 0, size.w, size.h);
+            const Blend dissolveBlend(
+                BlendFactor::One,
+                BlendFactor::OneMinusSrcAlpha,
+                BlendFactor::One,
+                BlendFactor::One);
+            const auto state = p.getState();
+            auto video = p.getBuffer("video", size);
+            p.setBuffer(video);
+            for (const auto& layer : videoData.layers)
+            {
+                switch (layer.transition)
+                {
+                case timeline::Transition::Dissolve:
+                {
+                    if (layer.image && layer.imageB)
+                    {
+                        auto dissolve = p.getBuffer("dissolve", size);
+                        auto dissolve2 = p.getBuffer("dissolve2", size);
+                        {
+                            p.setBuffer(dissolve);
+                            auto dissolveImageOptions = imageOptions.get() ? *imageOptions : layer.imageOptions;
+                            dissolveImageOptions.alphaBlend = timeline::AlphaBlend::Straight;
+                            drawImage(
+                                layer.image,
+                                image::getDataBox(*layer.image, bufferBox),
+                                image::Color4f(1.F, 1.F, 1.F, 1.F - layer.transitionValue),
+                                dissolveImageOptions);
+                        }
+                        {
+                            p.setBuffer(dissolve2);
+                            auto dissolveImageOptions = imageOptions.get() ? *imageOptions : layer.imageOptionsB;
+                            dissolveImageOptions.alphaBlend = timeline::AlphaBlend::Straight;
+                            drawImage(
+                                layer.imageB,
+                                image::getDataBox(*layer.imageB, bufferBox),
+                                image::Color4f(1.F, 1.F, 1.F, layer.transitionValue),
+                                dissolveImageOptions);
+                        }
+                        p.target = video;
+                        p.drawBuffer(
+                            dissolve,
+                            bufferBox,
+                            displayOptions.imageFilters,
+                            image::Mirror(),
+                            dissolveBlend);
+                        p.drawBuffer(
+                            dissolve2,
+                            bufferBox,
+                            displayOptions.imageFilters,
+                            image::Mirror(),
+                            dissolveBlend);
+                    }
+                    else if (layer.image)
+                    {
+                        drawImage(
+                            layer.image,
+                            image::getDataBox(*layer.image, bufferBox),
+                            image::Color4f(1.F, 1.F, 1.F, 1.F - layer.transitionValue),
+                            imageOptions.get() ? *imageOptions : layer.imageOptions);
+                    }
+                    else if (layer.imageB)
+                    {
+                        drawImage(
+                            layer.imageB,
+                            image::getDataBox(*layer.imageB, bufferBox),
+                            image::Color4f(1.F, 1.F, 1.F, layer.transitionValue),
+                            imageOptions.get() ? *imageOptions : layer.imageOptionsB);
+                    }
+                    break;
+                }
+                default:
+                    if (layer.image)
+                    {
+                        drawImage(
+                            layer.image,
+                            image::getDataBox(*layer.image, bufferBox),
+                            image::Color4f(1.F, 1.F, 1.F),
+                            imageOptions.get() ? *imageOptions : layer.imageOptions);
+                    }
+                    break;
+                }
+            }
+            p.setState(state);
+
+            const DisplayData displayData(displayOptions);
+            p.drawBuffer(
+                video,
+                box,
+                displayOptions.imageFilters,
+                displayOptions.mirror,
+                Blend(
+                    BlendFactor::One,
+                    BlendFactor::OneMinusSrcAlpha,
+                    BlendFactor::One,
+                    BlendFactor::OneMinusSrcAlpha),
+                [&p, &displayData](float* data, size_t count)
+                {
+                    displaySpan(data, count, displayData);
+                    p.colorSpan(data, count);
+                    channelsSpan(data, count, displayData.channels);
+                });
+        }
+
+        void Render::_drawVideoOffscreen(
+            const std::string& buffer,
+            const timeline::VideoData& videoData,
+            const math::Size2i& size,
+            const std::shared_ptr<timeline::ImageOptions>& imageOptions,
+            const timeline::DisplayOptions& displayOptions)
+        {
+            TLRENDER_P();
+            const auto state = p.getState();
+            p.setBuffer(p.getBuffer(buffer, size));
+            _drawVideo(
+                videoData,
+                math::Box2i(0, 0, size.w, size.h),
+                imageOptions,
+                displayOptions);
+            p.setState(state);
+        }
+    }
+}
@@ -109,93 +109,23 @@ namespace tl
             const std::vector<std::shared_ptr<gl::Texture> >& textures,
             size_t offset)
         {
-            const auto& info = image->getInfo();
-            switch (info.pixelType)
-            {
-            case image::PixelType::YUV_420P_U8:
-            {
-                if (3 == textures.size())
-                {
-                    textures[0]->copy(image->getData(), textures[0]->getInfo());
-                    const std::size_t w = info.size.w;
-                    const std::size_t h = info.size.h;
-                    const std::size_t w2 = w / 2;
-                    const std::size_t h2 = h / 2;
-                    textures[1]->copy(image->getData() + (w * h), textures[1]->getInfo());
-                    textures[2]->copy(image->getData() + (w * h) + (w2 * h2), textures[2]->getInfo());
-                }
-                break;
-            }
-            case image::PixelType::YUV_422P_U8:
-            {
-                if (3 == textures.size())
-                {
-                    textures[0]->copy(image->getData(), textures[0]->getInfo());
-                    const std::size_t w = info.size.w;
-                    const std::size_t h = info.size.h;
-                    const std::size_t w2 = w / 2;
-                    textures[1]->copy(image->getData() + (w * h), textures[1]->getInfo());
-                    textures[2]->copy(image->getData() + (w * h) + (w2 * h), textures[2]->getInfo());
-                }
-                break;
-            }
-            case image::PixelType::YUV_444P_U8:
-            {
-                if (3 == textures.size())
-                {
-                    textures[0]->copy(image->getData(), textures[0]->getInfo());
-                    const std::size_t w = info.size.w;
-                    const std::size_t h = info.size.h;
-                    textures[1]->copy(image->getData() + (w * h), textures[1]->getInfo());
-                    textures[2]->copy(image->getData() + (w * h) + (w * h), textures[2]->getInfo());
-                }
-                break;
-            }
-            case image::PixelType::YUV_420P_U16:
+            const auto& planes = image->getPlanes();
+            if (planes.size() > 1)
             {
-                if (3 == textures.size())
+                if (planes.size() == textures.size())
                 {
-                    textures[0]->copy(image->getData(), textures[0]->getInfo());
-                    const std::size_t w = info.size.w;
-                    const std::size_t h = info.size.h;
-                    const std::size_t w2 = w / 2;
-                    const std::size_t h2 = h / 2;
-                    textures[1]->copy(image->getData() + (w * h) * 2, textures[1]->getInfo());
-                    textures[2]->copy(image->getData() + (w * h) * 2 + (w2 * h2) * 2, textures[2]->getInfo());
+                    for (size_t i = 0; i < planes.size(); ++i)
+                    {
+                        textures[i]->copy(
+                            planes[i].data,
+                            textures[i]->getInfo(),
+                            planes[i].stride);
+                    }
                 }
-                break;
             }
-            case image::PixelType::YUV_422P_U16:
+            else if (1 == textures.size())
             {
-                if (3 == textures.size())
-                {
-                    textures[0]->copy(image->getData(), textures[0]->getInfo());
-                    const std::size_t w = info.size.w;
-                    const std::size_t h = info.size.h;
-                    const std::size_t w2 = w / 2;
-                    textures[1]->copy(image->getData() + (w * h) * 2, textures[1]->getInfo());
-                    textures[2]->copy(image->getData() + (w * h) * 2 + (w2 * h) * 2, textures[2]->getInfo());
-                }
-                break;
-            }
-            case image::PixelType::YUV_444P_U16:
-            {
-                if (3 == textures.size())
-                {
-                    textures[0]->copy(image->getData(), textures[0]->getInfo());
-                    const std::size_t w = info.size.w;
-                    const std::size_t h = info.size.h;
-                    textures[1]->copy(image->getData() + (w * h) * 2, textures[1]->getInfo());
-                    textures[2]->copy(image->getData() + (w * h) * 2 + (w * h) * 2, textures[2]->getInfo());
-                }
-                break;
-            }
-            default:
-                if (1 == textures.size())
-                {
-                    textures[0]->copy(image);
-                }
-                break;
+                textures[0]->copy(image);
             }
         }
 
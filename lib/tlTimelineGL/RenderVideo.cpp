@@ -682,8 +682,8 @@ namespace tl
                                     dissolveImageOptions.alphaBlend = timeline::AlphaBlend::Straight;
                                     drawImage(
                                         layer.image,
-                                        image::getBox(
-                                            layer.image->getAspect(),
+                                        image::getDataBox(
+                                            *layer.image,
                                             math::Box2i(0, 0, offscreenBufferSize.w, offscreenBufferSize.h)),
                                         image::Color4f(1.F, 1.F, 1.F, v),
                                         dissolveImageOptions);
@@ -699,8 +699,8 @@ namespace tl
                                     dissolveImageOptions.alphaBlend = timeline::AlphaBlend::Straight;
                                     drawImage(
                                         layer.imageB,
-                                        image::getBox(
-                                            layer.imageB->getAspect(),
+                                        image::getDataBox(
+                                            *layer.imageB,
                                             math::Box2i(0, 0, offscreenBufferSize.w, offscreenBufferSize.h)),
                                         image::Color4f(1.F, 1.F, 1.F, v),
                                         dissolveImageOptions);
@@ -746,8 +746,8 @@ namespace tl
                             {
                                 drawImage(
                                     layer.image,
-                                    image::getBox(
-                                        layer.image->getAspect(),
+                                    image::getDataBox(
+                                        *layer.image,
                                         math::Box2i(0, 0, offscreenBufferSize.w, offscreenBufferSize.h)),
                                     image::Color4f(1.F, 1.F, 1.F, 1.F - layer.transitionValue),
                                     imageOptions.get() ? *imageOptions : layer.imageOptions);
@@ -756,8 +756,8 @@ namespace tl
                             {
                                 drawImage(
                                     layer.imageB,
-                                    image::getBox(
-                                        layer.imageB->getAspect(),
+                                    image::getDataBox(
+                                        *layer.imageB,
                                         math::Box2i(0, 0, offscreenBufferSize.w, offscreenBufferSize.h)),
                                     image::Color4f(1.F, 1.F, 1.F, layer.transitionValue),
                                     imageOptions.get() ? *imageOptions : layer.imageOptionsB);
@@ -769,8 +769,8 @@ namespace tl
                         {
                             drawImage(
                                 layer.image,
-                                image::getBox(
-                                    layer.image->getAspect(),
+                                image::getDataBox(
+                                    *layer.image,
                                     math::Box2i(0, 0, offscreenBufferSize.w, offscreenBufferSize.h)),
                                 image::Color4f(1.F, 1.F, 1.F),
                                 imageOptions.get() ? *imageOptions : layer.imageOptions);
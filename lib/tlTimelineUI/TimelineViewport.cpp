@@ -12,10 +12,14 @@
 #include <tlGL/OffscreenBuffer.h>
 #include <tlGL/Util.h>
 
+#include <tlIO/IO.h>
+
 #include <tlCore/Error.h>
 #include <tlCore/LogSystem.h>
 #include <tlCore/String.h>
 
+#include <cmath>
+
 namespace tl
 {
     namespace timelineui
@@ -37,6 +41,8 @@ namespace tl
             std::shared_ptr<observer::Value<bool> > frameView;
             std::function<void(bool)> frameViewCallback;
             std::function<void(const math::Vector2i&, double)> viewPosAndZoomCallback;
+            bool autoProxy = true;
+            bool autoROI = true;
             std::shared_ptr<observer::Value<double> > fps;
             struct FpsData
             {
@@ -118,6 +124,7 @@ namespace tl
             p.compareOptions = value;
             p.doRender = true;
             _updates |= ui::Update::Draw;
+            _roiUpdate();
         }
 
         void TimelineViewport::setCompareCallback(const std::function<void(timeline::CompareOptions)>& value)
@@ -246,7 +253,10 @@ namespace tl
 
                         _p->doRender = true;
                         _updates |= ui::Update::Draw;
+                        _roiUpdate();
                     });
+                _proxyUpdate();
+                _roiUpdate();
             }
             else if (!p.videoData.empty())
             {
@@ -279,6 +289,8 @@ namespace tl
             {
                 p.viewPosAndZoomCallback(p.viewPos, p.viewZoom);
             }
+            _proxyUpdate();
+            _roiUpdate();
             setFrameView(false);
         }
 
@@ -344,6 +356,54 @@ namespace tl
             _p->viewPosAndZoomCallback = value;
         }
 
+        bool TimelineViewport::hasAutoProxy() const
+        {
+            return _p->autoProxy;
+        }
+
+        void TimelineViewport::setAutoProxy(bool value)
+        {
+            TLRENDER_P();
+            if (value == p.autoProxy)
+                return;
+            p.autoProxy = value;
+            if (p.player)
+            {
+                if (p.autoProxy)
+                {
+                    _proxyUpdate();
+                }
+                else
+                {
+                    p.player->setProxyLevel(0);
+                }
+            }
+        }
+
+        bool TimelineViewport::hasAutoROI() const
+        {
+            return _p->autoROI;
+        }
+
+        void TimelineViewport::setAutoROI(bool value)
+        {
+            TLRENDER_P();
+            if (value == p.autoROI)
+                return;
+            p.autoROI = value;
+            if (p.player)
+            {
+                if (p.autoROI)
+                {
+                    _roiUpdate();
+                }
+                else
+                {
+                    p.player->setROI(math::Box2f());
+                }
+            }
+        }
+
         double TimelineViewport::getFPS() const
         {
             return _p->fps->get();
@@ -386,6 +446,7 @@ namespace tl
             if (changed)
             {
                 p.doRender = true;
+                _roiUpdate();
             }
         }
 
@@ -632,6 +693,10 @@ namespace tl
         {
             IWidget::mouseReleaseEvent(event);
             TLRENDER_P();
+            if (Private::MouseMode::View == p.mouse.mode)
+            {
+                _roiUpdate();
+            }
             p.mouse.mode = Private::MouseMode::None;
         }
 
@@ -732,6 +797,48 @@ namespace tl
                 {
                     p.viewPosAndZoomCallback(p.viewPos, p.viewZoom);
                 }
+                _proxyUpdate();
+                _roiUpdate();
+            }
+        }
+
+        void TimelineViewport::_proxyUpdate()
+        {
+            TLRENDER_P();
+            if (p.player && p.autoProxy)
+            {
+                p.player->setProxyLevel(io::getProxyLevel(p.viewZoom));
+            }
+        }
+
+        void TimelineViewport::_roiUpdate()
+        {
+            TLRENDER_P();
+            if (p.player && p.autoROI)
+            {
+                // Get the visible part of the image. The region is expanded
+                // to a coarse grid so that small changes to the view do not
+                // clear the player cache. The region is only used for a
+                // single full resolution image, and is normalized so each
+                // clip can convert it to its own resolution.
+                math::Box2f roi;
+                if (timeline::CompareMode::A == p.compareOptions.mode &&
+                    0 == p.player->getProxyLevel() &&
+                    !p.videoData.empty() &&
+                    p.viewZoom > 0.0)
+                {
+                    const math::Box2f view(
+                        math::Vector2f(
+                            -p.viewPos.x / p.viewZoom,
+                            -p.viewPos.y / p.viewZoom),
+                        math::Vector2f(
+                            (_geometry.w() - p.viewPos.x) / p.viewZoom,
+                            (_geometry.h() - p.viewPos.y) / p.viewZoom));
+                    roi = timeline::getNormalizedROI(
+                        timeline::getROI(view, p.videoData[0].size),
+                        p.videoData[0].size);
+                }
+                p.player->setROI(roi);
             }
         }
 
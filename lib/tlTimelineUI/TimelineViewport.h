@@ -103,6 +103,18 @@ namespace tl
             void setViewPosAndZoomCallback(
                 const std::function<void(const math::Vector2i&, double)>&);
 
+            //! Get whether the player proxy level follows the view zoom.
+            bool hasAutoProxy() const;
+
+            //! Set whether the player proxy level follows the view zoom.
+            void setAutoProxy(bool);
+
+            //! Get whether the player region of interest follows the view.
+            bool hasAutoROI() const;
+
+            //! Set whether the player region of interest follows the view.
+            void setAutoROI(bool);
+
             //! Get the frames per second.
             double getFPS() const;
 
@@ -138,6 +150,8 @@ namespace tl
             math::Size2i _getRenderSize() const;
             math::Vector2i _getViewportCenter() const;
             void _frameView();
+            void _proxyUpdate();
+            void _roiUpdate();
 
             void _droppedFramesUpdate(const otime::RationalTime&);
 
@@ -161,6 +161,16 @@ namespace tl
             const size_t requestTimeout = 5;
 
             typedef std::pair<std::string, float> CacheKey;
+            struct CacheKeyHash
+            {
+                std::size_t operator() (const CacheKey& value) const noexcept
+                {
+                    std::size_t out = 0;
+                    memory::hashCombine(out, value.first);
+                    memory::hashCombine(out, value.second);
+                    return out;
+                }
+            };
 
             struct Mutex
             {
@@ -173,7 +183,7 @@ namespace tl
             struct Thread
             {
                 std::shared_ptr<io::IPlugin> plugin;
-                memory::LRUCache<CacheKey, std::shared_ptr<image::Image> > cache;
+                memory::LRUCache<CacheKey, std::shared_ptr<image::Image>, CacheKeyHash> cache;
                 std::condition_variable cv;
                 std::thread thread;
                 std::atomic<bool> running;
@@ -4,6 +4,7 @@
 
 #include <tlUI/ThumbnailSystem.h>
 
+#include <tlTimelineCPU/Render.h>
 #include <tlTimelineGL/Render.h>
 
 #include <tlTimeline/Timeline.h>
@@ -289,6 +290,7 @@ namespace tl
             {
                 std::shared_ptr<timeline_gl::Render> render;
                 std::shared_ptr<gl::OffscreenBuffer> buffer;
+                std::shared_ptr<timeline_cpu::Render> cpuRender;
                 memory::LRUCache<std::string, std::shared_ptr<io::IRead> > ioCache;
                 std::condition_variable cv;
                 std::thread thread;
@@ -320,11 +322,22 @@ namespace tl
             p.window = window;
             if (!p.window)
             {
-                p.window = gl::GLFWWindow::create(
-                    "tl::ui::ThumbnailGenerator",
-                    math::Size2i(1, 1),
-                    context,
-                    static_cast<int>(gl::GLFWWindowOptions::None));
+                // Fall back to the CPU renderer if there is no display.
+                try
+                {
+                    p.window = gl::GLFWWindow::create(
+                        "tl::ui::ThumbnailGenerator",
+                        math::Size2i(1, 1),
+                        context,
+                        static_cast<int>(gl::GLFWWindowOptions::None));
+                }
+                catch (const std::exception& e)
+                {
+                    context->log(
+                        "tl::ui::ThumbnailGenerator",
+                        string::Format("Using the CPU renderer: {0}").arg(e.what()),
+                        log::Type::Warning);
+                }
             }
 
             p.infoThread.running = true;
@@ -349,10 +362,17 @@ namespace tl
                 [this]
                 {
                     TLRENDER_P();
-                    p.window->makeCurrent();
                     if (auto context = p.context.lock())
                     {
-                        p.thumbnailThread.render = timeline_gl::Render::create(context);
+                        if (p.window)
+                        {
+                            p.window->makeCurrent();
+                            p.thumbnailThread.render = timeline_gl::Render::create(context);
+                        }
+                        else
+                        {
+                            p.thumbnailThread.cpuRender = timeline_cpu::Render::create(context);
+                        }
                     }
                     while (p.thumbnailThread.running)
                     {
@@ -364,7 +384,11 @@ namespace tl
                     }
                     p.thumbnailThread.buffer.reset();
                     p.thumbnailThread.render.reset();
-                    p.window->doneCurrent();
+                    p.thumbnailThread.cpuRender.reset();
+                    if (p.window)
+                    {
+                        p.window->doneCurrent();
+                    }
                     _thumbnailCancel();
                 });
 
@@ -724,7 +748,8 @@ namespace tl
                                 }
                                 gl::OffscreenBufferOptions options;
                                 options.colorType = image::PixelType::RGBA_U8;
-                                if (gl::doCreate(p.thumbnailThread.buffer, size, options))
+                                if (p.thumbnailThread.render &&
+                                    gl::doCreate(p.thumbnailThread.buffer, size, options))
                                 {
                                     p.thumbnailThread.buffer = gl::OffscreenBuffer::create(size, options);
                                 }
@@ -733,7 +758,20 @@ namespace tl
                                     request->time :
                                     info.videoTime.start_time();
                                 const auto videoData = read->readVideo(time, request->options).get();
-                                if (p.thumbnailThread.render && p.thumbnailThread.buffer && videoData.image)
+                                if (p.thumbnailThread.cpuRender && videoData.image)
+                                {
+                                    p.thumbnailThread.cpuRender->begin(size);
+                                    p.thumbnailThread.cpuRender->drawImage(
+                                        videoData.image,
+                                        { math::Box2i(0, 0, size.w, size.h) });
+                                    p.thumbnailThread.cpuRender->end();
+                                    image = image::Image::create(
+                                        size.w,
+                                        size.h,
+                                        image::PixelType::RGBA_U8);
+                                    p.thumbnailThread.cpuRender->copyImage(image);
+                                }
+                                else if (p.thumbnailThread.render && p.thumbnailThread.buffer && videoData.image)
                                 {
                                     gl::OffscreenBufferBinding binding(p.thumbnailThread.buffer);
                                     p.thumbnailThread.render->begin(size);
@@ -785,11 +823,25 @@ namespace tl
                                 {
                                     gl::OffscreenBufferOptions options;
                                     options.colorType = image::PixelType::RGBA_U8;
-                                    if (gl::doCreate(p.thumbnailThread.buffer, size, options))
+                                    if (p.thumbnailThread.render &&
+                                        gl::doCreate(p.thumbnailThread.buffer, size, options))
                                     {
                                         p.thumbnailThread.buffer = gl::OffscreenBuffer::create(size, options);
                                     }
-                                    if (p.thumbnailThread.render && p.thumbnailThread.buffer)
+                                    if (p.thumbnailThread.cpuRender)
+                                    {
+                                        p.thumbnailThread.cpuRender->begin(size);
+                                        p.thumbnailThread.cpuRender->drawVideo(
+                                            { videoData },
+                                            { math::Box2i(0, 0, size.w, size.h) });
+                                        p.thumbnailThread.cpuRender->end();
+                                        image = image::Image::create(
+                                            size.w,
+                                            size.h,
+                                            image::PixelType::RGBA_U8);
+                                        p.thumbnailThread.cpuRender->copyImage(image);
+                                    }
+                                    else if (p.thumbnailThread.render && p.thumbnailThread.buffer)
                                     {
                                         gl::OffscreenBufferBinding binding(p.thumbnailThread.buffer);
                                         p.thumbnailThread.render->begin(size);
@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/Audio.h>
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+using namespace tl;
+
+namespace
+{
+    std::shared_ptr<audio::Audio> getAudio(const audio::Info& info, size_t sampleCount)
+    {
+        auto out = audio::Audio::create(
+            audio::Info(info.channelCount, audio::DataType::F32, info.sampleRate),
+            sampleCount);
+        std::mt19937 random(0);
+        std::uniform_real_distribution<float> distribution(-1.F, 1.F);
+        float* p = reinterpret_cast<float*>(out->getData());
+        for (size_t i = 0; i < sampleCount * info.channelCount; ++i)
+        {
+            p[i] = distribution(random);
+        }
+        return audio::convert(out, info.dataType);
+    }
+
+    //! Run a function for each SIMD instruction set and print the time.
+    void benchmark(
+        const std::string& name,
+        const audio::Info& info,
+        const std::function<void(void)>& func)
+    {
+        std::cout << std::setw(20) << std::left << name <<
+            std::setw(6) << std::right << info.dataType;
+        const auto simdSupported = audio::getSIMDSupported();
+        for (auto simd : audio::getSIMDEnums())
+        {
+            if (simd <= simdSupported)
+            {
+                audio::setSIMD(simd);
+                const auto t0 = std::chrono::steady_clock::now();
+                for (size_t i = 0; i < 100; ++i)
+                {
+                    func();
+                }
+                const auto t1 = std::chrono::steady_clock::now();
+                const std::chrono::duration<double> diff = t1 - t0;
+                std::cout << std::setw(12) << std::fixed << std::setprecision(4) << diff.count();
+            }
+            else
+            {
+                std::cout << std::setw(12) << "-";
+            }
+        }
+        std::cout << std::endl;
+        audio::setSIMD(simdSupported);
+    }
+}
+
+int main()
+{
+    std::cout << std::setw(26) << std::left << "Time (s)";
+    for (auto simd : audio::getSIMDEnums())
+    {
+        std::cout << std::setw(12) << std::right << simd;
+    }
+    std::cout << std::endl;
+
+    // One second of stereo audio, mixed from twelve tracks.
+    const size_t sampleCount = 48000;
+    const size_t trackCount = 12;
+    for (auto dataType : audio::getDataTypeEnums())
+    {
+        if (audio::DataType::None == dataType)
+            continue;
+        const audio::Info info(2, dataType, 48000);
+        std::vector<std::shared_ptr<audio::Audio> > tracks;
+        std::vector<const uint8_t*> in;
+        for (size_t i = 0; i < trackCount; ++i)
+        {
+            tracks.push_back(getAudio(info, sampleCount));
+            in.push_back(tracks.back()->getData());
+        }
+        auto out = audio::Audio::create(info, sampleCount);
+
+        benchmark(
+            "mix",
+            info,
+            [&in, &out, info, sampleCount]
+            {
+                audio::mix(
+                    in.data(),
+                    in.size(),
+                    out->getData(),
+                    .5F,
+                    sampleCount,
+                    info.channelCount,
+                    info.dataType);
+            });
+        benchmark(
+            "reverse",
+            info,
+            [&tracks, &out, info, sampleCount]
+            {
+                audio::reverse(
+                    tracks[0]->getData(),
+                    out->getData(),
+                    sampleCount,
+                    info.channelCount,
+                    info.dataType);
+            });
+        benchmark(
+            "planarInterleave",
+            info,
+            [&tracks]
+            {
+                audio::planarInterleave(tracks[0]);
+            });
+        for (auto outType : audio::getDataTypeEnums())
+        {
+            if (audio::DataType::None == outType || dataType == outType)
+                continue;
+            std::stringstream ss;
+            ss << "convert to " << outType;
+            benchmark(
+                ss.str(),
+                info,
+                [&tracks, outType]
+                {
+                    audio::convert(tracks[0], outType);
+                });
+        }
+    }
+    return 0;
+}
@@ -6,9 +6,16 @@
 
 #include <tlCore/Assert.h>
 #include <tlCore/AudioResample.h>
+#include <tlCore/AudioRingBuffer.h>
 #include <tlCore/AudioSystem.h>
+#include <tlCore/AudioTimeStretch.h>
+#include <tlCore/Math.h>
 
+#include <atomic>
+#include <cmath>
 #include <cstring>
+#include <random>
+#include <thread>
 
 using namespace tl::audio;
 
@@ -38,12 +45,16 @@ namespace tl
             _interleave();
             _move();
             _resample();
+            _ringBuffer();
+            _timeStretch();
+            _simd();
         }
 
         void AudioTest::_enums()
         {
             _enum<DataType>("DataType", getDataTypeEnums);
             _enum<DeviceFormat>("DeviceFormat", getDeviceFormatEnums);
+            _enum<SIMD>("SIMD", getSIMDEnums);
         }
 
         void AudioTest::_types()
@@ -570,5 +581,294 @@ namespace tl
                 r->flush();
             }
         }
+
+        void AudioTest::_ringBuffer()
+        {
+            {
+                const Info info(2, DataType::S16, 44100);
+                auto ringBuffer = AudioRingBuffer::create(info, 10);
+                TLRENDER_ASSERT(info == ringBuffer->getInfo());
+                TLRENDER_ASSERT(10 == ringBuffer->getSampleCount());
+                TLRENDER_ASSERT(0 == ringBuffer->getReadAvailable());
+                TLRENDER_ASSERT(10 == ringBuffer->getWriteAvailable());
+
+                std::vector<S16_T> in(20);
+                for (size_t i = 0; i < in.size(); ++i)
+                {
+                    in[i] = i;
+                }
+                TLRENDER_ASSERT(8 == ringBuffer->write(
+                    reinterpret_cast<const uint8_t*>(in.data()), 8));
+                TLRENDER_ASSERT(8 == ringBuffer->getReadAvailable());
+                TLRENDER_ASSERT(2 == ringBuffer->getWriteAvailable());
+                TLRENDER_ASSERT(2 == ringBuffer->write(
+                    reinterpret_cast<const uint8_t*>(in.data()), 8));
+                TLRENDER_ASSERT(0 == ringBuffer->getWriteAvailable());
+
+                std::vector<S16_T> out(20);
+                TLRENDER_ASSERT(6 == ringBuffer->read(
+                    reinterpret_cast<uint8_t*>(out.data()), 6));
+                for (size_t i = 0; i < 6; ++i)
+                {
+                    TLRENDER_ASSERT(out[i] == in[i]);
+                }
+                TLRENDER_ASSERT(2 == ringBuffer->skip(2));
+                TLRENDER_ASSERT(2 == ringBuffer->getReadAvailable());
+
+                // Write across the end of the buffer.
+                TLRENDER_ASSERT(8 == ringBuffer->write(
+                    reinterpret_cast<const uint8_t*>(in.data() + 4), 10));
+                TLRENDER_ASSERT(10 == ringBuffer->read(
+                    reinterpret_cast<uint8_t*>(out.data()), 20));
+                TLRENDER_ASSERT(0 == out[0]);
+                TLRENDER_ASSERT(1 == out[1]);
+                for (size_t i = 0; i < 8; ++i)
+                {
+                    TLRENDER_ASSERT(out[2 + i] == in[4 + i]);
+                }
+                TLRENDER_ASSERT(0 == ringBuffer->read(
+                    reinterpret_cast<uint8_t*>(out.data()), 10));
+                TLRENDER_ASSERT(0 == ringBuffer->skip(10));
+            }
+            {
+                // Read from the ring buffer the same way as an audio
+                // callback while another thread writes to it.
+                const Info info(1, DataType::S32, 48000);
+                const size_t bufferSampleCount = 256;
+                const size_t sampleCount = 48000;
+                auto ringBuffer = AudioRingBuffer::create(info, bufferSampleCount * 4);
+                std::thread thread(
+                    [=]
+                    {
+                        std::vector<S32_T> data(bufferSampleCount);
+                        size_t value = 0;
+                        while (value < sampleCount)
+                        {
+                            const size_t size = std::min(
+                                ringBuffer->getWriteAvailable(),
+                                std::min(bufferSampleCount, sampleCount - value));
+                            for (size_t i = 0; i < size; ++i)
+                            {
+                                data[i] = value + i;
+                            }
+                            value += ringBuffer->write(
+                                reinterpret_cast<const uint8_t*>(data.data()),
+                                size);
+                            std::this_thread::yield();
+                        }
+                    });
+
+                std::vector<S32_T> out(bufferSampleCount);
+                size_t count = 0;
+                bool valid = true;
+                while (count < sampleCount)
+                {
+                    const size_t size = ringBuffer->read(
+                        reinterpret_cast<uint8_t*>(out.data()),
+                        bufferSampleCount);
+                    if (size < bufferSampleCount)
+                    {
+                        std::memset(
+                            out.data() + size,
+                            0,
+                            (bufferSampleCount - size) * info.getByteCount());
+                    }
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        valid &= out[i] == static_cast<S32_T>(count + i);
+                    }
+                    count += size;
+                }
+                thread.join();
+                TLRENDER_ASSERT(valid);
+            }
+        }
+
+        void AudioTest::_timeStretch()
+        {
+            {
+                const Info info(2, DataType::F32, 48000);
+                auto timeStretch = AudioTimeStretch::create(info);
+                TLRENDER_ASSERT(info == timeStretch->getInfo());
+                TLRENDER_ASSERT(1.F == timeStretch->getSpeed());
+                timeStretch->setSpeed(2.F);
+                TLRENDER_ASSERT(2.F == timeStretch->getSpeed());
+                timeStretch->setSpeed(0.F);
+                TLRENDER_ASSERT(timeStretchSpeedMin == timeStretch->getSpeed());
+                timeStretch->setSpeed(100.F);
+                TLRENDER_ASSERT(timeStretchSpeedMax == timeStretch->getSpeed());
+                auto out = timeStretch->process(nullptr);
+                TLRENDER_ASSERT(0 == out->getSampleCount());
+                out = timeStretch->process(Audio::create(Info(1, DataType::F32, 48000), 100));
+                TLRENDER_ASSERT(0 == out->getSampleCount());
+            }
+            for (auto dataType : { DataType::S16, DataType::F32 })
+            {
+                for (float speed : { .5F, 1.F, 2.F })
+                {
+                    // Stretch one second of a 440Hz sine wave, and check the
+                    // duration and the frequency of the output.
+                    const Info info(2, dataType, 48000);
+                    auto timeStretch = AudioTimeStretch::create(info);
+                    timeStretch->setSpeed(speed);
+                    const size_t chunkSize = 1000;
+                    std::vector<float> out;
+                    for (size_t i = 0; i < info.sampleRate; i += chunkSize)
+                    {
+                        auto in = Audio::create(Info(2, DataType::F32, 48000), chunkSize);
+                        float* inP = reinterpret_cast<float*>(in->getData());
+                        for (size_t j = 0; j < chunkSize; ++j)
+                        {
+                            const float v = .5F * std::sin(
+                                2.F * math::pi * 440.F * (i + j) / info.sampleRate);
+                            inP[j * 2] = v;
+                            inP[j * 2 + 1] = v;
+                        }
+                        auto stretched = timeStretch->process(convert(in, dataType));
+                        TLRENDER_ASSERT(info.dataType == stretched->getDataType());
+                        stretched = convert(stretched, DataType::F32);
+                        const float* stretchedP = reinterpret_cast<const float*>(stretched->getData());
+                        for (size_t j = 0; j < stretched->getSampleCount(); ++j)
+                        {
+                            out.push_back(stretchedP[j * 2]);
+                        }
+                    }
+                    timeStretch->flush();
+
+                    const float expected = info.sampleRate / speed;
+                    TLRENDER_ASSERT(out.size() > expected * .9F && out.size() < expected * 1.1F);
+                    size_t crossings = 0;
+                    for (size_t j = 1; j < out.size(); ++j)
+                    {
+                        if (out[j - 1] < 0.F && out[j] >= 0.F)
+                        {
+                            ++crossings;
+                        }
+                    }
+                    const float frequency = crossings / (out.size() / static_cast<float>(info.sampleRate));
+                    std::stringstream ss;
+                    ss << dataType << " speed " << speed << ": " << out.size() <<
+                        " samples, " << frequency << "Hz";
+                    _print(ss.str());
+                    TLRENDER_ASSERT(std::fabs(frequency - 440.F) < 10.F);
+                }
+            }
+        }
+
+        namespace
+        {
+            std::shared_ptr<Audio> getRandomAudio(const Info& info, size_t sampleCount, std::mt19937& random)
+            {
+                // Random values including the edges of the range.
+                auto out = Audio::create(Info(info.channelCount, DataType::F32, info.sampleRate), sampleCount);
+                std::uniform_real_distribution<float> distribution(-1.F, 1.F);
+                float* p = reinterpret_cast<float*>(out->getData());
+                const size_t size = sampleCount * info.channelCount;
+                for (size_t i = 0; i < size; ++i)
+                {
+                    switch (i % 11)
+                    {
+                    case 0: p[i] = -1.F; break;
+                    case 1: p[i] = 1.F; break;
+                    case 2: p[i] = 0.F; break;
+                    default: p[i] = distribution(random); break;
+                    }
+                }
+                return convert(out, info.dataType);
+            }
+        }
+
+        void AudioTest::_simd()
+        {
+            {
+                std::stringstream ss;
+                ss << "SIMD supported: " << getSIMDSupported();
+                _print(ss.str());
+            }
+            const SIMD simdSupported = getSIMDSupported();
+            std::mt19937 random(0);
+            for (auto simd : getSIMDEnums())
+            {
+                if (SIMD::None == simd || simd > simdSupported)
+                    continue;
+                for (auto dataType : getDataTypeEnums())
+                {
+                    if (DataType::None == dataType)
+                        continue;
+                    for (size_t channelCount : { 1, 2, 3, 6 })
+                    {
+                        // Use a sample count that is not a multiple of the
+                        // SIMD width to exercise the scalar remainder.
+                        const Info info(channelCount, dataType, 48000);
+                        const size_t sampleCount = 1000 + 37;
+                        std::vector<std::shared_ptr<Audio> > inputs;
+                        for (size_t i = 0; i < 3; ++i)
+                        {
+                            inputs.push_back(getRandomAudio(info, sampleCount, random));
+                        }
+                        const size_t byteCount = sampleCount * info.getByteCount();
+
+                        for (float volume : { 0.F, .3F, .5F, 1.F })
+                        {
+                            for (size_t inCount = 1; inCount <= inputs.size(); ++inCount)
+                            {
+                                std::vector<const uint8_t*> in;
+                                for (size_t i = 0; i < inCount; ++i)
+                                {
+                                    in.push_back(inputs[i]->getData());
+                                }
+                                std::vector<uint8_t> result(byteCount);
+                                std::vector<uint8_t> expected(byteCount);
+                                setSIMD(SIMD::None);
+                                mix(in.data(), inCount, expected.data(), volume, sampleCount, channelCount, dataType);
+                                setSIMD(simd);
+                                mix(in.data(), inCount, result.data(), volume, sampleCount, channelCount, dataType);
+                                TLRENDER_ASSERT(0 == std::memcmp(expected.data(), result.data(), byteCount));
+                            }
+                        }
+
+                        {
+                            std::vector<uint8_t> result(byteCount);
+                            std::vector<uint8_t> expected(byteCount);
+                            setSIMD(SIMD::None);
+                            reverse(inputs[0]->getData(), expected.data(), sampleCount, channelCount, dataType);
+                            setSIMD(simd);
+                            reverse(inputs[0]->getData(), result.data(), sampleCount, channelCount, dataType);
+                            TLRENDER_ASSERT(0 == std::memcmp(expected.data(), result.data(), byteCount));
+                        }
+
+                        for (auto outType : getDataTypeEnums())
+                        {
+                            if (DataType::None == outType)
+                                continue;
+                            setSIMD(SIMD::None);
+                            const auto expected = convert(inputs[0], outType);
+                            setSIMD(simd);
+                            const auto result = convert(inputs[0], outType);
+                            TLRENDER_ASSERT(0 == std::memcmp(
+                                expected->getData(),
+                                result->getData(),
+                                expected->getByteCount()));
+                        }
+
+                        {
+                            setSIMD(SIMD::None);
+                            const auto expected = planarInterleave(inputs[0]);
+                            setSIMD(simd);
+                            const auto result = planarInterleave(inputs[0]);
+                            TLRENDER_ASSERT(0 == std::memcmp(
+                                expected->getData(),
+                                result->getData(),
+                                expected->getByteCount()));
+                        }
+                    }
+                }
+                std::stringstream ss;
+                ss << "SIMD " << simd << ": matches scalar";
+                _print(ss.str());
+            }
+            setSIMD(simdSupported);
+            TLRENDER_ASSERT(simdSupported == getSIMD());
+        }
     }
 }
@@ -32,6 +32,9 @@ namespace tl
             void _interleave();
             void _move();
             void _resample();
+            void _ringBuffer();
+            void _timeStretch();
+            void _simd();
         };
     }
 }
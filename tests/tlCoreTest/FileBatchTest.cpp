@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCoreTest/FileBatchTest.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/File.h>
+#include <tlCore/FileBatch.h>
+#include <tlCore/FileIO.h>
+#include <tlCore/ImagePool.h>
+#include <tlCore/Path.h>
+
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+using namespace tl::file;
+
+namespace tl
+{
+    namespace core_tests
+    {
+        FileBatchTest::FileBatchTest(const std::shared_ptr<system::Context>& context) :
+            ITest("core_tests::FileBatchTest", context)
+        {}
+
+        std::shared_ptr<FileBatchTest> FileBatchTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<FileBatchTest>(new FileBatchTest(context));
+        }
+
+        void FileBatchTest::run()
+        {
+            _options();
+            _read();
+            _errors();
+        }
+
+        namespace
+        {
+            std::vector<uint8_t> createData(size_t size, size_t seed)
+            {
+                std::vector<uint8_t> out(size);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    out[i] = i * 7 + i / 256 + seed;
+                }
+                return out;
+            }
+        }
+
+        void FileBatchTest::_options()
+        {
+            {
+                BatchReadOptions options;
+                BatchReadOptions options2;
+                TLRENDER_ASSERT(options == options2);
+                options2.direct = true;
+                TLRENDER_ASSERT(options != options2);
+            }
+            {
+                BatchReadStats stats;
+                BatchReadStats stats2;
+                TLRENDER_ASSERT(stats == stats2);
+                stats2.requests = 1;
+                TLRENDER_ASSERT(stats != stats2);
+            }
+        }
+
+        void FileBatchTest::_read()
+        {
+            // Write some files with a header before the data.
+            const std::string tempDir = createTempDir();
+            const size_t headerSize = 8192;
+            const size_t dataSize = 3 * batchDirectAlignment + 100;
+            std::vector<std::string> fileNames;
+            std::vector<std::vector<uint8_t> > data;
+            for (size_t i = 0; i < 8; ++i)
+            {
+                std::stringstream ss;
+                ss << "FileBatchTest." << i << ".bin";
+                fileNames.push_back(Path(tempDir, ss.str()).get());
+                data.push_back(createData(headerSize + dataSize, i));
+                auto io = FileIO::create(fileNames.back(), Mode::Write);
+                io->write(data.back().data(), data.back().size());
+            }
+
+            for (bool direct : { false, true })
+            {
+                BatchReadOptions options;
+                options.threadCount = 2;
+                options.queueDepth = 4;
+                options.direct = direct;
+                auto batch = BatchRead::create(options);
+                TLRENDER_ASSERT(options == batch->getOptions());
+                {
+                    std::stringstream ss;
+                    ss << "Direct: " << direct << ", io_uring: " << batch->hasURing();
+                    _print(ss.str());
+                }
+
+                // Read the data after the headers into aligned buffers.
+                auto pool = image::ImagePool::create();
+                std::vector<std::shared_ptr<uint8_t> > buffers;
+                std::vector<BatchReadRequest> requests;
+                for (size_t i = 0; i < fileNames.size(); ++i)
+                {
+                    buffers.push_back(pool->allocate(dataSize));
+                    BatchReadRequest request;
+                    request.fileName = fileNames[i];
+                    request.pos = headerSize;
+                    request.size = dataSize;
+                    request.data = buffers.back().get();
+                    requests.push_back(request);
+                }
+                for (auto& future : batch->read(requests))
+                {
+                    future.get();
+                }
+                for (size_t i = 0; i < fileNames.size(); ++i)
+                {
+                    TLRENDER_ASSERT(0 == memcmp(
+                        buffers[i].get(),
+                        data[i].data() + headerSize,
+                        dataSize));
+                }
+
+                // Read unaligned ranges.
+                std::vector<uint8_t> buf(100);
+                BatchReadRequest request;
+                request.fileName = fileNames[1];
+                request.pos = 1;
+                request.size = buf.size();
+                request.data = buf.data();
+                batch->read(request).get();
+                TLRENDER_ASSERT(0 == memcmp(buf.data(), data[1].data() + 1, buf.size()));
+
+                const auto stats = batch->getStats();
+                TLRENDER_ASSERT(fileNames.size() + 1 == stats.requests);
+                TLRENDER_ASSERT(0 == stats.errors);
+                TLRENDER_ASSERT(fileNames.size() * dataSize + buf.size() == stats.byteCount);
+                if (!direct)
+                {
+                    TLRENDER_ASSERT(0 == stats.directBytes);
+                }
+                {
+                    std::stringstream ss;
+                    ss << "Direct bytes: " << stats.directBytes;
+                    _print(ss.str());
+                }
+            }
+
+            for (const auto& fileName : fileNames)
+            {
+                rm(fileName);
+            }
+            rmdir(tempDir);
+        }
+
+        void FileBatchTest::_errors()
+        {
+            auto batch = BatchRead::create();
+            std::vector<uint8_t> buf(100);
+            BatchReadRequest request;
+            request.fileName = "FileBatchTest_NonExistent";
+            request.size = buf.size();
+            request.data = buf.data();
+            try
+            {
+                batch->read(request).get();
+                TLRENDER_ASSERT(false);
+            }
+            catch (const std::exception&)
+            {}
+
+            // Read past the end of a file.
+            const std::string tempDir = createTempDir();
+            request.fileName = Path(tempDir, "FileBatchTest.bin").get();
+            {
+                auto io = FileIO::create(request.fileName, Mode::Write);
+                io->write(buf.data(), 10);
+            }
+            try
+            {
+                batch->read(request).get();
+                TLRENDER_ASSERT(false);
+            }
+            catch (const std::exception&)
+            {}
+            const auto stats = batch->getStats();
+            TLRENDER_ASSERT(2 == stats.requests);
+            TLRENDER_ASSERT(2 == stats.errors);
+            rm(request.fileName);
+            rmdir(tempDir);
+        }
+    }
+}
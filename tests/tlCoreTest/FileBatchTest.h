@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace core_tests
+    {
+        class FileBatchTest : public tests::ITest
+        {
+        protected:
+            FileBatchTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<FileBatchTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _options();
+            void _read();
+            void _errors();
+        };
+    }
+}
@@ -0,0 +1,366 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCoreTest/FilePrefetchTest.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/File.h>
+#include <tlCore/FileIO.h>
+#include <tlCore/FilePrefetch.h>
+#include <tlCore/Path.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace tl::file;
+
+namespace tl
+{
+    namespace core_tests
+    {
+        FilePrefetchTest::FilePrefetchTest(const std::shared_ptr<system::Context>& context) :
+            ITest("core_tests::FilePrefetchTest", context)
+        {}
+
+        std::shared_ptr<FilePrefetchTest> FilePrefetchTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<FilePrefetchTest>(new FilePrefetchTest(context));
+        }
+
+        void FilePrefetchTest::run()
+        {
+            _read();
+            _throttled();
+            _errors();
+            _fileIO();
+            _pool();
+        }
+
+        namespace
+        {
+            std::vector<uint8_t> createData(size_t size)
+            {
+                std::vector<uint8_t> out(size);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    out[i] = i * 7 + i / 256;
+                }
+                return out;
+            }
+
+            //! A file system stand-in that counts the reads, the number of
+            //! reads in flight, and optionally sleeps to simulate latency.
+            struct Source
+            {
+                std::vector<uint8_t> data;
+                std::chrono::milliseconds latency = std::chrono::milliseconds(0);
+                std::atomic<size_t> reads;
+                std::atomic<size_t> inFlight;
+                std::atomic<size_t> maxInFlight;
+                std::atomic<bool> unaligned;
+
+                Source(size_t size, size_t blockSize) :
+                    data(createData(size)),
+                    reads(0),
+                    inFlight(0),
+                    maxInFlight(0),
+                    unaligned(false),
+                    _blockSize(blockSize)
+                {}
+
+                PrefetchCallback getCallback()
+                {
+                    return [this](size_t pos, uint8_t* buf, size_t size)
+                    {
+                        const size_t n = ++inFlight;
+                        size_t max = maxInFlight;
+                        while (n > max && !maxInFlight.compare_exchange_weak(max, n))
+                            ;
+                        if (pos % _blockSize != 0)
+                        {
+                            unaligned = true;
+                        }
+                        std::this_thread::sleep_for(latency);
+                        std::memcpy(buf, data.data() + pos, size);
+                        ++reads;
+                        --inFlight;
+                    };
+                }
+
+            private:
+                size_t _blockSize = 0;
+            };
+        }
+
+        void FilePrefetchTest::_read()
+        {
+            {
+                PrefetchOptions options;
+                PrefetchOptions options2;
+                TLRENDER_ASSERT(options == options2);
+                options2.blockSize = 1;
+                TLRENDER_ASSERT(options != options2);
+            }
+            {
+                PrefetchStats stats;
+                TLRENDER_ASSERT(0.0 == stats.getLatency());
+                TLRENDER_ASSERT(0.0 == stats.getThroughput());
+                PrefetchStats stats2;
+                stats2.hits = 1;
+                TLRENDER_ASSERT(stats != stats2);
+            }
+            {
+                PrefetchOptions options;
+                options.blockSize = 100;
+                options.readAhead = 2;
+                options.maxInFlight = 2;
+                options.maxBlocks = 8;
+                Source source(1050, options.blockSize);
+                auto prefetch = PrefetchRead::create(
+                    "prefetch",
+                    source.data.size(),
+                    source.getCallback(),
+                    options);
+                TLRENDER_ASSERT("prefetch" == prefetch->getFileName());
+                TLRENDER_ASSERT(1050 == prefetch->getSize());
+                TLRENDER_ASSERT(options == prefetch->getOptions());
+
+                // Read the file sequentially in small reads that cross the
+                // block boundaries.
+                std::vector<uint8_t> data(source.data.size());
+                size_t pos = 0;
+                while (pos < data.size())
+                {
+                    const size_t n = prefetch->read(pos, data.data() + pos, 33);
+                    TLRENDER_ASSERT(n > 0);
+                    pos += n;
+                }
+                TLRENDER_ASSERT(data == source.data);
+                TLRENDER_ASSERT(0 == prefetch->read(data.size(), data.data(), 1));
+                TLRENDER_ASSERT(!source.unaligned);
+                TLRENDER_ASSERT(source.maxInFlight <= options.maxInFlight);
+
+                // Each block is only read once, and the blocks after the first
+                // are read ahead.
+                const auto stats = prefetch->getStats();
+                TLRENDER_ASSERT(11 == stats.blockCount);
+                TLRENDER_ASSERT(1050 == stats.byteCount);
+                TLRENDER_ASSERT(1 == stats.misses);
+                TLRENDER_ASSERT(stats.hits + stats.waits > 0);
+                TLRENDER_ASSERT(11 == source.reads);
+
+                // Read randomly.
+                for (size_t i : { 900, 0, 500, 1049, 250 })
+                {
+                    uint8_t value = 0;
+                    TLRENDER_ASSERT(1 == prefetch->read(i, &value, 1));
+                    TLRENDER_ASSERT(source.data[i] == value);
+                }
+            }
+        }
+
+        void FilePrefetchTest::_throttled()
+        {
+            // Compare reading a slow file with and without prefetching.
+            const std::chrono::milliseconds latency(10);
+            const size_t blockSize = 1000;
+            const size_t blockCount = 12;
+            std::chrono::duration<double> noPrefetchTime;
+            {
+                PrefetchOptions options;
+                options.blockSize = blockSize;
+                options.readAhead = 0;
+                options.maxInFlight = 1;
+                Source source(blockSize * blockCount, blockSize);
+                source.latency = latency;
+                auto prefetch = PrefetchRead::create(
+                    "throttled",
+                    source.data.size(),
+                    source.getCallback(),
+                    options);
+                const auto t0 = std::chrono::steady_clock::now();
+                std::vector<uint8_t> data(source.data.size());
+                prefetch->read(0, data.data(), data.size());
+                noPrefetchTime = std::chrono::steady_clock::now() - t0;
+                TLRENDER_ASSERT(data == source.data);
+                TLRENDER_ASSERT(1 == source.maxInFlight);
+            }
+            {
+                PrefetchOptions options;
+                options.blockSize = blockSize;
+                options.readAhead = blockCount;
+                options.maxInFlight = 4;
+                Source source(blockSize * blockCount, blockSize);
+                source.latency = latency;
+                auto prefetch = PrefetchRead::create(
+                    "throttled",
+                    source.data.size(),
+                    source.getCallback(),
+                    options);
+                const auto t0 = std::chrono::steady_clock::now();
+                prefetch->prefetch(0, source.data.size());
+                std::vector<uint8_t> data(source.data.size());
+                prefetch->read(0, data.data(), data.size());
+                const std::chrono::duration<double> prefetchTime = std::chrono::steady_clock::now() - t0;
+                TLRENDER_ASSERT(data == source.data);
+                TLRENDER_ASSERT(source.maxInFlight > 1);
+                TLRENDER_ASSERT(source.maxInFlight <= options.maxInFlight);
+                TLRENDER_ASSERT(prefetchTime < noPrefetchTime);
+                const auto stats = prefetch->getStats();
+                TLRENDER_ASSERT(stats.getLatency() > 0.0);
+                TLRENDER_ASSERT(stats.getThroughput() > 0.0);
+                TLRENDER_ASSERT(stats.maxReadTime >= stats.getLatency());
+                std::stringstream ss;
+                ss << "Prefetch throughput: " << stats.getThroughput() << " B/s, " <<
+                    "latency: " << stats.getLatency() * 1000.0 << " ms, " <<
+                    "time: " << prefetchTime.count() << " s (" <<
+                    noPrefetchTime.count() << " s without prefetching)";
+                _print(ss.str());
+            }
+        }
+
+        void FilePrefetchTest::_errors()
+        {
+            {
+                PrefetchOptions options;
+                options.blockSize = 100;
+                auto prefetch = PrefetchRead::create(
+                    "error",
+                    1000,
+                    [](size_t pos, uint8_t*, size_t)
+                    {
+                        if (pos >= 500)
+                        {
+                            throw std::runtime_error("Cannot read");
+                        }
+                    },
+                    options);
+                std::vector<uint8_t> data(1000);
+                TLRENDER_ASSERT(100 == prefetch->read(0, data.data(), 100));
+                try
+                {
+                    prefetch->read(500, data.data(), 100);
+                    TLRENDER_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {}
+            }
+            try
+            {
+                PrefetchRead::create("FilePrefetchTest_NonExistent");
+                TLRENDER_ASSERT(false);
+            }
+            catch (const std::exception&)
+            {}
+        }
+
+        void FilePrefetchTest::_fileIO()
+        {
+            const std::string fileName = Path(createTempDir(), "FilePrefetchTest.bin").get();
+            const std::vector<uint8_t> data = createData(100000);
+            {
+                auto io = FileIO::create(fileName, Mode::Write);
+                io->write(data.data(), data.size());
+            }
+            PrefetchOptions options;
+            options.blockSize = 4096;
+            auto prefetch = PrefetchRead::create(fileName, options);
+            TLRENDER_ASSERT(data.size() == prefetch->getSize());
+            auto io = FileIO::create(prefetch);
+            TLRENDER_ASSERT(io->isOpen());
+            TLRENDER_ASSERT(io->getFileName() == fileName);
+            TLRENDER_ASSERT(io->getSize() == data.size());
+            TLRENDER_ASSERT(!io->getMemoryStart());
+            uint8_t u8 = 0;
+            io->readU8(&u8);
+            TLRENDER_ASSERT(data[0] == u8);
+            TLRENDER_ASSERT(1 == io->getPos());
+            io->setPos(5000);
+            std::vector<uint8_t> buf(10000);
+            io->read(buf.data(), buf.size());
+            TLRENDER_ASSERT(std::equal(buf.begin(), buf.end(), data.begin() + 5000));
+            io->seek(10);
+            TLRENDER_ASSERT(15010 == io->getPos());
+            io->readU8(&u8);
+            TLRENDER_ASSERT(data[15010] == u8);
+            io->setPos(data.size());
+            TLRENDER_ASSERT(io->isEOF());
+            try
+            {
+                io->readU8(&u8);
+                TLRENDER_ASSERT(false);
+            }
+            catch (const std::exception&)
+            {}
+            try
+            {
+                io->setPos(data.size() + 1);
+                TLRENDER_ASSERT(false);
+            }
+            catch (const std::exception&)
+            {}
+        }
+
+        void FilePrefetchTest::_pool()
+        {
+            auto pool = PrefetchPool::create(2);
+            TLRENDER_ASSERT(2 == pool->getThreadCount());
+
+            // Read several files with the same pool, like the frames of an
+            // image sequence.
+            PrefetchOptions options;
+            options.blockSize = 100;
+            options.maxInFlight = 4;
+            Source source(1000, options.blockSize);
+            source.latency = std::chrono::milliseconds(1);
+            std::vector<std::shared_ptr<PrefetchRead> > prefetches;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                prefetches.push_back(PrefetchRead::create(
+                    "pool",
+                    source.data.size(),
+                    source.getCallback(),
+                    options,
+                    pool));
+                prefetches.back()->prefetch(0, source.data.size());
+            }
+            for (const auto& prefetch : prefetches)
+            {
+                std::vector<uint8_t> data(source.data.size());
+                TLRENDER_ASSERT(data.size() == prefetch->read(0, data.data(), data.size()));
+                TLRENDER_ASSERT(data == source.data);
+                TLRENDER_ASSERT(10 == prefetch->getStats().blockCount);
+            }
+            TLRENDER_ASSERT(source.maxInFlight <= pool->getThreadCount());
+
+            // Destroy a reader with reads pending, the pool can still be
+            // used by the other readers.
+            {
+                auto prefetch = PrefetchRead::create(
+                    "pool",
+                    source.data.size(),
+                    source.getCallback(),
+                    options,
+                    pool);
+                prefetch->prefetch(0, source.data.size());
+            }
+            {
+                auto prefetch = PrefetchRead::create(
+                    "pool",
+                    source.data.size(),
+                    source.getCallback(),
+                    options,
+                    pool);
+                uint8_t value = 0;
+                TLRENDER_ASSERT(1 == prefetch->read(999, &value, 1));
+                TLRENDER_ASSERT(source.data[999] == value);
+            }
+        }
+    }
+}
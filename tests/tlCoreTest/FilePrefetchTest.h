@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace core_tests
+    {
+        class FilePrefetchTest : public tests::ITest
+        {
+        protected:
+            FilePrefetchTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<FilePrefetchTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _read();
+            void _throttled();
+            void _errors();
+            void _fileIO();
+            void _pool();
+        };
+    }
+}
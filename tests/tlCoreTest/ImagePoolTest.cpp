@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCoreTest/ImagePoolTest.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/Image.h>
+#include <tlCore/ImagePool.h>
+
+#include <thread>
+
+using namespace tl::image;
+
+namespace tl
+{
+    namespace core_tests
+    {
+        ImagePoolTest::ImagePoolTest(const std::shared_ptr<system::Context>& context) :
+            ITest("core_tests::ImagePoolTest", context)
+        {}
+
+        std::shared_ptr<ImagePoolTest> ImagePoolTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<ImagePoolTest>(new ImagePoolTest(context));
+        }
+
+        void ImagePoolTest::run()
+        {
+            {
+                TLRENDER_ASSERT(4096 == ImagePool::getSizeClass(0));
+                TLRENDER_ASSERT(4096 == ImagePool::getSizeClass(4096));
+                for (size_t i : { 4097, 10000, 1920 * 1080 * 3, 3840 * 2160 * 4 * 4 })
+                {
+                    const size_t sizeClass = ImagePool::getSizeClass(i);
+                    TLRENDER_ASSERT(sizeClass >= i);
+                    TLRENDER_ASSERT(sizeClass <= i + i / 4);
+                }
+            }
+            {
+                auto pool = ImagePool::create(memory::megabyte);
+                TLRENDER_ASSERT(memory::megabyte == pool->getMax());
+                TLRENDER_ASSERT(ImagePoolStats() == pool->getStats());
+                const size_t sizeClass = ImagePool::getSizeClass(100000);
+                auto a = pool->allocate(100000);
+                TLRENDER_ASSERT(a);
+                TLRENDER_ASSERT(0 == reinterpret_cast<uintptr_t>(a.get()) % imagePoolAlignment);
+                uint8_t* p = a.get();
+                auto stats = pool->getStats();
+                TLRENDER_ASSERT(0 == stats.hits);
+                TLRENDER_ASSERT(1 == stats.misses);
+                TLRENDER_ASSERT(sizeClass == stats.inUseByteCount);
+                a.reset();
+                stats = pool->getStats();
+                TLRENDER_ASSERT(0 == stats.inUseByteCount);
+                TLRENDER_ASSERT(sizeClass == stats.byteCount);
+                TLRENDER_ASSERT(1 == stats.bufferCount);
+                a = pool->allocate(100000 - 1);
+                TLRENDER_ASSERT(p == a.get());
+                stats = pool->getStats();
+                TLRENDER_ASSERT(1 == stats.hits);
+                TLRENDER_ASSERT(0 == stats.bufferCount);
+                a.reset();
+                pool->clear();
+                stats = pool->getStats();
+                TLRENDER_ASSERT(0 == stats.byteCount);
+                TLRENDER_ASSERT(0 == stats.bufferCount);
+            }
+            {
+                auto pool = ImagePool::create(memory::megabyte);
+                std::vector<std::shared_ptr<uint8_t> > buffers;
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    buffers.push_back(pool->allocate(512 * memory::kilobyte));
+                }
+                buffers.clear();
+                auto stats = pool->getStats();
+                TLRENDER_ASSERT(stats.byteCount <= memory::megabyte);
+                TLRENDER_ASSERT(2 == stats.bufferCount);
+                pool->setMax(0);
+                stats = pool->getStats();
+                TLRENDER_ASSERT(0 == stats.bufferCount);
+            }
+            {
+                auto pool = ImagePool::create();
+                auto a = pool->allocate(100000);
+                pool.reset();
+                a.reset();
+            }
+            {
+                auto pool = ImagePool::create();
+                std::vector<std::thread> threads;
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    threads.push_back(std::thread(
+                        [pool]
+                        {
+                            for (size_t j = 0; j < 100; ++j)
+                            {
+                                auto a = pool->allocate(100000 + j % 3);
+                                a.get()[0] = 0;
+                            }
+                        }));
+                }
+                for (auto& thread : threads)
+                {
+                    thread.join();
+                }
+                const auto stats = pool->getStats();
+                TLRENDER_ASSERT(400 == stats.hits + stats.misses);
+                TLRENDER_ASSERT(0 == stats.inUseByteCount);
+            }
+            {
+                auto poolPrev = getImagePool();
+                auto pool = ImagePool::create();
+                setImagePool(pool);
+                TLRENDER_ASSERT(pool == getImagePool());
+                const Info info(1920, 1080, PixelType::RGBA_U8);
+                auto image = Image::create(info);
+                uint8_t* p = image->getData();
+                image.reset();
+                image = Image::create(info);
+                TLRENDER_ASSERT(p == image->getData());
+                TLRENDER_ASSERT(1 == pool->getStats().hits);
+                image = Image::create(1, 1, PixelType::L_U8);
+                TLRENDER_ASSERT(image->getData());
+                setImagePool(nullptr);
+                image = Image::create(info);
+                TLRENDER_ASSERT(image->getData());
+                TLRENDER_ASSERT(1 == pool->getStats().hits);
+                setImagePool(poolPrev);
+            }
+        }
+    }
+}
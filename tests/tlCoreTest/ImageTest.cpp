@@ -8,6 +8,10 @@
 #include <tlCore/Image.h>
 #include <tlCore/StringFormat.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 using namespace tl::image;
 
 namespace tl
@@ -30,6 +34,8 @@ namespace tl
             _util();
             _info();
             _image();
+            _proxy();
+            _region();
             _serialize();
         }
 
@@ -211,6 +217,214 @@ namespace tl
                 TLRENDER_ASSERT(image->getHeight() == 2);
                 TLRENDER_ASSERT(image->getPixelType() == PixelType::L_U8);
             }
+            {
+                const Info info(4, 2, PixelType::YUV_420P_U8);
+                TLRENDER_ASSERT(3 == getPlaneCount(info.pixelType));
+                TLRENDER_ASSERT(Size(2, 1) == getPlaneSize(info, 1));
+                TLRENDER_ASSERT(2 == getPlaneRowByteCount(info, 1));
+                auto image = Image::create(info);
+                TLRENDER_ASSERT(!image->hasExternalData());
+                const auto& planes = image->getPlanes();
+                TLRENDER_ASSERT(3 == planes.size());
+                TLRENDER_ASSERT(planes[0].data == image->getData());
+                TLRENDER_ASSERT(4 == planes[0].stride);
+                TLRENDER_ASSERT(planes[1].data == image->getData() + 4 * 2);
+                TLRENDER_ASSERT(planes[2].data == image->getData() + 4 * 2 + 2);
+            }
+            {
+                Info info(2, 2, PixelType::RGB_U8);
+                info.layout.alignment = 4;
+                TLRENDER_ASSERT(8 == getPlaneRowByteCount(info, 0));
+                auto storage = std::make_shared<std::vector<uint8_t> >(16 * 2);
+                for (size_t i = 0; i < storage->size(); ++i)
+                {
+                    (*storage)[i] = i;
+                }
+                Plane plane;
+                plane.data = storage->data();
+                plane.stride = 16;
+                std::weak_ptr<std::vector<uint8_t> > weak(storage);
+                auto image = Image::create(info, { plane }, storage);
+                storage.reset();
+                TLRENDER_ASSERT(!weak.expired());
+                TLRENDER_ASSERT(image->hasExternalData());
+                TLRENDER_ASSERT(image->getPlanes()[0].stride == 16);
+                const uint8_t* data = static_cast<const Image*>(image.get())->getData();
+                TLRENDER_ASSERT(data != image->getPlanes()[0].data);
+                TLRENDER_ASSERT(0 == data[0]);
+                TLRENDER_ASSERT(5 == data[5]);
+                TLRENDER_ASSERT(16 == data[8]);
+                TLRENDER_ASSERT(21 == data[13]);
+                TLRENDER_ASSERT(data == image->getData());
+                image.reset();
+                TLRENDER_ASSERT(weak.expired());
+            }
+            {
+                auto image = Image::create(1, 1, PixelType::L_U8);
+                TLRENDER_ASSERT(image->getTags().empty());
+                TLRENDER_ASSERT(!image->getSharedTags());
+                TLRENDER_ASSERT(!image->getHDR());
+                const Tags tags = { { "Key", "Value" } };
+                image->setTags(tags);
+                TLRENDER_ASSERT(tags == image->getTags());
+                auto image2 = Image::create(1, 1, PixelType::L_U8);
+                image2->setTags(image->getSharedTags());
+                TLRENDER_ASSERT(image->getSharedTags() == image2->getSharedTags());
+                image2->setTags(Tags());
+                TLRENDER_ASSERT(image2->getTags().empty());
+                TLRENDER_ASSERT(tags == image->getTags());
+                auto hdr = std::make_shared<HDRData>();
+                hdr->eotf = HDR_EOTF::ST2084;
+                image->setHDR(hdr);
+                image2->setHDR(image->getHDR());
+                TLRENDER_ASSERT(image2->getHDR() == image->getHDR());
+                TLRENDER_ASSERT(HDR_EOTF::ST2084 == image2->getHDR()->eotf);
+            }
+        }
+
+        void ImageTest::_region()
+        {
+            {
+                auto image = Image::create(Size(100, 50), PixelType::RGBA_U8);
+                TLRENDER_ASSERT(!image->isRegion());
+                TLRENDER_ASSERT(Size(100, 50) == image->getDisplaySize());
+                TLRENDER_ASSERT(math::Box2i(0, 0, 200, 100) ==
+                    getDataBox(*image, math::Box2i(0, 0, 200, 100)));
+            }
+            {
+                auto image = Image::create(Size(25, 10), PixelType::RGBA_U8);
+                image->setRegion(Size(100, 50), math::Vector2i(50, 20));
+                TLRENDER_ASSERT(image->isRegion());
+                TLRENDER_ASSERT(Size(100, 50) == image->getDisplaySize());
+                TLRENDER_ASSERT(math::Vector2i(50, 20) == image->getDataPos());
+                TLRENDER_ASSERT(math::Box2i(100, 40, 50, 20) ==
+                    getDataBox(*image, math::Box2i(0, 0, 200, 100)));
+                image->setRegion(Size(25, 10), math::Vector2i());
+                TLRENDER_ASSERT(!image->isRegion());
+            }
+        }
+
+        void ImageTest::_proxy()
+        {
+            {
+                TLRENDER_ASSERT(Size(1920, 1080) == getProxySize(Size(1920, 1080), 0));
+                TLRENDER_ASSERT(Size(960, 540) == getProxySize(Size(1920, 1080), 1));
+                TLRENDER_ASSERT(Size(3, 2) == getProxySize(Size(11, 5), 2));
+            }
+            {
+                // Compare the proxies with a reference box filter. The width
+                // is odd and large enough to use the SIMD kernels.
+                const Size size(37, 9);
+                for (auto pixelType : { PixelType::RGBA_U8, PixelType::RGB_U8, PixelType::RGBA_F32, PixelType::L_U16 })
+                {
+                    auto image = Image::create(size, pixelType);
+                    const size_t channels = getChannelCount(pixelType);
+                    const size_t count = size.w * size.h * channels;
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        switch (pixelType)
+                        {
+                        case PixelType::RGBA_U8:
+                        case PixelType::RGB_U8:
+                            image->getData()[i] = (i * 37) % 256;
+                            break;
+                        case PixelType::RGBA_F32:
+                            reinterpret_cast<float*>(image->getData())[i] = (i % 100) / 100.F;
+                            break;
+                        case PixelType::L_U16:
+                            reinterpret_cast<uint16_t*>(image->getData())[i] = (i * 1237) % 65536;
+                            break;
+                        default: break;
+                        }
+                    }
+                    image->setTags({ { "Name", "Value" } });
+                    const auto proxy = createProxy(image, 1);
+                    TLRENDER_ASSERT(proxy);
+                    TLRENDER_ASSERT(getProxySize(size, 1) == proxy->getSize());
+                    TLRENDER_ASSERT(pixelType == proxy->getPixelType());
+                    TLRENDER_ASSERT(image->getSharedTags() == proxy->getSharedTags());
+                    for (int y = 0; y < proxy->getHeight(); ++y)
+                    {
+                        for (int x = 0; x < proxy->getWidth(); ++x)
+                        {
+                            const int x0 = x * 2;
+                            const int x1 = std::min(x * 2 + 1, size.w - 1);
+                            const int y0 = y * 2;
+                            const int y1 = std::min(y * 2 + 1, size.h - 1);
+                            for (size_t c = 0; c < channels; ++c)
+                            {
+                                const size_t i00 = (y0 * size.w + x0) * channels + c;
+                                const size_t i01 = (y0 * size.w + x1) * channels + c;
+                                const size_t i10 = (y1 * size.w + x0) * channels + c;
+                                const size_t i11 = (y1 * size.w + x1) * channels + c;
+                                const size_t o = (y * proxy->getWidth() + x) * channels + c;
+                                switch (pixelType)
+                                {
+                                case PixelType::RGBA_U8:
+                                case PixelType::RGB_U8:
+                                {
+                                    const uint8_t* in = image->getData();
+                                    TLRENDER_ASSERT(proxy->getData()[o] ==
+                                        (in[i00] + in[i01] + in[i10] + in[i11] + 2) / 4);
+                                    break;
+                                }
+                                case PixelType::RGBA_F32:
+                                {
+                                    const float* in = reinterpret_cast<const float*>(image->getData());
+                                    const float v = reinterpret_cast<const float*>(proxy->getData())[o];
+                                    TLRENDER_ASSERT(std::abs(v - (in[i00] + in[i01] + in[i10] + in[i11]) / 4.F) < 1e-6F);
+                                    break;
+                                }
+                                case PixelType::L_U16:
+                                {
+                                    const uint16_t* in = reinterpret_cast<const uint16_t*>(image->getData());
+                                    TLRENDER_ASSERT(reinterpret_cast<const uint16_t*>(proxy->getData())[o] ==
+                                        (in[i00] + in[i01] + in[i10] + in[i11] + 2) / 4);
+                                    break;
+                                }
+                                default: break;
+                                }
+                            }
+                        }
+                    }
+                    TLRENDER_ASSERT(getProxySize(size, 3) == createProxy(image, 3)->getSize());
+                }
+            }
+            for (const auto& size : { Size(16, 16), Size(15, 9) })
+            {
+                // The planes of planar YUV images are halved separately.
+                auto image = Image::create(size, PixelType::YUV_420P_U8);
+                TLRENDER_ASSERT(image == createProxy(image, 0));
+                uint8_t* data = image->getData();
+                for (size_t i = 0; i < image->getPlanes().size(); ++i)
+                {
+                    const size_t byteCount =
+                        getPlaneRowByteCount(image->getInfo(), i) *
+                        getPlaneSize(image->getInfo(), i).h;
+                    std::memset(data, (i + 1) * 50, byteCount);
+                    data += byteCount;
+                }
+                const auto proxy = createProxy(image, 1);
+                TLRENDER_ASSERT(proxy);
+                TLRENDER_ASSERT(getProxySize(size, 1) == proxy->getSize());
+                TLRENDER_ASSERT(PixelType::YUV_420P_U8 == proxy->getPixelType());
+                const auto& proxyPlanes = proxy->getPlanes();
+                for (size_t i = 0; i < proxyPlanes.size(); ++i)
+                {
+                    const Size planeSize = getPlaneSize(proxy->getInfo(), i);
+                    for (int y = 0; y < planeSize.h; ++y)
+                    {
+                        for (int x = 0; x < planeSize.w; ++x)
+                        {
+                            TLRENDER_ASSERT((i + 1) * 50 == proxyPlanes[i].data[y * proxyPlanes[i].stride + x]);
+                        }
+                    }
+                }
+            }
+            {
+                auto image = Image::create(Size(16, 16), PixelType::RGB_U10);
+                TLRENDER_ASSERT(!createProxy(image, 1));
+            }
         }
 
         void ImageTest::_serialize()
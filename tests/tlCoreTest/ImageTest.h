@@ -26,6 +26,8 @@ namespace tl
             void _info();
             void _util();
             void _image();
+            void _proxy();
+            void _region();
             void _serialize();
         };
     }
@@ -8,6 +8,9 @@
 #include <tlCore/LRUCache.h>
 #include <tlCore/Memory.h>
 
+#include <string>
+#include <thread>
+
 using namespace tl::memory;
 
 namespace tl
@@ -67,6 +70,20 @@ namespace tl
                 TLRENDER_ASSERT(std::vector<int>({ 1, 3, 4 }) == c.getKeys());
                 TLRENDER_ASSERT(std::vector<int>({ 2, 4, 5 }) == c.getValues());
             }
+            {
+                LRUCache<int, int> c;
+                c.setMax(3);
+                c.add(0, 1);
+                c.add(1, 2);
+                c.add(2, 3);
+                int v = 0;
+                TLRENDER_ASSERT(c.peek(0, v));
+                TLRENDER_ASSERT(1 == v);
+                TLRENDER_ASSERT(!c.peek(3, v));
+                c.add(3, 4);
+                TLRENDER_ASSERT(!c.contains(0));
+                TLRENDER_ASSERT(c.contains(1));
+            }
             {
                 LRUCache<int, int> c;
                 c.setMax(3 * memory::megabyte);
@@ -87,6 +104,61 @@ namespace tl
                 TLRENDER_ASSERT(std::vector<int>({ 1, 3, 4 }) == c.getKeys());
                 TLRENDER_ASSERT(std::vector<int>({ 2, 4, 5 }) == c.getValues());
             }
+            {
+                LRUCache<std::string, int> c;
+                c.setMax(3);
+                c.add("a", 1);
+                c.add("b", 2);
+                c.add("a", 3, 2);
+                TLRENDER_ASSERT(2 == c.getCount());
+                TLRENDER_ASSERT(3 == c.getSize());
+                int v = 0;
+                TLRENDER_ASSERT(c.get("a", v));
+                TLRENDER_ASSERT(3 == v);
+                c.add("c", 4);
+                TLRENDER_ASSERT(!c.contains("b"));
+                TLRENDER_ASSERT(c.contains("a"));
+                TLRENDER_ASSERT(c.contains("c"));
+                c.remove("a");
+                TLRENDER_ASSERT(1 == c.getSize());
+                c.clear();
+                TLRENDER_ASSERT(0 == c.getSize());
+                TLRENDER_ASSERT(0 == c.getCount());
+            }
+            {
+                ConcurrentLRUCache<int, int> c(4);
+                c.setMax(100);
+                TLRENDER_ASSERT(100 == c.getMax());
+                std::vector<std::thread> threads;
+                for (int i = 0; i < 4; ++i)
+                {
+                    threads.push_back(std::thread(
+                        [&c, i]
+                        {
+                            for (int j = 0; j < 1000; ++j)
+                            {
+                                c.add(i * 1000 + j, j);
+                                int v = 0;
+                                c.get(i * 1000 + j, v);
+                            }
+                        }));
+                }
+                for (auto& thread : threads)
+                {
+                    thread.join();
+                }
+                TLRENDER_ASSERT(c.getSize() <= c.getMax());
+                TLRENDER_ASSERT(c.getCount() > 0);
+                c.add(-1, 1);
+                TLRENDER_ASSERT(c.contains(-1));
+                int v = 0;
+                TLRENDER_ASSERT(c.get(-1, v));
+                TLRENDER_ASSERT(1 == v);
+                c.remove(-1);
+                TLRENDER_ASSERT(!c.contains(-1));
+                c.clear();
+                TLRENDER_ASSERT(0 == c.getSize());
+            }
         }
     }
 }
@@ -8,6 +8,7 @@
 #include <tlIO/System.h>
 
 #include <tlCore/Assert.h>
+#include <tlCore/StringFormat.h>
 
 #include <sstream>
 
@@ -18,7 +19,7 @@ namespace tl
     namespace io_tests
     {
         CineonTest::CineonTest(const std::shared_ptr<system::Context>& context) :
-            ITest("io_tests::CineonTest", context)
+            ISequenceTest("io_tests::CineonTest", context)
         {}
 
         std::shared_ptr<CineonTest> CineonTest::create(const std::shared_ptr<system::Context>& context)
@@ -30,6 +31,8 @@ namespace tl
         {
             _enums();
             _io();
+            _headerTemplate();
+            _proxy();
         }
 
         void CineonTest::_enums()
@@ -201,5 +204,37 @@ namespace tl
                 }
             }
         }
+
+        void CineonTest::_headerTemplate()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<cineon::Plugin>();
+
+            // The frame tags change per frame, check that they are updated
+            // for the frames that match the header template.
+            std::vector<image::Tags> tags;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                std::stringstream ss;
+                ss << "1:2:3:4:" << (5 + i);
+                tags.push_back(
+                    {
+                        { "Film Frame", std::to_string(20 + i) },
+                        { "Keycode", ss.str() }
+                    });
+            }
+            ISequenceTest::_headerTemplate<cineon::Read>(
+                plugin,
+                ".cin",
+                image::PixelType::RGB_U10,
+                tags);
+        }
+
+        void CineonTest::_proxy()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<cineon::Plugin>();
+            ISequenceTest::_proxy(plugin, ".cin", image::PixelType::RGB_U10);
+        }
     }
 }
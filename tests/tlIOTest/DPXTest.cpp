@@ -8,6 +8,7 @@
 #include <tlIO/System.h>
 
 #include <tlCore/Assert.h>
+#include <tlCore/StringFormat.h>
 
 #include <sstream>
 
@@ -18,7 +19,7 @@ namespace tl
     namespace io_tests
     {
         DPXTest::DPXTest(const std::shared_ptr<system::Context>& context) :
-            ITest("io_tests::DPXTest", context)
+            ISequenceTest("io_tests::DPXTest", context)
         {}
 
         std::shared_ptr<DPXTest> DPXTest::create(const std::shared_ptr<system::Context>& context)
@@ -30,6 +31,9 @@ namespace tl
         {
             _enums();
             _io();
+            _headerTemplate();
+            _proxy();
+            _batchRead();
         }
 
         void DPXTest::_enums()
@@ -195,7 +199,8 @@ namespace tl
                 { "DPX/Version", "2.0" },
                 { "DPX/Endian", "Auto" },
                 { "DPX/Endian", "MSB" },
-                { "DPX/Endian", "LSB" }
+                { "DPX/Endian", "LSB" },
+                { "SequenceIO/BatchRead", "1" }
             };
 
             for (const auto& fileName : fileNames)
@@ -242,5 +247,48 @@ namespace tl
                 }
             }
         }
+
+        void DPXTest::_headerTemplate()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<dpx::Plugin>();
+
+            // The frame tags change per frame, check that they are updated
+            // for the frames that match the header template.
+            std::vector<image::Tags> tags;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                std::stringstream ss;
+                ss << "01:00:00:0" << i;
+                tags.push_back(
+                    {
+                        { "Creator", "Charlie" },
+                        { "Film Frame", std::to_string(20 + i) },
+                        { "Timecode", ss.str() }
+                    });
+            }
+            ISequenceTest::_headerTemplate<dpx::Read>(
+                plugin,
+                ".dpx",
+                image::PixelType::RGB_U10,
+                tags);
+        }
+
+        void DPXTest::_proxy()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<dpx::Plugin>();
+            ISequenceTest::_proxy(plugin, ".dpx", image::PixelType::RGB_U10);
+        }
+
+        void DPXTest::_batchRead()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<dpx::Plugin>();
+            ISequenceTest::_batchRead(
+                plugin,
+                ".dpx",
+                image::Info(16, 16, image::PixelType::RGB_U10));
+        }
     }
 }
@@ -4,13 +4,13 @@
 
 #pragma once
 
-#include <tlTestLib/ITest.h>
+#include <tlIOTest/ISequenceTest.h>
 
 namespace tl
 {
     namespace io_tests
     {
-        class DPXTest : public tests::ITest
+        class DPXTest : public ISequenceTest
         {
         protected:
             DPXTest(const std::shared_ptr<system::Context>&);
@@ -23,6 +23,9 @@ namespace tl
         private:
             void _enums();
             void _io();
+            void _headerTemplate();
+            void _proxy();
+            void _batchRead();
         };
     }
 }
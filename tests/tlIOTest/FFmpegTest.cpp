@@ -9,9 +9,14 @@
 
 #include <tlCore/Assert.h>
 #include <tlCore/FileIO.h>
+#include <tlCore/StringFormat.h>
 
 #include <array>
+#include <cmath>
+#include <functional>
+#include <map>
 #include <sstream>
+#include <thread>
 
 using namespace tl::io;
 
@@ -33,6 +38,12 @@ namespace tl
             _enums();
             _util();
             _io();
+            _scrub();
+            _reverse();
+            _decoders();
+            _writeAsync();
+            _writeAudio();
+            _prefetch();
         }
 
         void FFmpegTest::_enums()
@@ -115,6 +126,14 @@ namespace tl
                 {
                     const auto videoData = read->readVideo(otime::RationalTime(i, 24.0)).get();
                 }
+
+                // The proxy option is ignored, movies are read at full
+                // resolution.
+                Options proxyOptions;
+                proxyOptions["Proxy"] = "2";
+                const auto videoData = read->readVideo(otime::RationalTime(0.0, 24.0), proxyOptions).get();
+                TLRENDER_ASSERT(videoData.image);
+                TLRENDER_ASSERT(videoData.image->getSize() == image->getSize());
             }
 
             void readError(
@@ -143,6 +162,51 @@ namespace tl
                 //! \bug This causes the test to hang.
                 //const auto videoData = read->readVideo(otime::RationalTime(0.0, 24.0)).get();
             }
+
+            const otime::RationalTime longGOPDuration(96.0, 24.0);
+
+            // Write a long-GOP movie.
+            file::Path writeLongGOP(
+                const std::shared_ptr<io::IPlugin>& plugin,
+                const std::string& fileName)
+            {
+                const file::Path path(fileName);
+                const auto imageInfo = plugin->getWriteInfo(image::Info(80, 60, image::PixelType::RGB_U8));
+                auto image = image::Image::create(imageInfo);
+                image->zero();
+                write(plugin, image, path, imageInfo, image::Tags(), longGOPDuration, Options());
+                return path;
+            }
+
+            // Open a movie, wait for the keyframe index which is built in
+            // the background, play it, and get the decoder statistics.
+            ffmpeg::ReadStats measure(
+                const std::shared_ptr<io::IPlugin>& plugin,
+                const std::shared_ptr<Cache>& cache,
+                const file::Path& path,
+                const Options& options,
+                const std::function<void(const std::shared_ptr<ffmpeg::Read>&)>& play)
+            {
+                cache->clear();
+                auto read = std::dynamic_pointer_cast<ffmpeg::Read>(plugin->read(path, options));
+                TLRENDER_ASSERT(read);
+                read->getInfo().get();
+                while (!read->isIndexReady())
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                play(read);
+                const ffmpeg::ReadStats out = read->getStats();
+                cache->clear();
+                return out;
+            }
+
+            std::string getLabel(const ffmpeg::ReadStats& stats)
+            {
+                return string::Format("{0} seeks, {1} decoded frames per displayed frame").
+                    arg(stats.videoSeeks).
+                    arg(stats.getDecodedPerRequest());
+            }
         }
 
         void FFmpegTest::_io()
@@ -234,5 +298,298 @@ namespace tl
                 }
             }
         }
+
+        void FFmpegTest::_scrub()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<ffmpeg::Plugin>();
+            const file::Path path = writeLongGOP(plugin, "FFmpegTest_Scrub.mp4");
+
+            // Scrub forward two frames at a time, then backward, and compare
+            // the number of decoded frames per displayed frame with and
+            // without the index.
+            std::vector<otime::RationalTime> times;
+            for (int i = 0; i < static_cast<int>(longGOPDuration.value()); i += 2)
+            {
+                times.push_back(otime::RationalTime(i, 24.0));
+            }
+            for (int i = static_cast<int>(longGOPDuration.value()) - 1; i >= 0; i -= 5)
+            {
+                times.push_back(otime::RationalTime(i, 24.0));
+            }
+            std::map<bool, ffmpeg::ReadStats> stats;
+            for (const bool index : { false, true })
+            {
+                Options options;
+                options["FFmpeg/Index"] = string::Format("{0}").arg(index);
+                stats[index] = measure(
+                    plugin,
+                    system->getCache(),
+                    path,
+                    options,
+                    [times](const std::shared_ptr<ffmpeg::Read>& read)
+                    {
+                        for (const auto& time : times)
+                        {
+                            TLRENDER_ASSERT(read->readVideo(time).get().image);
+                        }
+                    });
+                TLRENDER_ASSERT(times.size() == stats[index].videoRequests);
+                _print(string::Format("Scrub index {0}: {1}").arg(index).arg(getLabel(stats[index])));
+            }
+            TLRENDER_ASSERT(stats[true].videoSeeks < stats[false].videoSeeks);
+            TLRENDER_ASSERT(stats[true].videoDecoded <= stats[false].videoDecoded);
+        }
+
+        void FFmpegTest::_reverse()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<ffmpeg::Plugin>();
+            const file::Path path = writeLongGOP(plugin, "FFmpegTest_Reverse.mp4");
+
+            // Play backward with and without the direction hint, and with a
+            // reverse buffer smaller than a GOP.
+            const std::vector<std::string> reverseBufferSizes = { "24", "24", "5" };
+            const std::vector<bool> hints = { false, true, true };
+            std::vector<ffmpeg::ReadStats> stats;
+            for (size_t i = 0; i < hints.size(); ++i)
+            {
+                Options options;
+                options["FFmpeg/ReverseBufferSize"] = reverseBufferSizes[i];
+                Options requestOptions;
+                if (hints[i])
+                {
+                    requestOptions["Direction"] = "Reverse";
+                }
+                stats.push_back(measure(
+                    plugin,
+                    system->getCache(),
+                    path,
+                    options,
+                    [requestOptions](const std::shared_ptr<ffmpeg::Read>& read)
+                    {
+                        for (int j = static_cast<int>(longGOPDuration.value()) - 1; j >= 0; --j)
+                        {
+                            const otime::RationalTime time(j, 24.0);
+                            const auto videoData = read->readVideo(time, requestOptions).get();
+                            TLRENDER_ASSERT(videoData.image);
+                            TLRENDER_ASSERT(videoData.time == time);
+                        }
+
+                        // Switch back to forward playback.
+                        for (int j = 0; j < 10; ++j)
+                        {
+                            TLRENDER_ASSERT(read->readVideo(otime::RationalTime(j, 24.0)).get().image);
+                        }
+                    }));
+                _print(string::Format("Reverse hint {0}, buffer {1}: {2}").
+                    arg(hints[i]).
+                    arg(reverseBufferSizes[i]).
+                    arg(getLabel(stats[i])));
+            }
+            TLRENDER_ASSERT(stats[1].videoSeeks < stats[0].videoSeeks);
+            TLRENDER_ASSERT(stats[1].videoDecoded < stats[0].videoDecoded);
+            TLRENDER_ASSERT(stats[2].videoSeeks >= stats[1].videoSeeks);
+        }
+
+        void FFmpegTest::_decoders()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<ffmpeg::Plugin>();
+            const file::Path path = writeLongGOP(plugin, "FFmpegTest_Decoders.mp4");
+
+            // Play two time offsets of the movie at once, like comparing a
+            // movie with itself, with one and two decoders.
+            const int offset = static_cast<int>(longGOPDuration.value()) / 2;
+            std::map<size_t, ffmpeg::ReadStats> stats;
+            for (const size_t decoderCount : { 1, 2 })
+            {
+                Options options;
+                options["FFmpeg/VideoDecoderCount"] = string::Format("{0}").arg(decoderCount);
+                stats[decoderCount] = measure(
+                    plugin,
+                    system->getCache(),
+                    path,
+                    options,
+                    [decoderCount, offset](const std::shared_ptr<ffmpeg::Read>& read)
+                    {
+                        for (int i = 0; i < offset; ++i)
+                        {
+                            auto a = read->readVideo(otime::RationalTime(i, 24.0));
+                            auto b = read->readVideo(otime::RationalTime(i + offset, 24.0));
+                            TLRENDER_ASSERT(a.get().image);
+                            TLRENDER_ASSERT(b.get().image);
+                        }
+                        TLRENDER_ASSERT(decoderCount == read->getDecoderStats().size());
+                    });
+                TLRENDER_ASSERT(static_cast<size_t>(offset * 2) == stats[decoderCount].videoRequests);
+                _print(string::Format("Decoders {0}: {1}").arg(decoderCount).arg(getLabel(stats[decoderCount])));
+            }
+            TLRENDER_ASSERT(stats[2].videoSeeks < stats[1].videoSeeks);
+            TLRENDER_ASSERT(stats[2].videoDecoded < stats[1].videoDecoded);
+        }
+
+        void FFmpegTest::_writeAsync()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<ffmpeg::Plugin>();
+
+            const auto imageInfo = plugin->getWriteInfo(image::Info(80, 60, image::PixelType::RGB_U8));
+            Info info;
+            info.video.push_back(imageInfo);
+            const otime::RationalTime duration(48.0, 24.0);
+            info.videoTime = otime::TimeRange(otime::RationalTime(0.0, 24.0), duration);
+            Options options;
+            options["FFmpeg/WriteAsync"] = "1";
+            options["FFmpeg/WriteThreadCount"] = "2";
+            options["FFmpeg/WriteQueueSize"] = "3";
+            {
+                // Write a movie asynchronously and read it back.
+                const file::Path path("FFmpegTest_WriteAsync.mp4");
+                auto write = plugin->write(path, info, options);
+                for (size_t i = 0; i < static_cast<size_t>(duration.value()); ++i)
+                {
+                    auto image = image::Image::create(imageInfo);
+                    image->zero();
+                    write->writeVideo(otime::RationalTime(i, 24.0), image);
+                }
+                write->finish();
+                write.reset();
+
+                auto read = plugin->read(path);
+                const auto ioInfo = read->getInfo().get();
+                TLRENDER_ASSERT(!ioInfo.video.empty());
+                TLRENDER_ASSERT(duration == ioInfo.videoTime.duration());
+                for (size_t i = 0; i < static_cast<size_t>(duration.value()); ++i)
+                {
+                    const auto videoData = read->readVideo(otime::RationalTime(i, 24.0)).get();
+                    TLRENDER_ASSERT(videoData.image);
+                }
+            }
+            {
+                // Errors are reported when finishing.
+                const file::Path path("FFmpegTest_WriteAsyncError.mp4");
+                auto write = plugin->write(path, info, options);
+                auto image = image::Image::create(80, 60, image::PixelType::YUV_420P_U8);
+                write->writeVideo(otime::RationalTime(0.0, 24.0), image);
+                try
+                {
+                    write->finish();
+                    TLRENDER_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {}
+            }
+        }
+
+        void FFmpegTest::_writeAudio()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<ffmpeg::Plugin>();
+
+            const auto imageInfo = plugin->getWriteInfo(image::Info(80, 60, image::PixelType::RGB_U8));
+            const otime::RationalTime duration(48.0, 24.0);
+            for (const double startTime : { 0.0, 86400.0 })
+            {
+                // The video time range may start anywhere, like the in/out
+                // range of a timeline, but the frames and audio are written
+                // in output time starting at zero.
+                Info info;
+                info.video.push_back(imageInfo);
+                info.videoTime = otime::TimeRange(otime::RationalTime(startTime, 24.0), duration);
+                info.audio = audio::Info(2, audio::DataType::S16, 44100);
+                for (const bool async : { false, true })
+                {
+                    // Write a movie with audio, one frame of audio per video
+                    // frame.
+                    const file::Path path(string::Format("FFmpegTest_WriteAudio_{0}_{1}.mp4").
+                        arg(startTime).
+                        arg(async));
+                    _print(path.get());
+                    Options options;
+                    options["FFmpeg/WriteAsync"] = string::Format("{0}").arg(async);
+                    auto write = plugin->write(path, info, options);
+                    auto image = image::Image::create(imageInfo);
+                    image->zero();
+                    for (size_t i = 0; i < static_cast<size_t>(duration.value()); ++i)
+                    {
+                        const otime::RationalTime time(i, 24.0);
+                        write->writeVideo(time, image);
+                        const otime::TimeRange timeRange(
+                            time.rescaled_to(info.audio.sampleRate),
+                            otime::RationalTime(1.0, 24.0).rescaled_to(info.audio.sampleRate));
+                        auto audio = audio::Audio::create(info.audio, timeRange.duration().value());
+                        audio->zero();
+                        write->writeAudio(timeRange, audio);
+                    }
+                    write->finish();
+                    write.reset();
+
+                    // Read it back, the audio should cover the same time
+                    // as the video.
+                    auto read = plugin->read(path);
+                    const auto ioInfo = read->getInfo().get();
+                    TLRENDER_ASSERT(!ioInfo.video.empty());
+                    TLRENDER_ASSERT(ioInfo.audio.isValid());
+                    TLRENDER_ASSERT(info.audio.channelCount == ioInfo.audio.channelCount);
+                    TLRENDER_ASSERT(info.audio.sampleRate == ioInfo.audio.sampleRate);
+                    TLRENDER_ASSERT(std::fabs(
+                        ioInfo.audioTime.duration().rescaled_to(1.0).value() -
+                        ioInfo.videoTime.duration().rescaled_to(1.0).value()) < .1);
+                    const auto audioData = read->readAudio(otime::TimeRange(
+                        ioInfo.audioTime.start_time(),
+                        otime::RationalTime(info.audio.sampleRate, info.audio.sampleRate))).get();
+                    TLRENDER_ASSERT(audioData.audio);
+                }
+            }
+        }
+
+        void FFmpegTest::_prefetch()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<ffmpeg::Plugin>();
+
+            const file::Path path("FFmpegTest_Prefetch.mp4");
+            const auto imageInfo = plugin->getWriteInfo(image::Info(80, 60, image::PixelType::RGB_U8));
+            auto image = image::Image::create(imageInfo);
+            image->zero();
+            const otime::RationalTime duration(48.0, 24.0);
+            write(plugin, image, path, imageInfo, image::Tags(), duration, Options());
+
+            // Read the movie through the prefetching reader, forward and in
+            // reverse.
+            system->getCache()->clear();
+            Options options;
+            options["FFmpeg/Prefetch"] = "1";
+            options["FFmpeg/PrefetchBlockSize"] = "4096";
+            options["FFmpeg/PrefetchReadAhead"] = "2";
+            options["FFmpeg/PrefetchMaxInFlight"] = "2";
+            auto read = std::dynamic_pointer_cast<ffmpeg::Read>(plugin->read(path, options));
+            TLRENDER_ASSERT(read);
+            const auto ioInfo = read->getInfo().get();
+            TLRENDER_ASSERT(!ioInfo.video.empty());
+            for (size_t i = 0; i < static_cast<size_t>(duration.value()); ++i)
+            {
+                const auto videoData = read->readVideo(otime::RationalTime(i, 24.0)).get();
+                TLRENDER_ASSERT(videoData.image);
+                TLRENDER_ASSERT(videoData.image->getSize() == image->getSize());
+            }
+            Options reverse;
+            reverse["Direction"] = "Reverse";
+            for (int i = static_cast<int>(duration.value()) - 1; i >= 0; --i)
+            {
+                const auto videoData = read->readVideo(otime::RationalTime(i, 24.0), reverse).get();
+                TLRENDER_ASSERT(videoData.image);
+            }
+            const auto stats = read->getPrefetchStats();
+            TLRENDER_ASSERT(stats.blockCount > 0);
+            TLRENDER_ASSERT(stats.hits + stats.waits > 0);
+            _print(string::Format("Prefetch: {0} blocks, {1}/{2}/{3} hits/waits/misses").
+                arg(stats.blockCount).
+                arg(stats.hits).
+                arg(stats.waits).
+                arg(stats.misses));
+            system->getCache()->clear();
+        }
     }
 }
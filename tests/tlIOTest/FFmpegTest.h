@@ -24,6 +24,12 @@ namespace tl
             void _enums();
             void _util();
             void _io();
+            void _scrub();
+            void _reverse();
+            void _decoders();
+            void _writeAsync();
+            void _writeAudio();
+            void _prefetch();
         };
     }
 }
@@ -4,13 +4,16 @@
 
 #include <tlIOTest/IOTest.h>
 
+#include <tlIO/SequenceIO.h>
 #include <tlIO/System.h>
 
 #include <tlCore/Assert.h>
 #include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
 
+#include <atomic>
 #include <sstream>
+#include <thread>
 
 using namespace tl::io;
 
@@ -30,6 +33,9 @@ namespace tl
         void IOTest::run()
         {
             _videoData();
+            _proxy();
+            _decodePool();
+            _cache();
             _ioSystem();
         }
 
@@ -62,6 +68,294 @@ namespace tl
             }
         }
 
+        void IOTest::_proxy()
+        {
+            {
+                Options options;
+                TLRENDER_ASSERT(0 == getProxyLevel(options));
+                options["Proxy"] = "2";
+                TLRENDER_ASSERT(2 == getProxyLevel(options));
+                options["Proxy"] = "-1";
+                TLRENDER_ASSERT(0 == getProxyLevel(options));
+                options["Proxy"] = "100";
+                TLRENDER_ASSERT(proxyLevelMax == getProxyLevel(options));
+            }
+            {
+                TLRENDER_ASSERT(0 == getProxyLevel(1.0));
+                TLRENDER_ASSERT(0 == getProxyLevel(2.0));
+                TLRENDER_ASSERT(0 == getProxyLevel(0.75));
+                TLRENDER_ASSERT(1 == getProxyLevel(0.5));
+                TLRENDER_ASSERT(1 == getProxyLevel(0.3));
+                TLRENDER_ASSERT(2 == getProxyLevel(0.25));
+                TLRENDER_ASSERT(proxyLevelMax == getProxyLevel(0.0001));
+            }
+            {
+                Options options;
+                math::Box2i roi;
+                TLRENDER_ASSERT(!getROI(options, roi));
+                options["ROI"] = getROIOption(math::Box2i(10, 20, 30, 40));
+                TLRENDER_ASSERT(getROI(options, roi));
+                TLRENDER_ASSERT(math::Box2i(10, 20, 30, 40) == roi);
+                options["ROI"] = "invalid";
+                TLRENDER_ASSERT(!getROI(options, roi));
+            }
+        }
+
+        void IOTest::_decodePool()
+        {
+            {
+                auto pool = DecodePool::create(2);
+                TLRENDER_ASSERT(2 == pool->getThreadCount());
+                const uint64_t client = pool->addClient();
+                std::atomic<size_t> count(0);
+                for (size_t i = 0; i < 100; ++i)
+                {
+                    TLRENDER_ASSERT(pool->submit(
+                        client,
+                        i,
+                        [&count]
+                        {
+                            ++count;
+                        }));
+                }
+                while (count < 100)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                pool->removeClient(client);
+                TLRENDER_ASSERT(!pool->submit(client, 0, [] {}));
+            }
+            {
+                auto pool = DecodePool::create(1);
+                const uint64_t client = pool->addClient();
+                std::vector<int64_t> order;
+                std::mutex mutex;
+                std::promise<void> promise;
+                auto future = promise.get_future().share();
+                pool->submit(client, 0, [future] { future.wait(); });
+                for (int64_t i : { 3, 1, 2 })
+                {
+                    pool->submit(
+                        client,
+                        i,
+                        [i, &order, &mutex]
+                        {
+                            std::unique_lock<std::mutex> lock(mutex);
+                            order.push_back(i);
+                        });
+                }
+                promise.set_value();
+                while (pool->getPendingCount() > 0)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                pool->removeClient(client);
+                TLRENDER_ASSERT(std::vector<int64_t>({ 1, 2, 3 }) == order);
+            }
+            {
+                // Lend the idle threads while one task is running.
+                auto pool = DecodePool::create(4);
+                const uint64_t client = pool->addClient();
+                std::promise<void> promise;
+                auto future = promise.get_future().share();
+                std::atomic<size_t> started(0);
+                auto wait = [future, &started]
+                {
+                    ++started;
+                    future.wait();
+                };
+                pool->submit(client, 0, wait);
+                while (started < 1)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                TLRENDER_ASSERT(1 == pool->getActiveCount());
+                TLRENDER_ASSERT(16 == getSequenceMaxTasks(16, *pool));
+                TLRENDER_ASSERT(1 == pool->lendThreads(1));
+                TLRENDER_ASSERT(1 == pool->lendThreads(1));
+                TLRENDER_ASSERT(2 == pool->getLentCount());
+                TLRENDER_ASSERT(2 == getSequenceMaxTasks(16, *pool));
+                TLRENDER_ASSERT(1 == getSequenceMaxTasks(1, *pool));
+
+                // Pending and running tasks are not idle threads.
+                pool->submit(client, 0, wait);
+                TLRENDER_ASSERT(0 == pool->lendThreads(1));
+                while (started < 2)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                TLRENDER_ASSERT(2 == pool->getActiveCount());
+
+                // Tasks are held back while the threads are lent.
+                std::atomic<size_t> count(0);
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    pool->submit(client, 0, [&count] { ++count; });
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                TLRENDER_ASSERT(0 == count);
+                TLRENDER_ASSERT(4 == pool->getPendingCount());
+                pool->returnThreads(2);
+                TLRENDER_ASSERT(0 == pool->getLentCount());
+                TLRENDER_ASSERT(16 == getSequenceMaxTasks(16, *pool));
+                while (count < 4)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                promise.set_value();
+                pool->removeClient(client);
+                TLRENDER_ASSERT(0 == pool->getActiveCount());
+                TLRENDER_ASSERT(4 == pool->lendThreads(8));
+                pool->returnThreads(4);
+                TLRENDER_ASSERT(0 == pool->getLentCount());
+            }
+            {
+                auto system = _context->getSystem<System>();
+                TLRENDER_ASSERT(system->getDecodePool());
+                TLRENDER_ASSERT(system->getDecodePool()->getThreadCount() > 0);
+            }
+        }
+
+        void IOTest::_cache()
+        {
+            {
+                const uint64_t pathID = getPathID(file::Path("cache.0.exr"));
+                TLRENDER_ASSERT(pathID == getPathID(file::Path("cache.0.exr")));
+                TLRENDER_ASSERT(pathID != getPathID(file::Path("cache.1.exr")));
+                Options options;
+                options["Layer"] = "0";
+                TLRENDER_ASSERT(getOptionsHash(options) == getOptionsHash(options));
+                TLRENDER_ASSERT(getOptionsHash(options) != getOptionsHash(Options()));
+                Options options2 = options;
+                options2["Direction"] = "Reverse";
+                TLRENDER_ASSERT(getOptionsHash(options) == getOptionsHash(options2));
+                const otime::RationalTime time(0.0, 24.0);
+                const auto key = getVideoCacheKey(pathID, time, getOptionsHash(Options()), options);
+                TLRENDER_ASSERT(key == getVideoCacheKey(pathID, time, getOptionsHash(Options()), options));
+                TLRENDER_ASSERT(key != getVideoCacheKey(pathID, time, getOptionsHash(Options()), Options()));
+                TLRENDER_ASSERT(key != getVideoCacheKey(pathID, time + otime::RationalTime(1.0, 24.0), getOptionsHash(Options()), options));
+                const otime::TimeRange timeRange(time, otime::RationalTime(1.0, 24.0));
+                TLRENDER_ASSERT(
+                    getAudioCacheKey(pathID, timeRange, 0, options) ==
+                    getAudioCacheKey(pathID, timeRange, 0, options));
+                TLRENDER_ASSERT(
+                    getAudioCacheKey(pathID, timeRange, 0, options) !=
+                    getAudioCacheKey(pathID, otime::TimeRange(time, otime::RationalTime(2.0, 24.0)), 0, options));
+            }
+            const image::Info info(16, 16, image::PixelType::RGBA_U8);
+            const size_t byteCount = image::getDataByteCount(info);
+            const uint64_t pathID = getPathID(file::Path("cache.exr"));
+            auto getKey = [pathID](int frame)
+            {
+                return CacheKey(pathID, otime::RationalTime(frame, 24.0), 0);
+            };
+            {
+                auto cache = Cache::create();
+                cache->setMax(byteCount * 10);
+                TLRENDER_ASSERT(byteCount * 10 == cache->getMax());
+                const uint64_t owner = cache->addOwner();
+                const uint64_t owner2 = cache->addOwner();
+                TLRENDER_ASSERT(owner != owner2);
+
+                // Pinned video is not evicted.
+                auto image = image::Image::create(info);
+                cache->addVideo(getKey(0), VideoData(otime::RationalTime(0.0, 24.0), 0, image));
+                cache->pin(owner, image);
+                cache->pin(owner2, image);
+                TLRENDER_ASSERT(byteCount == cache->getPinnedSize());
+                TLRENDER_ASSERT(byteCount == cache->getSize());
+                for (int i = 1; i < 20; ++i)
+                {
+                    cache->addVideo(
+                        getKey(i),
+                        VideoData(otime::RationalTime(i, 24.0), 0, image::Image::create(info)));
+                }
+                TLRENDER_ASSERT(cache->containsVideo(getKey(0)));
+                TLRENDER_ASSERT(cache->getSize() <= cache->getMax());
+                VideoData videoData;
+                TLRENDER_ASSERT(cache->getVideo(getKey(0), videoData));
+                TLRENDER_ASSERT(image == videoData.image);
+
+                // Unpinned video can be evicted again.
+                cache->unpin(owner, image);
+                TLRENDER_ASSERT(byteCount == cache->getPinnedSize());
+                cache->removeOwner(owner2);
+                TLRENDER_ASSERT(0 == cache->getPinnedSize());
+                TLRENDER_ASSERT(cache->containsVideo(getKey(0)));
+                for (int i = 20; i < 40; ++i)
+                {
+                    cache->addVideo(
+                        getKey(i),
+                        VideoData(otime::RationalTime(i, 24.0), 0, image::Image::create(info)));
+                }
+                TLRENDER_ASSERT(!cache->containsVideo(getKey(0)));
+                TLRENDER_ASSERT(cache->getSize() <= cache->getMax());
+            }
+            {
+                // Pruning the image keys does not change the order of the
+                // video in the LRU cache.
+                auto cache = Cache::create();
+                cache->setMax(byteCount * 10);
+                cache->addVideo(getKey(0), VideoData(otime::RationalTime(0.0, 24.0), 0, image::Image::create(info)));
+                for (int i = 1; i < 600; i += 3)
+                {
+                    TLRENDER_ASSERT(cache->containsVideo(getKey(0)));
+                    VideoData videoData;
+                    cache->getVideo(getKey(0), videoData);
+                    for (int j = i; j < i + 3; ++j)
+                    {
+                        cache->addVideo(
+                            getKey(j),
+                            VideoData(otime::RationalTime(j, 24.0), 0, image::Image::create(info)));
+                    }
+                }
+            }
+            {
+                // Pinned images are limited to the video part of the
+                // maximum size.
+                auto cache = Cache::create();
+                cache->setMax(byteCount * 10);
+                const size_t pinnedMax = cache->getPinnedMax();
+                TLRENDER_ASSERT(pinnedMax > 0 && pinnedMax <= cache->getMax());
+                const uint64_t owner = cache->addOwner();
+                std::vector<std::shared_ptr<image::Image> > images;
+                for (int i = 0; i < 20; ++i)
+                {
+                    auto image = image::Image::create(info);
+                    cache->addVideo(getKey(i), VideoData(otime::RationalTime(i, 24.0), 0, image));
+                    const bool pinned = cache->pin(owner, image);
+                    TLRENDER_ASSERT(pinned == ((i + 1) * byteCount <= pinnedMax));
+                    if (pinned)
+                    {
+                        images.push_back(image);
+                    }
+                }
+                TLRENDER_ASSERT(cache->getPinnedSize() <= pinnedMax);
+                TLRENDER_ASSERT(cache->getSize() <= cache->getMax());
+                TLRENDER_ASSERT(cache->getPercentage() <= 100.F);
+                TLRENDER_ASSERT(cache->pin(owner, images.front()));
+                cache->unpin(owner, images.front());
+                cache->unpinAll(owner);
+                TLRENDER_ASSERT(0 == cache->getPinnedSize());
+                TLRENDER_ASSERT(!cache->pin(owner, nullptr));
+            }
+            {
+                auto cache = Cache::create();
+                const uint64_t owner = cache->addOwner();
+                auto image = image::Image::create(info);
+                cache->pin(owner, image);
+                cache->pin(owner, image);
+                TLRENDER_ASSERT(byteCount == cache->getPinnedSize());
+                cache->addVideo(getKey(0), VideoData(otime::RationalTime(0.0, 24.0), 0, image));
+                cache->clear();
+                TLRENDER_ASSERT(!cache->containsVideo(getKey(0)));
+                TLRENDER_ASSERT(byteCount == cache->getPinnedSize());
+                cache->unpinAll(owner);
+                TLRENDER_ASSERT(0 == cache->getPinnedSize());
+                TLRENDER_ASSERT(0 == cache->getSize());
+            }
+        }
+
         namespace
         {
             class DummyPlugin : public IPlugin
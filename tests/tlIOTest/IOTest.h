@@ -22,6 +22,9 @@ namespace tl
 
         private:
             void _videoData();
+            void _proxy();
+            void _decodePool();
+            void _cache();
             void _ioSystem();
         };
     }
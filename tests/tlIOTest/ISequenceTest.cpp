@@ -0,0 +1,200 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlIOTest/ISequenceTest.h>
+
+#include <tlIO/SequenceIO.h>
+#include <tlIO/System.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/StringFormat.h>
+
+#include <cstring>
+#include <future>
+
+using namespace tl::io;
+
+namespace tl
+{
+    namespace io_tests
+    {
+        ISequenceTest::ISequenceTest(
+            const std::string& name,
+            const std::shared_ptr<system::Context>& context) :
+            ITest(name, context)
+        {}
+
+        ISequenceTest::~ISequenceTest()
+        {}
+
+        void ISequenceTest::_batchRead(
+            const std::shared_ptr<io::IPlugin>& plugin,
+            const std::string& extension,
+            const image::Info& imageInfo)
+        {
+            auto system = _context->getSystem<System>();
+
+            // Read the middle of a sequence with and without batch reads and
+            // compare the image data. Each frame has different data so the
+            // frames can not be mixed up. Direct I/O only reads the parts of
+            // a file aligned to file::batchDirectAlignment directly, so it
+            // is tested with a larger image.
+            image::Info directInfo = imageInfo;
+            directInfo.size = image::Size(512, 512);
+            for (const bool directIO : { false, true })
+            {
+                const image::Info& info = directIO ? directInfo : imageInfo;
+                file::Path path(
+                    "",
+                    string::Format("SequenceTest_BatchRead_{0}.").arg(directIO ? "Direct" : "Default"),
+                    "0",
+                    0,
+                    extension);
+                path.setSequence(math::IntRange(0, 3));
+                try
+                {
+                    Info ioInfo;
+                    ioInfo.video.push_back(info);
+                    ioInfo.videoTime = otime::TimeRange(
+                        otime::RationalTime(0.0, 24.0),
+                        otime::RationalTime(4.0, 24.0));
+                    auto write = plugin->write(path, ioInfo);
+                    for (size_t i = 0; i < 4; ++i)
+                    {
+                        auto image = image::Image::create(info);
+                        uint8_t* data = image->getData();
+                        for (size_t j = 0; j < image->getDataByteCount(); ++j)
+                        {
+                            data[j] = (i + j) % 251;
+                        }
+                        write->writeVideo(otime::RationalTime(i, 24.0), image);
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    _printError(e.what());
+                }
+
+                std::vector<std::vector<std::shared_ptr<image::Image> > > images;
+                for (const auto& value : { "0", "1" })
+                {
+                    _print(string::Format("Batch read: {0}, direct I/O: {1}").
+                        arg(value).
+                        arg(directIO));
+                    Options options;
+                    options["SequenceIO/BatchRead"] = value;
+                    options["SequenceIO/DirectIO"] = directIO ? "1" : "0";
+                    auto read = std::dynamic_pointer_cast<ISequenceRead>(plugin->read(path, options));
+                    TLRENDER_ASSERT(read);
+                    const file::BatchReadStats stats = read->getBatchReadStats();
+                    std::vector<std::future<VideoData> > futures;
+                    for (size_t i = 1; i < 4; ++i)
+                    {
+                        futures.push_back(read->readVideo(otime::RationalTime(i, 24.0)));
+                    }
+                    images.push_back(std::vector<std::shared_ptr<image::Image> >());
+                    size_t byteCount = 0;
+                    for (auto& future : futures)
+                    {
+                        const auto videoData = future.get();
+                        TLRENDER_ASSERT(videoData.image);
+                        images.back().push_back(videoData.image);
+                        byteCount += videoData.image->getDataByteCount();
+                    }
+
+                    // Check that the frames went through the batch reader.
+                    const file::BatchReadStats stats2 = read->getBatchReadStats();
+                    if (std::string("1") == value)
+                    {
+                        TLRENDER_ASSERT(futures.size() == stats2.requests - stats.requests);
+                        TLRENDER_ASSERT(stats.errors == stats2.errors);
+                        TLRENDER_ASSERT(byteCount == stats2.byteCount - stats.byteCount);
+                        _print(string::Format("Direct bytes: {0}").
+                            arg(stats2.directBytes - stats.directBytes));
+                    }
+                    else
+                    {
+                        TLRENDER_ASSERT(file::BatchReadStats() == stats2);
+                    }
+                    system->getCache()->clear();
+                }
+                for (size_t i = 0; i < images[0].size(); ++i)
+                {
+                    TLRENDER_ASSERT(images[0][i]->getInfo() == images[1][i]->getInfo());
+                    TLRENDER_ASSERT(0 == memcmp(
+                        images[0][i]->getData(),
+                        images[1][i]->getData(),
+                        images[0][i]->getDataByteCount()));
+                }
+            }
+        }
+
+        void ISequenceTest::_proxy(
+            const std::shared_ptr<io::IPlugin>& plugin,
+            const std::string& extension,
+            image::PixelType pixelType)
+        {
+            auto system = _context->getSystem<System>();
+
+            // Write an image where each pixel is different, so the proxy
+            // pixels can be compared with the full resolution pixels.
+            const file::Path path("SequenceTest_Proxy.0" + extension);
+            const image::Info imageInfo(64, 48, pixelType);
+            try
+            {
+                Info info;
+                info.video.push_back(imageInfo);
+                info.videoTime = otime::TimeRange(
+                    otime::RationalTime(0.0, 24.0),
+                    otime::RationalTime(1.0, 24.0));
+                auto write = plugin->write(path, info);
+                auto image = image::Image::create(imageInfo);
+                uint8_t* data = image->getData();
+                for (size_t i = 0; i < image->getDataByteCount(); ++i)
+                {
+                    data[i] = i % 251;
+                }
+                write->writeVideo(otime::RationalTime(0.0, 24.0), image);
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+
+            auto read = plugin->read(path);
+            const auto videoData = read->readVideo(otime::RationalTime(0.0, 24.0)).get();
+            TLRENDER_ASSERT(videoData.image);
+            const auto& image = videoData.image;
+            image::Info pixelInfo = image->getInfo();
+            pixelInfo.size = image::Size(1, 1);
+            pixelInfo.layout.alignment = 1;
+            const size_t pixelByteCount = image::getDataByteCount(pixelInfo);
+            const size_t rowByteCount = image::getPlaneRowByteCount(image->getInfo(), 0);
+            for (int level = 1; level <= 3; ++level)
+            {
+                _print(string::Format("Proxy: {0}").arg(level));
+                Options options;
+                options["Proxy"] = string::Format("{0}").arg(level);
+                const auto proxyData = read->readVideo(otime::RationalTime(0.0, 24.0), options).get();
+                TLRENDER_ASSERT(proxyData.image);
+                const auto& proxy = proxyData.image;
+                TLRENDER_ASSERT(image::getProxySize(imageInfo.size, level) == proxy->getSize());
+                TLRENDER_ASSERT(image->getPixelType() == proxy->getPixelType());
+                const size_t proxyRowByteCount = image::getPlaneRowByteCount(proxy->getInfo(), 0);
+                const int step = 1 << level;
+                for (int y = 0; y < proxy->getHeight(); ++y)
+                {
+                    for (int x = 0; x < proxy->getWidth(); ++x)
+                    {
+                        TLRENDER_ASSERT(0 == memcmp(
+                            proxy->getData() + y * proxyRowByteCount + x * pixelByteCount,
+                            image->getData() + y * step * rowByteCount + x * step * pixelByteCount,
+                            pixelByteCount));
+                    }
+                }
+            }
+            system->getCache()->clear();
+        }
+    }
+}
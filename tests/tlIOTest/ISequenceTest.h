@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+#include <tlIO/SequenceIO.h>
+
+#include <atomic>
+
+namespace tl
+{
+    namespace io_tests
+    {
+        //! Image sequence reader that counts the headers that are parsed,
+        //! instead of read with the header template.
+        template<typename T>
+        class ParseHeaderCountRead : public T
+        {
+        protected:
+            ParseHeaderCountRead();
+
+        public:
+            ~ParseHeaderCountRead() override;
+
+            //! Create a new reader.
+            static std::shared_ptr<ParseHeaderCountRead<T> > create(
+                const file::Path&,
+                const io::Options&,
+                const std::shared_ptr<io::Cache>&,
+                const std::shared_ptr<io::DecodePool>&,
+                const std::weak_ptr<log::System>&);
+
+            //! Get the number of headers that have been parsed.
+            size_t getParseHeaderCount() const;
+
+        protected:
+            void _parseHeader(
+                const std::shared_ptr<file::FileIO>&,
+                io::SequenceHeader&) override;
+
+        private:
+            std::atomic<size_t> _parseHeaderCount;
+        };
+
+        //! Base class for image sequence tests.
+        class ISequenceTest : public tests::ITest
+        {
+        protected:
+            ISequenceTest(
+                const std::string& name,
+                const std::shared_ptr<system::Context>&);
+
+        public:
+            virtual ~ISequenceTest() = 0;
+
+        protected:
+            //! Write sequences with the given plugin and file extension, and
+            //! check that reading them with and without the batch reader
+            //! gives the same images. A larger image is also read with
+            //! direct I/O.
+            void _batchRead(
+                const std::shared_ptr<io::IPlugin>&,
+                const std::string& extension,
+                const image::Info&);
+
+            //! Write an image with the given plugin and file extension, and
+            //! check that proxy levels read every 2^level row and column
+            //! (see io::ISequenceRead::_readImage()).
+            void _proxy(
+                const std::shared_ptr<io::IPlugin>&,
+                const std::string& extension,
+                image::PixelType);
+
+            //! Write a sequence with the given plugin and file extension,
+            //! where the last frame has a different size so it does not
+            //! match the header template. Check that the frames and tags
+            //! are the same with and without the template, and that the
+            //! headers are only parsed when they do not match. The reader
+            //! type T must be the reader of the plugin.
+            template<typename T>
+            void _headerTemplate(
+                const std::shared_ptr<io::IPlugin>&,
+                const std::string& extension,
+                image::PixelType,
+                const std::vector<image::Tags>& = std::vector<image::Tags>());
+        };
+    }
+}
+
+#include <tlIOTest/ISequenceTestInline.h>
@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlIO/System.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/StringFormat.h>
+
+#include <cstring>
+
+namespace tl
+{
+    namespace io_tests
+    {
+        template<typename T>
+        inline ParseHeaderCountRead<T>::ParseHeaderCountRead() :
+            _parseHeaderCount(0)
+        {}
+
+        template<typename T>
+        inline ParseHeaderCountRead<T>::~ParseHeaderCountRead()
+        {
+            // Stop the reader before this class is destroyed, since the
+            // decode threads call _parseHeader().
+            this->_finish();
+        }
+
+        template<typename T>
+        inline std::shared_ptr<ParseHeaderCountRead<T> > ParseHeaderCountRead<T>::create(
+            const file::Path& path,
+            const io::Options& options,
+            const std::shared_ptr<io::Cache>& cache,
+            const std::shared_ptr<io::DecodePool>& decodePool,
+            const std::weak_ptr<log::System>& logSystem)
+        {
+            auto out = std::shared_ptr<ParseHeaderCountRead<T> >(new ParseHeaderCountRead<T>);
+            out->_init(path, {}, options, cache, decodePool, logSystem);
+            return out;
+        }
+
+        template<typename T>
+        inline size_t ParseHeaderCountRead<T>::getParseHeaderCount() const
+        {
+            return _parseHeaderCount;
+        }
+
+        template<typename T>
+        inline void ParseHeaderCountRead<T>::_parseHeader(
+            const std::shared_ptr<file::FileIO>& io,
+            io::SequenceHeader& header)
+        {
+            ++_parseHeaderCount;
+            T::_parseHeader(io, header);
+        }
+
+        template<typename T>
+        inline void ISequenceTest::_headerTemplate(
+            const std::shared_ptr<io::IPlugin>& plugin,
+            const std::string& extension,
+            image::PixelType pixelType,
+            const std::vector<image::Tags>& tags)
+        {
+            auto system = _context->getSystem<io::System>();
+
+            file::Path path("", "SequenceTest_HeaderTemplate.", "0", 0, extension);
+            path.setSequence(math::IntRange(0, 3));
+            const std::vector<image::Size> sizes =
+            {
+                image::Size(16, 16),
+                image::Size(16, 16),
+                image::Size(16, 16),
+                image::Size(8, 8)
+            };
+            try
+            {
+                io::Info info;
+                info.video.push_back(image::Info(sizes[0], pixelType));
+                info.videoTime = otime::TimeRange(
+                    otime::RationalTime(0.0, 24.0),
+                    otime::RationalTime(sizes.size(), 24.0));
+                auto write = plugin->write(path, info);
+                for (size_t i = 0; i < sizes.size(); ++i)
+                {
+                    auto image = image::Image::create(sizes[i], pixelType);
+                    uint8_t* data = image->getData();
+                    for (size_t j = 0; j < image->getDataByteCount(); ++j)
+                    {
+                        data[j] = (i + j) % 251;
+                    }
+                    if (i < tags.size())
+                    {
+                        image->setTags(tags[i]);
+                    }
+                    write->writeVideo(otime::RationalTime(i, 24.0), image);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+
+            std::vector<std::vector<std::shared_ptr<image::Image> > > images;
+            for (const bool headerTemplate : { true, false })
+            {
+                _print(string::Format("Header template: {0}").arg(headerTemplate));
+                io::Options options;
+                options["SequenceIO/HeaderTemplate"] = headerTemplate ? "1" : "0";
+                auto read = ParseHeaderCountRead<T>::create(
+                    path,
+                    options,
+                    system->getCache(),
+                    system->getDecodePool(),
+                    _context->getLogSystem());
+                const auto ioInfo = read->getInfo().get();
+                TLRENDER_ASSERT(!ioInfo.video.empty());
+                TLRENDER_ASSERT(sizes[0] == ioInfo.video[0].size);
+                images.push_back(std::vector<std::shared_ptr<image::Image> >());
+                for (size_t i = 0; i < sizes.size(); ++i)
+                {
+                    const auto videoData = read->readVideo(otime::RationalTime(i, 24.0)).get();
+                    TLRENDER_ASSERT(videoData.image);
+                    TLRENDER_ASSERT(sizes[i] == videoData.image->getSize());
+                    if (i < tags.size())
+                    {
+                        const auto frameTags = videoData.image->getTags();
+                        for (const auto& j : tags[i])
+                        {
+                            const auto k = frameTags.find(j.first);
+                            TLRENDER_ASSERT(k != frameTags.end());
+                            TLRENDER_ASSERT(k->second == j.second);
+                        }
+                    }
+                    images.back().push_back(videoData.image);
+                }
+
+                // With the template only the information and the last
+                // frame are parsed, otherwise every header is parsed.
+                const size_t parseHeaderCount = read->getParseHeaderCount();
+                _print(string::Format("Parsed headers: {0}").arg(parseHeaderCount));
+                TLRENDER_ASSERT((headerTemplate ? 2 : 1 + sizes.size()) == parseHeaderCount);
+                system->getCache()->clear();
+            }
+            for (size_t i = 0; i < sizes.size(); ++i)
+            {
+                TLRENDER_ASSERT(0 == memcmp(
+                    images[0][i]->getData(),
+                    images[1][i]->getData(),
+                    images[0][i]->getDataByteCount()));
+            }
+        }
+    }
+}
@@ -9,7 +9,9 @@
 
 #include <tlCore/Assert.h>
 #include <tlCore/FileIO.h>
+#include <tlCore/StringFormat.h>
 
+#include <cstdlib>
 #include <sstream>
 
 using namespace tl::io;
@@ -110,6 +112,12 @@ namespace tl
         }
 
         void JPEGTest::run()
+        {
+            _io();
+            _proxy();
+        }
+
+        void JPEGTest::_io()
         {
             auto system = _context->getSystem<System>();
             auto plugin = system->getPlugin<jpeg::Plugin>();
@@ -184,5 +192,67 @@ namespace tl
                 }
             }
         }
+
+        void JPEGTest::_proxy()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<jpeg::Plugin>();
+
+            // Write a smooth image, so the proxies decoded with DCT scaling
+            // are close to the full resolution image filtered with
+            // image::createProxy().
+            const file::Path path("JPEGTest_Proxy.0.jpg");
+            const image::Info imageInfo(64, 48, image::PixelType::L_U8);
+            try
+            {
+                auto image = image::Image::create(imageInfo);
+                uint8_t* data = image->getData();
+                for (int y = 0; y < imageInfo.size.h; ++y)
+                {
+                    for (int x = 0; x < imageInfo.size.w; ++x, ++data)
+                    {
+                        *data = (x + y) * 2;
+                    }
+                }
+                Options options;
+                options["JPEG/Quality"] = "100";
+                write(plugin, image, path, imageInfo, image::Tags(), options);
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+
+            // DCT scaling goes to level three, the higher levels are
+            // filtered from there.
+            auto read = plugin->read(path);
+            const auto videoData = read->readVideo(otime::RationalTime(0.0, 24.0)).get();
+            TLRENDER_ASSERT(videoData.image);
+            for (int level = 1; level <= 4; ++level)
+            {
+                _print(string::Format("Proxy: {0}").arg(level));
+                Options options;
+                options["Proxy"] = string::Format("{0}").arg(level);
+                const auto proxyData = read->readVideo(otime::RationalTime(0.0, 24.0), options).get();
+                TLRENDER_ASSERT(proxyData.image);
+                TLRENDER_ASSERT(image::getProxySize(imageInfo.size, level) == proxyData.image->getSize());
+                TLRENDER_ASSERT(image::PixelType::L_U8 == proxyData.image->getPixelType());
+                const auto filtered = image::createProxy(videoData.image, level);
+                TLRENDER_ASSERT(filtered);
+                TLRENDER_ASSERT(filtered->getSize() == proxyData.image->getSize());
+                const size_t rowByteCount = image::getPlaneRowByteCount(proxyData.image->getInfo(), 0);
+                const size_t filteredRowByteCount = image::getPlaneRowByteCount(filtered->getInfo(), 0);
+                for (int y = 0; y < filtered->getHeight(); ++y)
+                {
+                    const uint8_t* a = proxyData.image->getData() + y * rowByteCount;
+                    const uint8_t* b = filtered->getData() + y * filteredRowByteCount;
+                    for (int x = 0; x < filtered->getWidth(); ++x)
+                    {
+                        TLRENDER_ASSERT(std::abs(static_cast<int>(a[x]) - static_cast<int>(b[x])) <= 8);
+                    }
+                }
+            }
+            system->getCache()->clear();
+        }
     }
 }
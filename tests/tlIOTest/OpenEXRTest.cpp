@@ -9,6 +9,9 @@
 
 #include <tlCore/Assert.h>
 #include <tlCore/FileIO.h>
+#include <tlCore/StringFormat.h>
+
+#include <ImfTiledRgbaFile.h>
 
 #include <sstream>
 
@@ -31,6 +34,8 @@ namespace tl
         {
             _enums();
             _io();
+            _tiled();
+            _mipmap();
         }
 
         void OpenEXRTest::_enums()
@@ -41,6 +46,40 @@ namespace tl
 
         namespace
         {
+            // Read a region of interest, and compare it with the same part
+            // of the whole image.
+            void readROI(
+                const std::shared_ptr<io::IRead>& read,
+                const std::shared_ptr<image::Image>& image,
+                const math::Box2i& roi,
+                const math::Box2i& dataBox)
+            {
+                io::Options options;
+                options["ROI"] = getROIOption(roi);
+                const auto roiData = read->readVideo(otime::RationalTime(0.0, 24.0), options).get();
+                TLRENDER_ASSERT(roiData.image);
+                TLRENDER_ASSERT(roiData.image->isRegion());
+                TLRENDER_ASSERT(roiData.image->getDisplaySize() == image->getSize());
+                TLRENDER_ASSERT(dataBox == math::Box2i(
+                    roiData.image->getDataPos().x,
+                    roiData.image->getDataPos().y,
+                    roiData.image->getWidth(),
+                    roiData.image->getHeight()));
+                image::Info pixelInfo = image->getInfo();
+                pixelInfo.size = image::Size(1, 1);
+                pixelInfo.layout.alignment = 1;
+                const size_t pixelByteCount = image::getDataByteCount(pixelInfo);
+                const size_t rowByteCount = image::getPlaneRowByteCount(image->getInfo(), 0);
+                const size_t roiRowByteCount = image::getPlaneRowByteCount(roiData.image->getInfo(), 0);
+                for (int y = 0; y < dataBox.h(); ++y)
+                {
+                    TLRENDER_ASSERT(0 == memcmp(
+                        roiData.image->getData() + y * roiRowByteCount,
+                        image->getData() + (dataBox.min.y + y) * rowByteCount + dataBox.min.x * pixelByteCount,
+                        dataBox.w() * pixelByteCount));
+                }
+            }
+
             void write(
                 const std::shared_ptr<io::IPlugin>& plugin,
                 const std::shared_ptr<image::Image>& image,
@@ -85,6 +124,15 @@ namespace tl
                 const auto videoData = read->readVideo(otime::RationalTime(0.0, 24.0)).get();
                 TLRENDER_ASSERT(videoData.image);
                 TLRENDER_ASSERT(videoData.image->getSize() == image->getSize());
+                if (image->getHeight() > 8)
+                {
+                    // Scanline files are read a whole row at a time.
+                    readROI(
+                        read,
+                        videoData.image,
+                        math::Box2i(0, 0, 8, 8),
+                        math::Box2i(0, 0, image->getWidth(), 8));
+                }
                 //! \todo Compare image data.
                 //TLRENDER_ASSERT(0 == memcmp(
                 //    videoData.image->getData(),
@@ -269,7 +317,10 @@ namespace tl
                                         path = file::Path(ss.str());
                                     }
                                     auto image = image::Image::create(imageInfo);
-                                    image->zero();
+                                    for (size_t i = 0; i < image->getDataByteCount(); ++i)
+                                    {
+                                        image->getData()[i] = i % 251;
+                                    }
                                     image->setTags(tags);
                                     try
                                     {
@@ -290,5 +341,115 @@ namespace tl
                 }
             }
         }
+
+        void OpenEXRTest::_tiled()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<exr::Plugin>();
+
+            // Write tiled files, and read regions of interest that cross
+            // the tile boundaries.
+            const image::Size size(64, 48);
+            const int tileSize = 16;
+            for (const bool memoryIO : { false, true })
+            {
+                const file::Path path("OpenEXRTest_Tiled.0.exr");
+                _print(path.get());
+                {
+                    std::vector<Imf::Rgba> pixels(size.w * size.h);
+                    for (int y = 0; y < size.h; ++y)
+                    {
+                        for (int x = 0; x < size.w; ++x)
+                        {
+                            pixels[y * size.w + x] = Imf::Rgba(x / 64.F, y / 48.F, (x + y) / 112.F, 1.F);
+                        }
+                    }
+                    Imf::TiledRgbaOutputFile file(
+                        path.get().c_str(),
+                        size.w,
+                        size.h,
+                        tileSize,
+                        tileSize,
+                        Imf::ONE_LEVEL);
+                    file.setFrameBuffer(pixels.data(), 1, size.w);
+                    file.writeTiles(0, file.numXTiles() - 1, 0, file.numYTiles() - 1);
+                }
+
+                std::vector<uint8_t> memoryData;
+                std::vector<file::MemoryRead> memory;
+                if (memoryIO)
+                {
+                    auto fileIO = file::FileIO::create(path.get(), file::Mode::Read);
+                    memoryData.resize(fileIO->getSize());
+                    fileIO->read(memoryData.data(), memoryData.size());
+                    memory.push_back(file::MemoryRead(memoryData.data(), memoryData.size()));
+                }
+                auto read = plugin->read(path, memory);
+                const auto videoData = read->readVideo(otime::RationalTime(0.0, 24.0)).get();
+                TLRENDER_ASSERT(videoData.image);
+                TLRENDER_ASSERT(size == videoData.image->getSize());
+                TLRENDER_ASSERT(image::PixelType::RGBA_F16 == videoData.image->getPixelType());
+                readROI(
+                    read,
+                    videoData.image,
+                    math::Box2i(20, 10, 8, 8),
+                    math::Box2i(16, 0, 16, 32));
+                readROI(
+                    read,
+                    videoData.image,
+                    math::Box2i(40, 40, 100, 100),
+                    math::Box2i(32, 32, 32, 16));
+                system->getCache()->clear();
+            }
+        }
+
+        void OpenEXRTest::_mipmap()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<exr::Plugin>();
+
+            // Write a file with mip map levels, where each level has a
+            // different value so the level that is read can be checked.
+            const image::Size size(64, 48);
+            const file::Path path("OpenEXRTest_MipMap.0.exr");
+            {
+                Imf::TiledRgbaOutputFile file(
+                    path.get().c_str(),
+                    size.w,
+                    size.h,
+                    16,
+                    16,
+                    Imf::MIPMAP_LEVELS,
+                    Imf::ROUND_UP);
+                for (int level = 0; level < file.numLevels(); ++level)
+                {
+                    const int w = file.levelWidth(level);
+                    const int h = file.levelHeight(level);
+                    std::vector<Imf::Rgba> pixels(w * h, Imf::Rgba(level / 8.F, 0.F, 0.F, 1.F));
+                    file.setFrameBuffer(pixels.data(), 1, w);
+                    file.writeTiles(0, file.numXTiles(level) - 1, 0, file.numYTiles(level) - 1, level);
+                }
+            }
+
+            // Read the proxy levels, they should come from the mip map
+            // levels instead of filtering the full resolution image.
+            auto read = plugin->read(path);
+            for (int level = 0; level <= 3; ++level)
+            {
+                _print(string::Format("Mip map level: {0}").arg(level));
+                Options options;
+                options["Proxy"] = string::Format("{0}").arg(level);
+                const auto videoData = read->readVideo(otime::RationalTime(0.0, 24.0), options).get();
+                TLRENDER_ASSERT(videoData.image);
+                TLRENDER_ASSERT(image::getProxySize(size, level) == videoData.image->getSize());
+                TLRENDER_ASSERT(image::PixelType::RGBA_F16 == videoData.image->getPixelType());
+                const Imf::Rgba* pixels = reinterpret_cast<const Imf::Rgba*>(videoData.image->getData());
+                for (int i = 0; i < videoData.image->getWidth() * videoData.image->getHeight(); ++i)
+                {
+                    TLRENDER_ASSERT(level / 8.F == pixels[i].r);
+                }
+            }
+            system->getCache()->clear();
+        }
     }
 }
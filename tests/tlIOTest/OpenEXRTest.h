@@ -23,6 +23,8 @@ namespace tl
         private:
             void _enums();
             void _io();
+            void _tiled();
+            void _mipmap();
         };
     }
 }
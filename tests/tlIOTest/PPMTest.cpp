@@ -8,6 +8,7 @@
 #include <tlIO/System.h>
 
 #include <tlCore/Assert.h>
+#include <tlCore/StringFormat.h>
 
 #include <sstream>
 
@@ -18,7 +19,7 @@ namespace tl
     namespace io_tests
     {
         PPMTest::PPMTest(const std::shared_ptr<system::Context>& context) :
-            ITest("io_tests::PPMTest", context)
+            ISequenceTest("io_tests::PPMTest", context)
         {}
 
         std::shared_ptr<PPMTest> PPMTest::create(const std::shared_ptr<system::Context>& context)
@@ -30,6 +31,8 @@ namespace tl
         {
             _enums();
             _io();
+            _batchRead();
+            _headerTemplate();
         }
 
         void PPMTest::_enums()
@@ -138,7 +141,8 @@ namespace tl
             const std::vector<std::pair<std::string, std::string> > options =
             {
                 { "PPM/Data", "Binary" },
-                { "PPM/Data", "ASCII" }
+                { "PPM/Data", "ASCII" },
+                { "SequenceIO/BatchRead", "1" }
             };
 
             for (const auto& fileName : fileNames)
@@ -184,5 +188,25 @@ namespace tl
                 }
             }
         }
+
+        void PPMTest::_batchRead()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<ppm::Plugin>();
+            ISequenceTest::_batchRead(
+                plugin,
+                ".ppm",
+                image::Info(16, 16, image::PixelType::RGB_U16));
+        }
+
+        void PPMTest::_headerTemplate()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<ppm::Plugin>();
+            ISequenceTest::_headerTemplate<ppm::Read>(
+                plugin,
+                ".ppm",
+                image::PixelType::RGB_U8);
+        }
     }
 }
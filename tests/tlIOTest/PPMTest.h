@@ -4,13 +4,13 @@
 
 #pragma once
 
-#include <tlTestLib/ITest.h>
+#include <tlIOTest/ISequenceTest.h>
 
 namespace tl
 {
     namespace io_tests
     {
-        class PPMTest : public tests::ITest
+        class PPMTest : public ISequenceTest
         {
         protected:
             PPMTest(const std::shared_ptr<system::Context>&);
@@ -23,6 +23,8 @@ namespace tl
         private:
             void _enums();
             void _io();
+            void _batchRead();
+            void _headerTemplate();
         };
     }
 }
@@ -8,6 +8,7 @@
 #include <tlIO/System.h>
 
 #include <tlCore/Assert.h>
+#include <tlCore/StringFormat.h>
 
 #include <sstream>
 
@@ -29,6 +30,8 @@ namespace tl
         void SGITest::run()
         {
             _io();
+            _batchRead();
+            _headerTemplate();
         }
 
         namespace
@@ -165,5 +168,25 @@ namespace tl
                 }
             }
         }
+
+        void SGITest::_batchRead()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<sgi::Plugin>();
+            ISequenceTest::_batchRead(
+                plugin,
+                ".sgi",
+                image::Info(16, 16, image::PixelType::RGBA_U16));
+        }
+
+        void SGITest::_headerTemplate()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<sgi::Plugin>();
+            ISequenceTest::_headerTemplate<sgi::Read>(
+                plugin,
+                ".sgi",
+                image::PixelType::RGB_U8);
+        }
     }
 }
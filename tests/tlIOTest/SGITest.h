@@ -4,13 +4,13 @@
 
 #pragma once
 
-#include <tlTestLib/ITest.h>
+#include <tlIOTest/ISequenceTest.h>
 
 namespace tl
 {
     namespace io_tests
     {
-        class SGITest : public tests::ITest
+        class SGITest : public ISequenceTest
         {
         protected:
             SGITest(const std::shared_ptr<system::Context>&);
@@ -22,6 +22,8 @@ namespace tl
 
         private:
             void _io();
+            void _batchRead();
+            void _headerTemplate();
         };
     }
 }
@@ -10,6 +10,8 @@
 #include <tlCore/Assert.h>
 #include <tlCore/FileIO.h>
 
+#include <tiffio.h>
+
 #include <sstream>
 
 using namespace tl::io;
@@ -29,6 +31,40 @@ namespace tl
 
         namespace
         {
+            // Read a region of interest, and compare it with the same part
+            // of the whole image.
+            void readROI(
+                const std::shared_ptr<io::IRead>& read,
+                const std::shared_ptr<image::Image>& image,
+                const math::Box2i& roi,
+                const math::Box2i& dataBox)
+            {
+                io::Options options;
+                options["ROI"] = getROIOption(roi);
+                const auto roiData = read->readVideo(otime::RationalTime(0.0, 24.0), options).get();
+                TLRENDER_ASSERT(roiData.image);
+                TLRENDER_ASSERT(roiData.image->isRegion());
+                TLRENDER_ASSERT(roiData.image->getDisplaySize() == image->getSize());
+                TLRENDER_ASSERT(dataBox == math::Box2i(
+                    roiData.image->getDataPos().x,
+                    roiData.image->getDataPos().y,
+                    roiData.image->getWidth(),
+                    roiData.image->getHeight()));
+                image::Info pixelInfo = image->getInfo();
+                pixelInfo.size = image::Size(1, 1);
+                pixelInfo.layout.alignment = 1;
+                const size_t pixelByteCount = image::getDataByteCount(pixelInfo);
+                const size_t rowByteCount = image::getPlaneRowByteCount(image->getInfo(), 0);
+                const size_t roiRowByteCount = image::getPlaneRowByteCount(roiData.image->getInfo(), 0);
+                for (int y = 0; y < dataBox.h(); ++y)
+                {
+                    TLRENDER_ASSERT(0 == memcmp(
+                        roiData.image->getData() + y * roiRowByteCount,
+                        image->getData() + (dataBox.min.y + y) * rowByteCount + dataBox.min.x * pixelByteCount,
+                        dataBox.w() * pixelByteCount));
+                }
+            }
+
             void write(
                 const std::shared_ptr<io::IPlugin>& plugin,
                 const std::shared_ptr<image::Image>& image,
@@ -71,6 +107,15 @@ namespace tl
                 const auto videoData = read->readVideo(otime::RationalTime(0.0, 24.0)).get();
                 TLRENDER_ASSERT(videoData.image);
                 TLRENDER_ASSERT(videoData.image->getSize() == image->getSize());
+                if (image->getHeight() > 8)
+                {
+                    // Scanline files are read a whole row at a time.
+                    readROI(
+                        read,
+                        videoData.image,
+                        math::Box2i(0, 0, 8, 8),
+                        math::Box2i(0, 0, image->getWidth(), 8));
+                }
                 //! \todo Compare image data.
                 //TLRENDER_ASSERT(0 == memcmp(
                 //    videoData.image->getData(),
@@ -112,6 +157,12 @@ namespace tl
         }
 
         void TIFFTest::run()
+        {
+            _io();
+            _tiled();
+        }
+
+        void TIFFTest::_io()
         {
             auto system = _context->getSystem<System>();
             auto plugin = system->getPlugin<tiff::Plugin>();
@@ -159,7 +210,10 @@ namespace tl
                                     path = file::Path(ss.str());
                                 }
                                 auto image = image::Image::create(imageInfo);
-                                image->zero();
+                                for (size_t i = 0; i < image->getDataByteCount(); ++i)
+                                {
+                                    image->getData()[i] = i % 251;
+                                }
                                 image->setTags(tags);
                                 try
                                 {
@@ -179,5 +233,90 @@ namespace tl
                 }
             }
         }
+
+        void TIFFTest::_tiled()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<tiff::Plugin>();
+
+            // Write tiled files with interleaved and planar samples, and
+            // read regions of interest that cross the tile boundaries.
+            const image::Size size(64, 48);
+            const uint32_t tileSize = 16;
+            const uint16_t samples = 3;
+            for (const uint16_t planarConfig : { PLANARCONFIG_CONTIG, PLANARCONFIG_SEPARATE })
+            {
+                std::stringstream ss;
+                ss << "TIFFTest_Tiled_" << planarConfig << ".0.tif";
+                _print(ss.str());
+                const file::Path path(ss.str());
+                {
+                    TIFF* tiff = TIFFOpen(path.get().c_str(), "w");
+                    TLRENDER_ASSERT(tiff);
+                    TIFFSetField(tiff, TIFFTAG_IMAGEWIDTH, size.w);
+                    TIFFSetField(tiff, TIFFTAG_IMAGELENGTH, size.h);
+                    TIFFSetField(tiff, TIFFTAG_SAMPLESPERPIXEL, samples);
+                    TIFFSetField(tiff, TIFFTAG_BITSPERSAMPLE, 8);
+                    TIFFSetField(tiff, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_RGB);
+                    TIFFSetField(tiff, TIFFTAG_PLANARCONFIG, planarConfig);
+                    TIFFSetField(tiff, TIFFTAG_COMPRESSION, COMPRESSION_NONE);
+                    TIFFSetField(tiff, TIFFTAG_TILEWIDTH, tileSize);
+                    TIFFSetField(tiff, TIFFTAG_TILELENGTH, tileSize);
+                    const bool planar = PLANARCONFIG_SEPARATE == planarConfig;
+                    const size_t tileSamples = planar ? 1 : samples;
+                    std::vector<uint8_t> tile(TIFFTileSize(tiff));
+                    for (uint16_t sample = 0; sample < (planar ? samples : 1); ++sample)
+                    {
+                        for (int ty = 0; ty < size.h; ty += tileSize)
+                        {
+                            for (int tx = 0; tx < size.w; tx += tileSize)
+                            {
+                                for (uint32_t y = 0; y < tileSize; ++y)
+                                {
+                                    for (uint32_t x = 0; x < tileSize; ++x)
+                                    {
+                                        for (size_t c = 0; c < tileSamples; ++c)
+                                        {
+                                            tile[(y * tileSize + x) * tileSamples + c] =
+                                                (tx + x) * 3 + (ty + y) * 5 + (planar ? sample : c) * 7;
+                                        }
+                                    }
+                                }
+                                TLRENDER_ASSERT(TIFFWriteTile(tiff, tile.data(), tx, ty, 0, sample) != -1);
+                            }
+                        }
+                    }
+                    TIFFClose(tiff);
+                }
+
+                auto read = plugin->read(path);
+                const auto videoData = read->readVideo(otime::RationalTime(0.0, 24.0)).get();
+                TLRENDER_ASSERT(videoData.image);
+                TLRENDER_ASSERT(size == videoData.image->getSize());
+                TLRENDER_ASSERT(image::PixelType::RGB_U8 == videoData.image->getPixelType());
+                for (int y = 0; y < size.h; ++y)
+                {
+                    for (int x = 0; x < size.w; ++x)
+                    {
+                        for (int c = 0; c < samples; ++c)
+                        {
+                            TLRENDER_ASSERT(static_cast<uint8_t>(x * 3 + y * 5 + c * 7) ==
+                                videoData.image->getData()[(y * size.w + x) * samples + c]);
+                        }
+                    }
+                }
+                readROI(
+                    read,
+                    videoData.image,
+                    math::Box2i(20, 10, 8, 8),
+                    math::Box2i(16, 0, 16, 32));
+                readROI(
+                    read,
+                    videoData.image,
+                    math::Box2i(40, 40, 100, 100),
+                    math::Box2i(32, 32, 32, 16));
+                system->getCache()->clear();
+            }
+        }
     }
 }
@@ -0,0 +1,397 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineCPUTest/RenderTest.h>
+
+#include <tlTimelineCPU/Render.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/StringFormat.h>
+
+#include <array>
+#include <cmath>
+#include <cstring>
+
+using namespace tl::timeline_cpu;
+
+namespace tl
+{
+    namespace timeline_cpu_tests
+    {
+        RenderTest::RenderTest(const std::shared_ptr<system::Context>& context) :
+            ITest("timeline_cpu_tests::RenderTest", context)
+        {}
+
+        std::shared_ptr<RenderTest> RenderTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<RenderTest>(new RenderTest(context));
+        }
+
+        void RenderTest::run()
+        {
+            _prims();
+            _image();
+            _compare();
+            _region();
+            _displayOptions();
+            _threads();
+        }
+
+        namespace
+        {
+            // Get a pixel with the origin at the top left.
+            image::Color4f getPixel(const std::shared_ptr<image::Image>& image, int x, int y)
+            {
+                const uint8_t* p = image->getData() +
+                    ((image->getHeight() - 1 - y) * image->getWidth() + x) * 4;
+                return image::Color4f(p[0] / 255.F, p[1] / 255.F, p[2] / 255.F, p[3] / 255.F);
+            }
+
+            bool isEqual(const image::Color4f& a, const image::Color4f& b)
+            {
+                const float e = 2.F / 255.F;
+                return
+                    std::fabs(a.r - b.r) < e &&
+                    std::fabs(a.g - b.g) < e &&
+                    std::fabs(a.b - b.b) < e;
+            }
+
+            // Render a solid color image and get the center pixel.
+            image::Color4f renderColor(
+                const std::shared_ptr<Render>& render,
+                const std::array<uint8_t, 4>& color,
+                const timeline::ImageOptions& imageOptions,
+                const timeline::DisplayOptions& displayOptions)
+            {
+                auto image = image::Image::create(1, 1, image::PixelType::RGBA_U8);
+                memcpy(image->getData(), color.data(), 4);
+                timeline::VideoData video;
+                video.layers.push_back(timeline::VideoLayer());
+                video.layers.back().image = image;
+                const math::Size2i size(16, 16);
+                render->begin(size);
+                render->drawVideo(
+                    { video },
+                    { math::Box2i(0, 0, size.w, size.h) },
+                    { imageOptions },
+                    { displayOptions });
+                render->end();
+                auto out = image::Image::create(size.w, size.h, image::PixelType::RGBA_U8);
+                render->copyImage(out);
+                return getPixel(out, size.w / 2, size.h / 2);
+            }
+
+            // Render a gradient image and return the output.
+            std::shared_ptr<image::Image> renderGradient(
+                const std::shared_ptr<Render>& render,
+                const math::Size2i& size,
+                const timeline::ImageOptions& imageOptions,
+                const timeline::DisplayOptions& displayOptions)
+            {
+                auto image = image::Image::create(size.w / 2, size.h / 2, image::PixelType::RGBA_U8);
+                uint8_t* p = image->getData();
+                for (int y = 0; y < image->getHeight(); ++y)
+                {
+                    for (int x = 0; x < image->getWidth(); ++x, p += 4)
+                    {
+                        p[0] = x * 255 / (image->getWidth() - 1);
+                        p[1] = y * 255 / (image->getHeight() - 1);
+                        p[2] = (x + y) % 256;
+                        p[3] = 255;
+                    }
+                }
+                timeline::VideoData video;
+                video.layers.push_back(timeline::VideoLayer());
+                video.layers.back().image = image;
+                render->begin(size);
+                render->drawVideo(
+                    { video },
+                    { math::Box2i(0, 0, size.w, size.h) },
+                    { imageOptions },
+                    { displayOptions });
+                render->end();
+                auto out = image::Image::create(size.w, size.h, image::PixelType::RGBA_U8);
+                render->copyImage(out);
+                return out;
+            }
+        }
+
+        void RenderTest::_prims()
+        {
+            auto render = Render::create(_context);
+            const math::Size2i size(64, 32);
+            timeline::RenderOptions renderOptions;
+            renderOptions.clearColor = image::Color4f(0.F, 0.F, 0.F, 1.F);
+            render->begin(size, renderOptions);
+            TLRENDER_ASSERT(size == render->getRenderSize());
+            TLRENDER_ASSERT(math::Box2i(0, 0, size.w, size.h) == render->getViewport());
+            render->drawRect(math::Box2i(8, 8, 16, 8), image::Color4f(1.F, 0.F, 0.F));
+            render->setClipRectEnabled(true);
+            render->setClipRect(math::Box2i(40, 0, 8, 8));
+            render->drawRect(math::Box2i(32, 0, 32, 32), image::Color4f(0.F, 1.F, 0.F));
+            render->setClipRectEnabled(false);
+            render->end();
+
+            auto image = image::Image::create(size.w, size.h, image::PixelType::RGBA_U8);
+            render->copyImage(image);
+            TLRENDER_ASSERT(image::Color4f(1.F, 0.F, 0.F) == getPixel(image, 8, 8));
+            TLRENDER_ASSERT(image::Color4f(1.F, 0.F, 0.F) == getPixel(image, 23, 15));
+            TLRENDER_ASSERT(image::Color4f(0.F, 0.F, 0.F) == getPixel(image, 24, 16));
+            TLRENDER_ASSERT(image::Color4f(0.F, 0.F, 0.F) == getPixel(image, 7, 7));
+            TLRENDER_ASSERT(image::Color4f(0.F, 1.F, 0.F) == getPixel(image, 40, 0));
+            TLRENDER_ASSERT(image::Color4f(0.F, 0.F, 0.F) == getPixel(image, 48, 8));
+        }
+
+        void RenderTest::_image()
+        {
+            auto render = Render::create(_context);
+            const math::Size2i size(16, 16);
+
+            // The image data starts at the bottom.
+            auto image = image::Image::create(2, 2, image::PixelType::L_U8);
+            image->getData()[0] = 255;
+            image->getData()[1] = 255;
+            image->getData()[2] = 0;
+            image->getData()[3] = 0;
+            for (auto filter : timeline::getImageFilterEnums())
+            {
+                render->begin(size);
+                timeline::ImageOptions imageOptions;
+                imageOptions.imageFilters.minify = filter;
+                imageOptions.imageFilters.magnify = filter;
+                render->drawImage(image, math::Box2i(0, 0, size.w, size.h), image::Color4f(1.F, 1.F, 1.F), imageOptions);
+                render->end();
+
+                auto out = image::Image::create(size.w, size.h, image::PixelType::RGBA_U8);
+                render->copyImage(out);
+                TLRENDER_ASSERT(image::Color4f(0.F, 0.F, 0.F) == getPixel(out, 0, 0));
+                TLRENDER_ASSERT(image::Color4f(1.F, 1.F, 1.F) == getPixel(out, 15, 15));
+            }
+        }
+
+        void RenderTest::_compare()
+        {
+            auto render = Render::create(_context);
+            const math::Size2i size(32, 32);
+            auto imageA = image::Image::create(1, 1, image::PixelType::RGBA_U8);
+            imageA->getData()[0] = 255;
+            imageA->getData()[1] = 0;
+            imageA->getData()[2] = 0;
+            imageA->getData()[3] = 255;
+            auto imageB = image::Image::create(1, 1, image::PixelType::RGBA_U8);
+            imageB->getData()[0] = 0;
+            imageB->getData()[1] = 255;
+            imageB->getData()[2] = 0;
+            imageB->getData()[3] = 255;
+            timeline::VideoData videoA;
+            videoA.layers.push_back(timeline::VideoLayer());
+            videoA.layers.back().image = imageA;
+            timeline::VideoData videoB;
+            videoB.layers.push_back(timeline::VideoLayer());
+            videoB.layers.back().image = imageB;
+            const std::vector<image::Size> sizes =
+            {
+                image::Size(size.w, size.h),
+                image::Size(size.w, size.h)
+            };
+            for (auto mode : timeline::getCompareModeEnums())
+            {
+                _print(string::Format("Compare: {0}").arg(getLabel(mode)));
+                timeline::CompareOptions compareOptions;
+                compareOptions.mode = mode;
+                const auto boxes = timeline::getBoxes(mode, sizes);
+                const math::Size2i renderSize = timeline::getRenderSize(mode, sizes);
+                render->begin(renderSize);
+                render->drawVideo({ videoA, videoB }, boxes, {}, {}, compareOptions);
+                render->end();
+                auto out = image::Image::create(renderSize.w, renderSize.h, image::PixelType::RGBA_U8);
+                render->copyImage(out);
+                switch (mode)
+                {
+                case timeline::CompareMode::A:
+                    TLRENDER_ASSERT(size == renderSize);
+                    TLRENDER_ASSERT(image::Color4f(1.F, 0.F, 0.F) == getPixel(out, 16, 16));
+                    break;
+                case timeline::CompareMode::B:
+                    TLRENDER_ASSERT(size == renderSize);
+                    TLRENDER_ASSERT(image::Color4f(0.F, 1.F, 0.F) == getPixel(out, 16, 16));
+                    break;
+                case timeline::CompareMode::Wipe:
+                    TLRENDER_ASSERT(size == renderSize);
+                    TLRENDER_ASSERT(image::Color4f(1.F, 0.F, 0.F) == getPixel(out, 4, 16));
+                    TLRENDER_ASSERT(image::Color4f(0.F, 1.F, 0.F) == getPixel(out, 28, 16));
+                    break;
+                case timeline::CompareMode::Overlay:
+                {
+                    // A is blended over B with the overlay amount.
+                    TLRENDER_ASSERT(size == renderSize);
+                    const image::Color4f pixel = getPixel(out, 16, 16);
+                    const float e = 2.F / 255.F;
+                    TLRENDER_ASSERT(std::fabs(pixel.r - compareOptions.overlay) < e);
+                    TLRENDER_ASSERT(std::fabs(pixel.g - (1.F - compareOptions.overlay)) < e);
+                    TLRENDER_ASSERT(pixel.b < e);
+                    break;
+                }
+                case timeline::CompareMode::Difference:
+                    TLRENDER_ASSERT(size == renderSize);
+                    TLRENDER_ASSERT(image::Color4f(1.F, 1.F, 0.F) == getPixel(out, 16, 16));
+                    break;
+                case timeline::CompareMode::Horizontal:
+                    TLRENDER_ASSERT(math::Size2i(size.w * 2, size.h) == renderSize);
+                    TLRENDER_ASSERT(image::Color4f(1.F, 0.F, 0.F) == getPixel(out, 16, 16));
+                    TLRENDER_ASSERT(image::Color4f(0.F, 1.F, 0.F) == getPixel(out, 48, 16));
+                    break;
+                case timeline::CompareMode::Vertical:
+                case timeline::CompareMode::Tile:
+                    TLRENDER_ASSERT(math::Size2i(size.w, size.h * 2) == renderSize);
+                    TLRENDER_ASSERT(image::Color4f(1.F, 0.F, 0.F) == getPixel(out, 16, 16));
+                    TLRENDER_ASSERT(image::Color4f(0.F, 1.F, 0.F) == getPixel(out, 16, 48));
+                    break;
+                default: break;
+                }
+            }
+        }
+
+        void RenderTest::_region()
+        {
+            // The image is the right half of a larger image, and is drawn
+            // where its data sits in the larger image.
+            auto render = Render::create(_context);
+            const math::Size2i size(32, 32);
+            auto image = image::Image::create(size.w / 2, size.h, image::PixelType::RGBA_U8);
+            for (int i = 0; i < size.w / 2 * size.h; ++i)
+            {
+                image->getData()[i * 4] = 255;
+                image->getData()[i * 4 + 1] = 0;
+                image->getData()[i * 4 + 2] = 0;
+                image->getData()[i * 4 + 3] = 255;
+            }
+            image->setRegion(image::Size(size.w, size.h), math::Vector2i(size.w / 2, 0));
+            timeline::VideoData video;
+            video.layers.push_back(timeline::VideoLayer());
+            video.layers.back().image = image;
+            timeline::RenderOptions renderOptions;
+            renderOptions.clearColor = image::Color4f(0.F, 0.F, 0.F, 1.F);
+            render->begin(size, renderOptions);
+            render->drawVideo({ video }, { math::Box2i(0, 0, size.w, size.h) });
+            render->end();
+
+            auto out = image::Image::create(size.w, size.h, image::PixelType::RGBA_U8);
+            render->copyImage(out);
+            TLRENDER_ASSERT(image::Color4f(0.F, 0.F, 0.F) == getPixel(out, 8, 16));
+            TLRENDER_ASSERT(image::Color4f(1.F, 0.F, 0.F) == getPixel(out, 24, 16));
+        }
+    
+        void RenderTest::_displayOptions()
+        {
+            auto render = Render::create(_context);
+            {
+                timeline::DisplayOptions displayOptions;
+                displayOptions.color.enabled = true;
+                displayOptions.color.invert = true;
+                TLRENDER_ASSERT(isEqual(
+                    image::Color4f(191 / 255.F, 191 / 255.F, 191 / 255.F),
+                    renderColor(render, { 64, 64, 64, 255 }, {}, displayOptions)));
+            }
+            {
+                timeline::DisplayOptions displayOptions;
+                displayOptions.color.enabled = true;
+                displayOptions.color.add = math::Vector3f(.25F, 0.F, 0.F);
+                TLRENDER_ASSERT(isEqual(
+                    image::Color4f(.5F, .25F, .25F),
+                    renderColor(render, { 64, 64, 64, 255 }, {}, displayOptions)));
+            }
+            {
+                timeline::DisplayOptions displayOptions;
+                displayOptions.levels.enabled = true;
+                displayOptions.levels.gamma = 2.F;
+                const float v = std::sqrt(128 / 255.F);
+                TLRENDER_ASSERT(isEqual(
+                    image::Color4f(v, v, v),
+                    renderColor(render, { 128, 128, 128, 255 }, {}, displayOptions)));
+            }
+            {
+                timeline::DisplayOptions displayOptions;
+                displayOptions.softClip.enabled = true;
+                displayOptions.softClip.value = .5F;
+                const float v = .5F + (1.F - std::exp(-1.F)) * .5F;
+                TLRENDER_ASSERT(isEqual(
+                    image::Color4f(v, v, .25F),
+                    renderColor(render, { 255, 255, 64, 255 }, {}, displayOptions)));
+            }
+            {
+                timeline::DisplayOptions displayOptions;
+                displayOptions.channels = timeline::Channels::Red;
+                TLRENDER_ASSERT(isEqual(
+                    image::Color4f(1.F, 1.F, 1.F),
+                    renderColor(render, { 255, 0, 128, 255 }, {}, displayOptions)));
+                displayOptions.channels = timeline::Channels::Green;
+                TLRENDER_ASSERT(isEqual(
+                    image::Color4f(0.F, 0.F, 0.F),
+                    renderColor(render, { 255, 0, 128, 255 }, {}, displayOptions)));
+            }
+            {
+                // Full range is compressed to legal range for display.
+                timeline::DisplayOptions displayOptions;
+                displayOptions.videoLevels = image::VideoLevels::LegalRange;
+                TLRENDER_ASSERT(isEqual(
+                    image::Color4f(64.F / 1023.F, 940.F / 1023.F, 64.F / 1023.F),
+                    renderColor(render, { 0, 255, 0, 255 }, {}, displayOptions)));
+            }
+            {
+                // Legal range input is expanded to full range.
+                timeline::ImageOptions imageOptions;
+                imageOptions.videoLevels = timeline::InputVideoLevels::LegalRange;
+                TLRENDER_ASSERT(isEqual(
+                    image::Color4f(1.F, 0.F, 1.F),
+                    renderColor(render, { 235, 16, 240, 255 }, imageOptions, {})));
+                imageOptions.videoLevels = timeline::InputVideoLevels::FullRange;
+                TLRENDER_ASSERT(isEqual(
+                    image::Color4f(235 / 255.F, 16 / 255.F, 240 / 255.F),
+                    renderColor(render, { 235, 16, 240, 255 }, imageOptions, {})));
+            }
+        }
+
+        void RenderTest::_threads()
+        {
+            // The render size is large enough to be split across threads,
+            // and the result must match a single threaded render.
+            auto render = Render::create(_context, nullptr, 1);
+            auto renderThreads = Render::create(_context, nullptr, 4);
+            const math::Size2i size(512, 256);
+            std::vector<std::pair<timeline::ImageOptions, timeline::DisplayOptions> > options;
+            options.push_back({});
+            {
+                timeline::DisplayOptions displayOptions;
+                displayOptions.color.enabled = true;
+                displayOptions.color.brightness = math::Vector3f(1.5F, 1.F, .5F);
+                displayOptions.color.saturation = math::Vector3f(.5F, .5F, .5F);
+                displayOptions.color.invert = true;
+                displayOptions.levels.enabled = true;
+                displayOptions.levels.gamma = .5F;
+                displayOptions.softClip.enabled = true;
+                displayOptions.softClip.value = .25F;
+                options.push_back({ timeline::ImageOptions(), displayOptions });
+            }
+            {
+                timeline::ImageOptions imageOptions;
+                imageOptions.videoLevels = timeline::InputVideoLevels::LegalRange;
+                timeline::DisplayOptions displayOptions;
+                displayOptions.videoLevels = image::VideoLevels::LegalRange;
+                displayOptions.channels = timeline::Channels::Green;
+                displayOptions.mirror.x = true;
+                options.push_back({ imageOptions, displayOptions });
+            }
+            for (const auto& i : options)
+            {
+                auto out = renderGradient(render, size, i.first, i.second);
+                auto outThreads = renderGradient(renderThreads, size, i.first, i.second);
+                TLRENDER_ASSERT(0 == memcmp(
+                    out->getData(),
+                    outThreads->getData(),
+                    out->getDataByteCount()));
+            }
+        }
+    }
+}
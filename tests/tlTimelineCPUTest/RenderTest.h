@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace timeline_cpu_tests
+    {
+        class RenderTest : public tests::ITest
+        {
+        protected:
+            RenderTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<RenderTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _prims();
+            void _image();
+            void _compare();
+            void _region();
+            void _displayOptions();
+            void _threads();
+        };
+    }
+}
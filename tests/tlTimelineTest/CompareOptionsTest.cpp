@@ -85,6 +85,45 @@ namespace tl
                 renderSize = getRenderSize(CompareMode::Tile, sizes	);
                 TLRENDER_ASSERT(math::Size2i(1920 * 2, 1080 * 2) == renderSize);
             }
+            {
+                // The view is in render coordinates, which are twice the
+                // width of the image with a pixel aspect ratio of two.
+                const image::Size size(4096, 2048, 2.F);
+                TLRENDER_ASSERT(math::Size2i(8192, 2048) ==
+                    getRenderSize(CompareMode::A, std::vector<image::Size>({ size })));
+                TLRENDER_ASSERT(!getROI(
+                    math::Box2f(math::Vector2f(0.F, 0.F), math::Vector2f(8192.F, 2048.F)),
+                    size).isValid());
+                const math::Box2i roi = getROI(
+                    math::Box2f(math::Vector2f(4096.F, 0.F), math::Vector2f(6144.F, 1024.F)),
+                    size);
+                TLRENDER_ASSERT(math::Box2i(math::Vector2i(1792, 0), math::Vector2i(3583, 1535)) == roi);
+
+                // Without a pixel aspect ratio the same view is further right.
+                TLRENDER_ASSERT(math::Box2i(math::Vector2i(3840, 0), math::Vector2i(4095, 1535)) == getROI(
+                    math::Box2f(math::Vector2f(4096.F, 0.F), math::Vector2f(6144.F, 1024.F)),
+                    image::Size(4096, 2048)));
+            }
+            {
+                // The normalized region of interest converts to the same
+                // part of images with different resolutions.
+                const image::Size size(4096, 2048);
+                TLRENDER_ASSERT(!getNormalizedROI(math::Box2i(), size).isValid());
+                const math::Box2f roi = getNormalizedROI(
+                    math::Box2i(math::Vector2i(1792, 0), math::Vector2i(3583, 1535)),
+                    size);
+                TLRENDER_ASSERT(math::Box2f(math::Vector2f(.4375F, 0.F), math::Vector2f(.875F, .75F)) == roi);
+                TLRENDER_ASSERT(math::Box2i(math::Vector2i(1792, 0), math::Vector2i(3583, 1535)) ==
+                    getImageROI(roi, size));
+                TLRENDER_ASSERT(math::Box2i(math::Vector2i(896, 0), math::Vector2i(1791, 767)) ==
+                    getImageROI(roi, image::Size(2048, 1024)));
+                TLRENDER_ASSERT(math::Box2i(math::Vector2i(840, 0), math::Vector2i(1679, 809)) ==
+                    getImageROI(roi, image::Size(1920, 1080)));
+                TLRENDER_ASSERT(!getImageROI(
+                    math::Box2f(math::Vector2f(0.F, 0.F), math::Vector2f(1.F, 1.F)),
+                    size).isValid());
+                TLRENDER_ASSERT(!getImageROI(math::Box2f(), size).isValid());
+            }
             {
                 const auto time = getCompareTime(
                     otime::RationalTime(0.0, 24.0),
@@ -32,6 +32,17 @@ namespace tl
                 TLRENDER_ASSERT(v == v);
                 TLRENDER_ASSERT(v != PlayerCacheOptions());
             }
+            {
+                PlayerCacheOptions v;
+                v.mode = PlayerCacheMode::ByteCount;
+                TLRENDER_ASSERT(v != PlayerCacheOptions());
+                v = PlayerCacheOptions();
+                v.videoByteCount = memory::megabyte;
+                TLRENDER_ASSERT(v != PlayerCacheOptions());
+                v = PlayerCacheOptions();
+                v.audioByteCount = memory::megabyte;
+                TLRENDER_ASSERT(v != PlayerCacheOptions());
+            }
         }
     }
 }
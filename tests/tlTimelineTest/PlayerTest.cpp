@@ -42,6 +42,7 @@ namespace tl
 
         void PlayerTest::_enums()
         {
+            ITest::_enum<PlayerCacheMode>("PlayerCacheMode", getPlayerCacheModeEnums);
             ITest::_enum<Playback>("Playback", getPlaybackEnums);
             ITest::_enum<Loop>("Loop", getLoopEnums);
             ITest::_enum<TimeAction>("TimeAction", getTimeActionEnums);
@@ -259,6 +260,32 @@ namespace tl
             TLRENDER_ASSERT(compareVideoLayers2 == compareVideoLayers);
             player->setVideoLayer(0);
             player->setCompareVideoLayers({});
+            int proxyLevel = 0;
+            auto proxyLevelObserver = observer::ValueObserver<int>::create(
+                player->observeProxyLevel(),
+                [&proxyLevel](int value)
+                {
+                    proxyLevel = value;
+                });
+            player->setProxyLevel(2);
+            TLRENDER_ASSERT(2 == player->getProxyLevel());
+            TLRENDER_ASSERT(2 == proxyLevel);
+            player->setProxyLevel(io::proxyLevelMax + 1);
+            TLRENDER_ASSERT(io::proxyLevelMax == player->getProxyLevel());
+            player->setProxyLevel(0);
+            math::Box2f roi;
+            auto roiObserver = observer::ValueObserver<math::Box2f>::create(
+                player->observeROI(),
+                [&roi](const math::Box2f& value)
+                {
+                    roi = value;
+                });
+            const math::Box2f roi2(math::Vector2f(0.F, 0.F), math::Vector2f(.5F, .5F));
+            player->setROI(roi2);
+            TLRENDER_ASSERT(roi2 == player->getROI());
+            TLRENDER_ASSERT(roi2 == roi);
+            player->setROI(math::Box2f());
+            TLRENDER_ASSERT(!player->getROI().isValid());
 
             // Test audio.
             float volume = 1.F;
@@ -392,6 +419,57 @@ namespace tl
                 }
                 player->setPlayback(Playback::Stop);
                 player->clearCache();
+
+                PlayerCacheInfo cacheInfo;
+                cacheInfoObserver = observer::ValueObserver<PlayerCacheInfo>::create(
+                    player->observeCacheInfo(),
+                    [&cacheInfo](const PlayerCacheInfo& value)
+                    {
+                        cacheInfo = value;
+                    });
+                cacheOptions.mode = PlayerCacheMode::ByteCount;
+                cacheOptions.videoByteCount = 16 * memory::megabyte;
+                cacheOptions.audioByteCount = memory::megabyte;
+                player->setCacheOptions(cacheOptions);
+                TLRENDER_ASSERT(cacheOptions == player->getCacheOptions());
+                player->seek(timeRange.start_time());
+                player->setPlayback(Playback::Forward);
+                const auto t = std::chrono::steady_clock::now();
+                std::chrono::duration<float> diff;
+                do
+                {
+                    player->tick();
+                    time::sleep(std::chrono::milliseconds(10));
+                    const auto t2 = std::chrono::steady_clock::now();
+                    diff = t2 - t;
+                } while (diff.count() < 1.F);
+                TLRENDER_ASSERT(cacheInfo.videoByteCount <= cacheOptions.videoByteCount);
+                player->setPlayback(Playback::Stop);
+                player->clearCache();
+
+                // The video budget is limited by the I/O cache.
+                auto ioCache = _context->getSystem<io::System>()->getCache();
+                const size_t ioCacheMax = ioCache->getMax();
+                ioCache->setMax(4 * memory::megabyte);
+                cacheOptions.videoByteCount = 0;
+                player->setCacheOptions(cacheOptions);
+                player->seek(timeRange.start_time());
+                player->setPlayback(Playback::Forward);
+                const auto t3 = std::chrono::steady_clock::now();
+                do
+                {
+                    player->tick();
+                    time::sleep(std::chrono::milliseconds(10));
+                    const auto t2 = std::chrono::steady_clock::now();
+                    diff = t2 - t3;
+                } while (diff.count() < 1.F);
+                TLRENDER_ASSERT(cacheInfo.videoByteCount <= ioCache->getPinnedMax());
+                TLRENDER_ASSERT(ioCache->getPinnedSize() <= ioCache->getPinnedMax());
+                TLRENDER_ASSERT(ioCache->getPercentage() <= 100.F);
+                player->setPlayback(Playback::Stop);
+                player->clearCache();
+                ioCache->setMax(ioCacheMax);
+                player->setCacheOptions(PlayerCacheOptions());
             }
         }
     }
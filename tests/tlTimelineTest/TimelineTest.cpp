@@ -18,6 +18,8 @@
 #include <opentimelineio/imageSequenceReference.h>
 #include <opentimelineio/timeline.h>
 
+#include <mutex>
+
 using namespace tl::timeline;
 
 namespace tl
@@ -33,6 +35,151 @@ namespace tl
             return std::shared_ptr<TimelineTest>(new TimelineTest(context));
         }
 
+        namespace
+        {
+            // Record the requests each test reader receives.
+            struct TestReadLog
+            {
+                std::mutex mutex;
+                std::map<std::string, std::vector<io::Options> > options;
+                std::map<std::string, std::vector<size_t> > batches;
+            };
+
+            // Test reader that returns empty images of a given size.
+            class TestRead : public io::IRead
+            {
+            protected:
+                TestRead() {}
+
+            public:
+                static std::shared_ptr<TestRead> create(
+                    const file::Path& path,
+                    const std::vector<file::MemoryRead>& memory,
+                    const io::Options& options,
+                    const image::Size& size,
+                    const std::shared_ptr<TestReadLog>& readLog,
+                    const std::shared_ptr<io::Cache>& cache,
+                    const std::weak_ptr<log::System>& logSystem)
+                {
+                    auto out = std::shared_ptr<TestRead>(new TestRead);
+                    out->_init(path, memory, options, cache, logSystem);
+                    out->_info.video.push_back(image::Info(size, image::PixelType::RGBA_U8));
+                    out->_info.videoTime = otime::TimeRange(
+                        otime::RationalTime(0.0, 24.0),
+                        otime::RationalTime(24.0, 24.0));
+                    out->_readLog = readLog;
+                    return out;
+                }
+
+                std::future<io::Info> getInfo() override
+                {
+                    std::promise<io::Info> promise;
+                    promise.set_value(_info);
+                    return promise.get_future();
+                }
+
+                std::future<io::VideoData> readVideo(
+                    const otime::RationalTime& time,
+                    const io::Options& options) override
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(_readLog->mutex);
+                        _readLog->options[_path.getBaseName()].push_back(options);
+                    }
+                    std::promise<io::VideoData> promise;
+                    promise.set_value(io::VideoData(time, 0, nullptr));
+                    return promise.get_future();
+                }
+
+                std::vector<std::future<io::VideoData> > readVideo(
+                    const std::vector<otime::RationalTime>& times,
+                    const io::Options& options) override
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(_readLog->mutex);
+                        _readLog->batches[_path.getBaseName()].push_back(times.size());
+                    }
+                    return io::IRead::readVideo(times, options);
+                }
+
+                void cancelRequests() override {}
+
+            private:
+                io::Info _info;
+                std::shared_ptr<TestReadLog> _readLog;
+            };
+
+            // Test plugin for the ".ttest" extension, the image size is
+            // looked up from the file base name.
+            class TestPlugin : public io::IPlugin
+            {
+            protected:
+                TestPlugin() {}
+
+            public:
+                static std::shared_ptr<TestPlugin> create(
+                    const std::map<std::string, image::Size>& sizes,
+                    const std::shared_ptr<TestReadLog>& readLog,
+                    const std::shared_ptr<io::Cache>& cache,
+                    const std::shared_ptr<io::DecodePool>& decodePool,
+                    const std::weak_ptr<log::System>& logSystem)
+                {
+                    auto out = std::shared_ptr<TestPlugin>(new TestPlugin);
+                    out->_init(
+                        "Test",
+                        { { ".ttest", io::FileType::Movie } },
+                        cache,
+                        decodePool,
+                        logSystem);
+                    out->_sizes = sizes;
+                    out->_readLog = readLog;
+                    return out;
+                }
+
+                std::shared_ptr<io::IRead> read(
+                    const file::Path& path,
+                    const io::Options& options) override
+                {
+                    return read(path, {}, options);
+                }
+
+                std::shared_ptr<io::IRead> read(
+                    const file::Path& path,
+                    const std::vector<file::MemoryRead>& memory,
+                    const io::Options& options) override
+                {
+                    const auto i = _sizes.find(path.getBaseName());
+                    return TestRead::create(
+                        path,
+                        memory,
+                        options,
+                        i != _sizes.end() ? i->second : image::Size(),
+                        _readLog,
+                        _cache,
+                        _logSystem);
+                }
+
+                image::Info getWriteInfo(
+                    const image::Info&,
+                    const io::Options&) const override
+                {
+                    return image::Info();
+                }
+
+                std::shared_ptr<io::IWrite> write(
+                    const file::Path&,
+                    const io::Info&,
+                    const io::Options&) override
+                {
+                    return nullptr;
+                }
+
+            private:
+                std::map<std::string, image::Size> _sizes;
+                std::shared_ptr<TestReadLog> _readLog;
+            };
+        }
+
         void TimelineTest::run()
         {
             _enums();
@@ -43,6 +190,8 @@ namespace tl
             _timeline();
             _separateAudio();
             _setTimeline();
+            _roi();
+            _batch();
         }
 
         void TimelineTest::_enums()
@@ -164,6 +313,22 @@ namespace tl
             }
             TLRENDER_ASSERT(videoRequests.empty());
 
+            // Get batched video from the timeline.
+            std::vector<otime::RationalTime> times;
+            for (size_t i = 0; i < static_cast<size_t>(timeRange.duration().value()); ++i)
+            {
+                times.push_back(otime::RationalTime(i, 24.0));
+            }
+            videoRequests = timeline->getVideo(times, ioOptions);
+            TLRENDER_ASSERT(times.size() == videoRequests.size());
+            for (size_t i = 0; i < videoRequests.size(); ++i)
+            {
+                TLRENDER_ASSERT(videoRequests[i].future.valid());
+                const auto data = videoRequests[i].future.get();
+                TLRENDER_ASSERT(times[i] == data.time);
+            }
+            videoRequests.clear();
+
             // Get audio from the timeline.
             std::vector<timeline::AudioData> audioData;
             std::vector<timeline::AudioRequest> audioRequests;
@@ -322,5 +487,132 @@ namespace tl
             timeline->setTimeline(otioTimeline);
             TLRENDER_ASSERT(otioTimeline.value == timeline->getTimeline().value);
         }
+
+        void TimelineTest::_roi()
+        {
+            // Create a timeline with two clips of different sizes.
+            auto ioSystem = _context->getSystem<io::System>();
+            auto readLog = std::make_shared<TestReadLog>();
+            auto plugin = TestPlugin::create(
+                {
+                    { "TimelineTest_A", image::Size(4096, 2048) },
+                    { "TimelineTest_B", image::Size(2048, 1024) }
+                },
+                readLog,
+                ioSystem->getCache(),
+                ioSystem->getDecodePool(),
+                _context->getLogSystem());
+            ioSystem->addPlugin(plugin);
+            try
+            {
+                otio::SerializableObject::Retainer<otio::Timeline> otioTimeline(new otio::Timeline);
+                auto otioTrack = new otio::Track("Video", std::nullopt, otio::Track::Kind::video);
+                otioTimeline->tracks()->append_child(otioTrack);
+                for (const std::string& name : { "TimelineTest_A", "TimelineTest_B" })
+                {
+                    otioTrack->append_child(new otio::Clip(
+                        name,
+                        new otio::ExternalReference(name + ".ttest"),
+                        otime::TimeRange(
+                            otime::RationalTime(0.0, 24.0),
+                            otime::RationalTime(24.0, 24.0))));
+                }
+                auto timeline = Timeline::create(otioTimeline, _context);
+                TLRENDER_ASSERT(image::Size(4096, 2048) == timeline->getIOInfo().video.front().size);
+
+                // The region of interest is normalized to the timeline
+                // frame, and each reader gets it in its own image
+                // coordinates.
+                const math::Box2f roi(math::Vector2f(.25F, .5F), math::Vector2f(.75F, 1.F));
+                io::Options ioOptions;
+                ioOptions["Timeline/ROI"] = getROIOption(roi);
+                std::vector<timeline::VideoRequest> videoRequests;
+                videoRequests.push_back(timeline->getVideo(otime::RationalTime(0.0, 24.0), ioOptions));
+                videoRequests.push_back(timeline->getVideo(otime::RationalTime(24.0, 24.0), ioOptions));
+                for (auto& videoRequest : videoRequests)
+                {
+                    TLRENDER_ASSERT(videoRequest.future.valid());
+                    videoRequest.future.get();
+                }
+                std::unique_lock<std::mutex> lock(readLog->mutex);
+                const std::map<std::string, math::Box2i> clipROIs =
+                {
+                    { "TimelineTest_A", math::Box2i(math::Vector2i(1024, 1024), math::Vector2i(3071, 2047)) },
+                    { "TimelineTest_B", math::Box2i(math::Vector2i(512, 512), math::Vector2i(1535, 1023)) }
+                };
+                for (const auto& clipROI : clipROIs)
+                {
+                    const auto i = readLog->options.find(clipROI.first);
+                    TLRENDER_ASSERT(i != readLog->options.end());
+                    TLRENDER_ASSERT(!i->second.empty());
+                    for (const auto& options : i->second)
+                    {
+                        TLRENDER_ASSERT(options.find("Timeline/ROI") == options.end());
+                        math::Box2i box;
+                        TLRENDER_ASSERT(io::getROI(options, box));
+                        TLRENDER_ASSERT(clipROI.second == box);
+                    }
+                }
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+            ioSystem->removePlugin(plugin);
+        }
+    
+        void TimelineTest::_batch()
+        {
+            // Create a timeline with a single clip.
+            auto ioSystem = _context->getSystem<io::System>();
+            auto readLog = std::make_shared<TestReadLog>();
+            auto plugin = TestPlugin::create(
+                { { "TimelineTest_Batch", image::Size(16, 16) } },
+                readLog,
+                ioSystem->getCache(),
+                ioSystem->getDecodePool(),
+                _context->getLogSystem());
+            ioSystem->addPlugin(plugin);
+            try
+            {
+                otio::SerializableObject::Retainer<otio::Timeline> otioTimeline(new otio::Timeline);
+                auto otioTrack = new otio::Track("Video", std::nullopt, otio::Track::Kind::video);
+                otioTimeline->tracks()->append_child(otioTrack);
+                otioTrack->append_child(new otio::Clip(
+                    "TimelineTest_Batch",
+                    new otio::ExternalReference("TimelineTest_Batch.ttest"),
+                    otime::TimeRange(
+                        otime::RationalTime(0.0, 24.0),
+                        otime::RationalTime(24.0, 24.0))));
+                auto timeline = Timeline::create(otioTimeline, _context);
+
+                // The batch is larger than the video request count, and the
+                // reader receives it with a single call.
+                std::vector<otime::RationalTime> times;
+                for (size_t i = 0; i < 24; ++i)
+                {
+                    times.push_back(otime::RationalTime(i, 24.0));
+                }
+                TLRENDER_ASSERT(times.size() > timeline->getOptions().videoRequestCount);
+                auto videoRequests = timeline->getVideo(times);
+                TLRENDER_ASSERT(times.size() == videoRequests.size());
+                for (size_t i = 0; i < videoRequests.size(); ++i)
+                {
+                    TLRENDER_ASSERT(videoRequests[i].future.valid());
+                    const auto data = videoRequests[i].future.get();
+                    TLRENDER_ASSERT(times[i] == data.time);
+                }
+                std::unique_lock<std::mutex> lock(readLog->mutex);
+                const auto i = readLog->batches.find("TimelineTest_Batch");
+                TLRENDER_ASSERT(i != readLog->batches.end());
+                TLRENDER_ASSERT(std::vector<size_t>({ times.size() }) == i->second);
+                TLRENDER_ASSERT(times.size() == readLog->options["TimelineTest_Batch"].size());
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+            ioSystem->removePlugin(plugin);
+        }
     }
 }
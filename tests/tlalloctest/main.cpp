@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+// Tests for code that must not allocate memory, like the real-time audio
+// callback. The tests run in their own executable because they replace the
+// global allocation operators.
+
+#include <tlTimeline/AudioOutput.h>
+
+#include <tlCore/Assert.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <vector>
+
+using namespace tl;
+
+namespace
+{
+    // Count the memory allocations made by the current thread while
+    // counting is enabled.
+    thread_local bool allocationCounting = false;
+    thread_local size_t allocationCount = 0;
+
+    class AllocationCounter
+    {
+    public:
+        AllocationCounter()
+        {
+            allocationCount = 0;
+            allocationCounting = true;
+        }
+
+        ~AllocationCounter()
+        {
+            allocationCounting = false;
+        }
+
+        size_t getCount() const
+        {
+            return allocationCount;
+        }
+    };
+}
+
+void* operator new(std::size_t size)
+{
+    if (allocationCounting)
+    {
+        ++allocationCount;
+    }
+    if (void* out = std::malloc(size > 0 ? size : 1))
+    {
+        return out;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+namespace
+{
+    void audioOutputTest()
+    {
+        std::cout << "audioOutputTest" << std::endl;
+        const audio::Info info(1, audio::DataType::S32, 48000);
+        const size_t bufferSampleCount = 256;
+        timeline::AudioOutputState state;
+        state.info = info;
+        state.ringBuffer = audio::AudioRingBuffer::create(info, bufferSampleCount * 4);
+        std::vector<audio::S32_T> out(bufferSampleCount);
+        uint8_t* outP = reinterpret_cast<uint8_t*>(out.data());
+        {
+            // The output is zeroed while stopped.
+            std::vector<audio::S32_T> in(bufferSampleCount, 1);
+            state.ringBuffer->write(reinterpret_cast<const uint8_t*>(in.data()), in.size());
+            out[0] = 1;
+            TLRENDER_ASSERT(0 == timeline::audioOutput(state, outP, bufferSampleCount));
+            TLRENDER_ASSERT(0 == out[0]);
+            TLRENDER_ASSERT(0 == state.frame);
+        }
+        {
+            // The output is zeroed until the audio thread flushes a reset,
+            // then the old audio is discarded.
+            state.playing = true;
+            ++state.resetCount;
+            out[0] = 1;
+            TLRENDER_ASSERT(0 == timeline::audioOutput(state, outP, bufferSampleCount));
+            TLRENDER_ASSERT(0 == out[0]);
+            state.flushCount = static_cast<uint64_t>(state.resetCount);
+            TLRENDER_ASSERT(0 == timeline::audioOutput(state, outP, bufferSampleCount));
+            TLRENDER_ASSERT(state.resetAck == state.resetCount);
+            TLRENDER_ASSERT(0 == state.ringBuffer->getReadAvailable());
+        }
+        {
+            // Fill the output like the audio device callback while another
+            // thread writes to the ring buffer, and check that the callback
+            // does not allocate memory.
+            const size_t sampleCount = 48000;
+            auto ringBuffer = state.ringBuffer;
+            std::thread thread(
+                [ringBuffer, bufferSampleCount, sampleCount]
+                {
+                    std::vector<audio::S32_T> data(bufferSampleCount);
+                    size_t value = 0;
+                    while (value < sampleCount)
+                    {
+                        const size_t size = std::min(
+                            ringBuffer->getWriteAvailable(),
+                            std::min(bufferSampleCount, sampleCount - value));
+                        for (size_t i = 0; i < size; ++i)
+                        {
+                            data[i] = value + i;
+                        }
+                        value += ringBuffer->write(
+                            reinterpret_cast<const uint8_t*>(data.data()),
+                            size);
+                        std::this_thread::yield();
+                    }
+                });
+            size_t count = 0;
+            bool valid = true;
+            size_t allocations = 0;
+            {
+                AllocationCounter counter;
+                while (count < sampleCount)
+                {
+                    const size_t size = timeline::audioOutput(state, outP, bufferSampleCount);
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        valid &= out[i] == static_cast<audio::S32_T>(count + i);
+                    }
+                    for (size_t i = size; i < bufferSampleCount; ++i)
+                    {
+                        valid &= 0 == out[i];
+                    }
+                    count += size;
+                }
+                allocations = counter.getCount();
+            }
+            thread.join();
+            TLRENDER_ASSERT(valid);
+            TLRENDER_ASSERT(0 == allocations);
+            TLRENDER_ASSERT(sampleCount == state.frame);
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    audioOutputTest();
+    return 0;
+}
@@ -30,6 +30,8 @@
 #include <tlTimelineTest/TimelineTest.h>
 #include <tlTimelineTest/UtilTest.h>
 
+#include <tlTimelineCPUTest/RenderTest.h>
+
 #include <tlIOTest/CineonTest.h>
 #include <tlIOTest/DPXTest.h>
 #include <tlIOTest/IOTest.h>
@@ -59,11 +61,14 @@
 #include <tlCoreTest/ColorTest.h>
 #include <tlCoreTest/ContextTest.h>
 #include <tlCoreTest/ErrorTest.h>
+#include <tlCoreTest/FileBatchTest.h>
 #include <tlCoreTest/FileIOTest.h>
+#include <tlCoreTest/FilePrefetchTest.h>
 #include <tlCoreTest/FileInfoTest.h>
 #include <tlCoreTest/FileTest.h>
 #include <tlCoreTest/FontSystemTest.h>
 #include <tlCoreTest/HDRTest.h>
+#include <tlCoreTest/ImagePoolTest.h>
 #include <tlCoreTest/ImageTest.h>
 #include <tlCoreTest/LRUCacheTest.h>
 #include <tlCoreTest/ListObserverTest.h>
@@ -102,11 +107,14 @@ void coreTests(
     tests.push_back(core_tests::ColorTest::create(context));
     tests.push_back(core_tests::ContextTest::create(context));
     tests.push_back(core_tests::ErrorTest::create(context));
+    tests.push_back(core_tests::FileBatchTest::create(context));
     tests.push_back(core_tests::FileIOTest::create(context));
+    tests.push_back(core_tests::FilePrefetchTest::create(context));
     tests.push_back(core_tests::FileInfoTest::create(context));
     tests.push_back(core_tests::FileTest::create(context));
     tests.push_back(core_tests::FontSystemTest::create(context));
     tests.push_back(core_tests::HDRTest::create(context));
+    tests.push_back(core_tests::ImagePoolTest::create(context));
     tests.push_back(core_tests::ImageTest::create(context));
     tests.push_back(core_tests::LRUCacheTest::create(context));
     tests.push_back(core_tests::ListObserverTest::create(context));
@@ -187,6 +195,13 @@ void timelineTests(
     tests.push_back(timeline_tests::UtilTest::create(context));
 }
 
+void timelineCPUTests(
+    std::vector<std::shared_ptr<tests::ITest> >& tests,
+    const std::shared_ptr<system::Context>& context)
+{
+    tests.push_back(timeline_cpu_tests::RenderTest::create(context));
+}
+
 void appTests(
     std::vector<std::shared_ptr<tests::ITest> >& tests,
     const std::shared_ptr<system::Context>& context)
@@ -237,6 +252,7 @@ int main(int argc, char* argv[])
     glTests(tests, context);
     ioTests(tests, context);
     timelineTests(tests, context);
+    timelineCPUTests(tests, context);
     appTests(tests, context);
     qtTests(tests, context);
 